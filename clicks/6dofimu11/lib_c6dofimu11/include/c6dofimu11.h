@@ -75,6 +75,7 @@
 #define C6DOFIMU11_RETVAL  uint8_t
 
 #define C6DOFIMU11_OK           0x00
+#define C6DOFIMU11_ERROR        0xFE
 #define C6DOFIMU11_INIT_ERROR   0xFF
 /** \} */
 
@@ -401,6 +402,10 @@
 #define C6DOFIMU11_ACCEL_COEF_RES_32G                      0.02929776840
 #define C6DOFIMU11_ACCEL_COEF_RES_64G                      0.11255815032
 #define C6DOFIMU11_MAG_COEF                                0.03662221137
+
+#define C6DOFIMU11_BUF_SIZE_BYTES                                   384
+#define C6DOFIMU11_BUF_ACCEL_SAMPLE_BYTES                           6
+#define C6DOFIMU11_BUF_ACCEL_MAX_SAMPLES                            64
 /** \} */
 
 /** \} */ // End group macro 
@@ -432,6 +437,7 @@ typedef struct
     // ctx variable 
 
     uint8_t slave_address;
+    float accel_coef;
 
 } c6dofimu11_t;
 
@@ -479,6 +485,33 @@ typedef struct
 }
 c6dofimu11_mag_t;
 
+/**
+ * @brief Raw accel sample structure definition.
+ */
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    uint32_t timestamp;
+}
+c6dofimu11_sample_t;
+
+/**
+ * @brief Single producer / single consumer sample ring definition.
+ * @details Only the FIFO drain writes @b head and only the application
+ * writes @b tail, so the drain may run from the interrupt context.
+ */
+typedef struct
+{
+    c6dofimu11_sample_t *buf;
+    uint16_t size;
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    uint16_t dropped;
+}
+c6dofimu11_ring_t;
+
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
 /**
@@ -724,6 +757,69 @@ float c6dofimu11_get_temperature ( c6dofimu11_t *ctx );
  */
 uint8_t c6dofimu11_get_interrupt ( c6dofimu11_t *ctx );
 
+ /**
+ * @brief Read motion data.
+ * 
+ * @param ctx          Click object.
+ * @param accel_data   Accel data.
+ * @param mag_data     Mag data.
+ * @param temperature  Temperature.
+ *
+ * @description This function reads accel, mag and temperature output
+ * registers in one 14 byte burst and scales them with the cached range.
+ */
+void c6dofimu11_read_motion ( c6dofimu11_t *ctx, c6dofimu11_accel_t *accel_data, 
+                              c6dofimu11_mag_t *mag_data, float *temperature );
+
+ /**
+ * @brief Set FIFO watermark.
+ * 
+ * @param ctx          Click object.
+ * @param watermark    Number of accel samples that fires the interrupt [1-64].
+ *
+ * @description This function buffers accel axes in stream mode and routes
+ * the watermark interrupt to the INT1 pin.
+ * @note Sensors are put in standby while the buffer is configured.
+ */
+C6DOFIMU11_RETVAL c6dofimu11_set_fifo_watermark ( c6dofimu11_t *ctx, uint8_t watermark );
+
+ /**
+ * @brief Ring init.
+ * 
+ * @param ring         Sample ring.
+ * @param buf          Sample storage.
+ * @param size         Number of samples in storage, one slot is kept free.
+ *
+ * @description This function attaches caller provided storage to the ring.
+ */
+void c6dofimu11_ring_init ( c6dofimu11_ring_t *ring, c6dofimu11_sample_t *buf, uint16_t size );
+
+ /**
+ * @brief Ring pop.
+ * 
+ * @param ring         Sample ring.
+ * @param sample       Oldest sample.
+ *
+ * @description This function takes the oldest sample out of the ring,
+ * returns C6DOFIMU11_ERROR when the ring is empty.
+ */
+C6DOFIMU11_RETVAL c6dofimu11_ring_pop ( c6dofimu11_ring_t *ring, c6dofimu11_sample_t *sample );
+
+ /**
+ * @brief FIFO drain.
+ * 
+ * @param ctx          Click object.
+ * @param ring         Sample ring.
+ * @param timestamp    Time of the newest buffered sample.
+ * @param period       Accel output data period in timestamp units.
+ *
+ * @description This function empties the sample buffer into the ring reading
+ * several samples per transaction. Older samples are back-dated by @b period,
+ * samples that don't fit in the ring are counted in @b dropped.
+ * Returns number of samples read from the buffer.
+ */
+uint8_t c6dofimu11_fifo_drain ( c6dofimu11_t *ctx, c6dofimu11_ring_t *ring, uint32_t timestamp, uint32_t period );
+
 
 #ifdef __cplusplus
 }
@@ -27,6 +27,17 @@
 
 #include "c6dofimu11.h"
 
+// ------------------------------------------------------------- PRIVATE MACROS 
+
+#define C6DOFIMU11_FIFO_CHUNK_SAMPLES  8
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static float c6dofimu11_accel_coef ( uint8_t gsel );
+
+static int16_t c6dofimu11_get_le16 ( uint8_t *buf );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void c6dofimu11_cfg_setup ( c6dofimu11_cfg_t *cfg )
 {
@@ -70,7 +81,8 @@ C6DOFIMU11_RETVAL c6dofimu11_init ( c6dofimu11_t *ctx, c6dofimu11_cfg_t *cfg )
     // Input pins
 
     digital_in_init( &ctx->gp2, cfg->gp2 );
-  
+    
+    ctx->accel_coef = C6DOFIMU11_ACCEL_COEF_RES_8G;
 
     return C6DOFIMU11_OK;
 }
@@ -94,6 +106,7 @@ void c6dofimu11_default_cfg ( c6dofimu11_t *ctx )
                                  C6DOFIMU11_CNTL2_MAG_EN_OPERATING_MODE | 
                                  C6DOFIMU11_CNTL2_ACCEL_EN_OPERATING_MODE );
     
+    ctx->accel_coef = C6DOFIMU11_ACCEL_COEF_RES_8G;
 }
 
 void c6dofimu11_generic_write ( c6dofimu11_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
@@ -231,6 +244,8 @@ void c6dofimu11_config_accel ( c6dofimu11_t *ctx, uint8_t data_rate, uint8_t dat
     tmp_val |= C6DOFIMU11_CNTL2_ACCEL_EN_MASK;
     
     c6dofimu11_write_byte( ctx, C6DOFIMU11_CNTL2, tmp_val );
+    
+    ctx->accel_coef = c6dofimu11_accel_coef( data_range & C6DOFIMU11_CNTL2_GSEL_MASK );
 }
 
 void c6dofimu11_config_mag ( c6dofimu11_t *ctx, uint8_t data_rate, uint8_t data_resolution )
@@ -276,16 +291,24 @@ int16_t c6dofimu11_get_axis ( c6dofimu11_t *ctx, uint8_t reg_add_lsb )
 
 void c6dofimu11_get_accel_data ( c6dofimu11_t *ctx, int16_t *accel_x, int16_t *accel_y, int16_t *accel_z )
 {
-    *accel_x = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_XOUT_L );
-    *accel_y = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_YOUT_L );
-    *accel_z = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_ZOUT_L );
+    uint8_t buf[ 6 ];
+
+    c6dofimu11_read_multiple_bytes( ctx, C6DOFIMU11_ACCEL_XOUT_L, buf, 6 );
+
+    *accel_x = c6dofimu11_get_le16( &buf[ 0 ] );
+    *accel_y = c6dofimu11_get_le16( &buf[ 2 ] );
+    *accel_z = c6dofimu11_get_le16( &buf[ 4 ] );
 }
 
 void c6dofimu11_get_mag_data ( c6dofimu11_t *ctx, int16_t *mag_x, int16_t *mag_y, int16_t *mag_z )
 {
-    *mag_x = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_XOUT_L );
-    *mag_y = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_YOUT_L );
-    *mag_z = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_ZOUT_L );
+    uint8_t buf[ 6 ];
+
+    c6dofimu11_read_multiple_bytes( ctx, C6DOFIMU11_MAG_XOUT_L, buf, 6 );
+
+    *mag_x = c6dofimu11_get_le16( &buf[ 0 ] );
+    *mag_y = c6dofimu11_get_le16( &buf[ 2 ] );
+    *mag_z = c6dofimu11_get_le16( &buf[ 4 ] );
 }
 
 void c6dofimu11_read_accel (  c6dofimu11_t *ctx, c6dofimu11_accel_t *accel_data )
@@ -293,58 +316,12 @@ void c6dofimu11_read_accel (  c6dofimu11_t *ctx, c6dofimu11_accel_t *accel_data
     int16_t accel_x;
     int16_t accel_y;
     int16_t accel_z;
-    uint8_t c_tmp;
-    
-    accel_x = c6dofimu11_get_axis(  ctx, C6DOFIMU11_ACCEL_XOUT_L );
-    accel_y = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_YOUT_L );
-    accel_z = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_ZOUT_L );
     
-    c_tmp = c6dofimu11_read_byte( ctx, C6DOFIMU11_CNTL2 );
-    c_tmp &= C6DOFIMU11_CNTL2_GSEL_MASK;
+    c6dofimu11_get_accel_data( ctx, &accel_x, &accel_y, &accel_z );
     
-    switch ( c_tmp )
-    {
-        case C6DOFIMU11_CNTL2_GSEL_8G:
-        {
-            accel_data->x = ( float ) accel_x;
-            accel_data->x *= C6DOFIMU11_ACCEL_COEF_RES_8G;
-            accel_data->y = ( float ) accel_y;
-            accel_data->y *= C6DOFIMU11_ACCEL_COEF_RES_8G;
-            accel_data->z = ( float ) accel_z;
-            accel_data->z *= C6DOFIMU11_ACCEL_COEF_RES_8G;
-            break;
-        }
-        case C6DOFIMU11_CNTL2_GSEL_16G:
-        {
-            accel_data->x = ( float ) accel_x;
-            accel_data->x *= C6DOFIMU11_ACCEL_COEF_RES_16G;
-            accel_data->y = ( float ) accel_y;
-            accel_data->y *= C6DOFIMU11_ACCEL_COEF_RES_16G;
-            accel_data->z = ( float ) accel_z;
-            accel_data->z *= C6DOFIMU11_ACCEL_COEF_RES_16G;
-            break;
-        }
-        case C6DOFIMU11_CNTL2_GSEL_32G:
-        {
-            accel_data->x = ( float ) accel_x;
-            accel_data->x *= C6DOFIMU11_ACCEL_COEF_RES_32G;
-            accel_data->y = ( float ) accel_y;
-            accel_data->y *= C6DOFIMU11_ACCEL_COEF_RES_32G;
-            accel_data->z = ( float ) accel_z;
-            accel_data->z *= C6DOFIMU11_ACCEL_COEF_RES_32G;
-            break;
-        }
-        case C6DOFIMU11_CNTL2_GSEL_64G:
-        {
-            accel_data->x = ( float ) accel_x;
-            accel_data->x *= C6DOFIMU11_ACCEL_COEF_RES_64G;
-            accel_data->y = ( float ) accel_y;
-            accel_data->y *= C6DOFIMU11_ACCEL_COEF_RES_64G;
-            accel_data->z = ( float ) accel_z;
-            accel_data->z *= C6DOFIMU11_ACCEL_COEF_RES_64G;
-            break;
-        }
-    }
+    accel_data->x = ( float ) accel_x * ctx->accel_coef;
+    accel_data->y = ( float ) accel_y * ctx->accel_coef;
+    accel_data->z = ( float ) accel_z * ctx->accel_coef;
 }
 
 void c6dofimu11_read_mag ( c6dofimu11_t *ctx, c6dofimu11_mag_t *mag_data )
@@ -352,11 +329,8 @@ void c6dofimu11_read_mag ( c6dofimu11_t *ctx, c6dofimu11_mag_t *mag_data )
     int16_t mag_x;
     int16_t mag_y;
     int16_t mag_z;
-    uint8_t c_tmp;
     
-    mag_x = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_XOUT_L );
-    mag_y = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_YOUT_L );
-    mag_z = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_ZOUT_L );
+    c6dofimu11_get_mag_data( ctx, &mag_x, &mag_y, &mag_z );
     
     mag_data->x = ( float ) mag_x;
     mag_data->x *= C6DOFIMU11_MAG_COEF;
@@ -403,5 +377,168 @@ uint8_t c6dofimu11_get_interrupt ( c6dofimu11_t *ctx )
   
 }
 
+void c6dofimu11_read_motion ( c6dofimu11_t *ctx, c6dofimu11_accel_t *accel_data, 
+                              c6dofimu11_mag_t *mag_data, float *temperature )
+{
+    uint8_t buf[ 14 ];
+
+    c6dofimu11_read_multiple_bytes( ctx, C6DOFIMU11_ACCEL_XOUT_L, buf, 14 );
+
+    accel_data->x = ( float ) c6dofimu11_get_le16( &buf[ 0 ] ) * ctx->accel_coef;
+    accel_data->y = ( float ) c6dofimu11_get_le16( &buf[ 2 ] ) * ctx->accel_coef;
+    accel_data->z = ( float ) c6dofimu11_get_le16( &buf[ 4 ] ) * ctx->accel_coef;
+
+    mag_data->x = ( float ) c6dofimu11_get_le16( &buf[ 6 ] ) * C6DOFIMU11_MAG_COEF;
+    mag_data->y = ( float ) c6dofimu11_get_le16( &buf[ 8 ] ) * C6DOFIMU11_MAG_COEF;
+    mag_data->z = ( float ) c6dofimu11_get_le16( &buf[ 10 ] ) * C6DOFIMU11_MAG_COEF;
+
+    *temperature = ( float ) ( ( int8_t ) buf[ 13 ] );
+    *temperature += ( ( float ) ( ( int8_t ) buf[ 12 ] ) ) / 256.0;
+}
+
+C6DOFIMU11_RETVAL c6dofimu11_set_fifo_watermark ( c6dofimu11_t *ctx, uint8_t watermark )
+{
+    uint8_t cntl2;
+
+    if ( ( watermark == 0 ) || ( watermark > C6DOFIMU11_BUF_ACCEL_MAX_SAMPLES ) )
+    {
+        return C6DOFIMU11_ERROR;
+    }
+
+    cntl2 = c6dofimu11_read_byte( ctx, C6DOFIMU11_CNTL2 );
+    c6dofimu11_disable_sensor( ctx );
+
+    c6dofimu11_write_byte( ctx, C6DOFIMU11_BUF_CTRL_1, watermark );
+    c6dofimu11_write_byte( ctx, C6DOFIMU11_BUF_CTRL_2, C6DOFIMU11_BUF_CTRL_2_BUF_M_STREAM );
+    c6dofimu11_write_byte( ctx, C6DOFIMU11_BUF_CTRL_3, C6DOFIMU11_BUF_CTRL_3_BUF_AX_ENABLED | 
+                                                       C6DOFIMU11_BUF_CTRL_3_BUF_AY_ENABLED | 
+                                                       C6DOFIMU11_BUF_CTRL_3_BUF_AZ_ENABLED );
+    c6dofimu11_write_byte( ctx, C6DOFIMU11_BUF_CLEAR, 0x00 );
+    c6dofimu11_write_byte( ctx, C6DOFIMU11_INC1, c6dofimu11_read_byte( ctx, C6DOFIMU11_INC1 ) | 
+                                                 C6DOFIMU11_INC1_WMI1 );
+
+    c6dofimu11_write_byte( ctx, C6DOFIMU11_CNTL2, cntl2 );
+
+    return C6DOFIMU11_OK;
+}
+
+void c6dofimu11_ring_init ( c6dofimu11_ring_t *ring, c6dofimu11_sample_t *buf, uint16_t size )
+{
+    ring->buf = buf;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+}
+
+C6DOFIMU11_RETVAL c6dofimu11_ring_pop ( c6dofimu11_ring_t *ring, c6dofimu11_sample_t *sample )
+{
+    uint16_t tail = ring->tail;
+
+    if ( tail == ring->head )
+    {
+        return C6DOFIMU11_ERROR;
+    }
+
+    *sample = ring->buf[ tail ];
+
+    if ( ++tail >= ring->size )
+    {
+        tail = 0;
+    }
+    ring->tail = tail;
+
+    return C6DOFIMU11_OK;
+}
+
+uint8_t c6dofimu11_fifo_drain ( c6dofimu11_t *ctx, c6dofimu11_ring_t *ring, uint32_t timestamp, uint32_t period )
+{
+    uint8_t buf[ C6DOFIMU11_FIFO_CHUNK_SAMPLES * C6DOFIMU11_BUF_ACCEL_SAMPLE_BYTES ];
+    uint8_t status[ 2 ];
+    uint16_t level;
+    uint8_t samples;
+    uint8_t chunk;
+    uint8_t done = 0;
+    uint8_t cnt;
+    uint16_t head = ring->head;
+    uint16_t next;
+
+    c6dofimu11_read_multiple_bytes( ctx, C6DOFIMU11_BUF_STATUS_1, status, 2 );
+    level = ( ( uint16_t ) ( status[ 1 ] & C6DOFIMU11_BUF_STATUS_2_SMP_LEV_H ) << 8 ) | status[ 0 ];
+    samples = level / C6DOFIMU11_BUF_ACCEL_SAMPLE_BYTES;
+
+    while ( done < samples )
+    {
+        chunk = samples - done;
+        if ( chunk > C6DOFIMU11_FIFO_CHUNK_SAMPLES )
+        {
+            chunk = C6DOFIMU11_FIFO_CHUNK_SAMPLES;
+        }
+
+        c6dofimu11_read_multiple_bytes( ctx, C6DOFIMU11_BUF_READ, buf, 
+                                        chunk * C6DOFIMU11_BUF_ACCEL_SAMPLE_BYTES );
+
+        for ( cnt = 0; cnt < chunk; cnt++, done++ )
+        {
+            next = head + 1;
+            if ( next >= ring->size )
+            {
+                next = 0;
+            }
+
+            if ( next == ring->tail )
+            {
+                ring->dropped++;
+                continue;
+            }
+
+            ring->buf[ head ].x = c6dofimu11_get_le16( &buf[ cnt * C6DOFIMU11_BUF_ACCEL_SAMPLE_BYTES ] );
+            ring->buf[ head ].y = c6dofimu11_get_le16( &buf[ cnt * C6DOFIMU11_BUF_ACCEL_SAMPLE_BYTES + 2 ] );
+            ring->buf[ head ].z = c6dofimu11_get_le16( &buf[ cnt * C6DOFIMU11_BUF_ACCEL_SAMPLE_BYTES + 4 ] );
+            ring->buf[ head ].timestamp = timestamp - ( uint32_t ) ( samples - 1 - done ) * period;
+            head = next;
+            ring->head = head;
+        }
+    }
+
+    return samples;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static float c6dofimu11_accel_coef ( uint8_t gsel )
+{
+    switch ( gsel )
+    {
+        case C6DOFIMU11_CNTL2_GSEL_16G:
+        {
+            return C6DOFIMU11_ACCEL_COEF_RES_16G;
+        }
+        case C6DOFIMU11_CNTL2_GSEL_32G:
+        {
+            return C6DOFIMU11_ACCEL_COEF_RES_32G;
+        }
+        case C6DOFIMU11_CNTL2_GSEL_64G:
+        {
+            return C6DOFIMU11_ACCEL_COEF_RES_64G;
+        }
+        default:
+        {
+            return C6DOFIMU11_ACCEL_COEF_RES_8G;
+        }
+    }
+}
+
+static int16_t c6dofimu11_get_le16 ( uint8_t *buf )
+{
+    uint16_t axis_val;
+
+    axis_val = buf[ 1 ];
+    axis_val <<= 8;
+    axis_val |= buf[ 0 ];
+
+    return ( int16_t ) axis_val;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -167,6 +167,21 @@
 #define ACCEL_DATA_FORMAT_RANGE_8           0x02
 #define ACCEL_DATA_FORMAT_RANGE_4           0x01
 #define ACCEL_DATA_FORMAT_RANGE_2           0x00
+#define ACCEL_DATA_FORMAT_RANGE_MASK        0x03
+/** \} */
+
+/**
+ * \defgroup int_enable Interrupt enable 
+ * \{
+ */ 
+#define ACCEL_INT_DATA_READY                0x80
+#define ACCEL_INT_SINGLE_TAP                0x40
+#define ACCEL_INT_DOUBLE_TAP                0x20
+#define ACCEL_INT_ACTIVITY                  0x10
+#define ACCEL_INT_INACTIVITY                0x08
+#define ACCEL_INT_FREE_FALL                 0x04
+#define ACCEL_INT_WATERMARK                 0x02
+#define ACCEL_INT_OVERRUN                   0x01
 /** \} */
 
 /**
@@ -201,6 +216,9 @@
 #define ACCEL_FIFO_CTL_FIFO_MODE_STREAM     0x80
 #define ACCEL_FIFO_CTL_FIFO_MODE_TRIGGER    0x60
 #define ACCEL_FIFO_CTL_TRIGGER_INT2         0x20
+#define ACCEL_FIFO_CTL_SAMPLES_MASK         0x1F
+#define ACCEL_FIFO_STATUS_ENTRIES_MASK      0x3F
+#define ACCEL_FIFO_SIZE                     32
 /** \} */
 
 /**
@@ -259,6 +277,7 @@ typedef struct accel_s
     accel_master_io_t  write_f;
     accel_master_io_t  read_f;
     accel_select_t master_sel;
+    float g_per_lsb;
 
 } accel_t;
 
@@ -289,6 +308,34 @@ typedef struct
 
 } accel_cfg_t;
 
+/**
+ * @brief Raw axes sample structure definition.
+ */
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    uint32_t timestamp;
+
+} accel_sample_t;
+
+/**
+ * @brief Single producer / single consumer sample ring definition.
+ * @details The FIFO drain is the only writer of @b head and the application
+ * is the only writer of @b tail, so draining from an interrupt while the
+ * main loop pops samples needs no locking.
+ */
+typedef struct
+{
+    accel_sample_t *buf;
+    uint16_t size;
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    uint16_t dropped;
+
+} accel_ring_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 /**
@@ -415,6 +462,94 @@ int16_t accel_read_y_axis ( accel_t *ctx );
  */
 int16_t accel_read_z_axis ( accel_t *ctx );
 
+/**
+ * @brief Data format setting function.
+ *
+ * @param ctx          Click object.
+ * @param data_format  DATA_FORMAT register value.
+ *
+ * @description This function writes the DATA_FORMAT register and caches the
+ * g-per-LSB scale so the sample reads don't have to query the range.
+ */
+void accel_set_data_format ( accel_t *ctx, uint8_t data_format );
+
+/**
+ * @brief Function raw read of all axes.
+ *
+ * @param ctx      Click object.
+ * @param sample   Output sample, timestamp field is left untouched.
+ *
+ * @description Function reads X, Y and Z axis in one 6 byte burst,
+ * so all three values belong to the same conversion.
+ */
+void accel_read_axes ( accel_t *ctx, accel_sample_t *sample );
+
+/**
+ * @brief Function read of all axes in g.
+ *
+ * @param ctx      Click object.
+ * @param x_g      X axis value in g.
+ * @param y_g      Y axis value in g.
+ * @param z_g      Z axis value in g.
+ *
+ * @description Function burst reads all axes and scales them with
+ * the cached data format resolution.
+ */
+void accel_read_axes_g ( accel_t *ctx, float *x_g, float *y_g, float *z_g );
+
+/**
+ * @brief FIFO watermark setting function.
+ *
+ * @param ctx        Click object.
+ * @param watermark  Number of FIFO entries that fires the interrupt [1-31].
+ *
+ * @returns 0 - Ok, -1 - Wrong watermark.
+ *
+ * @description This function puts the FIFO in stream mode and enables
+ * the watermark interrupt on the INT1 pin.
+ */
+err_t accel_set_fifo_watermark ( accel_t *ctx, uint8_t watermark );
+
+/**
+ * @brief Sample ring initialization function.
+ *
+ * @param ring     Sample ring.
+ * @param buf      Sample storage.
+ * @param size     Number of samples in storage, one slot is kept free.
+ *
+ * @description This function attaches caller provided storage to the ring.
+ */
+void accel_ring_init ( accel_ring_t *ring, accel_sample_t *buf, uint16_t size );
+
+/**
+ * @brief Sample ring pop function.
+ *
+ * @param ring     Sample ring.
+ * @param sample   Output oldest sample.
+ *
+ * @returns 0 - Ok, -1 - Ring is empty.
+ *
+ * @description This function takes the oldest sample out of the ring.
+ */
+err_t accel_ring_pop ( accel_ring_t *ring, accel_sample_t *sample );
+
+/**
+ * @brief FIFO drain function.
+ *
+ * @param ctx        Click object.
+ * @param ring       Sample ring.
+ * @param timestamp  Time of the newest FIFO entry.
+ * @param period     Output data period in timestamp units.
+ *
+ * @returns Number of samples moved from the FIFO.
+ *
+ * @description This function empties the device FIFO into the ring with one
+ * burst read per entry. Older entries are back-dated by @b period from
+ * @b timestamp. When the ring is full the sample is counted in @b dropped.
+ * @note On SPI faster than 1.6 MHz the device needs 5 us between entry reads.
+ */
+uint8_t accel_fifo_drain ( accel_t *ctx, accel_ring_t *ring, uint32_t timestamp, uint32_t period );
+
 /**
  * @brief INT Pin Get function.
  *
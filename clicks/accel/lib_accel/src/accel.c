@@ -143,6 +143,8 @@ err_t accel_init ( accel_t *ctx, accel_cfg_t *cfg )
     
     digital_in_init( &ctx->int_pin, cfg->int_pin );
     
+    ctx->g_per_lsb = 1.0f / ACCEL_DATA_RES_LSB_PER_G;
+    
     return ACCEL_OK;
 }
 
@@ -153,8 +155,7 @@ void accel_default_cfg ( accel_t *ctx )
     tx_buf = ACCEL_POWER_CTL_WAKEUP_1;
     accel_generic_write( ctx, ACCEL_REG_POWER_CTL, &tx_buf, 1 );
     
-    tx_buf = ACCEL_DATA_FORMAT_FULL_RES | ACCEL_DATA_FORMAT_RANGE_16;
-    accel_generic_write( ctx, ACCEL_REG_DATA_FORMAT , &tx_buf, 1 );
+    accel_set_data_format( ctx, ACCEL_DATA_FORMAT_FULL_RES | ACCEL_DATA_FORMAT_RANGE_16 );
     
     tx_buf = ACCEL_BW_RATE_50;
     accel_generic_write( ctx, ACCEL_REG_BW_RATE, &tx_buf, 1 );
@@ -219,6 +220,130 @@ int16_t accel_read_z_axis ( accel_t *ctx )
     return out_z;
 }
 
+void accel_set_data_format ( accel_t *ctx, uint8_t data_format )
+{
+    accel_generic_write( ctx, ACCEL_REG_DATA_FORMAT, &data_format, 1 );
+
+    if ( data_format & ACCEL_DATA_FORMAT_FULL_RES )
+    {
+        ctx->g_per_lsb = 1.0f / ACCEL_DATA_RES_LSB_PER_G;
+    }
+    else
+    {
+        ctx->g_per_lsb = ( float ) ( 1 << ( data_format & ACCEL_DATA_FORMAT_RANGE_MASK ) ) / 
+                         ACCEL_DATA_RES_LSB_PER_G;
+    }
+}
+
+void accel_read_axes ( accel_t *ctx, accel_sample_t *sample )
+{
+    uint8_t buf[ 6 ] = { 0 };
+
+    accel_generic_read( ctx, ACCEL_REG_DATA_X_LSB, buf, 6 );
+
+    sample->x = ( int16_t ) ( ( ( uint16_t ) buf[ 1 ] << 8 ) | buf[ 0 ] );
+    sample->y = ( int16_t ) ( ( ( uint16_t ) buf[ 3 ] << 8 ) | buf[ 2 ] );
+    sample->z = ( int16_t ) ( ( ( uint16_t ) buf[ 5 ] << 8 ) | buf[ 4 ] );
+}
+
+void accel_read_axes_g ( accel_t *ctx, float *x_g, float *y_g, float *z_g )
+{
+    accel_sample_t sample;
+
+    accel_read_axes( ctx, &sample );
+
+    *x_g = sample.x * ctx->g_per_lsb;
+    *y_g = sample.y * ctx->g_per_lsb;
+    *z_g = sample.z * ctx->g_per_lsb;
+}
+
+err_t accel_set_fifo_watermark ( accel_t *ctx, uint8_t watermark )
+{
+    uint8_t tx_buf = 0;
+
+    if ( ( 0 == watermark ) || ( watermark > ACCEL_FIFO_CTL_SAMPLES_MASK ) )
+    {
+        return ACCEL_ERROR;
+    }
+
+    tx_buf = ACCEL_FIFO_CTL_FIFO_MODE_STREAM | watermark;
+    accel_generic_write( ctx, ACCEL_REG_FIFO_CTL, &tx_buf, 1 );
+
+    accel_generic_read( ctx, ACCEL_REG_INT_MAP, &tx_buf, 1 );
+    tx_buf &= ~ACCEL_INT_WATERMARK;
+    accel_generic_write( ctx, ACCEL_REG_INT_MAP, &tx_buf, 1 );
+
+    accel_generic_read( ctx, ACCEL_REG_INT_ENABLE, &tx_buf, 1 );
+    tx_buf |= ACCEL_INT_WATERMARK;
+    accel_generic_write( ctx, ACCEL_REG_INT_ENABLE, &tx_buf, 1 );
+
+    return ACCEL_OK;
+}
+
+void accel_ring_init ( accel_ring_t *ring, accel_sample_t *buf, uint16_t size )
+{
+    ring->buf = buf;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+}
+
+err_t accel_ring_pop ( accel_ring_t *ring, accel_sample_t *sample )
+{
+    uint16_t tail = ring->tail;
+
+    if ( tail == ring->head )
+    {
+        return ACCEL_ERROR;
+    }
+
+    *sample = ring->buf[ tail ];
+
+    if ( ++tail >= ring->size )
+    {
+        tail = 0;
+    }
+    ring->tail = tail;
+
+    return ACCEL_OK;
+}
+
+uint8_t accel_fifo_drain ( accel_t *ctx, accel_ring_t *ring, uint32_t timestamp, uint32_t period )
+{
+    uint8_t entries = 0;
+    uint8_t cnt = 0;
+    uint16_t head = ring->head;
+    uint16_t next = 0;
+
+    accel_generic_read( ctx, ACCEL_REG_FIFO_STATUS, &entries, 1 );
+    entries &= ACCEL_FIFO_STATUS_ENTRIES_MASK;
+
+    for ( cnt = 0; cnt < entries; cnt++ )
+    {
+        next = head + 1;
+        if ( next >= ring->size )
+        {
+            next = 0;
+        }
+
+        if ( next == ring->tail )
+        {
+            accel_sample_t discard;
+            accel_read_axes( ctx, &discard );
+            ring->dropped++;
+            continue;
+        }
+
+        accel_read_axes( ctx, &ring->buf[ head ] );
+        ring->buf[ head ].timestamp = timestamp - ( uint32_t ) ( entries - 1 - cnt ) * period;
+        head = next;
+        ring->head = head;
+    }
+
+    return entries;
+}
+
 uint8_t accel_check_int_pin ( accel_t *ctx )
 {
     return digital_in_read( &ctx->int_pin );
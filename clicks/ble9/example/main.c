@@ -12,11 +12,10 @@
  * Initializes the driver and performs the Click default configuration.
  *
  * ## Application Task
- * Reads and processes all incoming data and displays them on the USB UART.
+ * Decodes all incoming BGAPI frames and displays the events on the USB UART.
  *
  * ## Additional Function
- * - static void ble9_clear_app_buf ( void )
- * - static err_t ble9_process ( ble9_t *ctx )
+ * - static void ble9_event_log ( ble9_t *ctx, ble9_bgapi_frame_t *evt )
  * 
  * <pre>
  * For more information on the chip itself and the firmware on it,
@@ -40,32 +39,20 @@
     #define MIKROBUS_POSITION_BLE9 MIKROBUS_1
 #endif
 
-#define PROCESS_BUFFER_SIZE 200
-
 static ble9_t ble9;
 static log_t logger;
 
-static uint8_t app_buf[ PROCESS_BUFFER_SIZE ] = { 0 };
-static int32_t app_buf_len = 0;
-
-/**
- * @brief BLE 9 clearing application buffer.
- * @details This function clears memory of application buffer and reset its length.
- * @note None.
- */
-static void ble9_clear_app_buf ( void );
-
 /**
- * @brief BLE 9 data reading function.
- * @details This function reads data from device and concatenates data to application buffer. 
+ * @brief BLE 9 event logging function.
+ * @details This function displays the class, ID and payload of an event on the USB UART.
  * @param[in] ctx : Click context object.
  * See #ble9_t object definition for detailed explanation.
- * @return @li @c  0 - Read some data.
- *         @li @c -1 - Nothing is read.
- * See #err_t definition for detailed explanation.
+ * @param[in] evt : Event frame.
+ * See #ble9_bgapi_frame_t object definition for detailed explanation.
+ * @return None.
  * @note None.
  */
-static err_t ble9_process ( ble9_t *ctx );
+static void ble9_event_log ( ble9_t *ctx, ble9_bgapi_frame_t *evt );
 
 // ------------------------------------------------------ APPLICATION FUNCTIONS
 
@@ -92,11 +79,11 @@ void application_init ( void )
     ble9_cfg_setup( &cfg );
     BLE9_MAP_MIKROBUS( cfg, MIKROBUS_POSITION_BLE9 );
     ble9_init( &ble9, &cfg );
+    ble9_set_event_handler( &ble9, ble9_event_log );
     Delay_ms ( 1000 );
     
-    // Clear app buffer
-    ble9_process ( &ble9 );
-    ble9_clear_app_buf( );
+    // Log the boot event
+    ble9_bgapi_process ( &ble9 );
     Delay_ms ( 100 );
     
     if ( BLE9_OK == ble9_sys_get_version ( &ble9 ) )
@@ -126,15 +113,7 @@ void application_init ( void )
 
 void application_task ( void )
 {
-    ble9_process ( &ble9 );
-    if ( app_buf_len > 0 ) 
-    {
-        for ( uint16_t cnt = 0; cnt < app_buf_len; cnt++ )
-        {
-            log_printf( &logger, "%.2X ", ( uint16_t ) app_buf[ cnt ] );
-        }
-        ble9_clear_app_buf( );
-    }
+    ble9_bgapi_process ( &ble9 );
 }
 
 int main ( void ) 
@@ -154,39 +133,14 @@ int main ( void )
     return 0;
 }
 
-static void ble9_clear_app_buf ( void ) 
-{
-    memset( app_buf, 0, app_buf_len );
-    app_buf_len = 0;
-}
-
-static err_t ble9_process ( ble9_t *ctx ) 
+static void ble9_event_log ( ble9_t *ctx, ble9_bgapi_frame_t *evt ) 
 {
-    uint8_t rx_buf[ PROCESS_BUFFER_SIZE ] = { 0 };
-    int32_t rx_size = 0;
-    rx_size = ble9_generic_read( ctx, rx_buf, PROCESS_BUFFER_SIZE );
-    if ( rx_size > 0 ) 
+    log_printf( &logger, "Event 0x%.2X/0x%.2X:", ( uint16_t ) evt->msg_class, ( uint16_t ) evt->msg_id );
+    for ( uint16_t cnt = 0; cnt < evt->len; cnt++ )
     {
-        int32_t buf_cnt = app_buf_len;
-        if ( ( ( app_buf_len + rx_size ) > PROCESS_BUFFER_SIZE ) && ( app_buf_len > 0 ) ) 
-        {
-            buf_cnt = PROCESS_BUFFER_SIZE - ( ( app_buf_len + rx_size ) - PROCESS_BUFFER_SIZE );
-            memmove ( app_buf, &app_buf[ PROCESS_BUFFER_SIZE - buf_cnt ], buf_cnt );
-        }
-        for ( int32_t rx_cnt = 0; rx_cnt < rx_size; rx_cnt++ ) 
-        {
-            if ( rx_buf[ rx_cnt ] ) 
-            {
-                app_buf[ buf_cnt++ ] = rx_buf[ rx_cnt ];
-                if ( app_buf_len < PROCESS_BUFFER_SIZE )
-                {
-                    app_buf_len++;
-                }
-            }
-        }
-        return BLE9_OK;
+        log_printf( &logger, " %.2X", ( uint16_t ) evt->payload[ cnt ] );
     }
-    return BLE9_ERROR;
+    log_printf( &logger, "\r\n" );
 }
 
 // ------------------------------------------------------------------------ END
@@ -90,7 +90,7 @@ extern "C"{
 #define BLE9_CMD_SYSTEM_HELLO_ID                                0x00010020ul
 #define BLE9_CMD_SYSTEM_DATA_BUFFER_CLEAR_ID                    0x14010020ul
 #define BLE9_CMD_SYSTEM_RESET_ID                                0x01010020ul
-#define BLE9_CMD_SYSTEM_HALT_ID                                 0x2001010Cul
+#define BLE9_CMD_SYSTEM_HALT_ID                                 0x0C010020ul
 #define BLE9_CMD_SYSTEM_SET_TX_POWER_ID                         0x17010020ul
 #define BLE9_CMD_SYSTEM_GET_VERSION_ID                          0x1B010020ul
 #define BLE9_CMD_SYSTEM_SET_SOFT_TIMER_ID                       0x19010020ul
@@ -106,7 +106,7 @@ extern "C"{
 /*!< @brief Advertiser commands. */
 #define BLE9_CMD_ADVERTISER_CREATE_ID                           0x01040020ul
 #define BLE9_CMD_ADVERTISER_DELETE_SET_ID                       0x02040020ul
-#define BLE9_CMD_ADVERTISER_START_ID                            0x09040320ul
+#define BLE9_CMD_ADVERTISER_START_ID                            0x09040020ul
 #define BLE9_CMD_ADVERTISER_STOP_ID                             0x0A040020ul
 #define BLE9_CMD_ADVERTISER_SET_TIMING_ID                       0x03040020ul
 #define BLE9_CMD_ADVERTISER_SET_PHY_ID                          0x06040020ul
@@ -129,8 +129,31 @@ extern "C"{
  * \defgroup driver Driver define
  * \{
  */
-#define DRV_RX_BUFFER_SIZE                                      100
-#define DRV_TX_BUFFER_SIZE                                      100
+#define DRV_RX_BUFFER_SIZE                                      256
+#define DRV_TX_BUFFER_SIZE                                      256
+/** \} */
+
+/**
+ * \defgroup bgapi BGAPI frame
+ * \{
+ */
+#define BLE9_BGAPI_HEADER_SIZE                                  4
+#define BLE9_BGAPI_MAX_PAYLOAD                                  256
+#define BLE9_BGAPI_TYPE_MASK                                    0xF8
+#define BLE9_BGAPI_TECH_MASK                                    0x78
+#define BLE9_BGAPI_TECH_BLUETOOTH                               0x20
+#define BLE9_BGAPI_LEN_HIGH_MASK                                0x07
+#define BLE9_BGAPI_TYPE_RESPONSE                                0x20
+#define BLE9_BGAPI_TYPE_EVENT                                   0xA0
+#define BLE9_BGAPI_RSP_TIMEOUT_MS                               100
+/** \} */
+
+/**
+ * \defgroup bgapi_process BGAPI process result
+ * \{
+ */
+#define BLE9_BGAPI_NONE                                         0
+#define BLE9_BGAPI_RESPONSE                                     1
 /** \} */
 
 /** \} */ // End group macro
@@ -272,9 +295,34 @@ typedef struct
 } ble9_timer_t;
 
 /**
- * @brief Click ctx object definition.
+ * @brief BGAPI frame definition.
  */
 typedef struct
+{
+    /*!< @brief BLE9_BGAPI_TYPE_RESPONSE or BLE9_BGAPI_TYPE_EVENT. */
+    uint8_t  msg_type;
+    /*!< @brief Message class. */
+    uint8_t  msg_class;
+    /*!< @brief Message ID within the class. */
+    uint8_t  msg_id;
+    /*!< @brief Payload length. */
+    uint16_t len;
+    /*!< @brief Payload, multi-byte fields are little endian. */
+    uint8_t  payload[ BLE9_BGAPI_MAX_PAYLOAD ];
+    
+} ble9_bgapi_frame_t;
+
+struct ble9_s;
+
+/**
+ * @brief Event handler definition, called for every event received.
+ */
+typedef void ( *ble9_event_handler_t )( struct ble9_s*, ble9_bgapi_frame_t* );
+
+/**
+ * @brief Click ctx object definition.
+ */
+typedef struct ble9_s
 {
     uint8_t ble9_adv_handle;
     ble9_version_t ble9_version;
@@ -283,6 +331,15 @@ typedef struct
 
     uint8_t uart_rx_buffer[ DRV_RX_BUFFER_SIZE ];
     uint8_t uart_tx_buffer[ DRV_TX_BUFFER_SIZE ];
+
+    // BGAPI decoder
+    ble9_bgapi_frame_t bgapi_frame;                     // Frame being received, holds the last response.
+    uint8_t  bgapi_header[ BLE9_BGAPI_HEADER_SIZE ];    // Header bytes received.
+    uint8_t  bgapi_state;                               // Decoder state.
+    uint16_t bgapi_cnt;                                 // Bytes received in the current state.
+    uint16_t bgapi_dropped;                             // Frames dropped for exceeding BLE9_BGAPI_MAX_PAYLOAD.
+    uint16_t bgapi_resync;                              // Bytes discarded while searching for a header.
+    ble9_event_handler_t event_handler;                 // Event handler, NULL to drop events.
     
 } ble9_t;
 
@@ -392,7 +449,7 @@ void ble9_sys_set_id_addr ( ble9_t *ctx, uint8_t *address, uint8_t type );
  * which can be a public or random static device address.
  *
  * @param ctx Click object.
- * @param data_buf Array address for storing return values.
+ * @param data_buf Identity address (6 bytes, little endian) followed by the address type.
  * @param type Address type.
  *             @b 1 Static device address
  *             @b 0 Public device address
@@ -843,6 +900,66 @@ int32_t ble9_generic_read ( ble9_t *ctx, uint8_t *data_buf, uint16_t max_len );
  */
 void ble9_send_command ( ble9_t *ctx, uint32_t command );
 
+/**
+ * @brief Event handler setting function.
+ *
+ * @param ctx Click object.
+ * @param handler Event handler, NULL to drop events.
+ *
+ * @description This function sets the handler called by the decoder for every event.
+ * @note The handler must not issue commands, the frame is only valid until it returns.
+ */
+void ble9_set_event_handler ( ble9_t *ctx, ble9_event_handler_t handler );
+
+/**
+ * @brief BGAPI process function.
+ *
+ * @param ctx Click object.
+ *
+ * @return @b BLE9_BGAPI_RESPONSE if a response is in @b ctx->bgapi_frame,
+ *         @b BLE9_BGAPI_NONE if the UART ring is empty.
+ *
+ * @description This function feeds the bytes waiting in the UART ring to the BGAPI decoder.
+ * Header and payload are read straight into the frame, no more bytes than the frame needs,
+ * and bytes that cannot start a header are skipped until the stream is aligned again.
+ * Events are passed to the event handler as they complete. The function returns on the
+ * first response, so it stays in @b ctx->bgapi_frame until the next call.
+ * @note Call it often enough to keep the UART ring from overflowing while events stream in.
+ */
+uint8_t ble9_bgapi_process ( ble9_t *ctx );
+
+/**
+ * @brief BGAPI wait response function.
+ *
+ * @param ctx Click object.
+ * @param msg_class Message class of the command.
+ * @param msg_id Message ID of the command.
+ * @param timeout_ms Response timeout in milliseconds.
+ *
+ * @return err_t
+ *
+ * @description This function runs the decoder until the response of the command arrives,
+ * dispatching events meanwhile. Responses to other commands are discarded.
+ * On success the response is in @b ctx->bgapi_frame.
+ */
+err_t ble9_bgapi_wait_response ( ble9_t *ctx, uint8_t msg_class, uint8_t msg_id, uint16_t timeout_ms );
+
+/**
+ * @brief BGAPI command function.
+ *
+ * @param ctx Click object.
+ * @param command Command constant, see commands group.
+ * @param payload Command parameters.
+ * @param len Length of the command parameters.
+ *
+ * @return err_t
+ *
+ * @description This function sends a command with the header length set from @b len and
+ * waits up to BLE9_BGAPI_RSP_TIMEOUT_MS for its response. It succeeds when the result
+ * code of the response is 0. Return values follow in @b ctx->bgapi_frame.payload from index 2.
+ */
+err_t ble9_bgapi_command ( ble9_t *ctx, uint32_t command, uint8_t *payload, uint16_t len );
+
 #ifdef __cplusplus
 }
 #endif
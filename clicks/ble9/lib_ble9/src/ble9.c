@@ -30,23 +30,39 @@
 // ------------------------------------------------ PRIVATE FUNCTION DECLARATIONS
 
 /**
- * @brief Generic BLE9 Click error check function.
- * Reads @b read_n_elements number of elements, places them in
- * @b ret_val_check array if any value is needed( handle for example ),
- * and checks @b check_var_num element for return value.
+ * @brief BGAPI decoder states.
+ */
+#define BLE9_BGAPI_STATE_HEADER                                 0
+#define BLE9_BGAPI_STATE_PAYLOAD                                1
+#define BLE9_BGAPI_STATE_SKIP                                   2
+
+/**
+ * @brief BGAPI header send function.
+ * Writes the command header with the length field set from @b len.
+ *
+ * @param ctx BLE9 Click object.
+ * @param command Command constant.
+ * @param len Length of the command parameters that follow.
+ */
+static void ble9_bgapi_send_header ( ble9_t *ctx, uint32_t command, uint16_t len );
+
+/**
+ * @brief BGAPI response check function.
+ * Waits for the response of @b command and checks its result code.
  *
  * @param ctx BLE9 Click object.
- * @param read_n_elements Number of elements to read.
- * @param check_char_num Ordinal number of element to check.
- * @param ret_val_check Array address.
- * @return true
- * @return false
+ * @param command Command constant.
+ * @return err_t
+ */
+static err_t ble9_bgapi_check_response ( ble9_t *ctx, uint32_t command );
+
+/**
+ * @brief BGAPI header alignment function.
+ * Drops received header bytes until the first one can start a BGAPI frame.
  *
- * @warning Take into consideration that different functionalities
- * have different return values and different number of bytes.
+ * @param ctx BLE9 Click object.
  */
-static uint8_t ble9_generic_err_check ( ble9_t *ctx, uint8_t read_n_elements,
-                                        uint8_t check_char_num, uint8_t *ret_val_check );
+static void ble9_bgapi_align_header ( ble9_t *ctx );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -88,38 +104,39 @@ err_t ble9_init ( ble9_t *ctx, ble9_cfg_t *cfg )
 
     uart_set_blocking( &ctx->uart, cfg->uart_blocking );
 
+    ctx->bgapi_state = BLE9_BGAPI_STATE_HEADER;
+    ctx->bgapi_cnt = 0;
+    ctx->bgapi_dropped = 0;
+    ctx->bgapi_resync = 0;
+    ctx->event_handler = NULL;
+
     return BLE9_OK;
 }
 
 err_t ble9_sys_hello ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_HELLO_ID );
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_HELLO_ID, NULL, 0 );
 }
 
 err_t ble9_sys_get_version ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 22 ] = { 0 };
+    uint8_t *rsp = ctx->bgapi_frame.payload;
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_GET_VERSION_ID );
-    Delay_10ms ( );
-    if ( 22 == uart_read ( &ctx->uart, tmp_array, 22 ) ) 
-    {
-        ctx->ble9_version.version_major = ( ( uint16_t ) tmp_array[ 5 ] << 8 ) | tmp_array[ 6 ];
-        ctx->ble9_version.version_minor = ( ( uint16_t ) tmp_array[ 7 ] << 8 ) | tmp_array[ 8 ];
-        ctx->ble9_version.version_patch = ( ( uint16_t ) tmp_array[ 9 ] << 8 ) | tmp_array[ 10 ];
-        ctx->ble9_version.version_build = ( ( uint16_t ) tmp_array[ 11 ] << 8 ) | tmp_array[ 12 ];
-        ctx->ble9_version.version_bootloader = ( ( uint32_t ) tmp_array[ 14 ] << 24 ) | ( ( uint32_t ) tmp_array[ 15 ] << 16 ) | 
-                                               ( ( uint16_t ) tmp_array[ 16 ] << 8 ) | tmp_array[ 17 ];
-        ctx->ble9_version.version_hash = ( ( uint32_t ) tmp_array[ 18 ] << 24 ) | ( ( uint32_t ) tmp_array[ 19 ] << 16 ) | 
-                                         ( ( uint16_t ) tmp_array[ 20 ] << 8 ) | tmp_array[ 21 ];;
-        return BLE9_OK;
-    } 
-    else 
+    if ( ( BLE9_OK != ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_GET_VERSION_ID, NULL, 0 ) ) || 
+         ( ctx->bgapi_frame.len < 18 ) ) 
     {
         return BLE9_ERROR;
     }
+
+    ctx->ble9_version.version_major = ( ( uint16_t ) rsp[ 3 ] << 8 ) | rsp[ 2 ];
+    ctx->ble9_version.version_minor = ( ( uint16_t ) rsp[ 5 ] << 8 ) | rsp[ 4 ];
+    ctx->ble9_version.version_patch = ( ( uint16_t ) rsp[ 7 ] << 8 ) | rsp[ 6 ];
+    ctx->ble9_version.version_build = ( ( uint16_t ) rsp[ 9 ] << 8 ) | rsp[ 8 ];
+    ctx->ble9_version.version_bootloader = ( ( uint32_t ) rsp[ 13 ] << 24 ) | ( ( uint32_t ) rsp[ 12 ] << 16 ) | 
+                                           ( ( uint16_t ) rsp[ 11 ] << 8 ) | rsp[ 10 ];
+    ctx->ble9_version.version_hash = ( ( uint32_t ) rsp[ 17 ] << 24 ) | ( ( uint32_t ) rsp[ 16 ] << 16 ) | 
+                                     ( ( uint16_t ) rsp[ 15 ] << 8 ) | rsp[ 14 ];
+    return BLE9_OK;
 }
 
 void ble9_sys_set_id_addr ( ble9_t *ctx, uint8_t *address, uint8_t type ) 
@@ -132,45 +149,36 @@ void ble9_sys_set_id_addr ( ble9_t *ctx, uint8_t *address, uint8_t type )
     }
     ble9_settings[ counter ] = type;
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_SET_IDENTITY_ADDRESS_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
+    ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_SET_IDENTITY_ADDRESS_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_sys_get_id_address ( ble9_t *ctx, uint8_t *data_buf, uint8_t type ) 
 {
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_GET_IDENTITY_ADDRESS_ID );
-    ble9_generic_write ( ctx, &type, 1 );
-    Delay_1ms ( );
-    if ( 13 == uart_read ( &ctx->uart, data_buf, 13 ) ) 
-    {
-        return BLE9_OK;
-    } 
-    else 
+    if ( ( BLE9_OK != ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_GET_IDENTITY_ADDRESS_ID, &type, 1 ) ) || 
+         ( ctx->bgapi_frame.len < 9 ) ) 
     {
         return BLE9_ERROR;
     }
+    memcpy ( data_buf, &ctx->bgapi_frame.payload[ 2 ], 7 );
+    return BLE9_OK;
 }
 
 void ble9_sys_reset ( ble9_t *ctx, ble9_dfu_reset_mode_t reset_mode ) 
 {
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_RESET_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ( uint8_t * ) &reset_mode, 1 );
+    uint8_t mode = ( uint8_t ) reset_mode;
+
+    // No response, the boot event is passed to the event handler.
+    ble9_bgapi_send_header ( ctx, BLE9_CMD_SYSTEM_RESET_ID, 1 );
+    ble9_generic_write ( ctx, &mode, 1 );
 }
 
 err_t ble9_sys_halt ( ble9_t *ctx, uint8_t halt ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
     if ( halt > BLE9_SYSTEM_HALT )
     {
         return BLE9_ERROR;
     }
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_HALT_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, &halt, 1 );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_HALT_ID, &halt, 1 );
 }
 
 void ble9_sys_set_tx_power ( ble9_t *ctx, int16_t min_power, int16_t max_power ) 
@@ -181,141 +189,97 @@ void ble9_sys_set_tx_power ( ble9_t *ctx, int16_t min_power, int16_t max_power )
     data_buf[ 1 ] = ( uint8_t ) ( ( min_power >> 8 ) & 0xFF );
     data_buf[ 2 ] = ( uint8_t ) ( max_power & 0xFF );
     data_buf[ 3 ] = ( uint8_t ) ( ( max_power >> 8 ) & 0xFF );
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_SET_TX_POWER_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, data_buf, 4 );
+    ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_SET_TX_POWER_ID, data_buf, 4 );
 }
 
 err_t ble9_sys_data_buf_write ( ble9_t *ctx, uint16_t data_len, uint8_t *wr_data ) 
 {
-    uint8_t tmp_dat = ( uint8_t ) ( ( ( 1 + data_len ) & 0xFF ) << 8 ) + ( ( ( 1 + data_len ) & 0x700 ) >> 8 );
-    uint8_t ble9_settings[ 5 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
+    uint8_t array_len = 0;
 
-    ble9_settings[ 0 ] = tmp_dat;
-    for ( uint8_t counter = 1; counter <= tmp_dat; counter++ ) 
+    if ( data_len > 0xFF )
     {
-        ble9_settings[ counter ] = ( uint8_t ) ( ( data_len & ( 0xFF << ( ( counter - 1 ) * 8 ) ) ) >> 
-                                                 ( ( counter - 1 ) * 8 ) );
+        return BLE9_ERROR;
     }
+    array_len = ( uint8_t ) data_len;
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_DATA_BUFFER_WRITE_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, tmp_dat + 1 );
-
-    ble9_generic_write( ctx, wr_data, data_len );
+    ble9_bgapi_send_header ( ctx, BLE9_CMD_SYSTEM_DATA_BUFFER_WRITE_ID, 1 + data_len );
+    ble9_generic_write ( ctx, &array_len, 1 );
+    ble9_generic_write ( ctx, wr_data, data_len );
 
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_check_response ( ctx, BLE9_CMD_SYSTEM_DATA_BUFFER_WRITE_ID );
 }
 
 err_t ble9_sys_data_buf_clear ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_DATA_BUFFER_CLEAR_ID );
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_DATA_BUFFER_CLEAR_ID, NULL, 0 );
 }
 
 err_t ble9_sys_set_soft_timer ( ble9_t  *ctx, ble9_timer_t *ble9_timer ) 
 {
     uint8_t ble9_settings[ 6 ] = { 0 };
     uint8_t counter = 0;
-    uint8_t tmp_array[ 6 ] = { 0 };
 
-    for ( counter = 0; counter < 3; counter++ ) 
+    for ( counter = 0; counter < 4; counter++ ) 
     {
-        ble9_settings[ counter ] = ( uint8_t ) ( ( ble9_timer->ble9_timer_time & ( 0xFF << ( counter * 8 ) ) ) >> 
-                                                 ( counter * 8 ) );
+        ble9_settings[ counter ] = ( uint8_t ) ( ble9_timer->ble9_timer_time >> ( counter * 8 ) );
     }
-    // Timer can have a maximum value of 2147483647, which corresponds to about 18.2 hours.
-    ble9_settings[ counter++ ] = BLE9_CMD_NULL;  
     ble9_settings[ counter++ ] = ble9_timer->ble9_timer_handle;
     ble9_settings[ counter ]   = ble9_timer->ble9_timer_single_shot;
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_SET_SOFT_TIMER_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_SET_SOFT_TIMER_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_sys_set_lazy_soft_timer ( ble9_t *ctx, ble9_timer_t *ble9_timer ) 
 {
     uint8_t ble9_settings[ 10 ] = { 0 };
     uint8_t counter = 0;
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     for ( counter = 0; counter < 4; counter++ ) 
     {
-        ble9_settings[ counter ] = ( uint8_t ) ( ( ble9_timer->ble9_timer_time & ( 0xFF << ( counter * 8 ) ) ) >> 
-                                                 ( counter * 8 ) );
-        ble9_settings[ counter + 4 ] = ( uint8_t ) ( ( ble9_timer->ble9_timer_slack & ( 0xFF << ( counter * 8 ) ) ) >> 
-                                                     ( counter * 8 ) );
+        ble9_settings[ counter ] = ( uint8_t ) ( ble9_timer->ble9_timer_time >> ( counter * 8 ) );
+        ble9_settings[ counter + 4 ] = ( uint8_t ) ( ble9_timer->ble9_timer_slack >> ( counter * 8 ) );
     }
-    // Timer can have a maximum value of 2147483647, which corresponds to about 18.2 hours.
-    ble9_settings[ 3 ] = BLE9_CMD_NULL; 
     ble9_settings[ 8 ] = ble9_timer->ble9_timer_handle;
     ble9_settings[ 9 ] = ble9_timer->ble9_timer_single_shot;
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_SET_LAZY_SOFT_TIMER_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_SET_LAZY_SOFT_TIMER_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_gap_set_privacy_mode ( ble9_t *ctx, uint8_t privacy, uint8_t interval_in_minutes ) 
 {
     uint8_t ble9_settings[ 2 ] = { privacy, interval_in_minutes };
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_GAP_SET_PRIVACY_MODE_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
 
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_GAP_SET_PRIVACY_MODE_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_gap_en_wlist ( ble9_t *ctx, uint8_t enable ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_GAP_ENABLE_WHITELISTING_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ( uint8_t * ) &enable, 1 );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_GAP_ENABLE_WHITELISTING_ID, &enable, 1 );
 }
 
 err_t ble9_adv_create_id ( ble9_t *ctx ) 
 {
-    uint8_t status = BLE9_OK;
-    uint8_t tmp_array[ 7 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_CREATE_ID );
-    status = ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 6, tmp_array );
+    if ( ( BLE9_OK != ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_CREATE_ID, NULL, 0 ) ) || 
+         ( ctx->bgapi_frame.len < 3 ) ) 
+    {
+        return BLE9_ERROR;
+    }
 
     /* Map new handle. */
-    ctx->ble9_adv_handle = tmp_array[ 5 ];
+    ctx->ble9_adv_handle = ctx->bgapi_frame.payload[ 2 ];
 
-    return status;
+    return BLE9_OK;
 }
 
 err_t ble9_adv_delete_id ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_DELETE_SET_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, &ctx->ble9_adv_handle, 1 );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_DELETE_SET_ID, &ctx->ble9_adv_handle, 1 );
 }
 
 err_t ble9_adv_set_timing ( ble9_t *ctx, uint16_t interval_min, uint16_t interval_max, 
                             uint16_t duration, uint8_t maxevents ) 
 {
     uint8_t ble9_settings[ 12 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ]  = ctx->ble9_adv_handle;
     ble9_settings[ 1 ]  = interval_min & 0xFF;
@@ -326,209 +290,144 @@ err_t ble9_adv_set_timing ( ble9_t *ctx, uint16_t interval_min, uint16_t interva
     ble9_settings[ 10 ] = ( duration & 0xFF00 ) >> 8;
     ble9_settings[ 11 ] = maxevents;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_TIMING_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_TIMING_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_adv_set_phy ( ble9_t *ctx, ble9_phy_type_t primary_phy, ble9_phy_type_t secondary_phy ) 
 {
     uint8_t ble9_settings[ 3 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = primary_phy;
     ble9_settings[ 2 ] = secondary_phy;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_PHY_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_PHY_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_adv_set_channel_map ( ble9_t *ctx, ble9_channel_t channel_map ) 
 {
     uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = channel_map;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_CHANNEL_MAP_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_CHANNEL_MAP_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_adv_set_tx_power ( ble9_t *ctx, int16_t power, int16_t *set_power ) 
 {
     uint8_t ble9_settings[ 3 ] = { 0 };
-    uint8_t status = BLE9_OK;
-    uint8_t tmp_array[ 8 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = power & 0xFF;
     ble9_settings[ 2 ] = ( power & 0xFF00 ) >> 8;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_TX_POWER_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    status = ble9_generic_err_check( ctx, sizeof ( tmp_array ), 5, tmp_array );
-    *set_power = tmp_array[ 6 ];
+    if ( ( BLE9_OK != ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_TX_POWER_ID, ble9_settings, sizeof ( ble9_settings ) ) ) || 
+         ( ctx->bgapi_frame.len < 4 ) ) 
+    {
+        return BLE9_ERROR;
+    }
+    *set_power = ( int16_t ) ( ( ( uint16_t ) ctx->bgapi_frame.payload[ 3 ] << 8 ) | ctx->bgapi_frame.payload[ 2 ] );
 
-    return status;
+    return BLE9_OK;
 }
 
 err_t ble9_adv_set_report_scan_req ( ble9_t *ctx, uint8_t report_scan_req ) 
 {
     uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = report_scan_req;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_REPORT_SCAN_REQUEST_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_REPORT_SCAN_REQUEST_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_adv_set_configuration ( ble9_t *ctx, uint8_t configurations ) 
 {
-    uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
+    uint8_t ble9_settings[ 5 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = configurations;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_CONFIGURATION_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_CONFIGURATION_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_adv_clear_configuration ( ble9_t *ctx, uint8_t configurations ) 
 {
-    uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
+    uint8_t ble9_settings[ 5 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = configurations;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_CLEAR_CONFIGURATION_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_CLEAR_CONFIGURATION_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_adv_set_data ( ble9_t *ctx, ble9_package_type_t packet_type, 
                           uint16_t adv_data_len, uint8_t *adv_data ) 
 {
-    uint8_t ble9_settings[ 7 ] = { 0 };
-    uint8_t dat_num = 0;
-    uint8_t tmp_array[ 6 ] = { 0 };
+    uint8_t ble9_settings[ 3 ] = { 0 };
 
-    ble9_settings[ 0 ] = ctx->ble9_adv_handle;
-    ble9_settings[ 1 ] = packet_type;
-    for ( uint8_t counter = 5; counter > 1; counter-- ) 
+    if ( adv_data_len > 0xFF )
     {
-        if ( adv_data_len & ( 0xFF << ( counter - 1) ) ) 
-        {
-            ble9_settings[ counter + 1 ] = ( packet_type & ( 0xFF << ( counter - 1 ) ) ) >> ( counter - 1 );
-            dat_num++;
-        }
+        return BLE9_ERROR;
     }
-    ble9_settings[ 2 ] = dat_num;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_DATA_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, 3 + dat_num );
-    Delay_1ms ( );
+    ble9_settings[ 0 ] = ctx->ble9_adv_handle;
+    ble9_settings[ 1 ] = packet_type;
+    ble9_settings[ 2 ] = ( uint8_t ) adv_data_len;
 
+    ble9_bgapi_send_header ( ctx, BLE9_CMD_ADVERTISER_SET_DATA_ID, sizeof ( ble9_settings ) + adv_data_len );
+    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
     ble9_generic_write ( ctx, adv_data, adv_data_len );
 
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_check_response ( ctx, BLE9_CMD_ADVERTISER_SET_DATA_ID );
 }
 
 err_t ble9_adv_set_long_data ( ble9_t *ctx, ble9_package_type_t packet_type ) 
 {
     uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = packet_type;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_LONG_DATA_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_LONG_DATA_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_adv_start ( ble9_t *ctx, ble9_adv_mode_discoverable_t discover, 
                        ble9_adv_mode_connectable_t connect ) 
 {
     uint8_t ble9_settings[ 3 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = discover;
     ble9_settings[ 2 ] = connect;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_START_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_START_ID, ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_adv_stop ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_STOP_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, &ctx->ble9_adv_handle, 1 );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_STOP_ID, &ctx->ble9_adv_handle, 1 );
 }
 
 err_t ble9_adv_start_per_adv ( ble9_t *ctx, uint16_t interval_min, uint16_t interval_max, uint8_t flags ) 
 {
-    uint8_t ble9_settings[ 6 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
+    uint8_t ble9_settings[ 9 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
-    ble9_settings[ 1 ] = ( interval_min & 0xFF00 ) >> 8;
-    ble9_settings[ 2 ] = ( interval_min & 0x00FF );
-    ble9_settings[ 3 ] = ( interval_max & 0xFF00 ) >> 8;
-    ble9_settings[ 4 ] = ( interval_max & 0x00FF );
+    ble9_settings[ 1 ] = ( interval_min & 0x00FF );
+    ble9_settings[ 2 ] = ( interval_min & 0xFF00 ) >> 8;
+    ble9_settings[ 3 ] = ( interval_max & 0x00FF );
+    ble9_settings[ 4 ] = ( interval_max & 0xFF00 ) >> 8;
     ble9_settings[ 5 ] = flags;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_START_PERIODIC_ADVERTISING_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_START_PERIODIC_ADVERTISING_ID, 
+                               ble9_settings, sizeof ( ble9_settings ) );
 }
 
 err_t ble9_adv_stop_per_adv ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_STOP_PERIODIC_ADVERTISING_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, &ctx->ble9_adv_handle, 1 );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_STOP_PERIODIC_ADVERTISING_ID, &ctx->ble9_adv_handle, 1 );
 }
 
 // -----------------------------------------------------------------------------
@@ -555,25 +454,166 @@ void ble9_send_command ( ble9_t *ctx, uint32_t command )
     ble9_generic_write( ctx, data_buf, 4 );
 }
 
+void ble9_set_event_handler ( ble9_t *ctx, ble9_event_handler_t handler ) 
+{
+    ctx->event_handler = handler;
+}
+
+uint8_t ble9_bgapi_process ( ble9_t *ctx ) 
+{
+    ble9_bgapi_frame_t *frame = &ctx->bgapi_frame;
+    uint8_t skip_buf[ 16 ] = { 0 };
+    uint16_t rx_len = 0;
+    int32_t rx_size = 0;
+
+    for ( ; ; ) 
+    {
+        if ( BLE9_BGAPI_STATE_HEADER == ctx->bgapi_state ) 
+        {
+            rx_size = uart_read ( &ctx->uart, &ctx->bgapi_header[ ctx->bgapi_cnt ], 
+                                  BLE9_BGAPI_HEADER_SIZE - ctx->bgapi_cnt );
+            if ( rx_size <= 0 ) 
+            {
+                return BLE9_BGAPI_NONE;
+            }
+            ctx->bgapi_cnt += rx_size;
+            ble9_bgapi_align_header ( ctx );
+            if ( ctx->bgapi_cnt < BLE9_BGAPI_HEADER_SIZE ) 
+            {
+                continue;
+            }
+
+            frame->msg_type = ctx->bgapi_header[ 0 ] & BLE9_BGAPI_TYPE_MASK;
+            frame->len = ( ( uint16_t ) ( ctx->bgapi_header[ 0 ] & BLE9_BGAPI_LEN_HIGH_MASK ) << 8 ) | 
+                         ctx->bgapi_header[ 1 ];
+            frame->msg_class = ctx->bgapi_header[ 2 ];
+            frame->msg_id = ctx->bgapi_header[ 3 ];
+            ctx->bgapi_cnt = 0;
+            ctx->bgapi_state = ( frame->len > BLE9_BGAPI_MAX_PAYLOAD ) ? BLE9_BGAPI_STATE_SKIP : 
+                                                                         BLE9_BGAPI_STATE_PAYLOAD;
+        }
+        else if ( BLE9_BGAPI_STATE_PAYLOAD == ctx->bgapi_state ) 
+        {
+            if ( ctx->bgapi_cnt < frame->len ) 
+            {
+                rx_size = uart_read ( &ctx->uart, &frame->payload[ ctx->bgapi_cnt ], frame->len - ctx->bgapi_cnt );
+                if ( rx_size <= 0 ) 
+                {
+                    return BLE9_BGAPI_NONE;
+                }
+                ctx->bgapi_cnt += rx_size;
+            }
+            if ( ctx->bgapi_cnt >= frame->len ) 
+            {
+                ctx->bgapi_state = BLE9_BGAPI_STATE_HEADER;
+                ctx->bgapi_cnt = 0;
+                if ( BLE9_BGAPI_TYPE_RESPONSE == frame->msg_type ) 
+                {
+                    return BLE9_BGAPI_RESPONSE;
+                }
+                if ( NULL != ctx->event_handler ) 
+                {
+                    ctx->event_handler ( ctx, frame );
+                }
+            }
+        }
+        else 
+        {
+            rx_len = frame->len - ctx->bgapi_cnt;
+            if ( rx_len > sizeof ( skip_buf ) ) 
+            {
+                rx_len = sizeof ( skip_buf );
+            }
+            rx_size = uart_read ( &ctx->uart, skip_buf, rx_len );
+            if ( rx_size <= 0 ) 
+            {
+                return BLE9_BGAPI_NONE;
+            }
+            ctx->bgapi_cnt += rx_size;
+            if ( ctx->bgapi_cnt >= frame->len ) 
+            {
+                ctx->bgapi_state = BLE9_BGAPI_STATE_HEADER;
+                ctx->bgapi_cnt = 0;
+                ctx->bgapi_dropped++;
+            }
+        }
+    }
+}
+
+err_t ble9_bgapi_wait_response ( ble9_t *ctx, uint8_t msg_class, uint8_t msg_id, uint16_t timeout_ms ) 
+{
+    for ( ; ; ) 
+    {
+        while ( BLE9_BGAPI_RESPONSE == ble9_bgapi_process ( ctx ) ) 
+        {
+            if ( ( msg_class == ctx->bgapi_frame.msg_class ) && ( msg_id == ctx->bgapi_frame.msg_id ) ) 
+            {
+                return BLE9_OK;
+            }
+        }
+        if ( 0 == timeout_ms-- ) 
+        {
+            return BLE9_ERROR;
+        }
+        Delay_1ms ( );
+    }
+}
+
+err_t ble9_bgapi_command ( ble9_t *ctx, uint32_t command, uint8_t *payload, uint16_t len ) 
+{
+    ble9_bgapi_send_header ( ctx, command, len );
+    if ( len > 0 ) 
+    {
+        ble9_generic_write ( ctx, payload, len );
+    }
+    return ble9_bgapi_check_response ( ctx, command );
+}
+
 // -----------------------------------------------------------------------------
 // STATIC FUNCTIONS
 // -----------------------------------------------------------------------------
 
-static uint8_t ble9_generic_err_check ( ble9_t *ctx, uint8_t read_n_elements,
-                                        uint8_t check_char_num, uint8_t *ret_val_check ) 
+static void ble9_bgapi_send_header ( ble9_t *ctx, uint32_t command, uint16_t len ) 
 {
-    uint8_t temp_array[ 22 ] = { 0 };
-    uart_read ( &ctx->uart, temp_array, read_n_elements );
+    uint8_t data_buf[ BLE9_BGAPI_HEADER_SIZE ] = { 0 };
+    data_buf[ 0 ] = ( uint8_t ) ( ( command & BLE9_BGAPI_TYPE_MASK ) | ( ( len >> 8 ) & BLE9_BGAPI_LEN_HIGH_MASK ) );
+    data_buf[ 1 ] = ( uint8_t ) ( len & 0xFF );
+    data_buf[ 2 ] = ( uint8_t ) ( ( command >> 16 ) & 0xFF );
+    data_buf[ 3 ] = ( uint8_t ) ( ( command >> 24 ) & 0xFF );
+    ble9_generic_write( ctx, data_buf, BLE9_BGAPI_HEADER_SIZE );
+}
 
-    if ( BLE9_OK == temp_array[ check_char_num ] ) 
+static err_t ble9_bgapi_check_response ( ble9_t *ctx, uint32_t command ) 
+{
+    if ( BLE9_OK != ble9_bgapi_wait_response ( ctx, ( uint8_t ) ( ( command >> 16 ) & 0xFF ), 
+                                               ( uint8_t ) ( ( command >> 24 ) & 0xFF ), 
+                                               BLE9_BGAPI_RSP_TIMEOUT_MS ) ) 
     {
-        memcpy ( ret_val_check, temp_array, read_n_elements );
-        return BLE9_OK;
-    } 
-    else 
+        return BLE9_ERROR;
+    }
+
+    // Result code is the first field of every response.
+    if ( ( ctx->bgapi_frame.len < 2 ) || ctx->bgapi_frame.payload[ 0 ] || ctx->bgapi_frame.payload[ 1 ] ) 
     {
         return BLE9_ERROR;
     }
+    return BLE9_OK;
+}
+
+static void ble9_bgapi_align_header ( ble9_t *ctx ) 
+{
+    uint8_t cnt = 0;
+
+    while ( ( ctx->bgapi_cnt > 0 ) && 
+            ( BLE9_BGAPI_TECH_BLUETOOTH != ( ctx->bgapi_header[ 0 ] & BLE9_BGAPI_TECH_MASK ) ) ) 
+    {
+        for ( cnt = 1; cnt < ctx->bgapi_cnt; cnt++ ) 
+        {
+            ctx->bgapi_header[ cnt - 1 ] = ctx->bgapi_header[ cnt ];
+        }
+        ctx->bgapi_cnt--;
+        ctx->bgapi_resync++;
+    }
 }
 
 // ------------------------------------------------------------------------- END
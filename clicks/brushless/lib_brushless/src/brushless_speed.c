@@ -0,0 +1,261 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ */
+
+#include "brushless_speed.h"
+
+// -------------------------------------------------------------- PRIVATE MACROS
+
+#define BRUSHLESS_SPEED_WINDOW_MASK             ( BRUSHLESS_SPEED_WINDOW - 1 )
+#define BRUSHLESS_SPEED_TERM_SPAN               ( 2 * BRUSHLESS_SPEED_DUTY_MAX * 256 )
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void speed_snapshot ( brushless_speed_t *speed, uint32_t *sum, uint8_t *count, uint32_t *last_edge, 
+                             uint8_t *started );
+
+static uint32_t speed_rpm ( uint32_t timer_hz, uint32_t rev_ticks );
+
+static int32_t speed_clamp_error ( int32_t error, uint16_t gain );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void brushless_speed_init ( brushless_speed_t *speed, brushless_t *ctx, uint32_t timer_hz, 
+                            uint8_t edges_per_rev, uint16_t stall_ms )
+{
+    speed->ctx = ctx;
+    speed->timer_hz = timer_hz;
+    speed->edges_per_rev = edges_per_rev ? edges_per_rev : 1;
+    speed->stall_ticks = ( timer_hz / 1000 ) * stall_ms + ( timer_hz % 1000 ) * stall_ms / 1000;
+
+    speed->index = 0;
+    speed->count = 0;
+    speed->sum = 0;
+    speed->last_edge = 0;
+    speed->started = 0;
+    speed->seq = 0;
+
+    speed->target_rpm = 0;
+    speed->kp = BRUSHLESS_SPEED_DEFAULT_KP;
+    speed->ki = BRUSHLESS_SPEED_DEFAULT_KI;
+    speed->integral = 0;
+    speed->duty = 0;
+}
+
+void brushless_speed_edge ( brushless_speed_t *speed, uint32_t timestamp )
+{
+    uint32_t period = timestamp - speed->last_edge;
+
+    // Glitch, both edges in the same timer tick
+    if ( speed->started && ( 0 == period ) )
+    {
+        return;
+    }
+
+    speed->seq++;
+
+    if ( !speed->started || ( period > speed->stall_ticks ) )
+    {
+        // First edge after a stop does not close a period
+        speed->started = 1;
+        speed->count = 0;
+        speed->sum = 0;
+        speed->index = 0;
+    }
+    else
+    {
+        if ( speed->count < BRUSHLESS_SPEED_WINDOW )
+        {
+            speed->count++;
+        }
+        else
+        {
+            speed->sum -= speed->period[ speed->index ];
+        }
+        speed->period[ speed->index ] = period;
+        speed->sum += period;
+        speed->index = ( speed->index + 1 ) & BRUSHLESS_SPEED_WINDOW_MASK;
+    }
+
+    speed->last_edge = timestamp;
+}
+
+uint32_t brushless_speed_get_rpm ( brushless_speed_t *speed, uint32_t now )
+{
+    uint32_t sum;
+    uint32_t last_edge;
+    uint32_t elapsed;
+    uint32_t rev_ticks;
+    uint8_t count;
+    uint8_t started;
+
+    speed_snapshot( speed, &sum, &count, &last_edge, &started );
+
+    elapsed = now - last_edge;
+    if ( !started || !count || ( elapsed > speed->stall_ticks ) )
+    {
+        return 0;
+    }
+
+    // Late edge, the period is at least the time since the last one
+    if ( elapsed > ( sum / count ) )
+    {
+        sum = elapsed;
+        count = 1;
+    }
+
+    // Ticks per revolution, the remainder keeps the fraction of the mean period
+    rev_ticks = ( sum / count ) * speed->edges_per_rev + ( sum % count ) * speed->edges_per_rev / count;
+
+    return speed_rpm( speed->timer_hz, rev_ticks );
+}
+
+uint8_t brushless_speed_is_stalled ( brushless_speed_t *speed, uint32_t now )
+{
+    uint32_t sum;
+    uint32_t last_edge;
+    uint8_t count;
+    uint8_t started;
+
+    speed_snapshot( speed, &sum, &count, &last_edge, &started );
+
+    return !started || ( ( now - last_edge ) > speed->stall_ticks );
+}
+
+void brushless_speed_set_gains ( brushless_speed_t *speed, uint16_t kp, uint16_t ki )
+{
+    speed->kp = kp;
+    speed->ki = ki;
+}
+
+void brushless_speed_set_target ( brushless_speed_t *speed, uint32_t rpm )
+{
+    speed->target_rpm = rpm;
+}
+
+void brushless_speed_update ( brushless_speed_t *speed, uint32_t now )
+{
+    int32_t error;
+    int32_t output;
+    int32_t integral;
+    uint16_t duty = 0;
+
+    if ( 0 == speed->target_rpm )
+    {
+        speed->integral = 0;
+    }
+    else
+    {
+        error = ( int32_t ) speed->target_rpm - ( int32_t ) brushless_speed_get_rpm( speed, now );
+        output = ( ( int32_t ) speed->kp * speed_clamp_error( error, speed->kp ) + speed->integral ) / 256;
+
+        // No integration while the output is saturated in the direction of the error
+        if ( !( ( output >= BRUSHLESS_SPEED_DUTY_MAX ) && ( error > 0 ) ) && !( ( output <= 0 ) && ( error < 0 ) ) )
+        {
+            integral = speed->integral + ( int32_t ) speed->ki * speed_clamp_error( error, speed->ki );
+            if ( integral < 0 )
+            {
+                integral = 0;
+            }
+            else if ( integral > ( BRUSHLESS_SPEED_DUTY_MAX * 256 ) )
+            {
+                integral = BRUSHLESS_SPEED_DUTY_MAX * 256;
+            }
+            speed->integral = integral;
+        }
+
+        output = ( ( int32_t ) speed->kp * speed_clamp_error( error, speed->kp ) + speed->integral ) / 256;
+        if ( output > BRUSHLESS_SPEED_DUTY_MAX )
+        {
+            output = BRUSHLESS_SPEED_DUTY_MAX;
+        }
+        else if ( output < 0 )
+        {
+            output = 0;
+        }
+        duty = ( uint16_t ) output;
+    }
+
+    if ( duty != speed->duty )
+    {
+        speed->duty = duty;
+        brushless_set_duty_cycle( speed->ctx, ( float ) duty / BRUSHLESS_SPEED_DUTY_MAX );
+    }
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void speed_snapshot ( brushless_speed_t *speed, uint32_t *sum, uint8_t *count, uint32_t *last_edge, 
+                             uint8_t *started )
+{
+    uint16_t seq;
+
+    // Read again if an edge came in between
+    do
+    {
+        seq = speed->seq;
+        *sum = speed->sum;
+        *count = speed->count;
+        *last_edge = speed->last_edge;
+        *started = speed->started;
+    }
+    while ( seq != speed->seq );
+}
+
+static uint32_t speed_rpm ( uint32_t timer_hz, uint32_t rev_ticks )
+{
+    uint32_t rem = timer_hz % rev_ticks;
+
+    // 60 * timer_hz / rev_ticks, split so no product leaves 32 bits
+    if ( rev_ticks <= ( 0xFFFFFFFFul / 60 ) )
+    {
+        return ( timer_hz / rev_ticks ) * 60 + rem * 60 / rev_ticks;
+    }
+    return ( timer_hz / rev_ticks ) * 60 + rem / ( rev_ticks / 60 );
+}
+
+static int32_t speed_clamp_error ( int32_t error, uint16_t gain )
+{
+    int32_t limit;
+
+    // A term beyond the span saturates the output or the integral anyway
+    if ( 0 == gain )
+    {
+        return 0;
+    }
+    limit = BRUSHLESS_SPEED_TERM_SPAN / gain + 1;
+    if ( error > limit )
+    {
+        return limit;
+    }
+    if ( error < -limit )
+    {
+        return -limit;
+    }
+    return error;
+}
+
+// ------------------------------------------------------------------------- END
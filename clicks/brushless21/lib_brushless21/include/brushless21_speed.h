@@ -0,0 +1,209 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file brushless21_speed.h
+ * @brief This file contains tachometer and speed loop for Brushless 21 Click Driver.
+ * @details The FG pin edges are timestamped by the application, from an input
+ * capture interrupt or from an external interrupt reading a free running timer.
+ * The speed is computed from the sum of the last periods, so one edge is enough
+ * for a new value. An integer PI controller turns the speed error into the PWM
+ * duty cycle.
+ */
+
+#ifndef BRUSHLESS21_SPEED_H
+#define BRUSHLESS21_SPEED_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "brushless21.h"
+
+/*!
+ * @addtogroup brushless21 Brushless 21 Click Driver
+ * @brief API for configuring and manipulating Brushless 21 Click driver.
+ * @{
+ */
+
+/**
+ * @defgroup brushless21_speed Brushless 21 Speed Settings
+ * @brief Settings for speed loop of Brushless 21 Click driver.
+ */
+
+/**
+ * @addtogroup brushless21_speed
+ * @{
+ */
+
+/**
+ * @brief Brushless 21 speed window setting.
+ * @details Number of periods the speed is averaged over.
+ * @note Has to be a power of two.
+ */
+#define BRUSHLESS21_SPEED_WINDOW                8
+
+/**
+ * @brief Brushless 21 speed duty cycle setting.
+ * @details Full scale of the duty cycle in permille.
+ */
+#define BRUSHLESS21_SPEED_DUTY_MAX              1000
+
+/**
+ * @brief Brushless 21 speed default gains setting.
+ * @details Default proportional and integral gain in duty permille per rpm, Q8.
+ */
+#define BRUSHLESS21_SPEED_DEFAULT_KP            64
+#define BRUSHLESS21_SPEED_DEFAULT_KI            8
+
+/*! @} */ // brushless21_speed
+
+/**
+ * @brief Brushless 21 speed loop object.
+ * @details Tachometer and speed controller definition of Brushless 21 Click driver.
+ */
+typedef struct
+{
+    brushless21_t *ctx;                 /**< Click context object. */
+    uint32_t timer_hz;                  /**< Frequency of the edge timestamps. */
+    uint8_t edges_per_rev;              /**< FG edges per revolution. */
+    uint32_t stall_ticks;               /**< Time without edges to report a stall. */
+
+    // Tachometer
+    uint32_t period[ BRUSHLESS21_SPEED_WINDOW ];    /**< Last periods in timer ticks. */
+    uint8_t index;                      /**< Oldest period. */
+    volatile uint8_t count;             /**< Periods in the window. */
+    volatile uint32_t sum;              /**< Sum of the periods in the window. */
+    volatile uint32_t last_edge;        /**< Timestamp of the last edge. */
+    volatile uint8_t started;           /**< At least one edge seen. */
+    volatile uint16_t seq;              /**< Incremented on every edge. */
+
+    // Controller
+    uint32_t target_rpm;                /**< Speed setpoint, zero turns the motor off. */
+    uint16_t kp;                        /**< Proportional gain in duty permille per rpm, Q8. */
+    uint16_t ki;                        /**< Integral gain in duty permille per rpm and update, Q8. */
+    int32_t integral;                   /**< Integral term in duty permille, Q8. */
+    uint16_t duty;                      /**< Duty cycle in permille. */
+
+} brushless21_speed_t;
+
+/**
+ * @brief Brushless 21 speed loop initialization function.
+ * @details This function initializes the tachometer and the controller with the
+ * default gains and zero target.
+ * @param[out] speed : Speed loop object.
+ * See #brushless21_speed_t object definition for detailed explanation.
+ * @param[in] ctx : Initialized Click context object.
+ * See #brushless21_t object definition for detailed explanation.
+ * @param[in] timer_hz : Frequency of the timer the edges are timestamped with.
+ * @param[in] edges_per_rev : FG edges per revolution, depends on the motor poles
+ * and the FG mode.
+ * @param[in] stall_ms : Time without edges after which the motor is stalled.
+ * @return None.
+ * @note None.
+ */
+void brushless21_speed_init ( brushless21_speed_t *speed, brushless21_t *ctx, uint32_t timer_hz, 
+                              uint8_t edges_per_rev, uint16_t stall_ms );
+
+/**
+ * @brief Brushless 21 speed edge function.
+ * @details This function records an edge of the FG pin.
+ * @param[in] speed : Speed loop object.
+ * See #brushless21_speed_t object definition for detailed explanation.
+ * @param[in] timestamp : Timer value at the edge, the timer may wrap around.
+ * @return None.
+ * @note Call it from the input capture or external interrupt of the FG pin.
+ */
+void brushless21_speed_edge ( brushless21_speed_t *speed, uint32_t timestamp );
+
+/**
+ * @brief Brushless 21 get speed function.
+ * @details This function computes the speed from the periods in the window. While
+ * the next edge is late, the speed is limited by the time since the last edge, so
+ * slowing down shows before the edge arrives.
+ * @param[in] speed : Speed loop object.
+ * See #brushless21_speed_t object definition for detailed explanation.
+ * @param[in] now : Current timer value.
+ * @return Speed in rpm, zero when stalled.
+ * @note None.
+ */
+uint32_t brushless21_speed_get_rpm ( brushless21_speed_t *speed, uint32_t now );
+
+/**
+ * @brief Brushless 21 stall check function.
+ * @details This function checks whether an edge came within the stall time.
+ * @param[in] speed : Speed loop object.
+ * See #brushless21_speed_t object definition for detailed explanation.
+ * @param[in] now : Current timer value.
+ * @return @li @c 0 - Running,
+ *         @li @c 1 - Stalled.
+ * @note None.
+ */
+uint8_t brushless21_speed_is_stalled ( brushless21_speed_t *speed, uint32_t now );
+
+/**
+ * @brief Brushless 21 set gains function.
+ * @details This function sets the gains of the PI controller.
+ * @param[in] speed : Speed loop object.
+ * See #brushless21_speed_t object definition for detailed explanation.
+ * @param[in] kp : Proportional gain in duty permille per rpm, Q8.
+ * @param[in] ki : Integral gain in duty permille per rpm and update, Q8.
+ * @return None.
+ * @note None.
+ */
+void brushless21_speed_set_gains ( brushless21_speed_t *speed, uint16_t kp, uint16_t ki );
+
+/**
+ * @brief Brushless 21 set target function.
+ * @details This function sets the speed the controller regulates to.
+ * @param[in] speed : Speed loop object.
+ * See #brushless21_speed_t object definition for detailed explanation.
+ * @param[in] rpm : Speed setpoint, zero turns the motor off.
+ * @return None.
+ * @note None.
+ */
+void brushless21_speed_set_target ( brushless21_speed_t *speed, uint32_t rpm );
+
+/**
+ * @brief Brushless 21 speed update function.
+ * @details This function runs one step of the PI controller and writes the duty cycle
+ * with brushless21_set_duty_cycle( ) when it changed.
+ * @param[in] speed : Speed loop object.
+ * See #brushless21_speed_t object definition for detailed explanation.
+ * @param[in] now : Current timer value.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Call it at a fixed rate from the main loop, e.g. every 10 ms. A motor at
+ * standstill is stalled, the integral term raises the duty cycle until it starts.
+ * Check brushless21_speed_is_stalled( ) to detect a blocked rotor.
+ */
+err_t brushless21_speed_update ( brushless21_speed_t *speed, uint32_t now );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // BRUSHLESS21_SPEED_H
+
+/*! @} */ // brushless21
+
+// ------------------------------------------------------------------------ END
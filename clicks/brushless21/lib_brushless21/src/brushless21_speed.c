@@ -0,0 +1,294 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file brushless21_speed.c
+ * @brief Brushless 21 Click Speed Loop.
+ */
+
+#include "brushless21_speed.h"
+
+/**
+ * @brief Brushless 21 speed window mask.
+ * @details Wraps the index of the period window.
+ */
+#define BRUSHLESS21_SPEED_WINDOW_MASK           ( BRUSHLESS21_SPEED_WINDOW - 1 )
+
+/**
+ * @brief Brushless 21 speed term span.
+ * @details A PI term beyond this span saturates the duty cycle or the integral.
+ */
+#define BRUSHLESS21_SPEED_TERM_SPAN             ( 2 * BRUSHLESS21_SPEED_DUTY_MAX * 256 )
+
+/**
+ * @brief Brushless 21 speed snapshot function.
+ * @details This function reads the tachometer state consistently with the edge
+ * interrupt, it reads again if an edge came in between.
+ * @param[in] speed : Speed loop object.
+ * See #brushless21_speed_t object definition for detailed explanation.
+ * @param[out] sum : Sum of the periods in the window.
+ * @param[out] count : Periods in the window.
+ * @param[out] last_edge : Timestamp of the last edge.
+ * @param[out] started : At least one edge seen.
+ * @return None.
+ * @note None.
+ */
+static void brushless21_speed_snapshot ( brushless21_speed_t *speed, uint32_t *sum, uint8_t *count, 
+                                         uint32_t *last_edge, uint8_t *started );
+
+/**
+ * @brief Brushless 21 speed rpm function.
+ * @details This function calculates 60 * timer_hz / rev_ticks in 32-bit arithmetic.
+ * @param[in] timer_hz : Frequency of the edge timestamps.
+ * @param[in] rev_ticks : Timer ticks per revolution.
+ * @return Speed in rpm.
+ * @note None.
+ */
+static uint32_t brushless21_speed_rpm ( uint32_t timer_hz, uint32_t rev_ticks );
+
+/**
+ * @brief Brushless 21 speed error clamp function.
+ * @details This function limits the speed error so that the gain times the error
+ * fits int32, beyond the limit the term saturates the output anyway.
+ * @param[in] error : Speed error in rpm.
+ * @param[in] gain : Proportional or integral gain, Q8.
+ * @return Limited speed error.
+ * @note None.
+ */
+static int32_t brushless21_speed_clamp_error ( int32_t error, uint16_t gain );
+
+void brushless21_speed_init ( brushless21_speed_t *speed, brushless21_t *ctx, uint32_t timer_hz, 
+                              uint8_t edges_per_rev, uint16_t stall_ms )
+{
+    speed->ctx = ctx;
+    speed->timer_hz = timer_hz;
+    speed->edges_per_rev = edges_per_rev ? edges_per_rev : 1;
+    speed->stall_ticks = ( timer_hz / 1000 ) * stall_ms + ( timer_hz % 1000 ) * stall_ms / 1000;
+
+    speed->index = 0;
+    speed->count = 0;
+    speed->sum = 0;
+    speed->last_edge = 0;
+    speed->started = 0;
+    speed->seq = 0;
+
+    speed->target_rpm = 0;
+    speed->kp = BRUSHLESS21_SPEED_DEFAULT_KP;
+    speed->ki = BRUSHLESS21_SPEED_DEFAULT_KI;
+    speed->integral = 0;
+    speed->duty = 0;
+}
+
+void brushless21_speed_edge ( brushless21_speed_t *speed, uint32_t timestamp )
+{
+    uint32_t period = timestamp - speed->last_edge;
+
+    // Glitch, both edges in the same timer tick
+    if ( speed->started && ( 0 == period ) )
+    {
+        return;
+    }
+
+    speed->seq++;
+
+    if ( !speed->started || ( period > speed->stall_ticks ) )
+    {
+        // First edge after a stop does not close a period
+        speed->started = 1;
+        speed->count = 0;
+        speed->sum = 0;
+        speed->index = 0;
+    }
+    else
+    {
+        if ( speed->count < BRUSHLESS21_SPEED_WINDOW )
+        {
+            speed->count++;
+        }
+        else
+        {
+            speed->sum -= speed->period[ speed->index ];
+        }
+        speed->period[ speed->index ] = period;
+        speed->sum += period;
+        speed->index = ( speed->index + 1 ) & BRUSHLESS21_SPEED_WINDOW_MASK;
+    }
+
+    speed->last_edge = timestamp;
+}
+
+uint32_t brushless21_speed_get_rpm ( brushless21_speed_t *speed, uint32_t now )
+{
+    uint32_t sum = 0;
+    uint32_t last_edge = 0;
+    uint32_t elapsed = 0;
+    uint32_t rev_ticks = 0;
+    uint8_t count = 0;
+    uint8_t started = 0;
+
+    brushless21_speed_snapshot ( speed, &sum, &count, &last_edge, &started );
+
+    elapsed = now - last_edge;
+    if ( !started || !count || ( elapsed > speed->stall_ticks ) )
+    {
+        return 0;
+    }
+
+    // Late edge, the period is at least the time since the last one
+    if ( elapsed > ( sum / count ) )
+    {
+        sum = elapsed;
+        count = 1;
+    }
+
+    // Ticks per revolution, the remainder keeps the fraction of the mean period
+    rev_ticks = ( sum / count ) * speed->edges_per_rev + ( sum % count ) * speed->edges_per_rev / count;
+
+    return brushless21_speed_rpm ( speed->timer_hz, rev_ticks );
+}
+
+uint8_t brushless21_speed_is_stalled ( brushless21_speed_t *speed, uint32_t now )
+{
+    uint32_t sum = 0;
+    uint32_t last_edge = 0;
+    uint8_t count = 0;
+    uint8_t started = 0;
+
+    brushless21_speed_snapshot ( speed, &sum, &count, &last_edge, &started );
+
+    return !started || ( ( now - last_edge ) > speed->stall_ticks );
+}
+
+void brushless21_speed_set_gains ( brushless21_speed_t *speed, uint16_t kp, uint16_t ki )
+{
+    speed->kp = kp;
+    speed->ki = ki;
+}
+
+void brushless21_speed_set_target ( brushless21_speed_t *speed, uint32_t rpm )
+{
+    speed->target_rpm = rpm;
+}
+
+err_t brushless21_speed_update ( brushless21_speed_t *speed, uint32_t now )
+{
+    int32_t error = 0;
+    int32_t output = 0;
+    int32_t integral = 0;
+    uint16_t duty = 0;
+    err_t error_flag = BRUSHLESS21_OK;
+
+    if ( 0 == speed->target_rpm )
+    {
+        speed->integral = 0;
+    }
+    else
+    {
+        error = ( int32_t ) speed->target_rpm - ( int32_t ) brushless21_speed_get_rpm ( speed, now );
+        output = ( ( int32_t ) speed->kp * brushless21_speed_clamp_error ( error, speed->kp ) + speed->integral ) / 256;
+
+        // No integration while the output is saturated in the direction of the error
+        if ( !( ( output >= BRUSHLESS21_SPEED_DUTY_MAX ) && ( error > 0 ) ) && !( ( output <= 0 ) && ( error < 0 ) ) )
+        {
+            integral = speed->integral + ( int32_t ) speed->ki * brushless21_speed_clamp_error ( error, speed->ki );
+            if ( integral < 0 )
+            {
+                integral = 0;
+            }
+            else if ( integral > ( BRUSHLESS21_SPEED_DUTY_MAX * 256 ) )
+            {
+                integral = BRUSHLESS21_SPEED_DUTY_MAX * 256;
+            }
+            speed->integral = integral;
+        }
+
+        output = ( ( int32_t ) speed->kp * brushless21_speed_clamp_error ( error, speed->kp ) + speed->integral ) / 256;
+        if ( output > BRUSHLESS21_SPEED_DUTY_MAX )
+        {
+            output = BRUSHLESS21_SPEED_DUTY_MAX;
+        }
+        else if ( output < 0 )
+        {
+            output = 0;
+        }
+        duty = ( uint16_t ) output;
+    }
+
+    if ( duty != speed->duty )
+    {
+        error_flag = brushless21_set_duty_cycle ( speed->ctx, ( float ) duty / BRUSHLESS21_SPEED_DUTY_MAX );
+        if ( BRUSHLESS21_OK == error_flag )
+        {
+            speed->duty = duty;
+        }
+    }
+    return error_flag;
+}
+
+static void brushless21_speed_snapshot ( brushless21_speed_t *speed, uint32_t *sum, uint8_t *count, 
+                                         uint32_t *last_edge, uint8_t *started )
+{
+    uint16_t seq = 0;
+
+    do
+    {
+        seq = speed->seq;
+        *sum = speed->sum;
+        *count = speed->count;
+        *last_edge = speed->last_edge;
+        *started = speed->started;
+    }
+    while ( seq != speed->seq );
+}
+
+static uint32_t brushless21_speed_rpm ( uint32_t timer_hz, uint32_t rev_ticks )
+{
+    uint32_t rem = timer_hz % rev_ticks;
+
+    if ( rev_ticks <= ( 0xFFFFFFFFul / 60 ) )
+    {
+        return ( timer_hz / rev_ticks ) * 60 + rem * 60 / rev_ticks;
+    }
+    return ( timer_hz / rev_ticks ) * 60 + rem / ( rev_ticks / 60 );
+}
+
+static int32_t brushless21_speed_clamp_error ( int32_t error, uint16_t gain )
+{
+    int32_t limit = 0;
+
+    if ( 0 == gain )
+    {
+        return 0;
+    }
+    limit = BRUSHLESS21_SPEED_TERM_SPAN / gain + 1;
+    if ( error > limit )
+    {
+        return limit;
+    }
+    if ( error < -limit )
+    {
+        return -limit;
+    }
+    return error;
+}
+
+// ------------------------------------------------------------------------- END
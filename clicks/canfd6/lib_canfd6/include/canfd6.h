@@ -73,6 +73,7 @@ extern "C"{
 #define CANFD6_MCAN_CACHE_TXBC                                  6
 #define CANFD6_MCAN_CACHE_RXESC                                 7
 #define CANFD6_MCAN_CACHE_TXESC                                 8
+#define CANFD6_MCAN_CACHE_SIZE                                  9
 #endif
 
 /**
@@ -81,6 +82,18 @@ extern "C"{
  */
 #define CANFD6_MRAM_SIZE                                        2048
 
+/**
+ * @brief CAN FD 6 maximum data payload.
+ * @details Largest data payload of a CAN FD frame in bytes.
+ */
+#define CANFD6_MCAN_MAX_DATA_LEN                                64
+
+/**
+ * @brief CAN FD 6 maximum burst length.
+ * @details Largest number of words transferred in one SPI burst.
+ */
+#define CANFD6_MAX_BURST_WORDS                                  255
+
 /**
  * @defgroup canfd6_reg1 CAN FD 6 Register address sections.
  * @brief List of register address sections of CAN FD 6 Click driver.
@@ -917,6 +930,10 @@ typedef struct
 
     pin_name_t  chip_select;                             /**< Chip select pin descriptor (used for SPI driver). */
 
+#ifdef CANFD6_MCAN_CACHE_CONFIGURATION
+    uint32_t  mcan_cache[ CANFD6_MCAN_CACHE_SIZE ];      /**< MCAN MRAM configuration cache. */
+#endif
+
 } canfd6_t;
 
 /**
@@ -1380,6 +1397,33 @@ typedef struct
 
 } canfd6_mcan_rx_header_t;
 
+/**
+ * @brief CAN FD 6 Click received CAN message.
+ * @details Struct containing the CAN message header and data payload.
+ */
+typedef struct
+{
+    canfd6_mcan_rx_header_t header;                  /**< CAN message header. */
+    uint8_t data_len;                                /**< Number of valid data bytes. */
+    uint8_t data_buf[ CANFD6_MCAN_MAX_DATA_LEN ];    /**< Data payload. */
+
+} canfd6_mcan_rx_frame_t;
+
+/**
+ * @brief CAN FD 6 Click received CAN message sink.
+ * @details Destination of the messages drained by #canfd6_mcan_drain_fifo_sink.
+ * @b alloc gets the decoded header and returns the buffer the data payload is
+ * read into, at least #CANFD6_MCAN_MAX_DATA_LEN bytes, or NULL to drop the
+ * message. @b commit is called once the payload is in the buffer.
+ */
+typedef struct
+{
+    uint8_t *( *alloc )( void *arg, canfd6_mcan_rx_header_t *header, uint8_t data_len );    /**< Payload buffer request. */
+    void ( *commit )( void *arg );                   /**< Message complete. */
+    void *arg;                                       /**< Argument passed to both functions. */
+
+} canfd6_mcan_rx_sink_t;
+
 /**
  * @brief CAN FD 6 Click CAN message header for transmitted messages.
  * @details Struct containing the CAN message header for transmitted messages.
@@ -1880,6 +1924,44 @@ void canfd6_mram_clear ( canfd6_t *ctx );
  */
 uint8_t canfd6_mcan_read_nextfifo ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_def, canfd6_mcan_rx_header_t *header, uint8_t data_payload[ ] );
 
+/**
+ * @brief CAN FD 6 drain fifo function.
+ * @details This function will read all pending elements of the MCAN FIFO specified,
+ * up to @b max_frames. The fill level is read once, the elements are burst-read
+ * in as few SPI transactions as the burst length allows, plus one when they wrap
+ * around the end of the FIFO, and acknowledged at once with the index of the last
+ * element read.
+ * @param[in] ctx : Click context object.
+ * See #canfd6_t object definition for detailed explanation.
+ * @param[in] fifo_def : Enum corresponding to either RXFIFO0 or RXFIFO1.
+ * @param[out] frames : Array that will be updated with the received messages.
+ * See #canfd6_mcan_rx_frame_t object definition for detailed explanation.
+ * @param[in] max_frames : Number of elements in the frames array.
+ * @return The number of messages that were read.
+ *
+ * @note A burst is limited to #CANFD6_MAX_BURST_WORDS words, so a long run of
+ * 64-byte elements is split into additional transactions.
+ */
+uint8_t canfd6_mcan_drain_fifo ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_def, canfd6_mcan_rx_frame_t *frames, uint8_t max_frames );
+
+/**
+ * @brief CAN FD 6 drain fifo to sink function.
+ * @details This function drains the MCAN FIFO specified like #canfd6_mcan_drain_fifo,
+ * but reads the data payload of each element straight into the buffer returned
+ * by the sink, so the messages are not copied again.
+ * @param[in] ctx : Click context object.
+ * See #canfd6_t object definition for detailed explanation.
+ * @param[in] fifo_def : Enum corresponding to either RXFIFO0 or RXFIFO1.
+ * @param[in] sink : Destination of the received messages.
+ * See #canfd6_mcan_rx_sink_t object definition for detailed explanation.
+ * @param[in] max_frames : Maximal number of elements to read.
+ * @return The number of elements that were read, including dropped ones.
+ * @note The sink is called with the SPI burst in progress, it must not access the device.
+ * A burst is limited to #CANFD6_MAX_BURST_WORDS words, so a long run of 64-byte
+ * elements is split into additional transactions.
+ */
+uint8_t canfd6_mcan_drain_fifo_sink ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_def, canfd6_mcan_rx_sink_t *sink, uint8_t max_frames );
+
 /**
  * @brief CAN FD 6 read rx buffer function.
  * @details This function will read the specified MCAN buffer element and return
@@ -1928,6 +2010,31 @@ uint32_t canfd6_mcan_write_txbuffer ( canfd6_t *ctx, uint8_t buf_index, canfd6_m
  */
 err_t canfd6_mcan_transmit_buffer_contents ( canfd6_t *ctx, uint8_t buf_index );
 
+/**
+ * @brief CAN FD 6 transmit buffers function.
+ * @details This function writes the buffer mask into the TXBAR register to
+ * request several messages to send with a single SPI write.
+ * @param[in] ctx : Click context object.
+ * See #canfd6_t object definition for detailed explanation.
+ * @param[in] buf_mask : Bit mask of TX buffers to send, as returned by #canfd6_mcan_write_txbuffer.
+ * @return Nothing.
+ * @note Function does NOT check if the buffer contents are valid.
+ */
+void canfd6_mcan_transmit_buffers ( canfd6_t *ctx, uint32_t buf_mask );
+
+/**
+ * @brief CAN FD 6 read tx queue free function.
+ * @details This function reads the pending TX buffer requests once and returns
+ * the indexes of the TX queue elements that are not pending.
+ * @param[in] ctx : Click context object.
+ * See #canfd6_t object definition for detailed explanation.
+ * @param[out] buf_index : Array that will be updated with the free TX buffer indexes.
+ * @param[in] max_bufs : Number of elements in the buf_index array.
+ * @return The number of free TX queue elements written to buf_index.
+ * @note None.
+ */
+uint8_t canfd6_mcan_read_txqueue_free ( canfd6_t *ctx, uint8_t buf_index[ ], uint8_t max_bufs );
+
 /**
  * @brief CAN FD 6 write sid filter function.
  * @details This function will write a standard ID MCAN filter to a specified
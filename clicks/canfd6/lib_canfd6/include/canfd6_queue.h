@@ -0,0 +1,290 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file canfd6_queue.h
+ * @brief This file contains the CAN frame queue API of CAN FD 6 Click Driver.
+ * @details The frame type, rings and ID filter do not depend on the TCAN4550,
+ * so frames from any CAN Click driver can be pushed to the same rings, e.g. by
+ * a gateway bridging two controllers. Only the adapter functions talk to the device,
+ * the MCP2518FD Click driver provides the adapter for its controller.
+ */
+
+#ifndef CANFD6_QUEUE_H
+#define CANFD6_QUEUE_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "canfd6.h"
+
+/*!
+ * @addtogroup canfd6 CAN FD 6 Click Driver
+ * @brief API for configuring and manipulating CAN FD 6 Click driver.
+ * @{
+ */
+
+/**
+ * @defgroup canfd6_queue CAN FD 6 frame queue settings.
+ * @brief Settings of the CAN frame queue of CAN FD 6 Click driver.
+ */
+
+/**
+ * @addtogroup canfd6_queue
+ * @{
+ */
+
+/**
+ * @brief CAN FD 6 frame flags.
+ * @details Specified flags of the common CAN frame.
+ */
+#define CANFD6_FRAME_FLAG_XTD                                   0x01
+#define CANFD6_FRAME_FLAG_RTR                                   0x02
+#define CANFD6_FRAME_FLAG_FDF                                   0x04
+#define CANFD6_FRAME_FLAG_BRS                                   0x08
+#define CANFD6_FRAME_FLAG_ESI                                   0x10
+
+/**
+ * @brief CAN FD 6 RX adapter batch size.
+ * @details Maximal number of FIFO elements drained per FIFO status read by the
+ * RX adapter. The status is read again after a full batch.
+ */
+#define CANFD6_QUEUE_RX_BATCH                                   8
+
+/**
+ * @brief CAN FD 6 ID filter settings.
+ * @details Standard IDs are kept in a bitmap, extended IDs in a hash table.
+ */
+#define CANFD6_FILTER_STD_MAP_SIZE                              256
+#define CANFD6_FILTER_EXT_EMPTY                                 0xFFFFFFFFul
+
+/*! @} */ // canfd6_queue
+/*! @} */ // canfd6
+
+/**
+ * @brief CAN FD 6 Click common CAN frame.
+ * @details Controller independent CAN frame stored in the rings.
+ */
+typedef struct
+{
+    uint32_t id;                                     /**< 11-bit or 29-bit CAN ID. */
+    uint32_t timestamp;                              /**< Hardware receive timestamp, 0 if not available. */
+    uint8_t flags;                                   /**< Frame flags, see CANFD6_FRAME_FLAG_x. */
+    uint8_t len;                                     /**< Number of data bytes. */
+    uint8_t data[ CANFD6_MCAN_MAX_DATA_LEN ];        /**< Data payload. */
+
+} canfd6_frame_t;
+
+/**
+ * @brief CAN FD 6 Click frame ring.
+ * @details Lock-free single-producer/single-consumer ring of frames. The producer
+ * only writes @b head and the consumer only writes @b tail, so an ISR may fill
+ * the ring while the main loop empties it without disabling interrupts.
+ */
+typedef struct
+{
+    canfd6_frame_t *buf;                             /**< Frame storage. */
+    uint16_t mask;                                   /**< Number of frames minus one. */
+    volatile uint16_t head;                          /**< Producer index. */
+    volatile uint16_t tail;                          /**< Consumer index. */
+    volatile uint16_t dropped;                       /**< Frames dropped because the ring was full. */
+
+} canfd6_ring_t;
+
+/**
+ * @brief CAN FD 6 Click software ID filter.
+ * @details Accepts IDs beyond the hardware filter count. Standard IDs are looked
+ * up in a bitmap and extended IDs in an open addressing hash table.
+ */
+typedef struct
+{
+    uint8_t std_map[ CANFD6_FILTER_STD_MAP_SIZE ];   /**< One bit per standard ID. */
+    uint32_t *ext_table;                             /**< Extended ID table. */
+    uint16_t ext_mask;                               /**< Extended ID table size minus one. */
+
+} canfd6_id_filter_t;
+
+/*!
+ * @addtogroup canfd6 CAN FD 6 Click Driver
+ * @brief API for configuring and manipulating CAN FD 6 Click driver.
+ * @{
+ */
+
+/**
+ * @brief CAN FD 6 ring init function.
+ * @details This function initializes an empty frame ring.
+ * @param[out] ring : Frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @param[in] buf : Frame storage.
+ * @param[in] size : Number of frames in @b buf, must be a power of two.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note One slot is kept free to tell a full ring from an empty one.
+ */
+err_t canfd6_ring_init ( canfd6_ring_t *ring, canfd6_frame_t *buf, uint16_t size );
+
+/**
+ * @brief CAN FD 6 ring alloc function.
+ * @details This function returns the next free slot of the ring, so the producer
+ * can fill the frame in place.
+ * @param[in] ring : Frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @return Free frame slot, NULL if the ring is full.
+ * @note The slot is not visible to the consumer until #canfd6_ring_commit is called.
+ */
+canfd6_frame_t *canfd6_ring_alloc ( canfd6_ring_t *ring );
+
+/**
+ * @brief CAN FD 6 ring commit function.
+ * @details This function publishes the slot returned by #canfd6_ring_alloc.
+ * @param[in] ring : Frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void canfd6_ring_commit ( canfd6_ring_t *ring );
+
+/**
+ * @brief CAN FD 6 ring peek function.
+ * @details This function returns the oldest frame of the ring without removing it,
+ * so the consumer can forward the frame in place.
+ * @param[in] ring : Frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @return Oldest frame, NULL if the ring is empty.
+ * @note None.
+ */
+canfd6_frame_t *canfd6_ring_peek ( canfd6_ring_t *ring );
+
+/**
+ * @brief CAN FD 6 ring release function.
+ * @details This function removes the frame returned by #canfd6_ring_peek.
+ * @param[in] ring : Frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void canfd6_ring_release ( canfd6_ring_t *ring );
+
+/**
+ * @brief CAN FD 6 ring count function.
+ * @details This function returns the number of frames waiting in the ring.
+ * @param[in] ring : Frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @return Number of frames.
+ * @note None.
+ */
+uint16_t canfd6_ring_count ( canfd6_ring_t *ring );
+
+/**
+ * @brief CAN FD 6 ID filter init function.
+ * @details This function initializes a filter that rejects all IDs.
+ * @param[out] filter : ID filter.
+ * See #canfd6_id_filter_t object definition for detailed explanation.
+ * @param[in] ext_table : Extended ID table, NULL if extended IDs are not filtered.
+ * @param[in] ext_size : Number of elements in @b ext_table, must be a power of two.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Keep @b ext_size at least twice the number of extended IDs for short probe runs.
+ */
+err_t canfd6_filter_init ( canfd6_id_filter_t *filter, uint32_t *ext_table, uint16_t ext_size );
+
+/**
+ * @brief CAN FD 6 ID filter add function.
+ * @details This function adds an ID to the accepted set.
+ * @param[in] filter : ID filter.
+ * See #canfd6_id_filter_t object definition for detailed explanation.
+ * @param[in] id : CAN ID.
+ * @param[in] xtd : 1 for an extended ID, 0 for a standard ID.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, extended ID table is full.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t canfd6_filter_add ( canfd6_id_filter_t *filter, uint32_t id, uint8_t xtd );
+
+/**
+ * @brief CAN FD 6 ID filter match function.
+ * @details This function checks whether an ID is in the accepted set.
+ * @param[in] filter : ID filter.
+ * See #canfd6_id_filter_t object definition for detailed explanation.
+ * @param[in] id : CAN ID.
+ * @param[in] xtd : 1 for an extended ID, 0 for a standard ID.
+ * @return @li @c 1 - Accepted,
+ *         @li @c 0 - Rejected.
+ * @note None.
+ */
+uint8_t canfd6_filter_match ( canfd6_id_filter_t *filter, uint32_t id, uint8_t xtd );
+
+/**
+ * @brief CAN FD 6 length to DLC function.
+ * @details This function converts the number of data bytes to the smallest DLC that holds them.
+ * @param[in] len : Number of data bytes (0-64).
+ * @return Data length code.
+ * @note None.
+ */
+uint8_t canfd6_frame_len_to_dlc ( uint8_t len );
+
+/**
+ * @brief CAN FD 6 RX adapter function.
+ * @details This function drains the MCAN FIFO specified into the ring, dropping
+ * frames rejected by the software filter. The payload is read from the MRAM
+ * straight into the ring slot. It is meant to be called from the
+ * INT pin interrupt or as soon as the INT pin goes low.
+ * @param[in] ctx : Click context object.
+ * See #canfd6_t object definition for detailed explanation.
+ * @param[in] fifo_def : Enum corresponding to either RXFIFO0 or RXFIFO1.
+ * @param[in] ring : RX frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @param[in] filter : Software ID filter, NULL to accept all frames.
+ * See #canfd6_id_filter_t object definition for detailed explanation.
+ * @return Number of frames added to the ring.
+ * @note Frames that do not fit in the ring are counted in @b dropped.
+ * The RX timestamp is only valid if the MCAN timestamp counter is enabled.
+ */
+uint8_t canfd6_queue_rx_service ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_def,
+                                  canfd6_ring_t *ring, canfd6_id_filter_t *filter );
+
+/**
+ * @brief CAN FD 6 TX adapter function.
+ * @details This function moves frames from the ring to the MCAN TX queue, as many
+ * as there are free TX queue elements, and requests their transmission at once.
+ * @param[in] ctx : Click context object.
+ * See #canfd6_t object definition for detailed explanation.
+ * @param[in] ring : TX frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @return Number of frames queued for transmission.
+ * @note The MRAM has to be configured with #canfd6_mram_configure, which enables TX queue mode.
+ * A frame that could not be written to the MRAM stays in the ring and is retried on the next call.
+ */
+uint8_t canfd6_queue_tx_service ( canfd6_t *ctx, canfd6_ring_t *ring );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CANFD6_QUEUE_H
+
+/*! @} */ // canfd6
+
+// ------------------------------------------------------------------------ END
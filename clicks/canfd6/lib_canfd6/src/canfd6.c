@@ -173,13 +173,11 @@
  */
 #define DEV_READ_OPCODE                                         0x41
 
-#ifdef CANFD6_MCAN_CACHE_CONFIGURATION
 /**
- * @brief MCAN Cache.
- * @details If caching is enabled, defines the necessary variables.
+ * @brief RX element header size.
+ * @details Size of the RX buffer and FIFO element header in bytes.
  */
-uint32_t CANFD6_MCAN_CACHE[ 9 ];
-#endif
+#define DEV_RX_HEADER_SIZE                                      8
 
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
 
@@ -283,6 +281,43 @@ static uint32_t dev_burst_read_data ( canfd6_t *ctx );
  */
 static void dev_burst_read_terminate ( canfd6_t *ctx );
 
+/**
+ * @brief CAN FD 6 RX elements read function.
+ * @details This function burst-reads consecutive RX elements from MRAM in a
+ * single SPI transaction, decodes the headers and reads the payloads into the
+ * buffers given by the sink.
+ * @param[in] ctx : Click context object.
+ * See #canfd6_t object definition for detailed explanation.
+ * @param[in] address : Address of the first element.
+ * @param[in] element_size : Data field size of an element in bytes.
+ * @param[in] sink : Destination of the decoded messages.
+ * @param[in] num_frames : Number of elements to read.
+ * @return Nothing.
+ * @note None.
+ */
+static void dev_read_rx_elements ( canfd6_t *ctx, uint16_t address, uint8_t element_size, 
+                                   canfd6_mcan_rx_sink_t *sink, uint8_t num_frames );
+
+/**
+ * @brief CAN FD 6 RX frame array alloc function.
+ * @details This function stores the header in the next element of a frame array.
+ * @param[in] arg : Pointer to the next frame of the array.
+ * @param[in] header : Decoded message header.
+ * @param[in] data_len : Number of valid data bytes.
+ * @return Data buffer of the frame.
+ * @note Used by #canfd6_mcan_drain_fifo.
+ */
+static uint8_t *dev_rx_array_alloc ( void *arg, canfd6_mcan_rx_header_t *header, uint8_t data_len );
+
+/**
+ * @brief CAN FD 6 RX frame array commit function.
+ * @details This function moves to the next element of a frame array.
+ * @param[in] arg : Pointer to the next frame of the array.
+ * @return Nothing.
+ * @note Used by #canfd6_mcan_drain_fifo.
+ */
+static void dev_rx_array_commit ( void *arg );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void canfd6_cfg_setup ( canfd6_cfg_t *cfg ) {
@@ -705,7 +740,7 @@ err_t canfd6_mram_configure ( canfd6_t *ctx, canfd6_mram_config_t *mram_config )
     start_address += ( 4 * ( uint16_t )mram_val );
     dev_write_word( ctx, CANFD6_REG_MCAN_SIDFC, register_value );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_SIDFC ] = register_value;
+    ctx->mcan_cache[ CANFD6_MCAN_CACHE_SIDFC ] = register_value;
 #endif
 
     mram_val = mram_config->xid_num_elements;
@@ -720,7 +755,7 @@ err_t canfd6_mram_configure ( canfd6_t *ctx, canfd6_mram_config_t *mram_config )
     start_address += ( 8 * ( uint16_t )mram_val );
     dev_write_word( ctx, CANFD6_REG_MCAN_XIDFC, register_value );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_XIDFC ] = register_value;
+    ctx->mcan_cache[ CANFD6_MCAN_CACHE_XIDFC ] = register_value;
 #endif
 
     mram_val = mram_config->rx0_num_elements;
@@ -736,7 +771,7 @@ err_t canfd6_mram_configure ( canfd6_t *ctx, canfd6_mram_config_t *mram_config )
     start_address += ( ( ( uint32_t )canfd6_mcan_txrxesc_data_byte_value( ( uint8_t )mram_config->rx0_element_size ) + 8 ) * ( uint16_t )mram_val );
     dev_write_word( ctx, CANFD6_REG_MCAN_RXF0C, register_value );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXF0C ] = register_value;
+    ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXF0C ] = register_value;
 #endif
 
     mram_val = mram_config->rx1_num_elements;
@@ -751,7 +786,7 @@ err_t canfd6_mram_configure ( canfd6_t *ctx, canfd6_mram_config_t *mram_config )
     start_address += ( ( ( uint32_t )canfd6_mcan_txrxesc_data_byte_value( ( uint8_t )mram_config->rx1_element_size ) + 8 ) * ( uint16_t )mram_val );
     dev_write_word( ctx, CANFD6_REG_MCAN_RXF1C, register_value );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXF1C ] = register_value;
+    ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXF1C ] = register_value;
 #endif
 
     mram_val = mram_config->rx_buf_num_elements;
@@ -766,7 +801,7 @@ err_t canfd6_mram_configure ( canfd6_t *ctx, canfd6_mram_config_t *mram_config )
     start_address += ( ( ( uint32_t )canfd6_mcan_txrxesc_data_byte_value( ( uint8_t )mram_config->rx_buf_element_size ) + 8 ) * ( uint16_t )mram_val );
     dev_write_word( ctx, CANFD6_REG_MCAN_RXBC, register_value );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXBC ] = register_value;
+    ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXBC ] = register_value;
 #endif
 
     mram_val = mram_config->tx_event_fifo_num_elements;
@@ -781,7 +816,7 @@ err_t canfd6_mram_configure ( canfd6_t *ctx, canfd6_mram_config_t *mram_config )
     start_address += ( 8 * ( uint16_t )mram_val );
     dev_write_word( ctx, CANFD6_REG_MCAN_TXEFC, register_value );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_TXEFC ] = register_value;
+    ctx->mcan_cache[ CANFD6_MCAN_CACHE_TXEFC ] = register_value;
 #endif
 
     mram_val = mram_config->tx_buffer_num_elements;
@@ -797,7 +832,7 @@ err_t canfd6_mram_configure ( canfd6_t *ctx, canfd6_mram_config_t *mram_config )
     start_address += ( ( ( uint32_t )canfd6_mcan_txrxesc_data_byte_value( ( uint8_t )mram_config->tx_buf_element_size ) + 8 ) * ( uint16_t )mram_val );
     dev_write_word( ctx, CANFD6_REG_MCAN_TXBC, register_value );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_TXBC ] = register_value;
+    ctx->mcan_cache[ CANFD6_MCAN_CACHE_TXBC ] = register_value;
 #endif
 
     if ( ( start_address - 1 ) > ( CANFD6_MRAM_SIZE + CANFD6_REG_MRAM ) ) {
@@ -807,13 +842,13 @@ err_t canfd6_mram_configure ( canfd6_t *ctx, canfd6_mram_config_t *mram_config )
     register_value = ( ( uint32_t )( mram_config->rx_buf_element_size ) << 8 ) | ( ( uint32_t )( mram_config->rx1_element_size ) << 4 ) | ( uint32_t )( mram_config->rx0_element_size );
     dev_write_word( ctx, CANFD6_REG_MCAN_RXESC, register_value );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXESC ] = register_value;
+    ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXESC ] = register_value;
 #endif
 
     register_value = ( uint32_t )( mram_config->tx_buf_element_size );
     dev_write_word( ctx, CANFD6_REG_MCAN_TXESC, register_value );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_TXESC ] = register_value;
+    ctx->mcan_cache[ CANFD6_MCAN_CACHE_TXESC ] = register_value;
 #endif
 
     return CANFD6_OK;
@@ -846,13 +881,13 @@ uint8_t canfd6_mcan_read_nextfifo ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_
             }
             get_index = ( uint8_t )( ( rd_data & DEV_BITMASK_FIRSTB_6 ) >> 8 );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-            rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXF0C ];
+            rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXF0C ];
 #else
             rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXF0C );
 #endif
             start_address = ( uint16_t )( rd_data & DEV_BITMASK_HWORD ) + CANFD6_REG_MRAM;
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-            rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXESC ];
+            rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXESC ];
 #else
             rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXESC );
 #endif
@@ -869,13 +904,13 @@ uint8_t canfd6_mcan_read_nextfifo ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_
             }
             get_index = ( uint8_t )( ( rd_data & DEV_BITMASK_FIRSTB_6 ) >> 8 );
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-            rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXF1C ];
+            rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXF1C ];
 #else
             rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXF1C );
 #endif
             start_address = ( uint16_t )( rd_data & DEV_BITMASK_HWORD ) + CANFD6_REG_MRAM;
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-            rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXESC ];
+            rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXESC ];
 #else
             rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXESC );
 #endif
@@ -941,6 +976,112 @@ uint8_t canfd6_mcan_read_nextfifo ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_
     return cnt_f;
 }
 
+uint8_t canfd6_mcan_drain_fifo ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_def, canfd6_mcan_rx_frame_t *frames, uint8_t max_frames ) {
+    canfd6_mcan_rx_frame_t *next_frame = frames;
+    canfd6_mcan_rx_sink_t sink;
+
+    sink.alloc = dev_rx_array_alloc;
+    sink.commit = dev_rx_array_commit;
+    sink.arg = &next_frame;
+    canfd6_mcan_drain_fifo_sink( ctx, fifo_def, &sink, max_frames );
+
+    return ( uint8_t )( next_frame - frames );
+}
+
+uint8_t canfd6_mcan_drain_fifo_sink ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_def, canfd6_mcan_rx_sink_t *sink, uint8_t max_frames ) {
+    uint32_t rd_data;
+    uint32_t cfg_data;
+    uint16_t start_address;
+    uint16_t element_stride;
+    uint8_t fill_level;
+    uint8_t get_index;
+    uint8_t fifo_size;
+    uint8_t element_size;
+    uint8_t burst_frames;
+    uint8_t frames_read;
+    uint8_t num_frames;
+
+    switch ( fifo_def ) {
+        default: {
+            rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXF0S );
+#ifdef CANFD6_MCAN_CACHE_CONFIGURATION
+            cfg_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXF0C ];
+#else
+            cfg_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXF0C );
+#endif
+            break;
+        }
+
+        case CANFD6_RXFIFO1: {
+            rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXF1S );
+#ifdef CANFD6_MCAN_CACHE_CONFIGURATION
+            cfg_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXF1C ];
+#else
+            cfg_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXF1C );
+#endif
+            break;
+        }
+    }
+
+    fill_level = ( uint8_t )( rd_data & DEV_BITMASK_LASTB_7 );
+    get_index = ( uint8_t )( ( rd_data & DEV_BITMASK_FIRSTB_6 ) >> 8 );
+    fifo_size = ( uint8_t )( ( cfg_data >> 16 ) & DEV_BITMASK_LASTB_7 );
+    if ( ( 0 == fill_level ) || ( 0 == fifo_size ) || ( 0 == max_frames ) ) {
+        return 0;
+    }
+    if ( fill_level > max_frames ) {
+        fill_level = max_frames;
+    }
+
+#ifdef CANFD6_MCAN_CACHE_CONFIGURATION
+    rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXESC ];
+#else
+    rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXESC );
+#endif
+    if ( CANFD6_RXFIFO1 == fifo_def ) {
+        rd_data >>= 4;
+    }
+    element_size = canfd6_mcan_txrxesc_data_byte_value( rd_data & 0x07 );
+    element_stride = ( uint16_t )element_size + DEV_RX_HEADER_SIZE;
+
+    frames_read = 0;
+    while ( frames_read < fill_level ) {
+        // Stop each burst at the end of the FIFO, so only a wrap costs another transaction
+        burst_frames = fill_level - frames_read;
+        if ( burst_frames > ( fifo_size - get_index ) ) {
+            burst_frames = fifo_size - get_index;
+        }
+        num_frames = ( CANFD6_MAX_BURST_WORDS * 4 ) / element_stride;
+        if ( burst_frames > num_frames ) {
+            burst_frames = num_frames;
+        }
+
+        start_address = ( uint16_t )( cfg_data & DEV_BITMASK_HWORD ) + CANFD6_REG_MRAM;
+        start_address += element_stride * get_index;
+        dev_read_rx_elements( ctx, start_address, element_size, sink, burst_frames );
+
+        frames_read += burst_frames;
+        get_index += burst_frames;
+        if ( get_index >= fifo_size ) {
+            get_index = 0;
+        }
+    }
+
+    // Acknowledging the last element releases all the elements before it
+    get_index = ( get_index > 0 ) ? ( get_index - 1 ) : ( fifo_size - 1 );
+    switch ( fifo_def ) {
+        default:
+        dev_write_word( ctx, CANFD6_REG_MCAN_RXF0A, get_index );
+        break;
+
+        case CANFD6_RXFIFO1:
+        dev_write_word( ctx, CANFD6_REG_MCAN_RXF1A, get_index );
+        break;
+    }
+
+    return frames_read;
+}
+
 uint8_t canfd6_mcan_read_rxbuffer ( canfd6_t *ctx, uint8_t buf_index, canfd6_mcan_rx_header_t *header, uint8_t data_payload[ ] ) {
     uint32_t rd_data;
     uint16_t start_address;
@@ -954,13 +1095,13 @@ uint8_t canfd6_mcan_read_rxbuffer ( canfd6_t *ctx, uint8_t buf_index, canfd6_mca
     }
 
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXBC ];
+    rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXBC ];
 #else
     rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXBC );
 #endif
     start_address = ( uint16_t )( rd_data & DEV_BITMASK_HWORD ) + CANFD6_REG_MRAM;
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_RXESC ];
+    rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_RXESC ];
 #else
     rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_RXESC );
 #endif
@@ -1027,7 +1168,7 @@ uint32_t canfd6_mcan_write_txbuffer ( canfd6_t *ctx, uint8_t buf_index, canfd6_m
     uint8_t temp;
 
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    spi_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_TXBC ];
+    spi_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_TXBC ];
 #else
     spi_data = dev_read_word( ctx, CANFD6_REG_MCAN_TXBC );
 #endif
@@ -1042,7 +1183,7 @@ uint32_t canfd6_mcan_write_txbuffer ( canfd6_t *ctx, uint8_t buf_index, canfd6_m
     }
 
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    spi_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_TXESC ];
+    spi_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_TXESC ];
 #else
     spi_data = dev_read_word( ctx, CANFD6_REG_MCAN_TXESC );
 #endif
@@ -1121,13 +1262,47 @@ err_t canfd6_mcan_transmit_buffer_contents ( canfd6_t *ctx, uint8_t buf_index )
     return CANFD6_OK;
 }
 
+void canfd6_mcan_transmit_buffers ( canfd6_t *ctx, uint32_t buf_mask ) {
+    dev_write_word( ctx, CANFD6_REG_MCAN_TXBAR, buf_mask );
+}
+
+uint8_t canfd6_mcan_read_txqueue_free ( canfd6_t *ctx, uint8_t buf_index[ ], uint8_t max_bufs ) {
+    uint32_t rd_data;
+    uint32_t pending;
+    uint8_t first_index;
+    uint8_t last_index;
+    uint8_t num_bufs = 0;
+    uint8_t cnt;
+
+#ifdef CANFD6_MCAN_CACHE_CONFIGURATION
+    rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_TXBC ];
+#else
+    rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_TXBC );
+#endif
+    first_index = ( uint8_t )( ( rd_data >> 16 ) & DEV_BITMASK_LASTB_6 );
+    last_index = first_index + ( uint8_t )( ( rd_data >> 24 ) & DEV_BITMASK_LASTB_6 );
+    if ( last_index > 32 ) {
+        last_index = 32;
+    }
+
+    // In queue mode the free elements are not contiguous, only TXBRP tells which are in use
+    pending = dev_read_word( ctx, CANFD6_REG_MCAN_TXBRP );
+    for ( cnt = first_index; ( cnt < last_index ) && ( num_bufs < max_bufs ); cnt++ ) {
+        if ( !( pending & ( ( uint32_t )1 << cnt ) ) ) {
+            buf_index[ num_bufs++ ] = cnt;
+        }
+    }
+
+    return num_bufs;
+}
+
 err_t canfd6_mcan_write_sid_filter ( canfd6_t *ctx, uint8_t filter_index, canfd6_mcan_sid_filter_t *filter ) {
     uint32_t rd_data;
     uint16_t start_address;
     uint8_t get_index;
     
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_SIDFC ];
+    rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_SIDFC ];
 #else
     rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_SIDFC );
 #endif
@@ -1153,7 +1328,7 @@ err_t canfd6_mcan_read_sid_filter ( canfd6_t *ctx, uint8_t filter_index, canfd6_
     uint8_t get_index;
     
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_SIDFC ];
+    rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_SIDFC ];
 #else
     rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_SIDFC );
 #endif
@@ -1180,7 +1355,7 @@ err_t canfd6_mcan_write_xid_filter ( canfd6_t *ctx, uint8_t filter_index, canfd6
     uint8_t get_index;
     
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_XIDFC ];
+    rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_XIDFC ];
 #else
     rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_XIDFC );
 #endif
@@ -1213,7 +1388,7 @@ err_t canfd6_mcan_read_xid_filter ( canfd6_t *ctx, uint8_t filter_index, canfd6_
     uint8_t get_index;
     
 #ifdef CANFD6_MCAN_CACHE_CONFIGURATION
-    rd_data = CANFD6_MCAN_CACHE[ CANFD6_MCAN_CACHE_XIDFC ];
+    rd_data = ctx->mcan_cache[ CANFD6_MCAN_CACHE_XIDFC ];
 #else
     rd_data = dev_read_word( ctx, CANFD6_REG_MCAN_XIDFC );
 #endif
@@ -1590,4 +1765,83 @@ static void dev_burst_read_terminate ( canfd6_t *ctx ) {
     spi_master_deselect_device( ctx->chip_select );
 }
 
+static void dev_read_rx_elements ( canfd6_t *ctx, uint16_t address, uint8_t element_size, 
+                                   canfd6_mcan_rx_sink_t *sink, uint8_t num_frames ) {
+    canfd6_mcan_rx_header_t header;
+    uint8_t rx_buf[ DEV_RX_HEADER_SIZE ];
+    uint8_t element_len = element_size + DEV_RX_HEADER_SIZE;
+    uint8_t *data_buf;
+    uint32_t rd_data;
+    uint8_t data_len;
+    uint8_t tmp;
+    uint8_t cnt_f;
+    uint8_t cnt;
+
+    dev_burst_read_init( ctx, address, ( uint8_t )( ( ( uint16_t )element_len * num_frames ) >> 2 ) );
+    for ( cnt_f = 0; cnt_f < num_frames; cnt_f++ ) {
+        spi_master_read( &ctx->spi, rx_buf, DEV_RX_HEADER_SIZE );
+
+        rd_data = ( ( uint32_t )rx_buf[ 0 ] << 24 ) | ( ( uint32_t )rx_buf[ 1 ] << 16 ) | 
+                  ( ( uint32_t )rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+        header.ESI = ( rd_data & DEV_MASK_BIT_32 ) >> 31;
+        header.XTD = ( rd_data & DEV_MASK_BIT_31 ) >> 30;
+        header.RTR = ( rd_data & DEV_MASK_BIT_30 ) >> 29;
+
+        if ( header.XTD ) {
+            header.ID  = ( rd_data & DEV_BITMASK_EXTENDED_ID );
+        } else {
+            header.ID  = ( rd_data & DEV_BITMASK_NORMAL_ID ) >> 18;
+        }
+
+        rd_data = ( ( uint32_t )rx_buf[ 4 ] << 24 ) | ( ( uint32_t )rx_buf[ 5 ] << 16 ) | 
+                  ( ( uint32_t )rx_buf[ 6 ] << 8 ) | rx_buf[ 7 ];
+        header.RXTS = ( rd_data & DEV_BITMASK_HWORD );
+        header.DLC  = ( rd_data & DEV_BITMASK_DLC  ) >> 16;
+        header.BRS  = ( rd_data & DEV_BITMASK_BRS  ) >> 20;
+        header.FDF  = ( rd_data & DEV_BITMASK_FDF  ) >> 21;
+        header.FIDX = ( rd_data & DEV_BITMASK_FIDX ) >> 24;
+        header.ANMF = ( rd_data & DEV_MASK_BIT_32  ) >> 31;
+
+        data_len = canfd6_mcan_dlc_to_bytes( header.DLC );
+        if ( data_len > element_size ) {
+            data_len = element_size;
+        }
+
+        data_buf = sink->alloc( sink->arg, &header, data_len );
+        if ( NULL == data_buf ) {
+            // Dropped, the data field still has to be clocked out of the burst
+            for ( cnt = 0; cnt < element_size; cnt += 4 ) {
+                dev_burst_read_data( ctx );
+            }
+            continue;
+        }
+
+        // Data words are sent MSB first while the payload is little-endian within a word
+        spi_master_read( &ctx->spi, data_buf, element_size );
+        for ( cnt = 0; cnt < data_len; cnt += 4 ) {
+            tmp = data_buf[ cnt ];
+            data_buf[ cnt ] = data_buf[ cnt + 3 ];
+            data_buf[ cnt + 3 ] = tmp;
+            tmp = data_buf[ cnt + 1 ];
+            data_buf[ cnt + 1 ] = data_buf[ cnt + 2 ];
+            data_buf[ cnt + 2 ] = tmp;
+        }
+        sink->commit( sink->arg );
+    }
+    dev_burst_read_terminate( ctx );
+}
+
+static uint8_t *dev_rx_array_alloc ( void *arg, canfd6_mcan_rx_header_t *header, uint8_t data_len ) {
+    canfd6_mcan_rx_frame_t *frame = *( canfd6_mcan_rx_frame_t ** )arg;
+
+    frame->header = *header;
+    frame->data_len = data_len;
+
+    return frame->data_buf;
+}
+
+static void dev_rx_array_commit ( void *arg ) {
+    ( *( canfd6_mcan_rx_frame_t ** )arg )++;
+}
+
 // ------------------------------------------------------------------------- END
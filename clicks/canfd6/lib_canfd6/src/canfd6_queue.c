@@ -0,0 +1,338 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file canfd6_queue.c
+ * @brief CAN FD 6 Click frame queue.
+ */
+
+#include "canfd6_queue.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+/**
+ * @brief Extended ID hash multiplier.
+ * @details Fibonacci hashing constant, spreads consecutive IDs over the table.
+ */
+#define QUEUE_HASH_MULTIPLIER                                   0x9E3779B1ul
+
+/**
+ * @brief Maximum TX queue size.
+ * @details Largest number of TX queue elements in the MRAM.
+ */
+#define QUEUE_TX_MAX_BUFS                                       32
+
+/**
+ * @brief RX adapter sink argument.
+ * @details State shared by the RX adapter sink functions.
+ */
+typedef struct
+{
+    canfd6_ring_t *ring;                             /**< RX frame ring. */
+    canfd6_id_filter_t *filter;                      /**< Software ID filter. */
+    uint8_t queued;                                  /**< Frames added to the ring. */
+
+} queue_rx_arg_t;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+/**
+ * @brief CAN FD 6 extended ID hash function.
+ * @details This function returns the first probe position of an extended ID.
+ * @param[in] filter : ID filter.
+ * See #canfd6_id_filter_t object definition for detailed explanation.
+ * @param[in] id : Extended CAN ID.
+ * @return Extended ID table index.
+ * @note None.
+ */
+static uint16_t queue_ext_hash ( canfd6_id_filter_t *filter, uint32_t id );
+
+/**
+ * @brief CAN FD 6 RX adapter alloc function.
+ * @details This function filters a received message and fills the header of a
+ * ring slot, the payload is then read straight into the slot.
+ * @param[in] arg : RX adapter state.
+ * @param[in] header : Decoded message header.
+ * @param[in] data_len : Number of valid data bytes.
+ * @return Data buffer of the slot, NULL if the message is dropped.
+ * @note None.
+ */
+static uint8_t *queue_rx_alloc ( void *arg, canfd6_mcan_rx_header_t *header, uint8_t data_len );
+
+/**
+ * @brief CAN FD 6 RX adapter commit function.
+ * @details This function publishes the slot filled by #queue_rx_alloc.
+ * @param[in] arg : RX adapter state.
+ * @return Nothing.
+ * @note None.
+ */
+static void queue_rx_commit ( void *arg );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+err_t canfd6_ring_init ( canfd6_ring_t *ring, canfd6_frame_t *buf, uint16_t size ) {
+    if ( ( size < 2 ) || ( size & ( size - 1 ) ) ) {
+        return CANFD6_ERROR;
+    }
+
+    ring->buf = buf;
+    ring->mask = size - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+
+    return CANFD6_OK;
+}
+
+canfd6_frame_t *canfd6_ring_alloc ( canfd6_ring_t *ring ) {
+    uint16_t head = ring->head;
+
+    if ( ( ( head + 1 ) & ring->mask ) == ring->tail ) {
+        return NULL;
+    }
+
+    return &ring->buf[ head ];
+}
+
+void canfd6_ring_commit ( canfd6_ring_t *ring ) {
+    ring->head = ( ring->head + 1 ) & ring->mask;
+}
+
+canfd6_frame_t *canfd6_ring_peek ( canfd6_ring_t *ring ) {
+    uint16_t tail = ring->tail;
+
+    if ( tail == ring->head ) {
+        return NULL;
+    }
+
+    return &ring->buf[ tail ];
+}
+
+void canfd6_ring_release ( canfd6_ring_t *ring ) {
+    ring->tail = ( ring->tail + 1 ) & ring->mask;
+}
+
+uint16_t canfd6_ring_count ( canfd6_ring_t *ring ) {
+    return ( ring->head - ring->tail ) & ring->mask;
+}
+
+err_t canfd6_filter_init ( canfd6_id_filter_t *filter, uint32_t *ext_table, uint16_t ext_size ) {
+    uint16_t cnt;
+
+    if ( ( NULL != ext_table ) && ( ( 0 == ext_size ) || ( ext_size & ( ext_size - 1 ) ) ) ) {
+        return CANFD6_ERROR;
+    }
+
+    for ( cnt = 0; cnt < CANFD6_FILTER_STD_MAP_SIZE; cnt++ ) {
+        filter->std_map[ cnt ] = 0;
+    }
+
+    filter->ext_table = ext_table;
+    filter->ext_mask = 0;
+    if ( NULL != ext_table ) {
+        filter->ext_mask = ext_size - 1;
+        for ( cnt = 0; cnt < ext_size; cnt++ ) {
+            ext_table[ cnt ] = CANFD6_FILTER_EXT_EMPTY;
+        }
+    }
+
+    return CANFD6_OK;
+}
+
+err_t canfd6_filter_add ( canfd6_id_filter_t *filter, uint32_t id, uint8_t xtd ) {
+    uint16_t index;
+    uint16_t cnt;
+
+    if ( !xtd ) {
+        id &= 0x07FF;
+        filter->std_map[ id >> 3 ] |= ( uint8_t )( 1 << ( id & 0x07 ) );
+        return CANFD6_OK;
+    }
+
+    if ( NULL == filter->ext_table ) {
+        return CANFD6_ERROR;
+    }
+
+    id &= 0x1FFFFFFFul;
+    index = queue_ext_hash( filter, id );
+    for ( cnt = 0; cnt <= filter->ext_mask; cnt++ ) {
+        if ( ( filter->ext_table[ index ] == id ) || ( filter->ext_table[ index ] == CANFD6_FILTER_EXT_EMPTY ) ) {
+            filter->ext_table[ index ] = id;
+            return CANFD6_OK;
+        }
+        index = ( index + 1 ) & filter->ext_mask;
+    }
+
+    return CANFD6_ERROR;
+}
+
+uint8_t canfd6_filter_match ( canfd6_id_filter_t *filter, uint32_t id, uint8_t xtd ) {
+    uint16_t index;
+    uint16_t cnt;
+
+    if ( !xtd ) {
+        id &= 0x07FF;
+        return ( filter->std_map[ id >> 3 ] >> ( id & 0x07 ) ) & 0x01;
+    }
+
+    if ( NULL == filter->ext_table ) {
+        return 0;
+    }
+
+    id &= 0x1FFFFFFFul;
+    index = queue_ext_hash( filter, id );
+    for ( cnt = 0; cnt <= filter->ext_mask; cnt++ ) {
+        if ( filter->ext_table[ index ] == id ) {
+            return 1;
+        }
+        if ( filter->ext_table[ index ] == CANFD6_FILTER_EXT_EMPTY ) {
+            return 0;
+        }
+        index = ( index + 1 ) & filter->ext_mask;
+    }
+
+    return 0;
+}
+
+uint8_t canfd6_frame_len_to_dlc ( uint8_t len ) {
+    static const uint8_t lookup[ 7 ] = { 12, 16, 20, 24, 32, 48, 64 };
+    uint8_t dlc;
+
+    if ( len < 9 ) {
+        return len;
+    }
+
+    for ( dlc = 0; dlc < 6; dlc++ ) {
+        if ( len <= lookup[ dlc ] ) {
+            break;
+        }
+    }
+
+    return dlc + 9;
+}
+
+uint8_t canfd6_queue_rx_service ( canfd6_t *ctx, canfd6_mcan_fifo_enum_t fifo_def,
+                                  canfd6_ring_t *ring, canfd6_id_filter_t *filter ) {
+    canfd6_mcan_rx_sink_t sink;
+    queue_rx_arg_t rx_arg;
+    uint8_t num_frames;
+
+    rx_arg.ring = ring;
+    rx_arg.filter = filter;
+    rx_arg.queued = 0;
+    sink.alloc = queue_rx_alloc;
+    sink.commit = queue_rx_commit;
+    sink.arg = &rx_arg;
+
+    do {
+        num_frames = canfd6_mcan_drain_fifo_sink( ctx, fifo_def, &sink, CANFD6_QUEUE_RX_BATCH );
+    } while ( CANFD6_QUEUE_RX_BATCH == num_frames );
+
+    return rx_arg.queued;
+}
+
+uint8_t canfd6_queue_tx_service ( canfd6_t *ctx, canfd6_ring_t *ring ) {
+    uint8_t buf_index[ QUEUE_TX_MAX_BUFS ];
+    canfd6_mcan_tx_header_t header;
+    canfd6_frame_t *frame;
+    uint32_t buf_mask = 0;
+    uint32_t buf_bit;
+    uint8_t num_bufs;
+    uint8_t cnt;
+
+    if ( 0 == canfd6_ring_count( ring ) ) {
+        return 0;
+    }
+
+    num_bufs = canfd6_mcan_read_txqueue_free( ctx, buf_index, QUEUE_TX_MAX_BUFS );
+    for ( cnt = 0; cnt < num_bufs; cnt++ ) {
+        frame = canfd6_ring_peek( ring );
+        if ( NULL == frame ) {
+            break;
+        }
+
+        header.ID = frame->id;
+        header.XTD = ( frame->flags & CANFD6_FRAME_FLAG_XTD ) ? 1 : 0;
+        header.RTR = ( frame->flags & CANFD6_FRAME_FLAG_RTR ) ? 1 : 0;
+        header.FDF = ( frame->flags & CANFD6_FRAME_FLAG_FDF ) ? 1 : 0;
+        header.BRS = ( frame->flags & CANFD6_FRAME_FLAG_BRS ) ? 1 : 0;
+        header.ESI = ( frame->flags & CANFD6_FRAME_FLAG_ESI ) ? 1 : 0;
+        header.DLC = canfd6_frame_len_to_dlc( frame->len );
+        header.EFC = 0;
+        header.MM = 0;
+
+        buf_bit = canfd6_mcan_write_txbuffer( ctx, buf_index[ cnt ], &header, frame->data );
+        if ( 0 == buf_bit ) {
+            break;
+        }
+
+        buf_mask |= buf_bit;
+        canfd6_ring_release( ring );
+    }
+
+    if ( buf_mask ) {
+        canfd6_mcan_transmit_buffers( ctx, buf_mask );
+    }
+
+    return cnt;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint16_t queue_ext_hash ( canfd6_id_filter_t *filter, uint32_t id ) {
+    return ( uint16_t )( ( uint32_t )( id * QUEUE_HASH_MULTIPLIER ) >> 16 ) & filter->ext_mask;
+}
+
+static uint8_t *queue_rx_alloc ( void *arg, canfd6_mcan_rx_header_t *header, uint8_t data_len ) {
+    queue_rx_arg_t *rx_arg = ( queue_rx_arg_t * )arg;
+    canfd6_frame_t *frame;
+
+    if ( ( NULL != rx_arg->filter ) && !canfd6_filter_match( rx_arg->filter, header->ID, header->XTD ) ) {
+        return NULL;
+    }
+
+    frame = canfd6_ring_alloc( rx_arg->ring );
+    if ( NULL == frame ) {
+        rx_arg->ring->dropped++;
+        return NULL;
+    }
+
+    frame->id = header->ID;
+    frame->timestamp = header->RXTS;
+    frame->flags = ( header->XTD ? CANFD6_FRAME_FLAG_XTD : 0 ) |
+                   ( header->RTR ? CANFD6_FRAME_FLAG_RTR : 0 ) |
+                   ( header->FDF ? CANFD6_FRAME_FLAG_FDF : 0 ) |
+                   ( header->BRS ? CANFD6_FRAME_FLAG_BRS : 0 ) |
+                   ( header->ESI ? CANFD6_FRAME_FLAG_ESI : 0 );
+    frame->len = data_len;
+
+    return frame->data;
+}
+
+static void queue_rx_commit ( void *arg ) {
+    queue_rx_arg_t *rx_arg = ( queue_rx_arg_t * )arg;
+
+    canfd6_ring_commit( rx_arg->ring );
+    rx_arg->queued++;
+}
+
+// ------------------------------------------------------------------------ END
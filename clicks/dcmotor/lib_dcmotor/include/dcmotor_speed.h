@@ -0,0 +1,197 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ * \brief This file contains the speed measurement and control used with DC Motor Click driver.
+ *
+ * The speed sensor edges, hall or encoder output, are timestamped by the
+ * application, from an input capture interrupt or from an external interrupt
+ * reading a free running timer. The speed is computed from the sum of the last
+ * periods, so one edge is enough for a new value and no edges are counted in
+ * the main loop. An integer PI controller turns the speed error into the PWM
+ * duty cycle.
+ *
+ * \addtogroup dcmotor DC MOTOR  Click Driver
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef DCMOTOR_SPEED_H
+#define DCMOTOR_SPEED_H
+
+#include "dcmotor.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup speed_macros Speed macros
+ * \{
+ */
+
+/**
+ * \defgroup speed_settings Speed settings
+ * \{
+ */
+#define DCMOTOR_SPEED_WINDOW                    8
+#define DCMOTOR_SPEED_DUTY_MAX                  1000
+#define DCMOTOR_SPEED_DEFAULT_KP                64
+#define DCMOTOR_SPEED_DEFAULT_KI                8
+/** \} */
+
+/** \} */ // End group speed_macros
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup speed_type Speed types
+ * \{
+ */
+
+/**
+ * @brief Speed measurement and control definition.
+ */
+typedef struct
+{
+    dcmotor_t *ctx;                     /**< DC Motor Click object. */
+    uint32_t timer_hz;                  /**< Frequency of the edge timestamps. */
+    uint8_t edges_per_rev;              /**< Edges per revolution. */
+    uint32_t stall_ticks;               /**< Time without edges to report a stall. */
+
+    uint32_t period[ DCMOTOR_SPEED_WINDOW ];  /**< Last periods in timer ticks. */
+    uint8_t index;                      /**< Oldest period. */
+    volatile uint8_t count;             /**< Periods in the window. */
+    volatile uint32_t sum;              /**< Sum of the periods in the window. */
+    volatile uint32_t last_edge;        /**< Timestamp of the last edge. */
+    volatile uint8_t started;           /**< At least one edge seen. */
+    volatile uint16_t seq;              /**< Incremented on every edge. */
+
+    uint32_t target_rpm;                /**< Speed setpoint, zero turns the motor off. */
+    uint16_t kp;                        /**< Proportional gain in duty permille per rpm, Q8. */
+    uint16_t ki;                        /**< Integral gain in duty permille per rpm and update, Q8. */
+    int32_t integral;                   /**< Integral term in duty permille, Q8. */
+    uint16_t duty;                      /**< Duty cycle in permille. */
+
+} dcmotor_speed_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+/**
+ * \defgroup speed_function Speed function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Speed initialization function.
+ *
+ * @param speed          Speed object.
+ * @param ctx            Initialized DC Motor Click object.
+ * @param timer_hz       Frequency of the timer the edges are timestamped with.
+ * @param edges_per_rev  Edges per revolution, e.g. number of poles of the hall sensor output.
+ * @param stall_ms       Time without edges after which the motor is stalled.
+ *
+ * @details This function initializes the measurement and the controller with the
+ * default gains and zero target.
+ */
+void dcmotor_speed_init ( dcmotor_speed_t *speed, dcmotor_t *ctx, uint32_t timer_hz, 
+                          uint8_t edges_per_rev, uint16_t stall_ms );
+
+/**
+ * @brief Speed edge function.
+ *
+ * @param speed          Speed object.
+ * @param timestamp      Timer value at the edge.
+ *
+ * @details This function records an edge of the speed sensor output. Call it
+ * from the input capture or external interrupt, the timer may wrap around.
+ */
+void dcmotor_speed_edge ( dcmotor_speed_t *speed, uint32_t timestamp );
+
+/**
+ * @brief Get speed function.
+ *
+ * @param speed          Speed object.
+ * @param now            Current timer value.
+ *
+ * @returns Speed in rpm, zero when stalled.
+ *
+ * @details This function computes the speed from the periods in the window. While
+ * the next edge is late, the speed is limited by the time since the last edge, so
+ * slowing down shows before the edge arrives.
+ */
+uint32_t dcmotor_speed_get_rpm ( dcmotor_speed_t *speed, uint32_t now );
+
+/**
+ * @brief Stall check function.
+ *
+ * @param speed          Speed object.
+ * @param now            Current timer value.
+ *
+ * @returns 1 if no edge came within the stall time, 0 otherwise.
+ */
+uint8_t dcmotor_speed_is_stalled ( dcmotor_speed_t *speed, uint32_t now );
+
+/**
+ * @brief Set gains function.
+ *
+ * @param speed          Speed object.
+ * @param kp             Proportional gain in duty permille per rpm, Q8.
+ * @param ki             Integral gain in duty permille per rpm and update, Q8.
+ *
+ * @details This function sets the gains of the PI controller.
+ */
+void dcmotor_speed_set_gains ( dcmotor_speed_t *speed, uint16_t kp, uint16_t ki );
+
+/**
+ * @brief Set target function.
+ *
+ * @param speed          Speed object.
+ * @param rpm            Speed setpoint, zero turns the motor off.
+ *
+ * @details This function sets the speed the controller regulates to.
+ */
+void dcmotor_speed_set_target ( dcmotor_speed_t *speed, uint32_t rpm );
+
+/**
+ * @brief Speed update function.
+ *
+ * @param speed          Speed object.
+ * @param now            Current timer value.
+ *
+ * @details This function runs one step of the PI controller and writes the duty cycle
+ * with dcmotor_set_duty_cycle() when it changed. Call it at a fixed rate from the
+ * main loop, e.g. every 10 ms.
+ * @note A motor at standstill is stalled, the integral term raises the duty cycle
+ * until it starts. Check dcmotor_speed_is_stalled() to detect a blocked rotor.
+ */
+void dcmotor_speed_update ( dcmotor_speed_t *speed, uint32_t now );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _DCMOTOR_SPEED_H_
+
+/** \} */ // End speed_function group
+/*! @} */
+// ------------------------------------------------------------------------- END
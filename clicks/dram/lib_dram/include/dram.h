@@ -104,6 +104,20 @@ extern "C"{
  */
 #define DRAM_MANUFACTURER_ID            0x0D
 
+/**
+ * @brief DRAM burst page size.
+ * @details Specified burst page sizes of DRAM Click driver for Linear Burst (1K page)
+ * and Wrap 32 boundary settings.
+ */
+#define DRAM_PAGE_SIZE_LINEAR           1024
+#define DRAM_PAGE_SIZE_WRAP32           32
+
+/**
+ * @brief DRAM memory pool default alignment.
+ * @details Specified default allocation alignment of DRAM memory pool.
+ */
+#define DRAM_POOL_DEFAULT_ALIGN         4
+
 /**
  * @brief Data sample selection.
  * @details This macro sets data samples for SPI modules.
@@ -157,6 +171,8 @@ typedef struct
 
     pin_name_t   chip_select;   /**< Chip select pin descriptor (used for SPI driver). */
 
+    uint16_t     page_size;     /**< Current burst page size (depends on wrap boundary setting). */
+
 } dram_t;
 
 /**
@@ -193,6 +209,33 @@ typedef enum
 
 } dram_return_value_t;
 
+/**
+ * @brief DRAM Click memory pool object.
+ * @details Arena allocator object definition of DRAM Click driver, used for
+ * placing large buffers into the external memory.
+ */
+typedef struct
+{
+    uint32_t base;              /**< Starting memory address of the pool. */
+    uint32_t size;              /**< Pool size in bytes. */
+    uint32_t offset;            /**< Offset of the first free byte from the pool base. */
+
+} dram_pool_t;
+
+/**
+ * @brief DRAM Click write-combining buffer object.
+ * @details Write-combining buffer object definition of DRAM Click driver.
+ * Adjacent small writes are merged in the RAM buffer and flushed as a single burst.
+ */
+typedef struct
+{
+    uint8_t  *buf;              /**< User provided buffer for write combining. */
+    uint16_t buf_size;          /**< Size of the user provided buffer. */
+    uint32_t address;           /**< Starting memory address of buffered data. */
+    uint16_t len;               /**< Number of buffered data bytes. */
+
+} dram_wc_t;
+
 /*!
  * @addtogroup dram DRAM Click Driver
  * @brief API for configuring and manipulating DRAM Click driver.
@@ -347,6 +390,158 @@ void dram_set_io3_pin ( dram_t *ctx, uint8_t state );
  */
 void dram_set_io2_pin ( dram_t *ctx, uint8_t state );
 
+/**
+ * @brief DRAM burst write function.
+ * @details This function writes a desired number of data bytes starting from the
+ * selected memory address, splitting the transfer into bursts which do not cross
+ * the current page (wrap) boundary.
+ * @param[in] ctx : Click context object.
+ * See #dram_t object definition for detailed explanation.
+ * @param[in] address : Starting memory address [0x00000-0x7FFFFF].
+ * @param[in] data_in : Data to be written.
+ * @param[in] len : Number of data bytes.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t dram_burst_write ( dram_t *ctx, uint32_t address, uint8_t *data_in, uint32_t len );
+
+/**
+ * @brief DRAM burst read function.
+ * @details This function reads a desired number of data bytes starting from the
+ * selected memory address using the fast read feature, splitting the transfer into
+ * bursts which do not cross the current page (wrap) boundary.
+ * @param[in] ctx : Click context object.
+ * See #dram_t object definition for detailed explanation.
+ * @param[in] address : Starting memory address [0x00000-0x7FFFFF].
+ * @param[out] data_out : Read data output.
+ * @param[in] len : Number of data bytes.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t dram_burst_read ( dram_t *ctx, uint32_t address, uint8_t *data_out, uint32_t len );
+
+/**
+ * @brief DRAM memory pool init function.
+ * @details This function initializes the memory pool object which covers
+ * the selected external memory region.
+ * @param[out] pool : Memory pool object.
+ * See #dram_pool_t object definition for detailed explanation.
+ * @param[in] base : Starting memory address of the pool.
+ * @param[in] size : Pool size in bytes.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The pool end is bounded the same way as the burst functions, so every
+ * region allocated from it can be passed to them.
+ */
+err_t dram_pool_init ( dram_pool_t *pool, uint32_t base, uint32_t size );
+
+/**
+ * @brief DRAM memory pool allocate function.
+ * @details This function reserves a block of the external memory from the pool.
+ * @param[in] pool : Memory pool object.
+ * See #dram_pool_t object definition for detailed explanation.
+ * @param[in] len : Number of bytes to reserve.
+ * @param[in] align : Address alignment, must be a power of two (0 for default alignment).
+ * @param[out] address : Starting memory address of the reserved block.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Blocks are released in LIFO order by using #dram_pool_release.
+ */
+err_t dram_pool_alloc ( dram_pool_t *pool, uint32_t len, uint32_t align, uint32_t *address );
+
+/**
+ * @brief DRAM memory pool get mark function.
+ * @details This function returns the current pool fill level which can later be
+ * used for releasing all blocks allocated after this point.
+ * @param[in] pool : Memory pool object.
+ * See #dram_pool_t object definition for detailed explanation.
+ * @return Current pool mark.
+ * @note None.
+ */
+uint32_t dram_pool_get_mark ( dram_pool_t *pool );
+
+/**
+ * @brief DRAM memory pool release function.
+ * @details This function releases all blocks allocated after the selected pool mark.
+ * @param[in] pool : Memory pool object.
+ * See #dram_pool_t object definition for detailed explanation.
+ * @param[in] mark : Pool mark returned by #dram_pool_get_mark (0 releases the whole pool).
+ * @return None.
+ * @note None.
+ */
+void dram_pool_release ( dram_pool_t *pool, uint32_t mark );
+
+/**
+ * @brief DRAM write-combining buffer init function.
+ * @details This function initializes the write-combining buffer object.
+ * @param[out] wc : Write-combining buffer object.
+ * See #dram_wc_t object definition for detailed explanation.
+ * @param[in] buf : User provided buffer.
+ * @param[in] buf_size : Size of the user provided buffer, usually the device page size.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t dram_wc_init ( dram_wc_t *wc, uint8_t *buf, uint16_t buf_size );
+
+/**
+ * @brief DRAM write-combining write function.
+ * @details This function stores data into the write-combining buffer. Writes adjacent
+ * to the buffered data within the same page are merged, otherwise the buffer is flushed
+ * first. Chunks larger than the buffer are written directly.
+ * @param[in] ctx : Click context object.
+ * See #dram_t object definition for detailed explanation.
+ * @param[in] wc : Write-combining buffer object.
+ * See #dram_wc_t object definition for detailed explanation.
+ * @param[in] address : Starting memory address [0x00000-0x7FFFFF].
+ * @param[in] data_in : Data to be written.
+ * @param[in] len : Number of data bytes.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t dram_wc_write ( dram_t *ctx, dram_wc_t *wc, uint32_t address, uint8_t *data_in, uint32_t len );
+
+/**
+ * @brief DRAM write-combining flush function.
+ * @details This function writes all buffered data to the memory in a single burst.
+ * @param[in] ctx : Click context object.
+ * See #dram_t object definition for detailed explanation.
+ * @param[in] wc : Write-combining buffer object.
+ * See #dram_wc_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t dram_wc_flush ( dram_t *ctx, dram_wc_t *wc );
+
+/**
+ * @brief DRAM write-combining read function.
+ * @details This function flushes the write-combining buffer if it overlaps the requested
+ * range and then reads a desired number of data bytes by using #dram_burst_read.
+ * @param[in] ctx : Click context object.
+ * See #dram_t object definition for detailed explanation.
+ * @param[in] wc : Write-combining buffer object.
+ * See #dram_wc_t object definition for detailed explanation.
+ * @param[in] address : Starting memory address [0x00000-0x7FFFFF].
+ * @param[out] data_out : Read data output.
+ * @param[in] len : Number of data bytes.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t dram_wc_read ( dram_t *ctx, dram_wc_t *wc, uint32_t address, uint8_t *data_out, uint32_t len );
+
 #ifdef __cplusplus
 }
 #endif
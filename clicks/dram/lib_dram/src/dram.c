@@ -26,6 +26,7 @@
  */
 
 #include "dram.h"
+#include "string.h"
 
 /**
  * @brief Dummy data.
@@ -87,13 +88,15 @@ err_t dram_init ( dram_t *ctx, dram_cfg_t *cfg )
 
     digital_out_low ( &ctx->io3 );
     digital_out_low ( &ctx->io2 );
+
+    ctx->page_size = DRAM_PAGE_SIZE_LINEAR;
     
     return SPI_MASTER_SUCCESS;
 }
 
 err_t dram_memory_write ( dram_t *ctx, uint32_t address, uint8_t *data_in, uint32_t len )
 {
-    if ( ( NULL == data_in ) || ( ( address + len ) > DRAM_MAX_ADDRESS ) )
+    if ( ( NULL == data_in ) || ( ( address + len ) > ( DRAM_MAX_ADDRESS + 1 ) ) )
     {
         return DRAM_ERROR;
     }
@@ -111,7 +114,7 @@ err_t dram_memory_write ( dram_t *ctx, uint32_t address, uint8_t *data_in, uint3
 
 err_t dram_memory_read ( dram_t *ctx, uint32_t address, uint8_t *data_out, uint32_t len )
 {
-    if ( ( NULL == data_out ) || ( ( address + len ) > DRAM_MAX_ADDRESS ) )
+    if ( ( NULL == data_out ) || ( ( address + len ) > ( DRAM_MAX_ADDRESS + 1 ) ) )
     {
         return DRAM_ERROR;
     }
@@ -129,7 +132,7 @@ err_t dram_memory_read ( dram_t *ctx, uint32_t address, uint8_t *data_out, uint3
 
 err_t dram_memory_read_fast ( dram_t *ctx, uint32_t address, uint8_t *data_out, uint32_t len )
 {
-    if ( ( NULL == data_out ) || ( ( address + len ) > DRAM_MAX_ADDRESS ) )
+    if ( ( NULL == data_out ) || ( ( address + len ) > ( DRAM_MAX_ADDRESS + 1 ) ) )
     {
         return DRAM_ERROR;
     }
@@ -157,6 +160,7 @@ err_t dram_reset ( dram_t *ctx )
     spi_master_select_device( ctx->chip_select );
     error_flag |= spi_master_write( &ctx->spi, &cmd, 1 );
     spi_master_deselect_device( ctx->chip_select );
+    ctx->page_size = DRAM_PAGE_SIZE_LINEAR;
     return error_flag;
 }
 
@@ -166,6 +170,17 @@ err_t dram_toggle_wrap_boundary ( dram_t *ctx )
     spi_master_select_device( ctx->chip_select );
     err_t error_flag = spi_master_write( &ctx->spi, &cmd, 1 );
     spi_master_deselect_device( ctx->chip_select );
+    if ( DRAM_OK == error_flag )
+    {
+        if ( DRAM_PAGE_SIZE_LINEAR == ctx->page_size )
+        {
+            ctx->page_size = DRAM_PAGE_SIZE_WRAP32;
+        }
+        else
+        {
+            ctx->page_size = DRAM_PAGE_SIZE_LINEAR;
+        }
+    }
     return error_flag;
 }
 
@@ -210,4 +225,176 @@ void dram_set_io2_pin ( dram_t *ctx, uint8_t state )
     digital_out_write ( &ctx->io2, state );
 }
 
+err_t dram_burst_write ( dram_t *ctx, uint32_t address, uint8_t *data_in, uint32_t len )
+{
+    if ( ( NULL == data_in ) || ( ( address + len ) > ( DRAM_MAX_ADDRESS + 1 ) ) )
+    {
+        return DRAM_ERROR;
+    }
+    err_t error_flag = DRAM_OK;
+    while ( len > 0 )
+    {
+        uint32_t chunk = ctx->page_size - ( address & ( ctx->page_size - 1 ) );
+        if ( chunk > len )
+        {
+            chunk = len;
+        }
+        error_flag |= dram_memory_write ( ctx, address, data_in, chunk );
+        address += chunk;
+        data_in += chunk;
+        len -= chunk;
+    }
+    return error_flag;
+}
+
+err_t dram_burst_read ( dram_t *ctx, uint32_t address, uint8_t *data_out, uint32_t len )
+{
+    if ( ( NULL == data_out ) || ( ( address + len ) > ( DRAM_MAX_ADDRESS + 1 ) ) )
+    {
+        return DRAM_ERROR;
+    }
+    err_t error_flag = DRAM_OK;
+    while ( len > 0 )
+    {
+        uint32_t chunk = ctx->page_size - ( address & ( ctx->page_size - 1 ) );
+        if ( chunk > len )
+        {
+            chunk = len;
+        }
+        error_flag |= dram_memory_read_fast ( ctx, address, data_out, chunk );
+        address += chunk;
+        data_out += chunk;
+        len -= chunk;
+    }
+    return error_flag;
+}
+
+err_t dram_pool_init ( dram_pool_t *pool, uint32_t base, uint32_t size )
+{
+    if ( ( NULL == pool ) || ( 0 == size ) || ( size > ( DRAM_MAX_ADDRESS + 1 ) ) || ( ( base + size ) > ( DRAM_MAX_ADDRESS + 1 ) ) )
+    {
+        return DRAM_ERROR;
+    }
+    pool->base = base;
+    pool->size = size;
+    pool->offset = 0;
+    return DRAM_OK;
+}
+
+err_t dram_pool_alloc ( dram_pool_t *pool, uint32_t len, uint32_t align, uint32_t *address )
+{
+    if ( ( NULL == pool ) || ( NULL == address ) || ( 0 == len ) )
+    {
+        return DRAM_ERROR;
+    }
+    if ( 0 == align )
+    {
+        align = DRAM_POOL_DEFAULT_ALIGN;
+    }
+    if ( align & ( align - 1 ) )
+    {
+        return DRAM_ERROR;
+    }
+    uint32_t start = ( pool->base + pool->offset + align - 1 ) & ~( align - 1 );
+    uint32_t offset = start - pool->base;
+    if ( ( offset > pool->size ) || ( len > ( pool->size - offset ) ) )
+    {
+        return DRAM_ERROR;
+    }
+    pool->offset = offset + len;
+    *address = start;
+    return DRAM_OK;
+}
+
+uint32_t dram_pool_get_mark ( dram_pool_t *pool )
+{
+    return pool->offset;
+}
+
+void dram_pool_release ( dram_pool_t *pool, uint32_t mark )
+{
+    if ( mark < pool->offset )
+    {
+        pool->offset = mark;
+    }
+}
+
+err_t dram_wc_init ( dram_wc_t *wc, uint8_t *buf, uint16_t buf_size )
+{
+    if ( ( NULL == wc ) || ( NULL == buf ) || ( 0 == buf_size ) )
+    {
+        return DRAM_ERROR;
+    }
+    wc->buf = buf;
+    wc->buf_size = buf_size;
+    wc->address = DRAM_MIN_ADDRESS;
+    wc->len = 0;
+    return DRAM_OK;
+}
+
+err_t dram_wc_write ( dram_t *ctx, dram_wc_t *wc, uint32_t address, uint8_t *data_in, uint32_t len )
+{
+    if ( ( NULL == data_in ) || ( ( address + len ) > ( DRAM_MAX_ADDRESS + 1 ) ) )
+    {
+        return DRAM_ERROR;
+    }
+    uint32_t page_mask = ~( ( uint32_t ) ctx->page_size - 1 );
+    err_t error_flag = DRAM_OK;
+    while ( len > 0 )
+    {
+        uint32_t chunk = ctx->page_size - ( address & ( ctx->page_size - 1 ) );
+        if ( chunk > len )
+        {
+            chunk = len;
+        }
+        if ( ( wc->len > 0 ) && 
+             ( ( address != ( wc->address + wc->len ) ) || 
+               ( ( address & page_mask ) != ( wc->address & page_mask ) ) || 
+               ( ( wc->len + chunk ) > wc->buf_size ) ) )
+        {
+            error_flag |= dram_wc_flush ( ctx, wc );
+        }
+        if ( ( 0 == wc->len ) && ( chunk >= wc->buf_size ) )
+        {
+            error_flag |= dram_memory_write ( ctx, address, data_in, chunk );
+        }
+        else
+        {
+            if ( 0 == wc->len )
+            {
+                wc->address = address;
+            }
+            memcpy ( &wc->buf[ wc->len ], data_in, chunk );
+            wc->len += chunk;
+        }
+        address += chunk;
+        data_in += chunk;
+        len -= chunk;
+    }
+    return error_flag;
+}
+
+err_t dram_wc_flush ( dram_t *ctx, dram_wc_t *wc )
+{
+    if ( 0 == wc->len )
+    {
+        return DRAM_OK;
+    }
+    err_t error_flag = dram_memory_write ( ctx, wc->address, wc->buf, wc->len );
+    wc->len = 0;
+    return error_flag;
+}
+
+err_t dram_wc_read ( dram_t *ctx, dram_wc_t *wc, uint32_t address, uint8_t *data_out, uint32_t len )
+{
+    if ( ( wc->len > 0 ) && ( address < ( wc->address + wc->len ) ) && ( wc->address < ( address + len ) ) )
+    {
+        if ( DRAM_OK != dram_wc_flush ( ctx, wc ) )
+        {
+            return DRAM_ERROR;
+        }
+    }
+    return dram_burst_read ( ctx, address, data_out, len );
+}
+
 // ------------------------------------------------------------------------- END
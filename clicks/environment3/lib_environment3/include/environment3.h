@@ -160,6 +160,12 @@ extern "C"{
 #define ENVIRONMENT3_W_DEFINE_OP_MODE       1
 #define ENVIRONMENT3_W_NO_NEW_DATA          2
 
+/**
+ * @brief Environment 3 snapshot settings.
+ * @details Time waited on the new data flag after the expected measurement time.
+ */
+#define ENVIRONMENT3_SNAPSHOT_TIMEOUT_MS    200
+
 /**
  * @brief Environment 3 register mask summary.
  * @details The list of register masks.
@@ -395,6 +401,20 @@ typedef struct
     
 } environment3_field_data_t;
 
+/**
+ * @brief Environment 3 snapshot data structure.
+ * @details All channels of a single forced measurement, compensated with integer arithmetic.
+ */
+typedef struct
+{
+    uint8_t status;             /**< New data, gas valid and heater stable flags. */
+    int16_t temperature;        /**< Temperature in 0.01 degC. */
+    uint32_t pressure;          /**< Pressure in Pa. */
+    uint32_t humidity;          /**< Relative humidity in 0.001 %. */
+    uint32_t gas_resistance;    /**< Gas resistance in Ohms, valid only with ENVIRONMENT3_GASM_VALID_MASK set in status. */
+    
+} environment3_snapshot_t;
+
 /**
  * @brief Environment 3 calibration data structure.
  * @details Calibration data structure definition.
@@ -739,6 +759,76 @@ float environment3_get_pressure ( environment3_t *ctx );
  */
 float environment3_get_gas_resistance ( environment3_t *ctx );
 
+/**
+ * @brief Environment 3 start measurement function.
+ * @details This function triggers a single forced measurement and returns without waiting.
+ * @param[in] ctx : Click context object.
+ * See #environment3_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *         @li @c -2 - Communication fail.
+ * @note The result is read by #environment3_read_snapshot once #environment3_get_measurement_time
+ * has elapsed, so conversions of several sensors on the same bus can overlap.
+ */
+int8_t environment3_start_measurement ( environment3_t *ctx );
+
+/**
+ * @brief Environment 3 get measurement time function.
+ * @details This function calculates the duration of a forced measurement from the current
+ * oversampling and heater settings.
+ * @param[in] ctx : Click context object.
+ * See #environment3_t object definition for detailed explanation.
+ * @return Measurement time in milliseconds.
+ * @note None.
+ */
+uint16_t environment3_get_measurement_time ( environment3_t *ctx );
+
+/**
+ * @brief Environment 3 read snapshot function.
+ * @details This function reads the result of the measurement started by
+ * #environment3_start_measurement without waiting. The compensation is done with integer arithmetic only.
+ * @param[in] ctx : Click context object.
+ * See #environment3_t object definition for detailed explanation.
+ * @param[out] snapshot : Snapshot data.
+ * See #environment3_snapshot_t object definition for detailed explanation.
+ * @return @li @c  2 - No new data, conversion still running.
+ *         @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *         @li @c -2 - Null pointer.
+ * @note None.
+ */
+int8_t environment3_read_snapshot ( environment3_t *ctx, environment3_snapshot_t *snapshot );
+
+/**
+ * @brief Environment 3 get snapshot function.
+ * @details This function triggers a single forced measurement, waits for the conversion to finish
+ * and reads all channels in one burst. The compensation is done with integer arithmetic only.
+ * @param[in] ctx : Click context object.
+ * See #environment3_t object definition for detailed explanation.
+ * @param[out] snapshot : Snapshot data.
+ * See #environment3_snapshot_t object definition for detailed explanation.
+ * @return @li @c  2 - No new data.
+ *         @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *         @li @c -2 - Null pointer.
+ * @note Reading all four values this way costs one heater cycle instead of four.
+ */
+int8_t environment3_get_snapshot ( environment3_t *ctx, environment3_snapshot_t *snapshot );
+
+/**
+ * @brief Environment 3 snapshot to float function.
+ * @details This function converts the snapshot data to float values in the units used by
+ * #environment3_get_all_data.
+ * @param[in] snapshot : Snapshot data.
+ * See #environment3_snapshot_t object definition for detailed explanation.
+ * @param[out] temp : Temperature value in Celsius.
+ * @param[out] hum : Humidity value in Percents.
+ * @param[out] pres : Pressure value in mBar.
+ * @return Nothing.
+ * @note None.
+ */
+void environment3_snapshot_to_float ( environment3_snapshot_t *snapshot, float *temp, float *hum, float *pres );
+
 /**
  * @brief Environment 3 read data from register address function.
  * @details This function reads the desired number of data bytes starting from 
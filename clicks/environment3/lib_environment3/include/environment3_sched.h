@@ -0,0 +1,225 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file environment3_sched.h
+ * @brief This file contains measurement scheduler for Environment 3 Click Driver.
+ * @details Sensors sharing a bus are started back to back and their results are
+ * collected as each conversion becomes ready, so one polling cycle takes about the
+ * longest conversion time instead of the sum of all of them. A sensor is described
+ * by its start and read functions and its maximum conversion time, so any driver
+ * with split start and read steps can be scheduled.
+ */
+
+#ifndef ENVIRONMENT3_SCHED_H
+#define ENVIRONMENT3_SCHED_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "environment3.h"
+
+/*!
+ * @addtogroup environment3 Environment 3 Click Driver
+ * @brief API for configuring and manipulating Environment 3 Click driver.
+ * @{
+ */
+
+/**
+ * @defgroup environment3_sched Environment 3 Scheduler Settings
+ * @brief Settings for measurement scheduler of Environment 3 Click driver.
+ */
+
+/**
+ * @addtogroup environment3_sched
+ * @{
+ */
+
+/**
+ * @brief Environment 3 scheduler sensor state.
+ * @details Specified state of a scheduled sensor.
+ */
+#define ENVIRONMENT3_SCHED_IDLE                 0
+#define ENVIRONMENT3_SCHED_PENDING              1
+#define ENVIRONMENT3_SCHED_DONE                 2
+#define ENVIRONMENT3_SCHED_FAILED               3
+
+/**
+ * @brief Environment 3 scheduler read timeout.
+ * @details Time in milliseconds a sensor is polled after its maximum conversion
+ * time before it is marked as failed.
+ */
+#define ENVIRONMENT3_SCHED_READ_TIMEOUT_MS      50
+
+/*! @} */ // environment3_sched
+/*! @} */ // environment3
+
+/**
+ * @brief Environment 3 scheduler start function.
+ * @details Starts a conversion of the sensor and returns without waiting.
+ * Returns 0 on success.
+ */
+typedef int8_t ( *environment3_sched_start_t ) ( void *handle );
+
+/**
+ * @brief Environment 3 scheduler read function.
+ * @details Reads the result of the conversion into the result storage without waiting.
+ * Returns 0 once the result is read, any other value while the conversion is still running.
+ */
+typedef int8_t ( *environment3_sched_read_t ) ( void *handle, void *result );
+
+/**
+ * @brief Environment 3 scheduler sensor object.
+ * @details One sensor of Environment 3 measurement scheduler.
+ */
+typedef struct
+{
+    void *handle;                       /**< Sensor context passed to start and read functions. */
+    void *result;                       /**< Result storage passed to the read function. */
+    environment3_sched_start_t start_f; /**< Start conversion function. */
+    environment3_sched_read_t read_f;   /**< Read result function. */
+    uint16_t meas_time;                 /**< Maximum conversion time in milliseconds. */
+    uint8_t state;                      /**< Sensor state (ENVIRONMENT3_SCHED_x). */
+
+} environment3_sched_sensor_t;
+
+/**
+ * @brief Environment 3 scheduler done function.
+ * @details Called for each sensor once its result is read or it failed, in order of readiness.
+ */
+typedef void ( *environment3_sched_done_t ) ( environment3_sched_sensor_t *sensor );
+
+/**
+ * @brief Environment 3 scheduler object.
+ * @details Measurement scheduler definition of Environment 3 Click driver.
+ */
+typedef struct
+{
+    environment3_sched_sensor_t *sensor;    /**< Sensors, in bus order. */
+    uint8_t n_sensors;                  /**< Number of sensors. */
+    uint8_t pending;                    /**< Number of sensors with conversion running. */
+    uint16_t elapsed;                   /**< Time since the cycle start in milliseconds. */
+    environment3_sched_done_t done_f;   /**< Done function, may be NULL. */
+
+} environment3_sched_t;
+
+/*!
+ * @addtogroup environment3 Environment 3 Click Driver
+ * @brief API for configuring and manipulating Environment 3 Click driver.
+ * @{
+ */
+
+/**
+ * @brief Environment 3 scheduler initialization function.
+ * @details This function initializes the scheduler with the sensor table.
+ * @param[out] sched : Scheduler object.
+ * See #environment3_sched_t object definition for detailed explanation.
+ * @param[in] sensor : Sensor table.
+ * @param[in] n_sensors : Number of sensors in the table.
+ * @param[in] done_f : Done function, may be NULL.
+ * @return Nothing.
+ * @note None.
+ */
+void environment3_sched_init ( environment3_sched_t *sched, environment3_sched_sensor_t *sensor, 
+                               uint8_t n_sensors, environment3_sched_done_t done_f );
+
+/**
+ * @brief Environment 3 scheduler sensor setup function.
+ * @details This function describes one sensor of the scheduler.
+ * @param[out] sensor : Sensor object.
+ * See #environment3_sched_sensor_t object definition for detailed explanation.
+ * @param[in] handle : Sensor context.
+ * @param[in] result : Result storage.
+ * @param[in] start_f : Start conversion function.
+ * @param[in] read_f : Read result function.
+ * @param[in] meas_time : Maximum conversion time in milliseconds.
+ * @return Nothing.
+ * @note Other drivers are added with two small wrappers, e.g. for Temp&Hum 15 the start
+ * function calls temphum15_start_measurement and the read function temphum15_read_measurement,
+ * with the time from temphum15_get_measurement_time.
+ */
+void environment3_sched_sensor_setup ( environment3_sched_sensor_t *sensor, void *handle, void *result, 
+                                       environment3_sched_start_t start_f, environment3_sched_read_t read_f, 
+                                       uint16_t meas_time );
+
+/**
+ * @brief Environment 3 scheduler Environment 3 sensor setup function.
+ * @details This function describes an Environment 3 Click as a sensor of the scheduler,
+ * the result is read by #environment3_read_snapshot.
+ * @param[out] sensor : Sensor object.
+ * See #environment3_sched_sensor_t object definition for detailed explanation.
+ * @param[in] ctx : Click context object.
+ * See #environment3_t object definition for detailed explanation.
+ * @param[out] snapshot : Snapshot data storage.
+ * See #environment3_snapshot_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note The conversion time is taken from the current settings, call it again after
+ * changing the oversampling or heater settings.
+ */
+void environment3_sched_sensor_setup_env3 ( environment3_sched_sensor_t *sensor, environment3_t *ctx, 
+                                            environment3_snapshot_t *snapshot );
+
+/**
+ * @brief Environment 3 scheduler start function.
+ * @details This function starts the conversions of all sensors back to back.
+ * @param[in] sched : Scheduler object.
+ * See #environment3_sched_t object definition for detailed explanation.
+ * @return Number of sensors with conversion running.
+ * @note A sensor which fails to start is reported to the done function at once.
+ */
+uint8_t environment3_sched_start ( environment3_sched_t *sched );
+
+/**
+ * @brief Environment 3 scheduler process function.
+ * @details This function advances the cycle time and reads every sensor whose
+ * conversion time has elapsed. A sensor which is not ready yet is polled again
+ * on the next call until #ENVIRONMENT3_SCHED_READ_TIMEOUT_MS has passed.
+ * @param[in] sched : Scheduler object.
+ * See #environment3_sched_t object definition for detailed explanation.
+ * @param[in] elapsed_ms : Time since the previous call in milliseconds.
+ * @return Number of sensors with conversion running.
+ * @note Call it every millisecond from a timer or the main loop, results are collected
+ * in order of readiness with the call period resolution.
+ */
+uint8_t environment3_sched_process ( environment3_sched_t *sched, uint16_t elapsed_ms );
+
+/**
+ * @brief Environment 3 scheduler run function.
+ * @details This function runs one complete polling cycle, it starts all conversions
+ * and processes the scheduler every millisecond until all sensors are done.
+ * @param[in] sched : Scheduler object.
+ * See #environment3_sched_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, at least one sensor failed.
+ * @note None.
+ */
+int8_t environment3_sched_run ( environment3_sched_t *sched );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // ENVIRONMENT3_SCHED_H
+
+/*! @} */ // environment3
+
+// ------------------------------------------------------------------------ END
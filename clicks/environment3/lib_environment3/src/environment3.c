@@ -289,6 +289,82 @@ static float environment3_calc_gas_resistance_high ( environment3_t *ctx, uint16
  */
 static float environment3_calc_gas_resistance_low ( environment3_t *ctx, uint16_t gas_res_adc, uint8_t gas_range );
 
+/**
+ * @brief Environment 3 calculate temperature integer function.
+ * @details This function calculates temperature value from raw temperature ADC value
+ * with integer arithmetic.
+ * @param[in] ctx : Click context object.
+ * See #environment3_t object definition for detailed explanation.
+ * @param[in] temp_adc : Raw temperature ADC value.
+ * @param[out] t_fine : Fine temperature used by the humidity and pressure compensation.
+ * @return Temperature value in 0.01 Celsius.
+ * @note None.
+ */
+static int16_t environment3_calc_temperature_int ( environment3_t *ctx, uint32_t temp_adc, int32_t *t_fine );
+
+/**
+ * @brief Environment 3 calculate humidity integer function.
+ * @details This function calculates humidity value from raw humidity ADC value
+ * with integer arithmetic.
+ * @param[in] ctx : Click context object.
+ * See #environment3_t object definition for detailed explanation.
+ * @param[in] hum_adc : Raw humidity ADC value.
+ * @param[in] t_fine : Fine temperature.
+ * @return Humidity value in 0.001 Percent.
+ * @note None.
+ */
+static uint32_t environment3_calc_humidity_int ( environment3_t *ctx, uint16_t hum_adc, int32_t t_fine );
+
+/**
+ * @brief Environment 3 calculate pressure integer function.
+ * @details This function calculates pressure value from raw pressure ADC value
+ * with integer arithmetic.
+ * @param[in] ctx : Click context object.
+ * See #environment3_t object definition for detailed explanation.
+ * @param[in] pres_adc : Raw pressure ADC value.
+ * @param[in] t_fine : Fine temperature.
+ * @return Pressure value in Pascals.
+ * @note None.
+ */
+static uint32_t environment3_calc_pressure_int ( environment3_t *ctx, uint32_t pres_adc, int32_t t_fine );
+
+/**
+ * @brief Environment 3 calculate gas resistance high integer function.
+ * @details This function calculates gas resistance high value from raw gas resistance ADC value
+ * and gas range with integer arithmetic.
+ * @param[in] gas_res_adc : Raw gas resistance ADC value.
+ * @param[in] gas_range : Gas range value.
+ * @return Gas resistance value in Ohms.
+ * @note None.
+ */
+static uint32_t environment3_calc_gas_resistance_high_int ( uint16_t gas_res_adc, uint8_t gas_range );
+
+/**
+ * @brief Environment 3 calculate gas resistance low integer function.
+ * @details This function calculates gas resistance low value from raw gas resistance ADC value
+ * and gas range with integer arithmetic.
+ * @param[in] ctx : Click context object.
+ * See #environment3_t object definition for detailed explanation.
+ * @param[in] gas_res_adc : Raw gas resistance ADC value.
+ * @param[in] gas_range : Gas range value.
+ * @return Gas resistance value in Ohms.
+ * @note None.
+ */
+static uint32_t environment3_calc_gas_resistance_low_int ( environment3_t *ctx, uint16_t gas_res_adc, uint8_t gas_range );
+
+/**
+ * @brief Environment 3 multiply, shift and divide function.
+ * @details This function calculates ( ( mul_a * mul_b ) >> shift + div / 2 ) / div with
+ * 32-bit arithmetic only, the 64-bit product is kept in two 32-bit words.
+ * @param[in] mul_a : First factor.
+ * @param[in] mul_b : Second factor.
+ * @param[in] shift : Product right shift, 1 to 31.
+ * @param[in] div : Divisor, below 2^31.
+ * @return Lower 32 bits of the rounded quotient.
+ * @note None.
+ */
+static uint32_t environment3_mul_shift_div ( uint32_t mul_a, uint32_t mul_b, uint8_t shift, uint32_t div );
+
 /**
  * @brief Environment 3 read field data function.
  * @details This function reads all data from field 0.
@@ -610,6 +686,132 @@ float environment3_get_gas_resistance ( environment3_t *ctx )
     }
 }
 
+int8_t environment3_start_measurement ( environment3_t *ctx )
+{
+    return environment3_set_operating_mode( ctx, ENVIRONMENT3_MODE_FORCED );
+}
+
+uint16_t environment3_get_measurement_time ( environment3_t *ctx )
+{
+    const uint8_t os_to_meas_cycles[ 6 ] = { 0, 1, 2, 4, 8, 16 };
+    uint32_t meas_cycles = 0;
+    uint32_t meas_dur = 0;
+    
+    if ( ( ctx->tph_sett.os_temp <= ENVIRONMENT3_OS_16X ) && 
+         ( ctx->tph_sett.os_pres <= ENVIRONMENT3_OS_16X ) && 
+         ( ctx->tph_sett.os_hum <= ENVIRONMENT3_OS_16X ) )
+    {
+        meas_cycles = os_to_meas_cycles[ ctx->tph_sett.os_temp ];
+        meas_cycles += os_to_meas_cycles[ ctx->tph_sett.os_pres ];
+        meas_cycles += os_to_meas_cycles[ ctx->tph_sett.os_hum ];
+    }
+    
+    // TPH conversion, switching and gas measurement in us, rounded up to ms plus wake up
+    meas_dur = meas_cycles * 1963ul;
+    meas_dur += 477ul * 4;
+    meas_dur += 477ul * 5;
+    meas_dur = ( ( meas_dur + 500 ) / 1000 ) + 1;
+    
+    if ( ENVIRONMENT3_ENABLE == ctx->gas_sett.enable )
+    {
+        meas_dur += ctx->gas_sett.heater_dur;
+    }
+    return ( uint16_t ) meas_dur;
+}
+
+int8_t environment3_read_snapshot ( environment3_t *ctx, environment3_snapshot_t *snapshot )
+{
+    uint8_t buff[ ENVIRONMENT3_LEN_FIELD ] = { 0 };
+    uint8_t gas_reg = 0;
+    int32_t t_fine = 0;
+    int8_t error_check = 0;
+    
+    if ( 0 == snapshot )
+    {
+        return ENVIRONMENT3_E_NULL_PTR;
+    }
+    
+    // Check only the status byte while the conversion is still running
+    error_check = environment3_get_regs( ctx, ENVIRONMENT3_REG_MEAS_STATUS_FIELD_0, buff, 1 );
+    if ( ENVIRONMENT3_OK != error_check )
+    {
+        return error_check;
+    }
+    if ( !( buff[ 0 ] & ENVIRONMENT3_NEW_DATA_MASK ) )
+    {
+        return ENVIRONMENT3_W_NO_NEW_DATA;
+    }
+    
+    error_check = environment3_get_regs( ctx, ENVIRONMENT3_REG_MEAS_STATUS_FIELD_0, buff, ENVIRONMENT3_LEN_FIELD );
+    if ( ENVIRONMENT3_OK != error_check )
+    {
+        return error_check;
+    }
+    
+    if ( ENVIRONMENT3_VARIANT_GAS_HIGH == ctx->device_variant_id )
+    {
+        gas_reg = buff[ 16 ];
+        snapshot->gas_resistance = 
+            environment3_calc_gas_resistance_high_int( ( uint16_t ) ( ( ( uint16_t ) buff[ 15 ] << 2 ) | ( buff[ 16 ] >> 6 ) ), 
+                                                       buff[ 16 ] & ENVIRONMENT3_GAS_RANGE_MASK );
+    }
+    else
+    {
+        gas_reg = buff[ 14 ];
+        snapshot->gas_resistance = 
+            environment3_calc_gas_resistance_low_int( ctx, ( uint16_t ) ( ( ( uint16_t ) buff[ 13 ] << 2 ) | ( buff[ 14 ] >> 6 ) ), 
+                                                      buff[ 14 ] & ENVIRONMENT3_GAS_RANGE_MASK );
+    }
+    snapshot->status = ( buff[ 0 ] & ENVIRONMENT3_NEW_DATA_MASK ) | 
+                       ( gas_reg & ( ENVIRONMENT3_GASM_VALID_MASK | ENVIRONMENT3_HEAT_STAB_MASK ) );
+    
+    snapshot->temperature = environment3_calc_temperature_int( ctx, ( ( uint32_t ) buff[ 5 ] << 12 ) | 
+                                                                     ( ( uint32_t ) buff[ 6 ] << 4 ) | 
+                                                                     ( buff[ 7 ] >> 4 ), &t_fine );
+    snapshot->pressure = environment3_calc_pressure_int( ctx, ( ( uint32_t ) buff[ 2 ] << 12 ) | 
+                                                              ( ( uint32_t ) buff[ 3 ] << 4 ) | 
+                                                              ( buff[ 4 ] >> 4 ), t_fine );
+    snapshot->humidity = environment3_calc_humidity_int( ctx, ( ( uint16_t ) buff[ 8 ] << 8 ) | buff[ 9 ], t_fine );
+    
+    return ENVIRONMENT3_OK;
+}
+
+int8_t environment3_get_snapshot ( environment3_t *ctx, environment3_snapshot_t *snapshot )
+{
+    uint16_t timeout = ENVIRONMENT3_SNAPSHOT_TIMEOUT_MS;
+    int8_t error_check = environment3_start_measurement( ctx );
+    
+    if ( ENVIRONMENT3_OK != error_check )
+    {
+        return error_check;
+    }
+    
+    for ( uint16_t cnt = environment3_get_measurement_time( ctx ); cnt > 0; cnt-- )
+    {
+        Delay_1ms( );
+    }
+    
+    do
+    {
+        error_check = environment3_read_snapshot( ctx, snapshot );
+        if ( ENVIRONMENT3_W_NO_NEW_DATA != error_check )
+        {
+            break;
+        }
+        Delay_1ms( );
+    } while ( --timeout );
+    
+    return error_check;
+}
+
+void environment3_snapshot_to_float ( environment3_snapshot_t *snapshot, float *temp, float *hum, float *pres )
+{
+    *temp = snapshot->temperature / 100.0;
+    
+    *hum = snapshot->humidity / 1000.0;
+    
+    *pres = snapshot->pressure / 100.0;
+}
 
 int8_t environment3_get_regs ( environment3_t *ctx, uint8_t reg, uint8_t *data_out, uint16_t len )
 {
@@ -1219,6 +1421,194 @@ static float environment3_calc_gas_resistance_low ( environment3_t *ctx, uint16_
     return calc_gas_res;
 }
 
+static int16_t environment3_calc_temperature_int ( environment3_t *ctx, uint32_t temp_adc, int32_t *t_fine )
+{
+    int32_t var1;
+    int32_t var2;
+    int32_t var3;
+
+    var1 = ( ( int32_t ) temp_adc >> 3 ) - ( ( int32_t ) ctx->calib.par_t1 << 1 );
+    var2 = ( var1 * ( int32_t ) ctx->calib.par_t2 ) >> 11;
+    var3 = ( ( var1 >> 1 ) * ( var1 >> 1 ) ) >> 12;
+    var3 = ( var3 * ( ( int32_t ) ctx->calib.par_t3 << 4 ) ) >> 14;
+    *t_fine = var2 + var3;
+
+    return ( int16_t ) ( ( ( *t_fine * 5 ) + 128 ) >> 8 );
+}
+
+static uint32_t environment3_calc_humidity_int ( environment3_t *ctx, uint16_t hum_adc, int32_t t_fine )
+{
+    int32_t var1;
+    int32_t var2;
+    int32_t var3;
+    int32_t var4;
+    int32_t var5;
+    int32_t var6;
+    int32_t temp_scaled;
+    int32_t calc_hum;
+
+    temp_scaled = ( ( t_fine * 5 ) + 128 ) >> 8;
+    var1 = ( int32_t ) hum_adc - ( ( int32_t ) ctx->calib.par_h1 * 16 ) - 
+           ( ( ( temp_scaled * ( int32_t ) ctx->calib.par_h3 ) / 100 ) >> 1 );
+    var2 = ( ( int32_t ) ctx->calib.par_h2 * 
+             ( ( ( temp_scaled * ( int32_t ) ctx->calib.par_h4 ) / 100 ) + 
+               ( ( ( temp_scaled * ( ( temp_scaled * ( int32_t ) ctx->calib.par_h5 ) / 100 ) ) >> 6 ) / 100 ) + 
+               ( int32_t ) ( 1ul << 14 ) ) ) >> 10;
+    var3 = var1 * var2;
+    var4 = ( int32_t ) ctx->calib.par_h6 << 7;
+    var4 = ( var4 + ( ( temp_scaled * ( int32_t ) ctx->calib.par_h7 ) / 100 ) ) >> 4;
+    var5 = ( ( var3 >> 14 ) * ( var3 >> 14 ) ) >> 10;
+    var6 = ( var4 * var5 ) >> 1;
+    calc_hum = ( ( ( var3 + var6 ) >> 10 ) * 1000 ) >> 12;
+
+    if ( calc_hum > 100000 )
+    {
+        calc_hum = 100000;
+    }
+    else if ( calc_hum < 0 )
+    {
+        calc_hum = 0;
+    }
+    return ( uint32_t ) calc_hum;
+}
+
+static uint32_t environment3_calc_pressure_int ( environment3_t *ctx, uint32_t pres_adc, int32_t t_fine )
+{
+    int32_t var1;
+    int32_t var2;
+    int32_t var3;
+    int32_t calc_pres;
+    uint32_t pres_scaled;
+
+    var1 = ( t_fine >> 1 ) - 64000;
+    var2 = ( ( ( ( var1 >> 2 ) * ( var1 >> 2 ) ) >> 11 ) * ( int32_t ) ctx->calib.par_p6 ) >> 2;
+    var2 = var2 + ( ( var1 * ( int32_t ) ctx->calib.par_p5 ) * 2 );
+    var2 = ( var2 >> 2 ) + ( ( int32_t ) ctx->calib.par_p4 * 65536 );
+    var1 = ( ( ( ( ( var1 >> 2 ) * ( var1 >> 2 ) ) >> 13 ) * ( ( int32_t ) ctx->calib.par_p3 * 32 ) ) >> 3 ) + 
+           ( ( ( int32_t ) ctx->calib.par_p2 * var1 ) >> 1 );
+    var1 = var1 >> 18;
+    var1 = ( ( 32768 + var1 ) * ( int32_t ) ctx->calib.par_p1 ) >> 15;
+    
+    if ( var1 <= 0 )
+    {
+        return 0;
+    }
+    
+    pres_scaled = ( uint32_t ) ( ( 1048576 - ( int32_t ) pres_adc ) - ( var2 >> 12 ) ) * 3125ul;
+    
+    // Divide first on large values so the doubling does not overflow
+    if ( pres_scaled >= 0x80000000ul )
+    {
+        calc_pres = ( int32_t ) ( ( pres_scaled / ( uint32_t ) var1 ) * 2 );
+    }
+    else
+    {
+        calc_pres = ( int32_t ) ( ( pres_scaled * 2 ) / ( uint32_t ) var1 );
+    }
+    var1 = ( ( int32_t ) ctx->calib.par_p9 * ( ( ( calc_pres >> 3 ) * ( calc_pres >> 3 ) ) >> 13 ) ) >> 12;
+    var2 = ( ( calc_pres >> 2 ) * ( int32_t ) ctx->calib.par_p8 ) >> 13;
+    var3 = ( ( ( ( ( calc_pres >> 8 ) * ( calc_pres >> 8 ) ) >> 8 ) * ( calc_pres >> 8 ) * 
+             ( int32_t ) ctx->calib.par_p10 ) >> 9 );
+    calc_pres = calc_pres + ( ( var1 + var2 + var3 + ( ( int32_t ) ctx->calib.par_p7 * 128 ) ) >> 4 );
+
+    return ( uint32_t ) calc_pres;
+}
+
+static uint32_t environment3_calc_gas_resistance_high_int ( uint16_t gas_res_adc, uint8_t gas_range )
+{
+    uint32_t var1 = 262144ul >> gas_range;
+    int32_t var2 = ( int32_t ) gas_res_adc - 512;
+
+    var2 *= 3;
+    var2 += 4096;
+
+    // Vendor 32-bit variant, scaled by 10000 and then by 100 so the product fits
+    return ( ( 10000ul * var1 ) / ( uint32_t ) var2 ) * 100ul;
+}
+
+static uint32_t environment3_calc_gas_resistance_low_int ( environment3_t *ctx, uint16_t gas_res_adc, uint8_t gas_range )
+{
+    const uint32_t const_array1[ 16 ] =
+    {
+        2147483647ul, 2147483647ul, 2147483647ul, 2147483647ul, 2147483647ul, 2126008810ul, 2147483647ul, 2130303777ul,
+        2147483647ul, 2147483647ul, 2143188679ul, 2136746228ul, 2147483647ul, 2126008810ul, 2147483647ul, 2147483647ul
+    };
+    const uint32_t const_array2[ 16 ] =
+    {
+        4096000000ul, 2048000000ul, 1024000000ul, 512000000ul, 255744255ul, 127110228ul, 64000000ul, 32258064ul,
+        16016016ul, 8000000ul, 4000000ul, 2000000ul, 1000000ul, 500000ul, 250000ul, 125000ul
+    };
+    uint32_t sw_err = ( uint32_t ) ( 1340 + 5 * ( int32_t ) ctx->calib.range_sw_err );
+    uint32_t var1;
+    int32_t var2;
+
+    gas_range &= 0x0F;
+
+    // ( sw_err * const_array1 ) >> 16 from the 16-bit halves of the table value, exact in 32 bits
+    var1 = sw_err * ( const_array1[ gas_range ] >> 16 ) + 
+           ( ( sw_err * ( const_array1[ gas_range ] & 0xFFFF ) ) >> 16 );
+    var2 = ( ( int32_t ) gas_res_adc << 15 ) - 16777216l + ( int32_t ) var1;
+
+    return environment3_mul_shift_div( const_array2[ gas_range ], var1, 9, ( uint32_t ) var2 );
+}
+
+static uint32_t environment3_mul_shift_div ( uint32_t mul_a, uint32_t mul_b, uint8_t shift, uint32_t div )
+{
+    uint32_t prod_hi;
+    uint32_t prod_lo;
+    uint32_t part;
+    uint32_t rem;
+    uint32_t quot = 0;
+    uint8_t cnt;
+
+    // 64-bit product from 16-bit halves
+    prod_lo = ( mul_a & 0xFFFF ) * ( mul_b & 0xFFFF );
+    prod_hi = ( mul_a >> 16 ) * ( mul_b >> 16 );
+    part = ( mul_a >> 16 ) * ( mul_b & 0xFFFF );
+    prod_hi += part >> 16;
+    part <<= 16;
+    prod_lo += part;
+    if ( prod_lo < part )
+    {
+        prod_hi++;
+    }
+    part = ( mul_a & 0xFFFF ) * ( mul_b >> 16 );
+    prod_hi += part >> 16;
+    part <<= 16;
+    prod_lo += part;
+    if ( prod_lo < part )
+    {
+        prod_hi++;
+    }
+
+    prod_lo = ( prod_lo >> shift ) | ( prod_hi << ( 32 - shift ) );
+    prod_hi >>= shift;
+
+    // Round to nearest
+    part = div >> 1;
+    prod_lo += part;
+    if ( prod_lo < part )
+    {
+        prod_hi++;
+    }
+
+    // Upper quotient word is dropped, the remainder of the upper word is carried into the lower one
+    rem = prod_hi % div;
+    for ( cnt = 0; cnt < 32; cnt++ )
+    {
+        rem = ( rem << 1 ) | ( prod_lo >> 31 );
+        prod_lo <<= 1;
+        quot <<= 1;
+        if ( rem >= div )
+        {
+            rem -= div;
+            quot |= 1;
+        }
+    }
+
+    return quot;
+}
+
 static int8_t environment3_read_field_data ( environment3_t *ctx, environment3_field_data_t *f_data )
 {
     uint8_t buff[ ENVIRONMENT3_LEN_FIELD ] = { 0 };
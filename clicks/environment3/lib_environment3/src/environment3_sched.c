@@ -0,0 +1,197 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file environment3_sched.c
+ * @brief Environment 3 Click Measurement Scheduler.
+ */
+
+#include "environment3_sched.h"
+
+/**
+ * @brief Environment 3 scheduler finish function.
+ * @details This function sets the final state of a sensor and reports it to the done function.
+ * @param[in] sched : Scheduler object.
+ * See #environment3_sched_t object definition for detailed explanation.
+ * @param[in] sensor : Sensor object.
+ * See #environment3_sched_sensor_t object definition for detailed explanation.
+ * @param[in] state : Final sensor state.
+ * @return Nothing.
+ * @note None.
+ */
+static void environment3_sched_finish ( environment3_sched_t *sched, environment3_sched_sensor_t *sensor, 
+                                        uint8_t state );
+
+/**
+ * @brief Environment 3 scheduler Environment 3 start function.
+ * @details This function starts a forced measurement of Environment 3 Click.
+ * @param[in] handle : Click context object.
+ * @return Start measurement result.
+ * @note None.
+ */
+static int8_t environment3_sched_start_env3 ( void *handle );
+
+/**
+ * @brief Environment 3 scheduler Environment 3 read function.
+ * @details This function reads the snapshot of Environment 3 Click.
+ * @param[in] handle : Click context object.
+ * @param[out] result : Snapshot data.
+ * @return Read snapshot result.
+ * @note None.
+ */
+static int8_t environment3_sched_read_env3 ( void *handle, void *result );
+
+void environment3_sched_init ( environment3_sched_t *sched, environment3_sched_sensor_t *sensor, 
+                               uint8_t n_sensors, environment3_sched_done_t done_f )
+{
+    sched->sensor = sensor;
+    sched->n_sensors = n_sensors;
+    sched->pending = 0;
+    sched->elapsed = 0;
+    sched->done_f = done_f;
+}
+
+void environment3_sched_sensor_setup ( environment3_sched_sensor_t *sensor, void *handle, void *result, 
+                                       environment3_sched_start_t start_f, environment3_sched_read_t read_f, 
+                                       uint16_t meas_time )
+{
+    sensor->handle = handle;
+    sensor->result = result;
+    sensor->start_f = start_f;
+    sensor->read_f = read_f;
+    sensor->meas_time = meas_time;
+    sensor->state = ENVIRONMENT3_SCHED_IDLE;
+}
+
+void environment3_sched_sensor_setup_env3 ( environment3_sched_sensor_t *sensor, environment3_t *ctx, 
+                                            environment3_snapshot_t *snapshot )
+{
+    environment3_sched_sensor_setup( sensor, ctx, snapshot, &environment3_sched_start_env3, 
+                                     &environment3_sched_read_env3, 
+                                     environment3_get_measurement_time( ctx ) );
+}
+
+uint8_t environment3_sched_start ( environment3_sched_t *sched )
+{
+    environment3_sched_sensor_t *sensor = sched->sensor;
+    uint8_t cnt;
+
+    sched->pending = 0;
+    sched->elapsed = 0;
+    for ( cnt = 0; cnt < sched->n_sensors; cnt++, sensor++ )
+    {
+        sensor->state = ENVIRONMENT3_SCHED_PENDING;
+        sched->pending++;
+        if ( 0 != sensor->start_f( sensor->handle ) )
+        {
+            environment3_sched_finish( sched, sensor, ENVIRONMENT3_SCHED_FAILED );
+        }
+    }
+    return sched->pending;
+}
+
+uint8_t environment3_sched_process ( environment3_sched_t *sched, uint16_t elapsed_ms )
+{
+    environment3_sched_sensor_t *sensor = sched->sensor;
+    uint8_t cnt;
+
+    if ( 0 == sched->pending )
+    {
+        return 0;
+    }
+
+    // Saturate, pending sensors time out long before
+    if ( elapsed_ms > ( 0xFFFF - sched->elapsed ) )
+    {
+        sched->elapsed = 0xFFFF;
+    }
+    else
+    {
+        sched->elapsed += elapsed_ms;
+    }
+
+    for ( cnt = 0; cnt < sched->n_sensors; cnt++, sensor++ )
+    {
+        if ( ( ENVIRONMENT3_SCHED_PENDING != sensor->state ) || ( sched->elapsed < sensor->meas_time ) )
+        {
+            continue;
+        }
+        if ( 0 == sensor->read_f( sensor->handle, sensor->result ) )
+        {
+            environment3_sched_finish( sched, sensor, ENVIRONMENT3_SCHED_DONE );
+        }
+        else if ( ( sched->elapsed - sensor->meas_time ) >= ENVIRONMENT3_SCHED_READ_TIMEOUT_MS )
+        {
+            environment3_sched_finish( sched, sensor, ENVIRONMENT3_SCHED_FAILED );
+        }
+    }
+    return sched->pending;
+}
+
+int8_t environment3_sched_run ( environment3_sched_t *sched )
+{
+    environment3_sched_sensor_t *sensor = sched->sensor;
+    int8_t error_flag = ENVIRONMENT3_OK;
+    uint8_t pending;
+    uint8_t cnt;
+
+    environment3_sched_start( sched );
+    // Sensors with zero conversion time are read right after the start
+    pending = environment3_sched_process( sched, 0 );
+    while ( pending )
+    {
+        Delay_1ms( );
+        pending = environment3_sched_process( sched, 1 );
+    }
+
+    for ( cnt = 0; cnt < sched->n_sensors; cnt++, sensor++ )
+    {
+        if ( ENVIRONMENT3_SCHED_DONE != sensor->state )
+        {
+            error_flag = ENVIRONMENT3_ERROR;
+        }
+    }
+    return error_flag;
+}
+
+static void environment3_sched_finish ( environment3_sched_t *sched, environment3_sched_sensor_t *sensor, 
+                                        uint8_t state )
+{
+    sensor->state = state;
+    sched->pending--;
+    if ( NULL != sched->done_f )
+    {
+        sched->done_f( sensor );
+    }
+}
+
+static int8_t environment3_sched_start_env3 ( void *handle )
+{
+    return environment3_start_measurement( ( environment3_t * ) handle );
+}
+
+static int8_t environment3_sched_read_env3 ( void *handle, void *result )
+{
+    return environment3_read_snapshot( ( environment3_t * ) handle, ( environment3_snapshot_t * ) result );
+}
+
+// ------------------------------------------------------------------------ END
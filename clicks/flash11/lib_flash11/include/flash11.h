@@ -168,6 +168,12 @@ extern "C"{
 #define FLASH11_STATUS1_BSY                 0x01
 #define FLASH11_STATUS1_RDY                 0x00
 
+/**
+ * @brief Flash 11 description status register 2 bit assignments.
+ * @details Specified status register 2 bit assignments of Flash 11 Click driver.
+ */
+#define FLASH11_STATUS2_SUS                 0x80
+
 /**
  * @brief Flash 11 description manufacturer and device ID.
  * @details Specified manufacturer and device ID of Flash 11 Click driver.
@@ -183,6 +189,25 @@ extern "C"{
 #define FLASH11_MIN_ADDRESS                 0x000000
 #define FLASH11_MAX_ADDRESS                 0x3FFFFFul
 #define FLASH11_PAGE_SIZE                   256
+#define FLASH11_BLOCK_SIZE_4KB              0x001000ul
+#define FLASH11_BLOCK_SIZE_32KB             0x008000ul
+#define FLASH11_BLOCK_SIZE_64KB             0x010000ul
+
+/**
+ * @brief Flash 11 description of the background operation state.
+ * @details Specified background (non-blocking) operation state of Flash 11 Click driver.
+ */
+#define FLASH11_OP_IDLE                      0
+#define FLASH11_OP_BLOCK_ERASE               1
+#define FLASH11_OP_CHIP_ERASE                2
+#define FLASH11_OP_PAGE_PROGRAM              3
+
+/**
+ * @brief Flash 11 description of the suspend timeout.
+ * @details Specified number of 10us status polls to wait for the device to enter
+ * the suspended state (tSUS is 20us max) of Flash 11 Click driver.
+ */
+#define FLASH11_SUSPEND_TIMEOUT_10US         100
 
 /**
  * @brief Flash 11 description of the write-protection pin logic state.
@@ -236,6 +261,13 @@ extern "C"{
 /*! @} */ // flash11_map
 /*! @} */ // flash11
 
+/**
+ * @brief Flash 11 Click background operation completion callback.
+ * @details Callback called from #flash11_process_operation once the background
+ * operation (FLASH11_OP_x) started at the given memory address is completed.
+ */
+typedef void ( *flash11_op_callback_t ) ( uint8_t op, uint32_t mem_addr );
+
 /**
  * @brief Flash 11 Click context object.
  * @details Context object definition of Flash 11 Click driver.
@@ -251,6 +283,16 @@ typedef struct
 
     pin_name_t   chip_select;    /**< Chip select pin descriptor (used for SPI driver). */
 
+    // Background operation
+    uint8_t      op_state;       /**< Background operation state. */
+    uint32_t     op_addr;        /**< Background operation starting address. */
+    uint32_t     op_size;        /**< Number of bytes affected by the background operation. */
+    uint32_t     erase_addr;     /**< Next block address of the pre-erase region. */
+    uint32_t     erase_end;      /**< End address of the pre-erase region. */
+    uint8_t      wp_state;       /**< Write-protection pin state. */
+    uint8_t      op_wp_state;    /**< Write-protection pin state to restore once the operation is done. */
+    flash11_op_callback_t op_callback;  /**< Background operation completion callback. */
+
 } flash11_t;
 
 /**
@@ -608,6 +650,113 @@ void flash11_hw_write_protect ( flash11_t *ctx, uint8_t en_wp );
  */
 void flash11_en_hold ( flash11_t *ctx, uint8_t en_hold );
 
+/**
+ * @brief Flash 11 set operation callback function.
+ * @details This function sets the callback which is called once a background
+ * operation is completed.
+ * @param[in] ctx : Click context object.
+ * See #flash11_t object definition for detailed explanation.
+ * @param[in] op_callback : Completion callback (NULL to disable).
+ * @return Nothing.
+ * @note None.
+ */
+void flash11_set_op_callback ( flash11_t *ctx, flash11_op_callback_t op_callback );
+
+/**
+ * @brief Flash 11 start block erase function.
+ * @details This function starts erasing the selected memory block and returns
+ * without waiting for the erase to complete.
+ * @param[in] ctx : Click context object.
+ * See #flash11_t object definition for detailed explanation.
+ * @param[in] cmd_block_erase : Block erase command (FLASH11_CMD_BLOCK_ERASE_x).
+ * @param[in] mem_addr : Memory address inside the block.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Completion is detected by calling #flash11_process_operation.
+ */
+err_t flash11_start_block_erase ( flash11_t *ctx, uint8_t cmd_block_erase, uint32_t mem_addr );
+
+/**
+ * @brief Flash 11 start chip erase function.
+ * @details This function starts erasing the entire memory array and returns
+ * without waiting for the erase to complete.
+ * @param[in] ctx : Click context object.
+ * See #flash11_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Chip erase can not be suspended.
+ */
+err_t flash11_start_chip_erase ( flash11_t *ctx );
+
+/**
+ * @brief Flash 11 start memory write function.
+ * @details This function starts programming up to one page of data and returns
+ * without waiting for the program to complete.
+ * @param[in] ctx : Click context object.
+ * See #flash11_t object definition for detailed explanation.
+ * @param[in] mem_addr : Starting memory address.
+ * @param[in] data_in : Data to be written.
+ * @param[in] len : Number of bytes to be written (up to FLASH11_PAGE_SIZE).
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Completion is detected by calling #flash11_process_operation. Writing to a
+ * part of the pre-erase region which is not erased yet returns an error, keep calling
+ * #flash11_process_operation until the eraser has passed the selected address.
+ */
+err_t flash11_start_memory_write ( flash11_t *ctx, uint32_t mem_addr, uint8_t *data_in, uint32_t len );
+
+/**
+ * @brief Flash 11 pre-erase function.
+ * @details This function schedules the selected memory region for erasing in the
+ * background. The region is erased block by block from #flash11_process_operation
+ * whenever no other operation is in progress.
+ * @param[in] ctx : Click context object.
+ * See #flash11_t object definition for detailed explanation.
+ * @param[in] mem_addr : Starting memory address (aligned down to 4KB).
+ * @param[in] len : Number of bytes to be erased (aligned up to 4KB).
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Any previously scheduled region is replaced.
+ */
+err_t flash11_pre_erase ( flash11_t *ctx, uint32_t mem_addr, uint32_t len );
+
+/**
+ * @brief Flash 11 process operation function.
+ * @details This function checks the background operation state, calls the completion
+ * callback once the operation is done and starts the next scheduled pre-erase block.
+ * The write-protection pin is restored to the state it had before the operation was started.
+ * @param[in] ctx : Click context object.
+ * See #flash11_t object definition for detailed explanation.
+ * @param[out] op_state : Current operation state (FLASH11_OP_x), may be NULL.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Should be called periodically from the main loop or a timer task.
+ */
+err_t flash11_process_operation ( flash11_t *ctx, uint8_t *op_state );
+
+/**
+ * @brief Flash 11 memory read suspend function.
+ * @details This function reads data while a background block erase or page program
+ * is in progress by suspending the operation, reading the data and resuming the operation.
+ * @param[in] ctx : Click context object.
+ * See #flash11_t object definition for detailed explanation.
+ * @param[in] mem_addr : Starting memory address.
+ * @param[out] data_out : Read data output.
+ * @param[in] len : Number of bytes to be read.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Reading from the block being erased or programmed, or during chip erase,
+ * returns an error. An error is also returned if the device does not enter the
+ * suspended state within FLASH11_SUSPEND_TIMEOUT_10US status polls.
+ */
+err_t flash11_memory_read_suspend ( flash11_t *ctx, uint32_t mem_addr, uint8_t *data_out, uint32_t len );
+
 #ifdef __cplusplus
 }
 #endif
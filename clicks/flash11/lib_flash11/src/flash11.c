@@ -85,6 +85,15 @@ err_t flash11_init ( flash11_t *ctx, flash11_cfg_t *cfg )
     digital_out_init( &ctx->wp, cfg->wp );
     digital_out_init( &ctx->hld, cfg->hld );
 
+    ctx->op_state = FLASH11_OP_IDLE;
+    ctx->op_addr = FLASH11_MIN_ADDRESS;
+    ctx->op_size = 0;
+    ctx->erase_addr = FLASH11_MIN_ADDRESS;
+    ctx->erase_end = FLASH11_MIN_ADDRESS;
+    ctx->wp_state = FLASH11_WRITE_PROTECT_ENABLE;
+    ctx->op_wp_state = FLASH11_WRITE_PROTECT_ENABLE;
+    ctx->op_callback = NULL;
+
     return SPI_MASTER_SUCCESS;
 }
 
@@ -276,6 +285,7 @@ err_t flash11_get_device_id ( flash11_t *ctx, uint8_t *device_id )
 void flash11_hw_write_protect ( flash11_t *ctx, uint8_t en_wp )
 {
     digital_out_write( &ctx->wp, en_wp );
+    ctx->wp_state = en_wp;
 }
 
 void flash11_en_hold ( flash11_t *ctx, uint8_t en_hold )
@@ -283,4 +293,182 @@ void flash11_en_hold ( flash11_t *ctx, uint8_t en_hold )
     digital_out_write( &ctx->hld, en_hold );
 }
 
+void flash11_set_op_callback ( flash11_t *ctx, flash11_op_callback_t op_callback )
+{
+    ctx->op_callback = op_callback;
+}
+
+err_t flash11_start_block_erase ( flash11_t *ctx, uint8_t cmd_block_erase, uint32_t mem_addr )
+{
+    uint32_t block_size = 0;
+    if ( FLASH11_CMD_BLOCK_ERASE_4KB == cmd_block_erase )
+    {
+        block_size = FLASH11_BLOCK_SIZE_4KB;
+    }
+    else if ( FLASH11_CMD_BLOCK_ERASE_32KB == cmd_block_erase )
+    {
+        block_size = FLASH11_BLOCK_SIZE_32KB;
+    }
+    else if ( FLASH11_CMD_BLOCK_ERASE_64KB == cmd_block_erase )
+    {
+        block_size = FLASH11_BLOCK_SIZE_64KB;
+    }
+    if ( ( 0 == block_size ) || ( FLASH11_OP_IDLE != ctx->op_state ) || ( mem_addr > FLASH11_MAX_ADDRESS ) )
+    {
+        return FLASH11_ERROR;
+    }
+    uint8_t data_buf[ 3 ] = { 0 };
+    uint8_t wp_state = ctx->wp_state;
+    err_t err_flag = flash11_write_enable( ctx );
+    data_buf[ 0 ] = ( uint8_t ) ( ( mem_addr >> 16 ) & 0xFF );
+    data_buf[ 1 ] = ( uint8_t ) ( ( mem_addr >> 8 ) & 0xFF );
+    data_buf[ 2 ] = ( uint8_t ) ( mem_addr & 0xFF );
+    err_flag |= flash11_generic_write( ctx, cmd_block_erase, data_buf, 3 );
+    if ( FLASH11_OK == err_flag )
+    {
+        ctx->op_state = FLASH11_OP_BLOCK_ERASE;
+        ctx->op_addr = mem_addr & ~( block_size - 1 );
+        ctx->op_size = block_size;
+        ctx->op_wp_state = wp_state;
+    }
+    return err_flag;
+}
+
+err_t flash11_start_chip_erase ( flash11_t *ctx )
+{
+    if ( FLASH11_OP_IDLE != ctx->op_state )
+    {
+        return FLASH11_ERROR;
+    }
+    uint8_t wp_state = ctx->wp_state;
+    err_t err_flag = flash11_write_enable( ctx );
+    err_flag |= flash11_set_cmd( ctx, FLASH11_CMD_CHIP_ERASE );
+    if ( FLASH11_OK == err_flag )
+    {
+        ctx->op_state = FLASH11_OP_CHIP_ERASE;
+        ctx->op_addr = FLASH11_MIN_ADDRESS;
+        ctx->op_size = FLASH11_MAX_ADDRESS + 1;
+        ctx->op_wp_state = wp_state;
+    }
+    return err_flag;
+}
+
+err_t flash11_start_memory_write ( flash11_t *ctx, uint32_t mem_addr, uint8_t *data_in, uint32_t len )
+{
+    if ( ( NULL == data_in ) || ( 0 == len ) || ( FLASH11_PAGE_SIZE < len ) || 
+         ( FLASH11_OP_IDLE != ctx->op_state ) )
+    {
+        return FLASH11_ERROR;
+    }
+    if ( ( mem_addr < ctx->erase_end ) && ( ctx->erase_addr < ( mem_addr + len ) ) )
+    {
+        // Page would be erased later by the background pre-erase.
+        return FLASH11_ERROR;
+    }
+    uint8_t wp_state = ctx->wp_state;
+    err_t err_flag = flash11_write_enable( ctx );
+    err_flag |= flash11_write_cmd_addr_data( ctx, FLASH11_CMD_BYTE_PAGE_PROGRAM, mem_addr, data_in, len );
+    if ( FLASH11_OK == err_flag )
+    {
+        ctx->op_state = FLASH11_OP_PAGE_PROGRAM;
+        ctx->op_addr = mem_addr;
+        ctx->op_size = len;
+        ctx->op_wp_state = wp_state;
+    }
+    return err_flag;
+}
+
+err_t flash11_pre_erase ( flash11_t *ctx, uint32_t mem_addr, uint32_t len )
+{
+    if ( ( 0 == len ) || ( FLASH11_MAX_ADDRESS < ( mem_addr + len - 1 ) ) )
+    {
+        return FLASH11_ERROR;
+    }
+    ctx->erase_end = ( mem_addr + len + FLASH11_BLOCK_SIZE_4KB - 1 ) & ~( FLASH11_BLOCK_SIZE_4KB - 1 );
+    ctx->erase_addr = mem_addr & ~( FLASH11_BLOCK_SIZE_4KB - 1 );
+    return FLASH11_OK;
+}
+
+err_t flash11_process_operation ( flash11_t *ctx, uint8_t *op_state )
+{
+    err_t err_flag = FLASH11_OK;
+    if ( FLASH11_OP_IDLE != ctx->op_state )
+    {
+        uint8_t status = DUMMY;
+        err_flag = flash11_get_status( ctx, FLASH11_CMD_READ_STATUS_1, &status );
+        if ( ( FLASH11_OK == err_flag ) && !( status & FLASH11_STATUS1_BSY ) )
+        {
+            uint8_t op = ctx->op_state;
+            ctx->op_state = FLASH11_OP_IDLE;
+            flash11_hw_write_protect( ctx, ctx->op_wp_state );
+            if ( NULL != ctx->op_callback )
+            {
+                ctx->op_callback( op, ctx->op_addr );
+            }
+        }
+    }
+    if ( ( FLASH11_OK == err_flag ) && ( FLASH11_OP_IDLE == ctx->op_state ) && 
+         ( ctx->erase_addr < ctx->erase_end ) )
+    {
+        uint8_t cmd_block_erase = FLASH11_CMD_BLOCK_ERASE_4KB;
+        uint32_t block_size = FLASH11_BLOCK_SIZE_4KB;
+        if ( !( ctx->erase_addr & ( FLASH11_BLOCK_SIZE_64KB - 1 ) ) && 
+             ( ( ctx->erase_end - ctx->erase_addr ) >= FLASH11_BLOCK_SIZE_64KB ) )
+        {
+            cmd_block_erase = FLASH11_CMD_BLOCK_ERASE_64KB;
+            block_size = FLASH11_BLOCK_SIZE_64KB;
+        }
+        err_flag = flash11_start_block_erase( ctx, cmd_block_erase, ctx->erase_addr );
+        if ( FLASH11_OK == err_flag )
+        {
+            ctx->erase_addr += block_size;
+        }
+    }
+    if ( NULL != op_state )
+    {
+        *op_state = ctx->op_state;
+    }
+    return err_flag;
+}
+
+err_t flash11_memory_read_suspend ( flash11_t *ctx, uint32_t mem_addr, uint8_t *data_out, uint32_t len )
+{
+    uint8_t status = DUMMY;
+    uint16_t timeout_cnt = 0;
+    if ( FLASH11_OP_IDLE == ctx->op_state )
+    {
+        return flash11_memory_read( ctx, mem_addr, data_out, len );
+    }
+    if ( ( FLASH11_OP_CHIP_ERASE == ctx->op_state ) || 
+         ( ( mem_addr < ( ctx->op_addr + ctx->op_size ) ) && ( ctx->op_addr < ( mem_addr + len ) ) ) )
+    {
+        return FLASH11_ERROR;
+    }
+    err_t err_flag = flash11_get_status( ctx, FLASH11_CMD_READ_STATUS_1, &status );
+    if ( !( status & FLASH11_STATUS1_BSY ) )
+    {
+        return err_flag | flash11_memory_read( ctx, mem_addr, data_out, len );
+    }
+    err_flag |= flash11_set_cmd( ctx, FLASH11_CMD_ERASE_PROGRAM_SUSPEND );
+    err_flag |= flash11_get_status( ctx, FLASH11_CMD_READ_STATUS_1, &status );
+    while ( ( FLASH11_OK == err_flag ) && ( status & FLASH11_STATUS1_BSY ) )
+    {
+        if ( ++timeout_cnt > FLASH11_SUSPEND_TIMEOUT_10US )
+        {
+            flash11_set_cmd( ctx, FLASH11_CMD_ERASE_PROGRAM_RESUME );
+            return FLASH11_ERROR;
+        }
+        Delay_10us( );
+        err_flag |= flash11_get_status( ctx, FLASH11_CMD_READ_STATUS_1, &status );
+    }
+    err_flag |= flash11_memory_read( ctx, mem_addr, data_out, len );
+    err_flag |= flash11_get_status( ctx, FLASH11_CMD_READ_STATUS_2, &status );
+    if ( status & FLASH11_STATUS2_SUS )
+    {
+        // Operation could have been completed before the suspend command was accepted.
+        err_flag |= flash11_set_cmd( ctx, FLASH11_CMD_ERASE_PROGRAM_RESUME );
+    }
+    return err_flag;
+}
+
 // ------------------------------------------------------------------------- END
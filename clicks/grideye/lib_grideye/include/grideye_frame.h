@@ -0,0 +1,251 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ * \brief This file contains the thermal frame processing kernels used with Grid-EYE Click driver.
+ *
+ * The kernels work on int16 pixel frames of any size up to 32x24, so the
+ * same code serves 8x8 Grid-EYE, 16x4 IR Grid and 32x24 IR Grid 3 frames.
+ * Pixel unit is up to the caller, Grid-EYE raw data is 0.25 degC per LSB.
+ *
+ * \addtogroup grideye Grid-EYE Click Driver
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef GRIDEYE_FRAME_H
+#define GRIDEYE_FRAME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup frame_macros Frame macros
+ * \{
+ */
+
+/**
+ * \defgroup frame_error_code Frame error code
+ * \{
+ */
+#define GRIDEYE_FRAME_RETVAL  int8_t
+
+#define GRIDEYE_FRAME_OK            0
+#define GRIDEYE_FRAME_ERROR       (-1)
+/** \} */
+
+/**
+ * \defgroup frame_size Supported frame size
+ * \{
+ */
+#define GRIDEYE_FRAME_MAX_WIDTH                 32
+#define GRIDEYE_FRAME_MAX_HEIGHT                24
+#define GRIDEYE_FRAME_MAX_PIXELS                ( GRIDEYE_FRAME_MAX_WIDTH * GRIDEYE_FRAME_MAX_HEIGHT )
+/** \} */
+
+/**
+ * \defgroup frame_bg Background model settings
+ * \{
+ */
+#define GRIDEYE_FRAME_BG_SHIFT_DEFAULT          4
+#define GRIDEYE_FRAME_BG_FRAC_BITS              8
+/** \} */
+
+/**
+ * \defgroup frame_label Blob labels
+ * \{
+ */
+#define GRIDEYE_FRAME_LABEL_NONE                0x00
+#define GRIDEYE_FRAME_LABEL_IGNORED             0xFF
+/** \} */
+
+/** \} */ // End group frame_macros
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup frame_type Frame types
+ * \{
+ */
+
+/**
+ * @brief Running-average background model definition.
+ */
+typedef struct
+{
+    int32_t *acc;               /**< Background per pixel with GRIDEYE_FRAME_BG_FRAC_BITS fraction bits. */
+    uint16_t n_pixels;          /**< Number of pixels in the frame. */
+    uint8_t shift;              /**< Averaging weight 1/2^shift of the new frame. */
+
+} grideye_frame_bg_t;
+
+/**
+ * @brief Frame statistics definition.
+ */
+typedef struct
+{
+    int16_t min;                /**< Minimum pixel value. */
+    int16_t max;                /**< Maximum pixel value. */
+    uint16_t min_idx;           /**< Index of the minimum pixel. */
+    uint16_t max_idx;           /**< Index of the maximum pixel. */
+    uint16_t centroid_x;        /**< Centroid column weighted by value above minimum, Q8. */
+    uint16_t centroid_y;        /**< Centroid row weighted by value above minimum, Q8. */
+
+} grideye_frame_stats_t;
+
+/**
+ * @brief Hot-spot blob definition.
+ */
+typedef struct
+{
+    uint16_t pixels;            /**< Number of pixels. */
+    int16_t peak;               /**< Highest pixel value. */
+    uint16_t peak_idx;          /**< Index of the highest pixel. */
+    int32_t sum;                /**< Sum of pixel values. */
+    uint16_t centroid_x;        /**< Centroid column weighted by pixel value, Q8. */
+    uint16_t centroid_y;        /**< Centroid row weighted by pixel value, Q8. */
+    uint8_t x_min;              /**< Bounding box left column. */
+    uint8_t x_max;              /**< Bounding box right column. */
+    uint8_t y_min;              /**< Bounding box top row. */
+    uint8_t y_max;              /**< Bounding box bottom row. */
+
+} grideye_frame_blob_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+/**
+ * \defgroup frame_function Frame function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Float frame conversion function.
+ *
+ * @param in        Float frame, e.g. IR Grid 3 object temperatures.
+ * @param out       Fixed-point frame.
+ * @param n_pixels  Number of pixels.
+ * @param scale     Output LSB per input unit, e.g. 100 for 0.01 degC.
+ *
+ * @description This function converts a float frame to the int16 pixels used by the kernels.
+ */
+void grideye_frame_from_float ( float *in, int16_t *out, uint16_t n_pixels, float scale );
+
+/**
+ * @brief Background model initialization function.
+ *
+ * @param bg        Background model.
+ * @param acc       Buffer of n_pixels elements for the model.
+ * @param frame     First frame, taken as the initial background.
+ * @param n_pixels  Number of pixels.
+ * @param shift     Averaging weight 1/2^shift of each new frame.
+ *
+ * @description This function initializes the running-average background model.
+ */
+void grideye_frame_bg_init ( grideye_frame_bg_t *bg, int32_t *acc, int16_t *frame, uint16_t n_pixels, uint8_t shift );
+
+/**
+ * @brief Background model update function.
+ *
+ * @param bg        Background model.
+ * @param frame     New frame.
+ * @param labels    Blob labels of the frame, NULL to update every pixel.
+ *
+ * @description This function blends the new frame into the background. Pixels
+ * that belong to a blob are skipped so people standing still are not absorbed.
+ */
+void grideye_frame_bg_update ( grideye_frame_bg_t *bg, int16_t *frame, uint8_t *labels );
+
+/**
+ * @brief Background subtraction function.
+ *
+ * @param bg        Background model.
+ * @param frame     New frame.
+ * @param diff      Output frame minus background.
+ *
+ * @description This function subtracts the background from the frame.
+ */
+void grideye_frame_bg_subtract ( grideye_frame_bg_t *bg, int16_t *frame, int16_t *diff );
+
+/**
+ * @brief Bilinear upscaling function.
+ *
+ * @param in          Input frame.
+ * @param width       Input width, up to GRIDEYE_FRAME_MAX_WIDTH.
+ * @param height      Input height, up to GRIDEYE_FRAME_MAX_HEIGHT.
+ * @param out         Output frame of out_width * out_height pixels.
+ * @param out_width   Output width, at least 2.
+ * @param out_height  Output height, at least 2.
+ *
+ * @returns 0 for OK, -1 for an unsupported input or output size.
+ *
+ * @description This function upscales the frame to display resolution, corner
+ * pixels of the input and output are aligned.
+ */
+GRIDEYE_FRAME_RETVAL grideye_frame_upscale ( int16_t *in, uint8_t width, uint8_t height,
+                                             int16_t *out, uint16_t out_width, uint16_t out_height );
+
+/**
+ * @brief Frame statistics function.
+ *
+ * @param frame     Input frame.
+ * @param width     Frame width.
+ * @param height    Frame height.
+ * @param stats     Output statistics.
+ *
+ * @description This function finds minimum, maximum and the centroid of the heat above the minimum.
+ */
+void grideye_frame_get_stats ( int16_t *frame, uint8_t width, uint8_t height, grideye_frame_stats_t *stats );
+
+/**
+ * @brief Hot-spot detection function.
+ *
+ * @param diff        Background subtracted frame.
+ * @param width       Frame width.
+ * @param height      Frame height.
+ * @param threshold   Minimum pixel value of a hot pixel.
+ * @param min_pixels  Smaller blobs are labeled as ignored and not reported.
+ * @param labels      Output label per pixel, blob index + 1.
+ * @param stack       Work buffer of width * height elements.
+ * @param blobs       Output blobs.
+ * @param max_blobs   Size of the blobs array, at most 254 blobs are reported.
+ *
+ * @returns Number of blobs found.
+ *
+ * @description This function groups 4-connected hot pixels into blobs, e.g. for people counting.
+ */
+uint8_t grideye_frame_find_blobs ( int16_t *diff, uint8_t width, uint8_t height, int16_t threshold,
+                                   uint16_t min_pixels, uint8_t *labels, uint16_t *stack,
+                                   grideye_frame_blob_t *blobs, uint8_t max_blobs );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // GRIDEYE_FRAME_H
+
+/** \} */ // End frame_function group
+/*! @} */
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,373 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ */
+
+#include "grideye_frame.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+#define FRAME_Q                 8
+#define FRAME_Q_HALF            ( 1 << ( FRAME_Q - 1 ) )
+#define FRAME_POS_Q             16
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static uint16_t frame_q_ratio ( int32_t num, int32_t den );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void grideye_frame_from_float ( float *in, int16_t *out, uint16_t n_pixels, float scale )
+{
+    for ( uint16_t cnt = 0; cnt < n_pixels; cnt++ )
+    {
+        float val = in[ cnt ] * scale;
+
+        if ( val > 32767.0f )
+        {
+            val = 32767.0f;
+        }
+        else if ( val < -32768.0f )
+        {
+            val = -32768.0f;
+        }
+        out[ cnt ] = ( int16_t ) ( val >= 0.0f ? val + 0.5f : val - 0.5f );
+    }
+}
+
+void grideye_frame_bg_init ( grideye_frame_bg_t *bg, int32_t *acc, int16_t *frame, uint16_t n_pixels, uint8_t shift )
+{
+    bg->acc = acc;
+    bg->n_pixels = n_pixels;
+    bg->shift = shift;
+
+    for ( uint16_t cnt = 0; cnt < n_pixels; cnt++ )
+    {
+        acc[ cnt ] = ( int32_t ) frame[ cnt ] << GRIDEYE_FRAME_BG_FRAC_BITS;
+    }
+}
+
+void grideye_frame_bg_update ( grideye_frame_bg_t *bg, int16_t *frame, uint8_t *labels )
+{
+    int32_t *acc = bg->acc;
+    uint16_t n_pixels = bg->n_pixels;
+    uint8_t shift = bg->shift;
+
+    if ( NULL == labels )
+    {
+        for ( uint16_t cnt = 0; cnt < n_pixels; cnt++ )
+        {
+            acc[ cnt ] += ( ( ( int32_t ) frame[ cnt ] << GRIDEYE_FRAME_BG_FRAC_BITS ) - acc[ cnt ] ) >> shift;
+        }
+        return;
+    }
+
+    // Branch-free mask keeps the loop vectorizable
+    for ( uint16_t cnt = 0; cnt < n_pixels; cnt++ )
+    {
+        int32_t step = ( ( ( int32_t ) frame[ cnt ] << GRIDEYE_FRAME_BG_FRAC_BITS ) - acc[ cnt ] ) >> shift;
+        int32_t mask = -( int32_t ) ( GRIDEYE_FRAME_LABEL_NONE == labels[ cnt ] );
+        acc[ cnt ] += step & mask;
+    }
+}
+
+void grideye_frame_bg_subtract ( grideye_frame_bg_t *bg, int16_t *frame, int16_t *diff )
+{
+    int32_t *acc = bg->acc;
+    uint16_t n_pixels = bg->n_pixels;
+
+    for ( uint16_t cnt = 0; cnt < n_pixels; cnt++ )
+    {
+        diff[ cnt ] = ( int16_t ) ( frame[ cnt ] -
+                      ( ( acc[ cnt ] + ( 1 << ( GRIDEYE_FRAME_BG_FRAC_BITS - 1 ) ) ) >> GRIDEYE_FRAME_BG_FRAC_BITS ) );
+    }
+}
+
+GRIDEYE_FRAME_RETVAL grideye_frame_upscale ( int16_t *in, uint8_t width, uint8_t height,
+                                             int16_t *out, uint16_t out_width, uint16_t out_height )
+{
+    int32_t row[ GRIDEYE_FRAME_MAX_WIDTH + 1 ];
+    uint32_t step_x;
+    uint32_t step_y;
+    uint32_t pos_y = 0;
+
+    if ( ( 0 == width ) || ( width > GRIDEYE_FRAME_MAX_WIDTH ) ||
+         ( 0 == height ) || ( height > GRIDEYE_FRAME_MAX_HEIGHT ) ||
+         ( out_width < 2 ) || ( out_height < 2 ) )
+    {
+        return GRIDEYE_FRAME_ERROR;
+    }
+
+    // Q16 positions so the last output pixel lands on the last input pixel
+    step_x = ( ( uint32_t ) ( width - 1 ) << FRAME_POS_Q ) / ( out_width - 1 ) + 1;
+    step_y = ( ( uint32_t ) ( height - 1 ) << FRAME_POS_Q ) / ( out_height - 1 ) + 1;
+
+    for ( uint16_t out_y = 0; out_y < out_height; out_y++, pos_y += step_y )
+    {
+        uint16_t y0 = pos_y >> FRAME_POS_Q;
+        int32_t fy = ( pos_y >> ( FRAME_POS_Q - FRAME_Q ) ) & ( ( 1 << FRAME_Q ) - 1 );
+        int16_t *r0;
+        int16_t *r1;
+        if ( y0 >= height - 1 )
+        {
+            y0 = height - 1;
+            fy = 0;
+        }
+        r0 = &in[ ( uint16_t ) y0 * width ];
+        r1 = ( y0 + 1 < height ) ? ( r0 + width ) : r0;
+        uint32_t pos_x = 0;
+
+        // Vertical pass into one Q8 row, then horizontal pass per output pixel
+        for ( uint8_t x = 0; x < width; x++ )
+        {
+            row[ x ] = ( int32_t ) r0[ x ] * ( 1 << FRAME_Q ) + ( r1[ x ] - r0[ x ] ) * fy;
+        }
+        row[ width ] = row[ width - 1 ];
+
+        for ( uint16_t out_x = 0; out_x < out_width; out_x++, pos_x += step_x )
+        {
+            uint16_t x0 = pos_x >> FRAME_POS_Q;
+            int32_t fx = ( pos_x >> ( FRAME_POS_Q - FRAME_Q ) ) & ( ( 1 << FRAME_Q ) - 1 );
+            int32_t d = row[ x0 + 1 ] - row[ x0 ];
+            // Split the Q8 difference so the product stays within int32 for any int16 input
+            int32_t val = row[ x0 ] + ( d >> FRAME_Q ) * fx +
+                          ( ( ( d & ( ( 1 << FRAME_Q ) - 1 ) ) * fx + FRAME_Q_HALF ) >> FRAME_Q );
+            *out++ = ( int16_t ) ( ( val + FRAME_Q_HALF ) >> FRAME_Q );
+        }
+    }
+    return GRIDEYE_FRAME_OK;
+}
+
+void grideye_frame_get_stats ( int16_t *frame, uint8_t width, uint8_t height, grideye_frame_stats_t *stats )
+{
+    uint16_t n_pixels = ( uint16_t ) width * height;
+    int16_t min = frame[ 0 ];
+    int16_t max = frame[ 0 ];
+    uint16_t min_idx = 0;
+    uint16_t max_idx = 0;
+    // 32x24 pixels of up to 65535 above the minimum stay within int32
+    int32_t sum_w = 0;
+    int32_t sum_x = 0;
+    int32_t sum_y = 0;
+    uint16_t idx = 0;
+
+    for ( uint16_t cnt = 1; cnt < n_pixels; cnt++ )
+    {
+        if ( frame[ cnt ] < min )
+        {
+            min = frame[ cnt ];
+            min_idx = cnt;
+        }
+        if ( frame[ cnt ] > max )
+        {
+            max = frame[ cnt ];
+            max_idx = cnt;
+        }
+    }
+
+    for ( uint8_t y = 0; y < height; y++ )
+    {
+        int32_t row_w = 0;
+        int32_t row_x = 0;
+        for ( uint8_t x = 0; x < width; x++, idx++ )
+        {
+            int32_t w = ( int32_t ) frame[ idx ] - min;
+            row_w += w;
+            row_x += w * x;
+        }
+        sum_w += row_w;
+        sum_x += row_x;
+        sum_y += row_w * y;
+    }
+
+    stats->min = min;
+    stats->max = max;
+    stats->min_idx = min_idx;
+    stats->max_idx = max_idx;
+    if ( sum_w > 0 )
+    {
+        stats->centroid_x = frame_q_ratio( sum_x, sum_w );
+        stats->centroid_y = frame_q_ratio( sum_y, sum_w );
+    }
+    else
+    {
+        // Uniform frame, centroid is the frame center
+        stats->centroid_x = ( uint16_t ) ( ( width - 1 ) << FRAME_Q ) / 2;
+        stats->centroid_y = ( uint16_t ) ( ( height - 1 ) << FRAME_Q ) / 2;
+    }
+}
+
+uint8_t grideye_frame_find_blobs ( int16_t *diff, uint8_t width, uint8_t height, int16_t threshold,
+                                   uint16_t min_pixels, uint8_t *labels, uint16_t *stack,
+                                   grideye_frame_blob_t *blobs, uint8_t max_blobs )
+{
+    uint16_t n_pixels = ( uint16_t ) width * height;
+    uint8_t n_blobs = 0;
+
+    // Label 0xFF marks ignored pixels, so blob labels end at 0xFE
+    if ( max_blobs > ( GRIDEYE_FRAME_LABEL_IGNORED - 1 ) )
+    {
+        max_blobs = GRIDEYE_FRAME_LABEL_IGNORED - 1;
+    }
+
+    for ( uint16_t cnt = 0; cnt < n_pixels; cnt++ )
+    {
+        labels[ cnt ] = GRIDEYE_FRAME_LABEL_NONE;
+    }
+
+    for ( uint16_t seed = 0; seed < n_pixels; seed++ )
+    {
+        grideye_frame_blob_t blob;
+        int32_t sum_x = 0;
+        int32_t sum_y = 0;
+        uint16_t top = 0;
+        uint8_t label;
+
+        if ( ( GRIDEYE_FRAME_LABEL_NONE != labels[ seed ] ) || ( diff[ seed ] < threshold ) )
+        {
+            continue;
+        }
+
+        // Provisional label, the final one is known once the blob size is
+        label = ( n_blobs < max_blobs ) ? ( n_blobs + 1 ) : GRIDEYE_FRAME_LABEL_IGNORED;
+        blob.pixels = 0;
+        blob.peak = diff[ seed ];
+        blob.peak_idx = seed;
+        blob.sum = 0;
+        blob.x_min = width - 1;
+        blob.x_max = 0;
+        blob.y_min = height - 1;
+        blob.y_max = 0;
+
+        labels[ seed ] = label;
+        stack[ top++ ] = seed;
+        while ( top )
+        {
+            uint16_t idx = stack[ --top ];
+            uint8_t y = idx / width;
+            uint8_t x = idx - ( uint16_t ) y * width;
+            int16_t val = diff[ idx ];
+
+            blob.pixels++;
+            blob.sum += val;
+            sum_x += ( int32_t ) val * x;
+            sum_y += ( int32_t ) val * y;
+            if ( val > blob.peak )
+            {
+                blob.peak = val;
+                blob.peak_idx = idx;
+            }
+            if ( x < blob.x_min )
+            {
+                blob.x_min = x;
+            }
+            if ( x > blob.x_max )
+            {
+                blob.x_max = x;
+            }
+            if ( y < blob.y_min )
+            {
+                blob.y_min = y;
+            }
+            if ( y > blob.y_max )
+            {
+                blob.y_max = y;
+            }
+
+            // Each pixel is labeled before it is pushed, so the stack never exceeds n_pixels
+            if ( ( x > 0 ) && ( GRIDEYE_FRAME_LABEL_NONE == labels[ idx - 1 ] ) && ( diff[ idx - 1 ] >= threshold ) )
+            {
+                labels[ idx - 1 ] = label;
+                stack[ top++ ] = idx - 1;
+            }
+            if ( ( x + 1 < width ) && ( GRIDEYE_FRAME_LABEL_NONE == labels[ idx + 1 ] ) && ( diff[ idx + 1 ] >= threshold ) )
+            {
+                labels[ idx + 1 ] = label;
+                stack[ top++ ] = idx + 1;
+            }
+            if ( ( y > 0 ) && ( GRIDEYE_FRAME_LABEL_NONE == labels[ idx - width ] ) && ( diff[ idx - width ] >= threshold ) )
+            {
+                labels[ idx - width ] = label;
+                stack[ top++ ] = idx - width;
+            }
+            if ( ( y + 1 < height ) && ( GRIDEYE_FRAME_LABEL_NONE == labels[ idx + width ] ) && ( diff[ idx + width ] >= threshold ) )
+            {
+                labels[ idx + width ] = label;
+                stack[ top++ ] = idx + width;
+            }
+        }
+
+        if ( GRIDEYE_FRAME_LABEL_IGNORED == label )
+        {
+            continue;
+        }
+        if ( blob.pixels < min_pixels )
+        {
+            // Relabel the small blob so it is not reported and stays out of the background update
+            for ( uint16_t cnt = seed; cnt < n_pixels; cnt++ )
+            {
+                if ( label == labels[ cnt ] )
+                {
+                    labels[ cnt ] = GRIDEYE_FRAME_LABEL_IGNORED;
+                }
+            }
+            continue;
+        }
+
+        if ( blob.sum > 0 )
+        {
+            blob.centroid_x = frame_q_ratio( sum_x, blob.sum );
+            blob.centroid_y = frame_q_ratio( sum_y, blob.sum );
+        }
+        else
+        {
+            blob.centroid_x = ( uint16_t ) ( blob.peak_idx % width ) << FRAME_Q;
+            blob.centroid_y = ( uint16_t ) ( blob.peak_idx / width ) << FRAME_Q;
+        }
+        blobs[ n_blobs++ ] = blob;
+    }
+    return n_blobs;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint16_t frame_q_ratio ( int32_t num, int32_t den )
+{
+    int32_t whole;
+    int32_t rem;
+
+    // Keep the remainder shifted by FRAME_Q within int32
+    while ( den >= ( ( int32_t ) 1 << ( 31 - FRAME_Q ) ) )
+    {
+        num >>= 1;
+        den >>= 1;
+    }
+    whole = num / den;
+    rem = num - whole * den;
+
+    return ( uint16_t ) ( ( whole << FRAME_Q ) + ( ( rem << FRAME_Q ) + ( den >> 1 ) ) / den );
+}
+
+// ------------------------------------------------------------------------- END
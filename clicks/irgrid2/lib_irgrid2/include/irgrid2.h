@@ -77,6 +77,12 @@ extern "C"{
  */
 #define IRGRID2_SET_DEV_ADDR  0x33
 
+/**
+ * @brief IR Grid 2 frame pipeline setting.
+ * @details Marker of an empty frame pipeline slot of IR Grid 2 Click driver.
+ */
+#define IRGRID2_PIPELINE_NONE  0xFF
+
 /*! @} */ // irgrid2_set
 
 /**
@@ -132,6 +138,23 @@ typedef struct
     uint16_t outlier_pixels[ 5 ];
 } irgrid2_params_t;
 
+/**
+ * @brief IR Grid 2 Click frame pipeline object.
+ * @details Triple-buffered frame pipeline object definition of IR Grid 2 Click driver.
+ * The next subpage is read into one buffer, the latest one waits in another and the
+ * consumer holds the third one until it releases it.
+ */
+typedef struct
+{
+    uint16_t *frame[ 3 ];       /**< Three user provided frame buffers (834 words each). */
+    uint8_t  wr_idx;            /**< Index of the buffer the next subpage is read into. */
+    volatile uint8_t pub_idx;   /**< Index of the latest published buffer. */
+    volatile uint8_t pub_cnt;   /**< Incremented on every published frame. */
+    volatile uint8_t rd_idx;    /**< Index of the buffer held by the consumer. */
+    uint8_t  rd_cnt;            /**< Publish count of the last frame taken by the consumer. */
+
+} irgrid2_pipeline_t;
+
 /**
  * @brief IR Grid 2 Click context object.
  * @details Context object definition of IR Grid 2 Click driver.
@@ -309,6 +332,89 @@ void irgrid2_set_refresh_rate ( irgrid2_t *ctx, uint8_t refresh_rate );
  */
 uint16_t irgrid2_get_frame_data ( irgrid2_t *ctx, uint16_t *frame_data );
 
+/**
+ * @brief Function for checking data ready.
+ * @details This function checks whether a new subpage is available in the device RAM.
+ * @param[in] ctx : Click context object.
+ * See #irgrid2_t object definition for detailed explanation.
+ * @return @li @c 0 - No new data,
+ *         @li @c 1 - New data available.
+ */
+uint8_t irgrid2_check_data_ready ( irgrid2_t *ctx );
+
+/**
+ * @brief Function for reading frame data.
+ * @details This function reads the available subpage directly into the frame buffer
+ * without waiting for the data ready flag.
+ * @param[in] ctx : Click context object.
+ * See #irgrid2_t object definition for detailed explanation.
+ * @param[out] frame_data : Buffer in which the data will be stored (834 words).
+ * @return Subpage number.
+ * @note Should be called once #irgrid2_check_data_ready reports new data.
+ */
+uint16_t irgrid2_read_frame_data ( irgrid2_t *ctx, uint16_t *frame_data );
+
+/**
+ * @brief Function for waiting frame data.
+ * @details This function polls the data ready flag with increasing delay between
+ * polls, never past the timeout, and reads the subpage once it is available.
+ * @param[in] ctx : Click context object.
+ * See #irgrid2_t object definition for detailed explanation.
+ * @param[out] frame_data : Buffer in which the data will be stored (834 words).
+ * @param[in] timeout_ms : Timeout in milliseconds.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Timeout.
+ */
+err_t irgrid2_wait_frame_data ( irgrid2_t *ctx, uint16_t *frame_data, uint16_t timeout_ms );
+
+/**
+ * @brief Function for initializing frame pipeline.
+ * @details This function initializes the triple-buffered frame pipeline.
+ * @param[out] pipe : Frame pipeline object.
+ * See #irgrid2_pipeline_t object definition for detailed explanation.
+ * @param[in] frame_0 : First frame buffer (834 words).
+ * @param[in] frame_1 : Second frame buffer (834 words).
+ * @param[in] frame_2 : Third frame buffer (834 words).
+ * @return Nothing.
+ */
+void irgrid2_pipeline_init ( irgrid2_pipeline_t *pipe, uint16_t *frame_0, uint16_t *frame_1, uint16_t *frame_2 );
+
+/**
+ * @brief Function for processing frame pipeline.
+ * @details This function checks the data ready flag and, if new data is available, reads
+ * the subpage into the free buffer and publishes it. It never waits for the device and
+ * never writes the buffer held by the consumer.
+ * @param[in] ctx : Click context object.
+ * See #irgrid2_t object definition for detailed explanation.
+ * @param[in] pipe : Frame pipeline object.
+ * See #irgrid2_pipeline_t object definition for detailed explanation.
+ * @return @li @c 0 - No new frame,
+ *         @li @c 1 - New frame published.
+ * @note Should be called periodically, e.g. from a timer task.
+ */
+uint8_t irgrid2_pipeline_process ( irgrid2_t *ctx, irgrid2_pipeline_t *pipe );
+
+/**
+ * @brief Function for getting pipeline frame.
+ * @details This function takes the latest published frame. The consumer owns the
+ * returned buffer until it calls #irgrid2_pipeline_release or takes the next frame.
+ * @param[in] pipe : Frame pipeline object.
+ * See #irgrid2_pipeline_t object definition for detailed explanation.
+ * @return Pointer to frame data or NULL if no new frame is available.
+ * @note May be called while #irgrid2_pipeline_process runs from an interrupt.
+ */
+uint16_t *irgrid2_pipeline_get_frame ( irgrid2_pipeline_t *pipe );
+
+/**
+ * @brief Function for releasing pipeline frame.
+ * @details This function returns the buffer taken by #irgrid2_pipeline_get_frame
+ * to the pipeline.
+ * @param[in] pipe : Frame pipeline object.
+ * See #irgrid2_pipeline_t object definition for detailed explanation.
+ * @return Nothing.
+ */
+void irgrid2_pipeline_release ( irgrid2_pipeline_t *pipe );
+
 /**
  * @brief Function for setting resolution.
  * @details This function is used for setting resolution.
@@ -161,32 +161,114 @@ void irgrid2_set_refresh_rate( irgrid2_t *ctx, uint8_t refresh_rate ) {
     write_data_u16 ( ctx, 0x800D, value);
 }
 uint16_t irgrid2_get_frame_data ( irgrid2_t *ctx, uint16_t *frame_data ) {
-    uint16_t drdy = 1;
-    uint16_t ctrl_reg;
-    uint16_t status_reg;
-    uint8_t cnt = 0;
+    while ( !irgrid2_check_data_ready( ctx ) ) {
+        Delay_1ms( );
+    }
 
-    drdy = 0;
+    return irgrid2_read_frame_data( ctx, frame_data );
+}
+uint8_t irgrid2_check_data_ready ( irgrid2_t *ctx ) {
+    return ( read_data_u16( ctx, 0x8000 ) & 0x0008 ) ? 1 : 0;
+}
 
-    while ( drdy == 0 ) {
-        status_reg = read_data_u16( ctx, 0x8000 );
-        drdy = status_reg & 0x0008;
-    }
+uint16_t irgrid2_read_frame_data ( irgrid2_t *ctx, uint16_t *frame_data ) {
+    uint16_t status_reg;
+    uint8_t cnt = 0;
 
-    while ( ( drdy != 0 ) && ( cnt < 5 ) ) {
-        write_data_u16 ( ctx, 0x8000, 0x0030);
+    do {
+        write_data_u16 ( ctx, 0x8000, 0x0030 );
         read_data_block ( ctx, 0x0400, frame_data, 832 );
         status_reg = read_data_u16 ( ctx, 0x8000 );
-        drdy = status_reg & 0x0008;
-        cnt = cnt + 1;
-    }
+        cnt++;
+    } while ( ( status_reg & 0x0008 ) && ( cnt < 5 ) );
 
-    ctrl_reg = read_data_u16( ctx, 0x800D );
-    frame_data[ 832 ] = ctrl_reg;
+    frame_data[ 832 ] = read_data_u16( ctx, 0x800D );
     frame_data[ 833 ] = status_reg & 0x0001;
 
     return frame_data[ 833 ];
 }
+
+err_t irgrid2_wait_frame_data ( irgrid2_t *ctx, uint16_t *frame_data, uint16_t timeout_ms ) {
+    uint16_t elapsed_ms = 0;
+    uint16_t backoff_ms = 1;
+    uint16_t delay_ms;
+    uint16_t cnt;
+
+    while ( !irgrid2_check_data_ready( ctx ) ) {
+        if ( elapsed_ms >= timeout_ms ) {
+            return IRGRID2_ERROR;
+        }
+        // Never past the timeout, so elapsed_ms cannot overflow
+        delay_ms = timeout_ms - elapsed_ms;
+        if ( delay_ms > backoff_ms ) {
+            delay_ms = backoff_ms;
+        }
+        for ( cnt = 0; cnt < delay_ms; cnt++ ) {
+            Delay_1ms( );
+        }
+        elapsed_ms += delay_ms;
+        if ( backoff_ms < 16 ) {
+            backoff_ms <<= 1;
+        }
+    }
+    irgrid2_read_frame_data( ctx, frame_data );
+
+    return IRGRID2_OK;
+}
+
+void irgrid2_pipeline_init ( irgrid2_pipeline_t *pipe, uint16_t *frame_0, uint16_t *frame_1, uint16_t *frame_2 ) {
+    pipe->frame[ 0 ] = frame_0;
+    pipe->frame[ 1 ] = frame_1;
+    pipe->frame[ 2 ] = frame_2;
+    pipe->wr_idx = 0;
+    pipe->pub_idx = IRGRID2_PIPELINE_NONE;
+    pipe->pub_cnt = 0;
+    pipe->rd_idx = IRGRID2_PIPELINE_NONE;
+    pipe->rd_cnt = 0;
+}
+
+uint8_t irgrid2_pipeline_process ( irgrid2_t *ctx, irgrid2_pipeline_t *pipe ) {
+    uint8_t idx = 0;
+
+    if ( !irgrid2_check_data_ready( ctx ) ) {
+        return 0;
+    }
+    irgrid2_read_frame_data( ctx, pipe->frame[ pipe->wr_idx ] );
+    pipe->pub_idx = pipe->wr_idx;
+    pipe->pub_cnt++;
+
+    // Next subpage goes to the buffer that is neither published nor held
+    while ( ( idx == pipe->pub_idx ) || ( idx == pipe->rd_idx ) ) {
+        idx++;
+    }
+    pipe->wr_idx = idx;
+
+    return 1;
+}
+
+uint16_t *irgrid2_pipeline_get_frame ( irgrid2_pipeline_t *pipe ) {
+    uint8_t idx;
+    uint8_t cnt;
+
+    if ( pipe->rd_cnt == pipe->pub_cnt ) {
+        return NULL;
+    }
+
+    // Take it again if a frame was published while taking it
+    do {
+        cnt = pipe->pub_cnt;
+        idx = pipe->pub_idx;
+        pipe->rd_idx = idx;
+    } while ( ( idx != pipe->pub_idx ) || ( cnt != pipe->pub_cnt ) );
+    pipe->rd_cnt = cnt;
+
+    return pipe->frame[ idx ];
+}
+
+void irgrid2_pipeline_release ( irgrid2_pipeline_t *pipe ) {
+    pipe->rd_idx = IRGRID2_PIPELINE_NONE;
+}
+
 void irgrid2_set_resolution ( irgrid2_t *ctx, uint8_t resolution ) {
     uint16_t ctrl_reg;
     uint16_t value;
@@ -510,12 +592,14 @@ void irgrid2_get_image ( irgrid2_t *ctx, uint16_t *frame_data, float *px_matrix
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static void write_data_u16 ( irgrid2_t *ctx, uint16_t reg, uint16_t tx_data ) {
-    uint8_t tx_buf[ 2 ];
+    uint8_t tx_buf[ 4 ];
 
-    tx_buf[ 0 ] = (uint8_t)( tx_data >> 8 );
-    tx_buf[ 1 ] = (uint8_t)( tx_data & 0x00FF );
+    tx_buf[ 0 ] = (uint8_t)( reg >> 8 );
+    tx_buf[ 1 ] = (uint8_t)( reg & 0x00FF );
+    tx_buf[ 2 ] = (uint8_t)( tx_data >> 8 );
+    tx_buf[ 3 ] = (uint8_t)( tx_data & 0x00FF );
 
-    irgrid2_generic_write( ctx, reg, tx_buf, 2);
+    i2c_master_write( &ctx->i2c, tx_buf, 4 );
 }
 
 static uint16_t read_data_u16 ( irgrid2_t *ctx, uint16_t reg ) {
@@ -532,20 +616,15 @@ static uint16_t read_data_u16 ( irgrid2_t *ctx, uint16_t reg ) {
 }
 
 static void read_data_block ( irgrid2_t *ctx, uint16_t start_addr, uint16_t *data_out, uint16_t n_bytes ) {
-    uint8_t rx_buf[ 1664 ] = {0};
+    uint8_t *rx_buf;
     uint16_t cnt = 0;
-    uint16_t n_mem_addr = 0;
-    uint16_t i = 0;
-
-    n_mem_addr = 2 * n_bytes;
 
-    irgrid2_generic_read ( ctx, start_addr, rx_buf, n_mem_addr );
+    // Big-endian words are read directly into the output buffer and swapped in place.
+    irgrid2_generic_read ( ctx, start_addr, ( uint8_t * ) data_out, 2 * n_bytes );
 
     for ( cnt = 0; cnt < n_bytes; cnt++ ) {
-        i = cnt << 1;
-        data_out[ cnt ] = rx_buf[ i ];
-        data_out[ cnt ] <<= 8;
-        data_out[ cnt ] |= rx_buf[ i + 1 ];
+        rx_buf = ( uint8_t * ) &data_out[ cnt ];
+        data_out[ cnt ] = ( ( uint16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
     }
 }
 
@@ -77,6 +77,20 @@ extern "C"{
  */
 #define IRGRID3_SET_DEV_ADDR  0x33
 
+/**
+ * @brief IR Grid 3 frame pipeline setting.
+ * @details Marker of an empty frame pipeline slot of IR Grid 3 Click driver.
+ */
+#define IRGRID3_PIPELINE_NONE  0xFF
+
+/**
+ * @brief IR Grid 3 pixel count setting.
+ * @details Specified number of pixels and number of pixels per subpage of
+ * IR Grid 3 Click driver.
+ */
+#define IRGRID3_PIXEL_COUNT             768
+#define IRGRID3_SUBPAGE_PIXEL_COUNT     384
+
 /*! @} */ // irgrid3_set
 
 /**
@@ -132,6 +146,41 @@ typedef struct
     uint16_t outlier_pixels[ 5 ];
 } irgrid3_params_t;
 
+/**
+ * @brief IR Grid 3 Click compiled calibration table definition.
+ * @details Calibration table definition of IR Grid 3 Click driver. Per-pixel constants
+ * folded together by #irgrid3_fast_compile are kept as separate arrays indexed by subpage,
+ * so each subpage is processed as one contiguous walk over every array.
+ */
+typedef struct
+{
+    uint8_t mode;                                                   /**< Reading pattern the table is compiled for. */
+    float offset[ 2 ][ IRGRID3_SUBPAGE_PIXEL_COUNT ];               /**< Pixel offset. */
+    float kta[ 2 ][ IRGRID3_SUBPAGE_PIXEL_COUNT ];                  /**< Pixel Kta coefficient. */
+    float kv[ 2 ][ IRGRID3_SUBPAGE_PIXEL_COUNT ];                   /**< Pixel Kv coefficient. */
+    float alpha_cp[ 2 ][ IRGRID3_SUBPAGE_PIXEL_COUNT ];             /**< Pixel sensitivity compensated for the compensation pixel. */
+    float il_corr[ 2 ][ IRGRID3_SUBPAGE_PIXEL_COUNT ];              /**< Interleaved/chess pattern correction (zero in calibration mode). */
+    uint16_t px_number[ 2 ][ IRGRID3_SUBPAGE_PIXEL_COUNT ];         /**< Pixel index in the frame. */
+
+} irgrid3_fast_table_t;
+
+/**
+ * @brief IR Grid 3 Click frame pipeline object.
+ * @details Triple-buffered frame pipeline object definition of IR Grid 3 Click driver.
+ * The next subpage is read into one buffer, the latest one waits in another and the
+ * consumer holds the third one until it releases it.
+ */
+typedef struct
+{
+    uint16_t *frame[ 3 ];       /**< Three user provided frame buffers (834 words each). */
+    uint8_t  wr_idx;            /**< Index of the buffer the next subpage is read into. */
+    volatile uint8_t pub_idx;   /**< Index of the latest published buffer. */
+    volatile uint8_t pub_cnt;   /**< Incremented on every published frame. */
+    volatile uint8_t rd_idx;    /**< Index of the buffer held by the consumer. */
+    uint8_t  rd_cnt;            /**< Publish count of the last frame taken by the consumer. */
+
+} irgrid3_pipeline_t;
+
 /**
  * @brief IR Grid 3 Click context object.
  * @details Context object definition of IR Grid 3 Click driver.
@@ -309,6 +358,89 @@ void irgrid3_set_refresh_rate ( irgrid3_t *ctx, uint8_t refresh_rate );
  */
 uint16_t irgrid3_get_frame_data ( irgrid3_t *ctx, uint16_t *frame_data );
 
+/**
+ * @brief Function for checking data ready.
+ * @details This function checks whether a new subpage is available in the device RAM.
+ * @param[in] ctx : Click context object.
+ * See #irgrid3_t object definition for detailed explanation.
+ * @return @li @c 0 - No new data,
+ *         @li @c 1 - New data available.
+ */
+uint8_t irgrid3_check_data_ready ( irgrid3_t *ctx );
+
+/**
+ * @brief Function for reading frame data.
+ * @details This function reads the available subpage directly into the frame buffer
+ * without waiting for the data ready flag.
+ * @param[in] ctx : Click context object.
+ * See #irgrid3_t object definition for detailed explanation.
+ * @param[out] frame_data : Buffer in which the data will be stored (834 words).
+ * @return Subpage number.
+ * @note Should be called once #irgrid3_check_data_ready reports new data.
+ */
+uint16_t irgrid3_read_frame_data ( irgrid3_t *ctx, uint16_t *frame_data );
+
+/**
+ * @brief Function for waiting frame data.
+ * @details This function polls the data ready flag with increasing delay between
+ * polls, never past the timeout, and reads the subpage once it is available.
+ * @param[in] ctx : Click context object.
+ * See #irgrid3_t object definition for detailed explanation.
+ * @param[out] frame_data : Buffer in which the data will be stored (834 words).
+ * @param[in] timeout_ms : Timeout in milliseconds.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Timeout.
+ */
+err_t irgrid3_wait_frame_data ( irgrid3_t *ctx, uint16_t *frame_data, uint16_t timeout_ms );
+
+/**
+ * @brief Function for initializing frame pipeline.
+ * @details This function initializes the triple-buffered frame pipeline.
+ * @param[out] pipe : Frame pipeline object.
+ * See #irgrid3_pipeline_t object definition for detailed explanation.
+ * @param[in] frame_0 : First frame buffer (834 words).
+ * @param[in] frame_1 : Second frame buffer (834 words).
+ * @param[in] frame_2 : Third frame buffer (834 words).
+ * @return Nothing.
+ */
+void irgrid3_pipeline_init ( irgrid3_pipeline_t *pipe, uint16_t *frame_0, uint16_t *frame_1, uint16_t *frame_2 );
+
+/**
+ * @brief Function for processing frame pipeline.
+ * @details This function checks the data ready flag and, if new data is available, reads
+ * the subpage into the free buffer and publishes it. It never waits for the device and
+ * never writes the buffer held by the consumer.
+ * @param[in] ctx : Click context object.
+ * See #irgrid3_t object definition for detailed explanation.
+ * @param[in] pipe : Frame pipeline object.
+ * See #irgrid3_pipeline_t object definition for detailed explanation.
+ * @return @li @c 0 - No new frame,
+ *         @li @c 1 - New frame published.
+ * @note Should be called periodically, e.g. from a timer task.
+ */
+uint8_t irgrid3_pipeline_process ( irgrid3_t *ctx, irgrid3_pipeline_t *pipe );
+
+/**
+ * @brief Function for getting pipeline frame.
+ * @details This function takes the latest published frame. The consumer owns the
+ * returned buffer until it calls #irgrid3_pipeline_release or takes the next frame.
+ * @param[in] pipe : Frame pipeline object.
+ * See #irgrid3_pipeline_t object definition for detailed explanation.
+ * @return Pointer to frame data or NULL if no new frame is available.
+ * @note May be called while #irgrid3_pipeline_process runs from an interrupt.
+ */
+uint16_t *irgrid3_pipeline_get_frame ( irgrid3_pipeline_t *pipe );
+
+/**
+ * @brief Function for releasing pipeline frame.
+ * @details This function returns the buffer taken by #irgrid3_pipeline_get_frame
+ * to the pipeline.
+ * @param[in] pipe : Frame pipeline object.
+ * See #irgrid3_pipeline_t object definition for detailed explanation.
+ * @return Nothing.
+ */
+void irgrid3_pipeline_release ( irgrid3_pipeline_t *pipe );
+
 /**
  * @brief Function for setting resolution.
  * @details This function is used for setting resolution.
@@ -435,6 +567,37 @@ void irgrid3_calculate_temp_obj ( irgrid3_t *ctx, uint16_t *frame_data, float tr
  * 
  */
 void irgrid3_get_image ( irgrid3_t *ctx, uint16_t *frame_data, float *px_matrix );
+
+/**
+ * @brief Function for compiling calibration table.
+ * @details This function folds the extracted per-pixel calibration parameters into one
+ * contiguous table used by #irgrid3_fast_calculate_temp_obj.
+ * @param[in] ctx : Click context object.
+ * See #irgrid3_t object definition for detailed explanation.
+ * @param[out] table : Calibration table.
+ * @param[in] mode : Reading pattern (0 - interleaved, 1 - chess).
+ * @return Nothing.
+ * @note Must be called after #irgrid3_extract_parameters. The table is recompiled
+ * automatically if the frame reading pattern differs from the compiled one.
+ */
+void irgrid3_fast_compile ( irgrid3_t *ctx, irgrid3_fast_table_t *table, uint8_t mode );
+
+/**
+ * @brief Function for fast calculating temperature objects.
+ * @details This function calculates object temperatures of the subpage contained in the
+ * frame by using the compiled calibration table and single-precision math.
+ * Pixels of the other subpage are left untouched.
+ * @param[in] ctx : Click context object.
+ * See #irgrid3_t object definition for detailed explanation.
+ * @param[in] table : Calibration table.
+ * @param[in] frame_data : Frame Data
+ * @param[in] tr_data : Real temperature
+ * @param[out] px_matrix : Buffer in which the result of the calculation will be stored
+ * @return Nothing.
+ * @note Results match #irgrid3_calculate_temp_obj within single-precision rounding.
+ */
+void irgrid3_fast_calculate_temp_obj ( irgrid3_t *ctx, irgrid3_fast_table_t *table, uint16_t *frame_data, 
+                                       float tr_data, float *px_matrix );
 #ifdef __cplusplus
 }
 #endif
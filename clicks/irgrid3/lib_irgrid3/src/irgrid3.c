@@ -50,6 +50,7 @@ static void extract_cp_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data );
 static void extract_cilc_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data );
 static uint8_t extract_deviating_pixels ( irgrid3_t *ctx, uint16_t *eeprom_data );
 static float gain_calculation ( irgrid3_t *ctx, uint16_t raw_gain );
+static float fast_root4 ( float x );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -161,32 +162,114 @@ void irgrid3_set_refresh_rate( irgrid3_t *ctx, uint8_t refresh_rate ) {
     write_data_u16 ( ctx, 0x800D, value);
 }
 uint16_t irgrid3_get_frame_data ( irgrid3_t *ctx, uint16_t *frame_data ) {
-    uint16_t drdy = 1;
-    uint16_t ctrl_reg;
-    uint16_t status_reg;
-    uint8_t cnt = 0;
+    while ( !irgrid3_check_data_ready( ctx ) ) {
+        Delay_1ms( );
+    }
 
-    drdy = 0;
+    return irgrid3_read_frame_data( ctx, frame_data );
+}
+uint8_t irgrid3_check_data_ready ( irgrid3_t *ctx ) {
+    return ( read_data_u16( ctx, 0x8000 ) & 0x0008 ) ? 1 : 0;
+}
 
-    while ( drdy == 0 ) {
-        status_reg = read_data_u16( ctx, 0x8000 );
-        drdy = status_reg & 0x0008;
-    }
+uint16_t irgrid3_read_frame_data ( irgrid3_t *ctx, uint16_t *frame_data ) {
+    uint16_t status_reg;
+    uint8_t cnt = 0;
 
-    while ( ( drdy != 0 ) && ( cnt < 5 ) ) {
-        write_data_u16 ( ctx, 0x8000, 0x0030);
+    do {
+        write_data_u16 ( ctx, 0x8000, 0x0030 );
         read_data_block ( ctx, 0x0400, frame_data, 832 );
         status_reg = read_data_u16 ( ctx, 0x8000 );
-        drdy = status_reg & 0x0008;
-        cnt = cnt + 1;
-    }
+        cnt++;
+    } while ( ( status_reg & 0x0008 ) && ( cnt < 5 ) );
 
-    ctrl_reg = read_data_u16( ctx, 0x800D );
-    frame_data[ 832 ] = ctrl_reg;
+    frame_data[ 832 ] = read_data_u16( ctx, 0x800D );
     frame_data[ 833 ] = status_reg & 0x0001;
 
     return frame_data[ 833 ];
 }
+
+err_t irgrid3_wait_frame_data ( irgrid3_t *ctx, uint16_t *frame_data, uint16_t timeout_ms ) {
+    uint16_t elapsed_ms = 0;
+    uint16_t backoff_ms = 1;
+    uint16_t delay_ms;
+    uint16_t cnt;
+
+    while ( !irgrid3_check_data_ready( ctx ) ) {
+        if ( elapsed_ms >= timeout_ms ) {
+            return IRGRID3_ERROR;
+        }
+        // Never past the timeout, so elapsed_ms cannot overflow
+        delay_ms = timeout_ms - elapsed_ms;
+        if ( delay_ms > backoff_ms ) {
+            delay_ms = backoff_ms;
+        }
+        for ( cnt = 0; cnt < delay_ms; cnt++ ) {
+            Delay_1ms( );
+        }
+        elapsed_ms += delay_ms;
+        if ( backoff_ms < 16 ) {
+            backoff_ms <<= 1;
+        }
+    }
+    irgrid3_read_frame_data( ctx, frame_data );
+
+    return IRGRID3_OK;
+}
+
+void irgrid3_pipeline_init ( irgrid3_pipeline_t *pipe, uint16_t *frame_0, uint16_t *frame_1, uint16_t *frame_2 ) {
+    pipe->frame[ 0 ] = frame_0;
+    pipe->frame[ 1 ] = frame_1;
+    pipe->frame[ 2 ] = frame_2;
+    pipe->wr_idx = 0;
+    pipe->pub_idx = IRGRID3_PIPELINE_NONE;
+    pipe->pub_cnt = 0;
+    pipe->rd_idx = IRGRID3_PIPELINE_NONE;
+    pipe->rd_cnt = 0;
+}
+
+uint8_t irgrid3_pipeline_process ( irgrid3_t *ctx, irgrid3_pipeline_t *pipe ) {
+    uint8_t idx = 0;
+
+    if ( !irgrid3_check_data_ready( ctx ) ) {
+        return 0;
+    }
+    irgrid3_read_frame_data( ctx, pipe->frame[ pipe->wr_idx ] );
+    pipe->pub_idx = pipe->wr_idx;
+    pipe->pub_cnt++;
+
+    // Next subpage goes to the buffer that is neither published nor held
+    while ( ( idx == pipe->pub_idx ) || ( idx == pipe->rd_idx ) ) {
+        idx++;
+    }
+    pipe->wr_idx = idx;
+
+    return 1;
+}
+
+uint16_t *irgrid3_pipeline_get_frame ( irgrid3_pipeline_t *pipe ) {
+    uint8_t idx;
+    uint8_t cnt;
+
+    if ( pipe->rd_cnt == pipe->pub_cnt ) {
+        return NULL;
+    }
+
+    // Take it again if a frame was published while taking it
+    do {
+        cnt = pipe->pub_cnt;
+        idx = pipe->pub_idx;
+        pipe->rd_idx = idx;
+    } while ( ( idx != pipe->pub_idx ) || ( cnt != pipe->pub_cnt ) );
+    pipe->rd_cnt = cnt;
+
+    return pipe->frame[ idx ];
+}
+
+void irgrid3_pipeline_release ( irgrid3_pipeline_t *pipe ) {
+    pipe->rd_idx = IRGRID3_PIPELINE_NONE;
+}
+
 void irgrid3_set_resolution ( irgrid3_t *ctx, uint8_t resolution ) {
     uint16_t ctrl_reg;
     uint16_t value;
@@ -507,15 +590,156 @@ void irgrid3_get_image ( irgrid3_t *ctx, uint16_t *frame_data, float *px_matrix
     }
 }
 
+void irgrid3_fast_compile ( irgrid3_t *ctx, irgrid3_fast_table_t *table, uint8_t mode ) {
+    uint16_t cnt[ 2 ] = { 0 };
+    uint16_t idx;
+    int8_t il_pattern;
+    int8_t chess_pattern;
+    int8_t conversion_pattern;
+    uint8_t pattern;
+    int px_number;
+
+    table->mode = mode ? 1 : 0;
+
+    for ( px_number = 0; px_number < IRGRID3_PIXEL_COUNT; px_number++ ) {
+        il_pattern = px_number / 32 - ( px_number / 64 ) * 2;
+        chess_pattern = il_pattern ^ ( px_number - ( px_number / 2 ) * 2 );
+        conversion_pattern = ( ( px_number + 2 ) / 4 - ( px_number + 3 ) / 4 + ( px_number + 1 ) / 4 - px_number / 4 ) * ( 1 - 2 * il_pattern );
+
+        if ( table->mode == 0 ) {
+            pattern = il_pattern;
+        } else {
+            pattern = chess_pattern;
+        }
+
+        idx = cnt[ pattern ]++;
+        table->px_number[ pattern ][ idx ] = px_number;
+        table->offset[ pattern ][ idx ] = ctx->params.offset[ px_number ];
+        table->kta[ pattern ][ idx ] = ctx->params.kta[ px_number ];
+        table->kv[ pattern ][ idx ] = ctx->params.kv[ px_number ];
+        table->alpha_cp[ pattern ][ idx ] = ctx->params.alpha[ px_number ] - ctx->params.tgc * ctx->params.cp_alpha[ pattern ];
+        table->il_corr[ pattern ][ idx ] = 0.0f;
+        if ( ( table->mode << 7 ) != ctx->params.calibration_mode_eeprom ) {
+            table->il_corr[ pattern ][ idx ] = ctx->params.il_chess_c[ 2 ] * ( 2 * il_pattern - 1 ) - ctx->params.il_chess_c[ 1 ] * conversion_pattern;
+        }
+    }
+}
+
+void irgrid3_fast_calculate_temp_obj ( irgrid3_t *ctx, irgrid3_fast_table_t *table, uint16_t *frame_data, 
+                                       float tr_data, float *px_matrix ) {
+    const uint16_t *px_number;
+    const float *offset;
+    const float *kta;
+    const float *kv;
+    const float *alpha_cp;
+    const float *il_corr;
+    float gain;
+    float raw_vdd;
+    float raw_ta;
+    float d_ta;
+    float d_vdd;
+    float ta_4;
+    float tr_4;
+    float raw_ta_tr;
+    float ks_ta_corr;
+    float ks_to_corr;
+    float alpha_corr_r[ 4 ];
+    float ir_data_cp[ 2 ];
+    float cp_corr;
+    float ir_data;
+    float alpha_compensated;
+    float raw_sx;
+    float raw_to;
+    uint8_t mode;
+    uint16_t sub_page;
+    int8_t range;
+    int i;
+
+    sub_page = frame_data[ 833 ] & 0x0001;
+    mode = ( frame_data[ 832 ] & 0x1000 ) >> 12;
+    if ( mode != table->mode ) {
+        irgrid3_fast_compile( ctx, table, mode );
+    }
+
+    raw_vdd = irgrid3_get_vdd( ctx, frame_data );
+    raw_ta = irgrid3_get_temp_ambient( ctx, frame_data );
+    d_ta = raw_ta - 25.0f;
+    d_vdd = raw_vdd - 3.3f;
+
+    ta_4 = ( raw_ta + 273.15f ) * ( raw_ta + 273.15f );
+    ta_4 *= ta_4;
+    tr_4 = ( tr_data + 273.15f ) * ( tr_data + 273.15f );
+    tr_4 *= tr_4;
+    raw_ta_tr = tr_4 - ( tr_4 - ta_4 ) / 0.95f;
+
+    alpha_corr_r[ 0 ] = 1.0f / ( 1.0f + ctx->params.ks_to[ 0 ] * 40.0f );
+    alpha_corr_r[ 1 ] = 1.0f;
+    alpha_corr_r[ 2 ] = ( 1.0f + ctx->params.ks_to[ 2 ] * ctx->params.ct[ 2 ] );
+    alpha_corr_r[ 3 ] = alpha_corr_r[ 2 ] * ( 1.0f + ctx->params.ks_to[ 3 ] * ( ctx->params.ct[ 3 ] - ctx->params.ct[ 2 ] ) );
+
+    gain = gain_calculation( ctx, frame_data[ 778 ] );
+
+    ir_data_cp[ 0 ] = ( int16_t ) frame_data[ 776 ] * gain;
+    ir_data_cp[ 1 ] = ( int16_t ) frame_data[ 808 ] * gain;
+    cp_corr = ( 1.0f + ctx->params.cp_kta * d_ta ) * ( 1.0f + ctx->params.cp_kv * d_vdd );
+    ir_data_cp[ 0 ] -= ctx->params.cp_offset[ 0 ] * cp_corr;
+    if ( ( mode << 7 ) == ctx->params.calibration_mode_eeprom ) {
+        ir_data_cp[ 1 ] -= ctx->params.cp_offset[ 1 ] * cp_corr;
+    } else {
+        ir_data_cp[ 1 ] -= ( ctx->params.cp_offset[ 1 ] + ctx->params.il_chess_c[ 0 ] ) * cp_corr;
+    }
+    cp_corr = ctx->params.tgc * ir_data_cp[ sub_page ];
+
+    ks_ta_corr = 1.0f + ctx->params.ks_ta * d_ta;
+    ks_to_corr = 1.0f - ctx->params.ks_to[ 1 ] * 273.15f;
+
+    px_number = table->px_number[ sub_page ];
+    offset = table->offset[ sub_page ];
+    kta = table->kta[ sub_page ];
+    kv = table->kv[ sub_page ];
+    alpha_cp = table->alpha_cp[ sub_page ];
+    il_corr = table->il_corr[ sub_page ];
+    for ( i = 0; i < IRGRID3_SUBPAGE_PIXEL_COUNT; i++ ) {
+        ir_data = ( int16_t ) frame_data[ px_number[ i ] ] * gain;
+        ir_data -= offset[ i ] * ( 1.0f + kta[ i ] * d_ta ) * ( 1.0f + kv[ i ] * d_vdd );
+        ir_data += il_corr[ i ];
+        ir_data = ir_data * ( 1.0f / 0.95f ) - cp_corr;
+
+        alpha_compensated = alpha_cp[ i ] * ks_ta_corr;
+
+        raw_sx = alpha_compensated * alpha_compensated * alpha_compensated * ( ir_data + alpha_compensated * raw_ta_tr );
+        raw_sx = fast_root4( raw_sx ) * ctx->params.ks_to[ 1 ];
+
+        raw_to = fast_root4( ir_data / ( alpha_compensated * ks_to_corr + raw_sx ) + raw_ta_tr ) - 273.15f;
+
+        if ( raw_to < ctx->params.ct[ 1 ] ) {
+            range = 0;
+        } else if ( raw_to < ctx->params.ct[ 2 ] ) {
+            range = 1;
+        } else if ( raw_to < ctx->params.ct[ 3 ] ) {
+            range = 2;
+        } else {
+            range = 3;
+        }
+
+        raw_to = fast_root4( ir_data / ( alpha_compensated * alpha_corr_r[ range ] * 
+                             ( 1.0f + ctx->params.ks_to[ range ] * ( raw_to - ctx->params.ct[ range ] ) ) ) + raw_ta_tr ) - 273.15f;
+
+        px_matrix[ px_number[ i ] ] = raw_to;
+    }
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static void write_data_u16 ( irgrid3_t *ctx, uint16_t reg, uint16_t tx_data ) {
-    uint8_t tx_buf[ 2 ];
+    uint8_t tx_buf[ 4 ];
 
-    tx_buf[ 0 ] = (uint8_t)( tx_data >> 8 );
-    tx_buf[ 1 ] = (uint8_t)( tx_data & 0x00FF );
+    tx_buf[ 0 ] = (uint8_t)( reg >> 8 );
+    tx_buf[ 1 ] = (uint8_t)( reg & 0x00FF );
+    tx_buf[ 2 ] = (uint8_t)( tx_data >> 8 );
+    tx_buf[ 3 ] = (uint8_t)( tx_data & 0x00FF );
 
-    irgrid3_generic_write( ctx, reg, tx_buf, 2);
+    i2c_master_write( &ctx->i2c, tx_buf, 4 );
 }
 
 static uint16_t read_data_u16 ( irgrid3_t *ctx, uint16_t reg ) {
@@ -532,20 +756,15 @@ static uint16_t read_data_u16 ( irgrid3_t *ctx, uint16_t reg ) {
 }
 
 static void read_data_block ( irgrid3_t *ctx, uint16_t start_addr, uint16_t *data_out, uint16_t n_bytes ) {
-    uint8_t rx_buf[ 1664 ] = {0};
+    uint8_t *rx_buf;
     uint16_t cnt = 0;
-    uint16_t n_mem_addr = 0;
-    uint16_t i = 0;
 
-    n_mem_addr = 2 * n_bytes;
-
-    irgrid3_generic_read ( ctx, start_addr, rx_buf, n_mem_addr );
+    // Big-endian words are read directly into the output buffer and swapped in place.
+    irgrid3_generic_read ( ctx, start_addr, ( uint8_t * ) data_out, 2 * n_bytes );
 
     for ( cnt = 0; cnt < n_bytes; cnt++ ) {
-        i = cnt << 1;
-        data_out[ cnt ] = rx_buf[ i ];
-        data_out[ cnt ] <<= 8;
-        data_out[ cnt ] |= rx_buf[ i + 1 ];
+        rx_buf = ( uint8_t * ) &data_out[ cnt ];
+        data_out[ cnt ] = ( ( uint16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
     }
 }
 
@@ -1095,4 +1314,29 @@ static float gain_calculation ( irgrid3_t *ctx, uint16_t raw_gain ) {
 }
 
 
+static float fast_root4 ( float x ) {
+    union {
+        float f;
+        uint32_t u;
+    } conv;
+    float r;
+    float r2;
+    uint8_t cnt;
+
+    if ( x <= 0.0f ) {
+        return 0.0f;
+    }
+
+    // Initial estimate of x^-0.25 from the exponent bits, refined by Newton iterations.
+    conv.f = x;
+    conv.u = 0x4F58CAE4ul - ( conv.u >> 2 );
+    r = conv.f;
+    for ( cnt = 0; cnt < 3; cnt++ ) {
+        r2 = r * r;
+        r = r * ( 1.25f - 0.25f * x * r2 * r2 );
+    }
+
+    return x * r * r * r;
+}
+
 // ------------------------------------------------------------------------- END
@@ -160,6 +160,14 @@ extern "C"{
  */
 #define IRGRID4_DEVICE_ADDRESS              0x33
 
+/**
+ * @brief IR Grid 4 frame timing setting.
+ * @details Timeout of #irgrid4_sync_frame, twice the subpage period at 0.5 Hz,
+ * and the marker of an empty pipeline slot.
+ */
+#define IRGRID4_SYNC_TIMEOUT_MS             4000
+#define IRGRID4_PIPELINE_NONE               0xFF
+
 /*! @} */ // irgrid4_set
 
 /**
@@ -220,6 +228,23 @@ typedef struct
 
 } irgrid4_params_t;
 
+/**
+ * @brief IR Grid 4 Click frame pipeline object.
+ * @details Triple-buffered frame pipeline object definition of IR Grid 4 Click driver.
+ * The next subpage is read into one buffer, the latest one waits in another and the
+ * consumer holds the third one until it releases it.
+ */
+typedef struct
+{
+    uint16_t *frame[ 3 ];       /**< Three user provided frame buffers (242 words each). */
+    uint8_t  wr_idx;            /**< Index of the buffer the next subpage is read into. */
+    volatile uint8_t pub_idx;   /**< Index of the latest published buffer. */
+    volatile uint8_t pub_cnt;   /**< Incremented on every published frame. */
+    volatile uint8_t rd_idx;    /**< Index of the buffer held by the consumer. */
+    uint8_t  rd_cnt;            /**< Publish count of the last frame taken by the consumer. */
+
+} irgrid4_pipeline_t;
+
 /**
  * @brief IR Grid 4 Click context object.
  * @details Context object definition of IR Grid 4 Click driver.
@@ -413,11 +438,12 @@ err_t irgrid4_dump_eeprom ( irgrid4_t *ctx );
 
 /**
  * @brief IR Grid 4 sync frame function.
- * @details This function synchronize data frame.
+ * @details This function synchronize data frame. It clears the data ready flag
+ * and waits for the next subpage for up to #IRGRID4_SYNC_TIMEOUT_MS.
  * @param[in] ctx : Click context object.
  * See #irgrid4_t object definition for detailed explanation.
  * @return @li @c  0 - Success,
- *         @li @c -1 - Error.
+ *         @li @c -1 - Error or timeout.
  * See #err_t definition for detailed explanation.
  * @note None.
  */
@@ -448,6 +474,100 @@ err_t irgrid4_trigger_measurement ( irgrid4_t *ctx );
  */
 err_t irgrid4_get_frame_data ( irgrid4_t *ctx, uint16_t *frame_data );
 
+/**
+ * @brief IR Grid 4 check data ready function.
+ * @details This function checks whether a new subpage is available in the device RAM.
+ * @param[in] ctx : Click context object.
+ * See #irgrid4_t object definition for detailed explanation.
+ * @param[out] ready : @li @c 0 - No new data,
+ *                     @li @c 1 - New data available.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t irgrid4_check_data_ready ( irgrid4_t *ctx, uint8_t *ready );
+
+/**
+ * @brief IR Grid 4 read frame data function.
+ * @details This function reads and validates the available subpage directly into
+ * the frame buffer without waiting for the data ready flag, and clears the flag afterwards.
+ * @param[in] ctx : Click context object.
+ * See #irgrid4_t object definition for detailed explanation.
+ * @param[out] frame_data : RAM data frame read [242 words in total].
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Should be called once #irgrid4_check_data_ready reports new data.
+ */
+err_t irgrid4_read_frame_data ( irgrid4_t *ctx, uint16_t *frame_data );
+
+/**
+ * @brief IR Grid 4 wait frame data function.
+ * @details This function polls the data ready flag with increasing delay between
+ * polls and reads the subpage once it is available.
+ * @param[in] ctx : Click context object.
+ * See #irgrid4_t object definition for detailed explanation.
+ * @param[out] frame_data : RAM data frame read [242 words in total].
+ * @param[in] timeout_ms : Timeout in milliseconds.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error or timeout.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t irgrid4_wait_frame_data ( irgrid4_t *ctx, uint16_t *frame_data, uint16_t timeout_ms );
+
+/**
+ * @brief IR Grid 4 pipeline init function.
+ * @details This function initializes the triple-buffered frame pipeline.
+ * @param[out] pipe : Frame pipeline object.
+ * See #irgrid4_pipeline_t object definition for detailed explanation.
+ * @param[in] frame_0 : First frame buffer (242 words).
+ * @param[in] frame_1 : Second frame buffer (242 words).
+ * @param[in] frame_2 : Third frame buffer (242 words).
+ * @return Nothing.
+ * @note None.
+ */
+void irgrid4_pipeline_init ( irgrid4_pipeline_t *pipe, uint16_t *frame_0, uint16_t *frame_1, uint16_t *frame_2 );
+
+/**
+ * @brief IR Grid 4 pipeline process function.
+ * @details This function checks the data ready flag and, if new data is available, reads
+ * the subpage into the free buffer and publishes it. It never waits for the device and
+ * never writes the buffer held by the consumer.
+ * @param[in] ctx : Click context object.
+ * See #irgrid4_t object definition for detailed explanation.
+ * @param[in] pipe : Frame pipeline object.
+ * See #irgrid4_pipeline_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Should be called periodically, e.g. from a timer task.
+ */
+err_t irgrid4_pipeline_process ( irgrid4_t *ctx, irgrid4_pipeline_t *pipe );
+
+/**
+ * @brief IR Grid 4 pipeline get frame function.
+ * @details This function takes the latest published frame. The consumer owns the
+ * returned buffer until it calls #irgrid4_pipeline_release or takes the next frame.
+ * @param[in] pipe : Frame pipeline object.
+ * See #irgrid4_pipeline_t object definition for detailed explanation.
+ * @return Pointer to frame data or NULL if no new frame is available.
+ * @note May be called while #irgrid4_pipeline_process runs from an interrupt.
+ */
+uint16_t *irgrid4_pipeline_get_frame ( irgrid4_pipeline_t *pipe );
+
+/**
+ * @brief IR Grid 4 pipeline release function.
+ * @details This function returns the buffer taken by #irgrid4_pipeline_get_frame
+ * to the pipeline.
+ * @param[in] pipe : Frame pipeline object.
+ * See #irgrid4_pipeline_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void irgrid4_pipeline_release ( irgrid4_pipeline_t *pipe );
+
 /**
  * @brief IR Grid 4 get parameters function.
  * @details This function validates EEPROM data and extracts calibration parameters from it.
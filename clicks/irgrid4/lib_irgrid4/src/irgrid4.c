@@ -218,6 +218,34 @@ static err_t irgrid4_validate_frame_data ( uint16_t *frame_data );
  */
 static err_t irgrid4_validate_aux_data ( uint16_t *aux_data );
 
+/**
+ * @brief IR Grid 4 read subpage function.
+ * @details This function reads and validates the subpage selected by the status register value.
+ * @param[in] ctx : Click context object.
+ * See #irgrid4_t object definition for detailed explanation.
+ * @param[in] status : Status register value.
+ * @param[out] frame_data : RAM data frame read [242 words in total].
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t irgrid4_read_subpage ( irgrid4_t *ctx, uint16_t status, uint16_t *frame_data );
+
+/**
+ * @brief IR Grid 4 wait data ready function.
+ * @details This function polls the data ready flag with increasing delay between
+ * polls, without waiting longer than the timeout.
+ * @param[in] ctx : Click context object.
+ * See #irgrid4_t object definition for detailed explanation.
+ * @param[in] timeout_ms : Timeout in milliseconds.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error or timeout.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t irgrid4_wait_data_ready ( irgrid4_t *ctx, uint16_t timeout_ms );
+
 void irgrid4_cfg_setup ( irgrid4_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -294,14 +322,16 @@ err_t irgrid4_write_data ( irgrid4_t *ctx, uint16_t addr, uint16_t data_in )
 err_t irgrid4_read_data ( irgrid4_t *ctx, uint16_t addr, uint16_t *data_out, uint8_t len )
 {
     err_t error_flag = IRGRID4_OK;
-    uint8_t data_buf[ 96 ] = { 0 };
-    if ( ( 0 == len ) || ( len > 48 ) || ( NULL == data_out ) )
+    uint8_t addr_buf[ 2 ] = { 0 };
+    uint8_t *data_buf = ( uint8_t * ) data_out;
+    if ( ( 0 == len ) || ( NULL == data_out ) )
     {
         return IRGRID4_ERROR;
     }
-    data_buf[ 0 ] = ( uint8_t ) ( ( addr >> 8 ) & 0xFF );
-    data_buf[ 1 ] = ( uint8_t ) ( addr & 0xFF );
-    error_flag |= i2c_master_write_then_read ( &ctx->i2c, data_buf, 2, data_buf, len * 2 );
+    addr_buf[ 0 ] = ( uint8_t ) ( ( addr >> 8 ) & 0xFF );
+    addr_buf[ 1 ] = ( uint8_t ) ( addr & 0xFF );
+    // Big-endian words are read directly into the output buffer and swapped in place.
+    error_flag |= i2c_master_write_then_read ( &ctx->i2c, addr_buf, 2, data_buf, len * 2 );
     for ( uint16_t cnt = 0; ( cnt < len ) && ( IRGRID4_OK == error_flag ); cnt++ )
     {
         data_out[ cnt ] = ( ( uint16_t ) data_buf[ cnt * 2 ] << 8 ) | data_buf[ cnt * 2 + 1 ];
@@ -355,13 +385,10 @@ err_t irgrid4_dump_eeprom ( irgrid4_t *ctx )
 
 err_t irgrid4_sync_frame ( irgrid4_t *ctx )
 {
-    uint16_t status = 0;
-    err_t error_flag = IRGRID4_OK;
-    error_flag |= irgrid4_write_data ( ctx, IRGRID4_ADDR_REG_STATUS, IRGRID4_STATUS_OVERWRITE_EN );
-
-    while ( ( IRGRID4_STATUS_DATA_READY != ( status & IRGRID4_STATUS_DATA_READY ) ) && ( IRGRID4_OK == error_flag ) )
+    err_t error_flag = irgrid4_write_data ( ctx, IRGRID4_ADDR_REG_STATUS, IRGRID4_STATUS_OVERWRITE_EN );
+    if ( IRGRID4_OK == error_flag )
     {
-        error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_REG_STATUS, &status, 1 );
+        error_flag = irgrid4_wait_data_ready ( ctx, IRGRID4_SYNC_TIMEOUT_MS );
     }
     return error_flag;
 }
@@ -393,81 +420,114 @@ err_t irgrid4_trigger_measurement ( irgrid4_t *ctx )
 
 err_t irgrid4_get_frame_data ( irgrid4_t *ctx, uint16_t *frame_data )
 {
-    uint16_t control = 0;
     uint16_t status = 0;
     err_t error_flag = irgrid4_sync_frame ( ctx );
     if ( IRGRID4_OK == error_flag )
     {
-        if ( IRGRID4_STATUS_SUBPAGE != ( status & IRGRID4_STATUS_SUBPAGE ) )
-        {
-            error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START, &frame_data[ 0 ], 32 );
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 64, &frame_data[ 32 ], 32 );
-            }
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 128, &frame_data[ 64 ], 32 );
-            }
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 192, &frame_data[ 96 ], 32 );
-            }
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 256, &frame_data[ 128 ], 32 );
-            }
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 320, &frame_data[ 160 ], 32 );
-            }
-        }
-        else
-        {   
-            error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 32, &frame_data[ 0 ], 32 );
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 96, &frame_data[ 32 ], 32 );
-            }
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 160, &frame_data[ 64 ], 32 );
-            }
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 224, &frame_data[ 96 ], 32 );
-            }
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 288, &frame_data[ 128 ], 32 );
-            }
-            if ( IRGRID4_OK == error_flag )
-            {
-                error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + 352, &frame_data[ 160 ], 32 );
-            }
-        }
+        error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_REG_STATUS, &status, 1 );
     }
     if ( IRGRID4_OK == error_flag )
     {
-        error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_END - 63, &frame_data[ 192 ], 48 );
+        error_flag |= irgrid4_read_subpage ( ctx, status, frame_data );
     }
-    if ( IRGRID4_OK == error_flag )
+    return error_flag;
+}
+
+err_t irgrid4_check_data_ready ( irgrid4_t *ctx, uint8_t *ready )
+{
+    uint16_t status = 0;
+    err_t error_flag = irgrid4_read_data ( ctx, IRGRID4_ADDR_REG_STATUS, &status, 1 );
+    *ready = 0;
+    if ( ( IRGRID4_OK == error_flag ) && ( status & IRGRID4_STATUS_DATA_READY ) )
     {
-        error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_REG_CONTROL, &control, 1 );
-        frame_data[ 240 ] = control;
-        frame_data[ 241 ] = status & IRGRID4_STATUS_SUBPAGE;
+        *ready = 1;
     }
+    return error_flag;
+}
+
+err_t irgrid4_read_frame_data ( irgrid4_t *ctx, uint16_t *frame_data )
+{
+    uint16_t status = 0;
+    err_t error_flag = irgrid4_read_data ( ctx, IRGRID4_ADDR_REG_STATUS, &status, 1 );
     if ( IRGRID4_OK == error_flag )
     {
-        error_flag |= irgrid4_validate_aux_data ( &frame_data[ 192 ] );
+        error_flag |= irgrid4_read_subpage ( ctx, status, frame_data );
     }
+    // Clear the data ready flag so the next subpage can be detected.
+    error_flag |= irgrid4_write_data ( ctx, IRGRID4_ADDR_REG_STATUS, IRGRID4_STATUS_OVERWRITE_EN );
+    return error_flag;
+}
+
+err_t irgrid4_wait_frame_data ( irgrid4_t *ctx, uint16_t *frame_data, uint16_t timeout_ms )
+{
+    err_t error_flag = irgrid4_wait_data_ready ( ctx, timeout_ms );
     if ( IRGRID4_OK == error_flag )
     {
-        error_flag |= irgrid4_validate_frame_data ( frame_data );
+        error_flag = irgrid4_read_frame_data ( ctx, frame_data );
+    }
+    return error_flag;
+}
+
+void irgrid4_pipeline_init ( irgrid4_pipeline_t *pipe, uint16_t *frame_0, uint16_t *frame_1, uint16_t *frame_2 )
+{
+    pipe->frame[ 0 ] = frame_0;
+    pipe->frame[ 1 ] = frame_1;
+    pipe->frame[ 2 ] = frame_2;
+    pipe->wr_idx = 0;
+    pipe->pub_idx = IRGRID4_PIPELINE_NONE;
+    pipe->pub_cnt = 0;
+    pipe->rd_idx = IRGRID4_PIPELINE_NONE;
+    pipe->rd_cnt = 0;
+}
+
+err_t irgrid4_pipeline_process ( irgrid4_t *ctx, irgrid4_pipeline_t *pipe )
+{
+    uint8_t ready = 0;
+    uint8_t idx = 0;
+    err_t error_flag = irgrid4_check_data_ready ( ctx, &ready );
+    if ( ( IRGRID4_OK == error_flag ) && ready )
+    {
+        error_flag = irgrid4_read_frame_data ( ctx, pipe->frame[ pipe->wr_idx ] );
+        if ( IRGRID4_OK == error_flag )
+        {
+            pipe->pub_idx = pipe->wr_idx;
+            pipe->pub_cnt++;
+            // Next subpage goes to the buffer that is neither published nor held
+            while ( ( idx == pipe->pub_idx ) || ( idx == pipe->rd_idx ) )
+            {
+                idx++;
+            }
+            pipe->wr_idx = idx;
+        }
     }
     return error_flag;
 }
 
+uint16_t *irgrid4_pipeline_get_frame ( irgrid4_pipeline_t *pipe )
+{
+    uint8_t idx = 0;
+    uint8_t cnt = 0;
+    if ( pipe->rd_cnt == pipe->pub_cnt )
+    {
+        return NULL;
+    }
+    // Take it again if a frame was published while taking it
+    do
+    {
+        cnt = pipe->pub_cnt;
+        idx = pipe->pub_idx;
+        pipe->rd_idx = idx;
+    }
+    while ( ( idx != pipe->pub_idx ) || ( cnt != pipe->pub_cnt ) );
+    pipe->rd_cnt = cnt;
+    return pipe->frame[ idx ];
+}
+
+void irgrid4_pipeline_release ( irgrid4_pipeline_t *pipe )
+{
+    pipe->rd_idx = IRGRID4_PIPELINE_NONE;
+}
+
 err_t irgrid4_get_parameters ( irgrid4_t *ctx )
 {
     err_t error_flag = irgrid4_check_eeprom_valid ( ctx );
@@ -1369,4 +1429,68 @@ static err_t irgrid4_validate_aux_data ( uint16_t *aux_data )
     return IRGRID4_OK;
 }
 
+static err_t irgrid4_read_subpage ( irgrid4_t *ctx, uint16_t status, uint16_t *frame_data )
+{
+    uint16_t control = 0;
+    uint16_t subpage_offset = ( status & IRGRID4_STATUS_SUBPAGE ) ? 32 : 0;
+    err_t error_flag = IRGRID4_OK;
+    for ( uint8_t row = 0; ( row < 6 ) && ( IRGRID4_OK == error_flag ); row++ )
+    {
+        error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_START + subpage_offset + row * 64, 
+                                          &frame_data[ row * 32 ], 32 );
+    }
+    if ( IRGRID4_OK == error_flag )
+    {
+        error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_RAM_END - 63, &frame_data[ 192 ], 48 );
+    }
+    if ( IRGRID4_OK == error_flag )
+    {
+        error_flag |= irgrid4_read_data ( ctx, IRGRID4_ADDR_REG_CONTROL, &control, 1 );
+        frame_data[ 240 ] = control;
+        frame_data[ 241 ] = status & IRGRID4_STATUS_SUBPAGE;
+    }
+    if ( IRGRID4_OK == error_flag )
+    {
+        error_flag |= irgrid4_validate_aux_data ( &frame_data[ 192 ] );
+    }
+    if ( IRGRID4_OK == error_flag )
+    {
+        error_flag |= irgrid4_validate_frame_data ( frame_data );
+    }
+    return error_flag;
+}
+
+static err_t irgrid4_wait_data_ready ( irgrid4_t *ctx, uint16_t timeout_ms )
+{
+    uint16_t elapsed_ms = 0;
+    uint16_t backoff_ms = 1;
+    uint16_t delay_ms = 0;
+    uint8_t ready = 0;
+    err_t error_flag = irgrid4_check_data_ready ( ctx, &ready );
+    while ( ( IRGRID4_OK == error_flag ) && !ready )
+    {
+        if ( elapsed_ms >= timeout_ms )
+        {
+            return IRGRID4_ERROR;
+        }
+        // Never past the timeout, so elapsed_ms cannot overflow
+        delay_ms = timeout_ms - elapsed_ms;
+        if ( delay_ms > backoff_ms )
+        {
+            delay_ms = backoff_ms;
+        }
+        for ( uint16_t cnt = 0; cnt < delay_ms; cnt++ )
+        {
+            Delay_1ms ( );
+        }
+        elapsed_ms += delay_ms;
+        if ( backoff_ms < 16 )
+        {
+            backoff_ms <<= 1;
+        }
+        error_flag = irgrid4_check_data_ready ( ctx, &ready );
+    }
+    return error_flag;
+}
+
 // ------------------------------------------------------------------------- END
@@ -119,6 +119,20 @@ extern "C"{
 #define LIGHTRANGER12_OFFSET_BUFFER_SIZE            488
 #define LIGHTRANGER12_XTALK_BUFFER_SIZE             776
 
+/**
+ * @brief LightRanger 12 firmware download setting.
+ * @details Specified firmware download setting of LightRanger 12 Click driver.
+ * The bus is temporarily raised to the FW speed during the download and restored afterwards.
+ */
+#define LIGHTRANGER12_FW_SIZE                       0x15000ul
+#define LIGHTRANGER12_FW_PAGE_SIZE                  0x8000ul
+#define LIGHTRANGER12_FW_PAGE_FIRST                 0x09
+#define LIGHTRANGER12_FW_PAGE_COUNT                 3
+#define LIGHTRANGER12_FW_CHUNK_SIZE                 512
+#define LIGHTRANGER12_FW_I2C_SPEED                  I2C_MASTER_SPEED_FAST
+#define LIGHTRANGER12_FW_SPI_SPEED                  3000000ul
+#define LIGHTRANGER12_FW_PROBE_TIMEOUT_MS           20
+
 /**
  * @brief LightRanger 12 resolution setting.
  * @details Specified resolution setting of LightRanger 12 Click driver.
@@ -264,6 +278,9 @@ typedef struct lightranger12_s
     lightranger12_master_io_t write_f;  /**< Master write function. */
     lightranger12_master_io_t read_f;   /**< Master read function. */
 
+    uint32_t i2c_speed;             /**< I2C serial speed restored after the firmware download. */
+    uint32_t spi_speed;             /**< SPI serial speed restored after the firmware download. */
+
     uint8_t stream_count;           /**< Results stream count, value auto-incremented at each range. */
     uint32_t data_read_size;        /**< Size of data read though I2C or SPI. */
     uint8_t offset_data[ LIGHTRANGER12_OFFSET_BUFFER_SIZE ];    /**< Offset buffer. */
@@ -334,6 +351,26 @@ typedef union
 
 } lightranger12_block_header_t;
 
+/**
+ * @brief LightRanger 12 Click firmware read callback definition.
+ * @details Reads @b len bytes of the raw firmware image starting at @b offset.
+ * The image is the firmware without the page address words.
+ */
+typedef err_t ( *lightranger12_fw_read_t )( void *handle, uint32_t offset, uint8_t *data_out, uint16_t len );
+
+/**
+ * @brief LightRanger 12 Click firmware source object.
+ * @details Firmware source object definition of LightRanger 12 Click driver.
+ */
+typedef struct
+{
+    lightranger12_fw_read_t read_f; /**< Firmware image read function. */
+    void *handle;                   /**< User handle passed to the read function (file, flash, ...). */
+    uint32_t size;                  /**< Firmware image size in bytes, up to LIGHTRANGER12_FW_SIZE. */
+    uint32_t crc32;                 /**< CRC-32 (IEEE 802.3) of the firmware image. */
+
+} lightranger12_fw_source_t;
+
 /**
  * @brief LightRanger 12 Click return value data.
  * @details Predefined enum values for driver return values.
@@ -560,6 +597,36 @@ err_t lightranger12_set_i2c_address ( lightranger12_t *ctx, uint8_t i2c_address
  */
 err_t lightranger12_sensor_init ( lightranger12_t *ctx );
 
+/**
+ * @brief LightRanger 12 sensor init from external firmware function.
+ * @details This function initializes the sensor the same way as #lightranger12_sensor_init,
+ * but the firmware image is streamed in chunks from the selected source instead of the
+ * built-in buffer. The image CRC is checked before the sensor MCU is started.
+ * @param[in] ctx : Click context object.
+ * See #lightranger12_t object definition for detailed explanation.
+ * @param[in] fw : Firmware source, NULL for the built-in firmware.
+ * See #lightranger12_fw_source_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note If the firmware is already running (warm restart of the host) the download is skipped,
+ * the ranging is stopped and only the configuration is sent again.
+ */
+err_t lightranger12_sensor_init_ext ( lightranger12_t *ctx, lightranger12_fw_source_t *fw );
+
+/**
+ * @brief LightRanger 12 check firmware running function.
+ * @details This function checks whether the sensor firmware is already loaded and answering
+ * by issuing a short DCI read of the pipe control register.
+ * @param[in] ctx : Click context object.
+ * See #lightranger12_t object definition for detailed explanation.
+ * @return @li @c  0 - Firmware is running,
+ *         @li @c -1 - Error, firmware must be downloaded.
+ * See #err_t definition for detailed explanation.
+ * @note The check takes at most #LIGHTRANGER12_FW_PROBE_TIMEOUT_MS milliseconds.
+ */
+err_t lightranger12_check_fw_running ( lightranger12_t *ctx );
+
 /**
  * @brief LightRanger 12 dci write data function.
  * @details This function writes 'extra data' to DCI. The data can be simple data, or casted structure.
@@ -103,6 +103,58 @@ static err_t lightranger12_send_offset_data ( lightranger12_t *ctx, uint8_t reso
  */
 static err_t lightranger12_send_xtalk_data ( lightranger12_t *ctx, uint8_t resolution );
 
+/**
+ * @brief LightRanger 12 load firmware function.
+ * @details This function reboots the sensor, downloads the firmware and waits for the sensor MCU to boot.
+ * @param[in] ctx : Click context object.
+ * See #lightranger12_t object definition for detailed explanation.
+ * @param[in] fw : Firmware source, NULL for the built-in firmware.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t lightranger12_load_fw ( lightranger12_t *ctx, lightranger12_fw_source_t *fw );
+
+/**
+ * @brief LightRanger 12 stream firmware function.
+ * @details This function writes the firmware image from the external source page by page
+ * through the temporary buffer and checks its CRC.
+ * @param[in] ctx : Click context object.
+ * See #lightranger12_t object definition for detailed explanation.
+ * @param[in] fw : Firmware source.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t lightranger12_stream_fw ( lightranger12_t *ctx, lightranger12_fw_source_t *fw );
+
+/**
+ * @brief LightRanger 12 set bus speed function.
+ * @details This function sets the serial speed of the selected driver interface.
+ * @param[in] ctx : Click context object.
+ * See #lightranger12_t object definition for detailed explanation.
+ * @param[in] i2c_speed : I2C serial speed.
+ * @param[in] spi_speed : SPI serial speed.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t lightranger12_set_bus_speed ( lightranger12_t *ctx, uint32_t i2c_speed, uint32_t spi_speed );
+
+/**
+ * @brief LightRanger 12 CRC-32 function.
+ * @details This function updates the CRC-32 (IEEE 802.3, reflected 0xEDB88320) of the data.
+ * @param[in] crc : Running CRC, start with 0xFFFFFFFF and invert the final value.
+ * @param[in] data_in : Data buffer.
+ * @param[in] len : Number of bytes.
+ * @return Updated CRC.
+ * @note None.
+ */
+static uint32_t lightranger12_crc32 ( uint32_t crc, uint8_t *data_in, uint16_t len );
+
 /**
  * @brief LightRanger 12 I2C writing function.
  * @details This function writes a desired number of data bytes starting from
@@ -234,6 +286,7 @@ err_t lightranger12_init ( lightranger12_t *ctx, lightranger12_cfg_t *cfg )
         {
             return I2C_MASTER_ERROR;
         }
+        ctx->i2c_speed = cfg->i2c_speed;
 
         ctx->read_f  = lightranger12_i2c_read;
         ctx->write_f = lightranger12_i2c_write;
@@ -269,6 +322,7 @@ err_t lightranger12_init ( lightranger12_t *ctx, lightranger12_cfg_t *cfg )
         {
             return SPI_MASTER_ERROR;
         }
+        ctx->spi_speed = cfg->spi_speed;
 
         spi_master_set_chip_select_polarity( cfg->cs_polarity );
         spi_master_deselect_device( ctx->chip_select );
@@ -373,116 +427,30 @@ err_t lightranger12_set_i2c_address ( lightranger12_t *ctx, uint8_t i2c_address
 }
 
 err_t lightranger12_sensor_init ( lightranger12_t *ctx )
+{
+    return lightranger12_sensor_init_ext ( ctx, NULL );
+}
+
+err_t lightranger12_sensor_init_ext ( lightranger12_t *ctx, lightranger12_fw_source_t *fw )
 {
     err_t error_flag = LIGHTRANGER12_OK;
     uint8_t pipe_ctrl[ ] = { 0x01, 0x00, 0x01, 0x00 };
     uint8_t single_range[ ] = { 0x01, 0x00, 0x00, 0x00 };
-    uint8_t reg_data = 0;
-    
-    // SW reboot sequence
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0009, 0x04 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000F, 0x40 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000A, 0x03 );
-    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data  );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x01 );
 
-    error_flag |= lightranger12_write_byte ( ctx, 0x0101, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0102, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x010A, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x4002, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x4002, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x010A, 0x03 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0103, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000F, 0x43 );
-    Delay_1ms ( );
-
-    error_flag |= lightranger12_write_byte ( ctx, 0x000F, 0x40 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000A, 0x01 );
-    Delay_100ms ( );
-    
-    // Wait for sensor booted (several ms required to get sensor ready)
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
-    error_flag |= lightranger12_poll_for_answer ( ctx, 1, 0, 0x0006, 0xFF, 0x01 );
-    if ( LIGHTRANGER12_OK != error_flag )
+    // Skip the firmware download if the sensor kept it over a host reset
+    if ( LIGHTRANGER12_OK == lightranger12_check_fw_running ( ctx ) )
     {
-        return error_flag;
+        error_flag |= lightranger12_stop_ranging ( ctx );
     }
-    error_flag |= lightranger12_write_byte ( ctx, 0x000E, 0x01 );
-
-    // Enable FW access
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0006, 0x01 );
-    error_flag |= lightranger12_poll_for_answer ( ctx, 1, 0, 0x0021, 0xFF, 0x04 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
-
-    // Enable host access to GO1
-    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x01 );
-
-    // Power ON status
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0101, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0102, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x010A, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x4002, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x4002, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x010A, 0x03 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0103, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x400F, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x021A, 0x43 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x021A, 0x03 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x021A, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x021A, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0219, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x021B, 0x00 );
-
-    // Wake up MCU
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
-    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data );
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0020, 0x07 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0020, 0x06 );
-
-    // Download FW into VL53LMZ, address word is added at the beginning of each buffer block
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x09 );
-    error_flag |= lightranger12_write_data ( ctx, ( uint8_t * ) &lightranger12_firmware_buf[ 0 ], 0x8002 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x0A );
-    error_flag |= lightranger12_write_data ( ctx, ( uint8_t * ) &lightranger12_firmware_buf[ 0x8002 ], 0x8002 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x0B );
-    error_flag |= lightranger12_write_data ( ctx, ( uint8_t * ) &lightranger12_firmware_buf[ 0x10004 ], 0x5002 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x01 );
-
-    // Check if FW is correctly downloaded
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x01 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0006, 0x03 );
-    if ( LIGHTRANGER12_OK != error_flag )
+    else
     {
-        return error_flag;
+        error_flag |= lightranger12_load_fw ( ctx, fw );
     }
-    Delay_10ms ( );
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
-    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x01 );
-    
-    // Reset MCU and wait boot
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0114, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0115, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0116, 0x42 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x0117, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000B, 0x00 );
-    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x00 );
-    error_flag |= lightranger12_write_byte ( ctx, 0x000B, 0x01 );
-    error_flag |= lightranger12_poll_for_mcu_boot ( ctx );
     if ( LIGHTRANGER12_OK != error_flag )
     {
         return error_flag;
     }
-    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x02 );
-    
+
     // Get offset NVM data and store them into the offset buffer
     error_flag |= lightranger12_write_data ( ctx, ( uint8_t * ) &lightranger12_get_nvm_cmd_buf[ 0 ], 
                                              sizeof ( lightranger12_get_nvm_cmd_buf ) );
@@ -504,6 +472,48 @@ err_t lightranger12_sensor_init ( lightranger12_t *ctx )
     return error_flag;
 }
 
+err_t lightranger12_check_fw_running ( lightranger12_t *ctx )
+{
+    err_t error_flag = LIGHTRANGER12_OK;
+    uint8_t cmd[ ] = { ( uint8_t ) ( ( LIGHTRANGER12_DCI_PIPE_CONTROL >> 8 ) & 0xFF ), 
+                       ( uint8_t ) ( LIGHTRANGER12_DCI_PIPE_CONTROL & 0xFF ), 
+                       0x00, 0x40, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x02, 0x00, 0x08 };
+    uint8_t timeout = 0;
+
+    // Clear the command status so a stale answer is not taken as valid
+    memset ( ctx->temp_buf, 0, 4 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x02 );
+    error_flag |= lightranger12_write_multi ( ctx, LIGHTRANGER12_UI_CMD_STATUS, ctx->temp_buf, 4 );
+
+    // Request pipe control reading from FW, a cold sensor never answers
+    error_flag |= lightranger12_write_multi ( ctx, ( LIGHTRANGER12_UI_CMD_END - 11 ), cmd, sizeof ( cmd ) );
+    if ( LIGHTRANGER12_OK != error_flag )
+    {
+        return LIGHTRANGER12_ERROR;
+    }
+    do 
+    {
+        Delay_1ms ( );
+        if ( ( LIGHTRANGER12_OK != lightranger12_read_multi ( ctx, LIGHTRANGER12_UI_CMD_STATUS, ctx->temp_buf, 4 ) ) || 
+             ( timeout++ >= LIGHTRANGER12_FW_PROBE_TIMEOUT_MS ) )
+        {
+            return LIGHTRANGER12_ERROR;
+        }
+    }
+    while ( 0x03 != ctx->temp_buf[ 1 ] );
+
+    // Pipe control written by the sensor init must be read back
+    error_flag |= lightranger12_read_multi ( ctx, LIGHTRANGER12_UI_CMD_START, ctx->temp_buf, 16 );
+    lightranger12_swap_buffer ( ctx->temp_buf, 16 );
+    if ( ( LIGHTRANGER12_OK == error_flag ) && 
+         ( 0x01 == ctx->temp_buf[ 4 ] ) && ( 0x00 == ctx->temp_buf[ 5 ] ) && 
+         ( 0x01 == ctx->temp_buf[ 6 ] ) && ( 0x00 == ctx->temp_buf[ 7 ] ) )
+    {
+        return LIGHTRANGER12_OK;
+    }
+    return LIGHTRANGER12_ERROR;
+}
+
 err_t lightranger12_dci_write_data ( lightranger12_t *ctx, uint16_t index, uint8_t *data_in, uint16_t data_size )
 {
     err_t error_flag = LIGHTRANGER12_OK;
@@ -993,6 +1003,204 @@ err_t lightranger12_get_ranging_data ( lightranger12_t *ctx, lightranger12_resul
     return error_flag;
 }
 
+static err_t lightranger12_load_fw ( lightranger12_t *ctx, lightranger12_fw_source_t *fw )
+{
+    err_t error_flag = LIGHTRANGER12_OK;
+    uint8_t reg_data = 0;
+    
+    // SW reboot sequence
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0009, 0x04 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000F, 0x40 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000A, 0x03 );
+    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data  );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x01 );
+
+    error_flag |= lightranger12_write_byte ( ctx, 0x0101, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0102, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x010A, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x4002, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x4002, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x010A, 0x03 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0103, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000F, 0x43 );
+    Delay_1ms ( );
+
+    error_flag |= lightranger12_write_byte ( ctx, 0x000F, 0x40 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000A, 0x01 );
+    Delay_100ms ( );
+    
+    // Wait for sensor booted (several ms required to get sensor ready)
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
+    error_flag |= lightranger12_poll_for_answer ( ctx, 1, 0, 0x0006, 0xFF, 0x01 );
+    if ( LIGHTRANGER12_OK != error_flag )
+    {
+        return error_flag;
+    }
+    error_flag |= lightranger12_write_byte ( ctx, 0x000E, 0x01 );
+
+    // Enable FW access
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0006, 0x01 );
+    error_flag |= lightranger12_poll_for_answer ( ctx, 1, 0, 0x0021, 0xFF, 0x04 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
+
+    // Enable host access to GO1
+    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x01 );
+
+    // Power ON status
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0101, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0102, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x010A, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x4002, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x4002, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x010A, 0x03 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0103, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x400F, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x021A, 0x43 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x021A, 0x03 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x021A, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x021A, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0219, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x021B, 0x00 );
+
+    // Wake up MCU
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
+    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data );
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0020, 0x07 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0020, 0x06 );
+
+    // Download FW into VL53LMZ at the raised bus speed
+    error_flag |= lightranger12_set_bus_speed ( ctx, LIGHTRANGER12_FW_I2C_SPEED, LIGHTRANGER12_FW_SPI_SPEED );
+    if ( NULL == fw )
+    {
+        // Address word is added at the beginning of each buffer block
+        error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x09 );
+        error_flag |= lightranger12_write_data ( ctx, ( uint8_t * ) &lightranger12_firmware_buf[ 0 ], 0x8002 );
+        error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x0A );
+        error_flag |= lightranger12_write_data ( ctx, ( uint8_t * ) &lightranger12_firmware_buf[ 0x8002 ], 0x8002 );
+        error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x0B );
+        error_flag |= lightranger12_write_data ( ctx, ( uint8_t * ) &lightranger12_firmware_buf[ 0x10004 ], 0x5002 );
+    }
+    else
+    {
+        error_flag |= lightranger12_stream_fw ( ctx, fw );
+    }
+    error_flag |= lightranger12_set_bus_speed ( ctx, ctx->i2c_speed, ctx->spi_speed );
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x01 );
+
+    // Check if FW is correctly downloaded
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x01 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0006, 0x03 );
+    if ( LIGHTRANGER12_OK != error_flag )
+    {
+        return error_flag;
+    }
+    Delay_10ms ( );
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
+    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x01 );
+    
+    // Reset MCU and wait boot
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0114, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0115, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0116, 0x42 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x0117, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000B, 0x00 );
+    error_flag |= lightranger12_read_byte ( ctx, 0x7FFF, &reg_data );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000C, 0x00 );
+    error_flag |= lightranger12_write_byte ( ctx, 0x000B, 0x01 );
+    error_flag |= lightranger12_poll_for_mcu_boot ( ctx );
+    if ( LIGHTRANGER12_OK != error_flag )
+    {
+        return error_flag;
+    }
+    error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, 0x02 );
+    return error_flag;
+}
+
+static err_t lightranger12_stream_fw ( lightranger12_t *ctx, lightranger12_fw_source_t *fw )
+{
+    err_t error_flag = LIGHTRANGER12_OK;
+    uint32_t offset = 0;
+    uint32_t crc = 0xFFFFFFFFul;
+    uint16_t address = 0;
+    uint16_t chunk = 0;
+    uint8_t page = LIGHTRANGER12_FW_PAGE_FIRST;
+
+    if ( ( NULL == fw->read_f ) || ( 0 == fw->size ) || 
+         ( fw->size > LIGHTRANGER12_FW_SIZE ) )
+    {
+        return LIGHTRANGER12_ERROR;
+    }
+
+    // Address word is added at the beginning of each chunk
+    while ( offset < fw->size )
+    {
+        address = ( uint16_t ) ( offset % LIGHTRANGER12_FW_PAGE_SIZE );
+        if ( 0 == address )
+        {
+            error_flag |= lightranger12_write_byte ( ctx, 0x7FFF, page++ );
+        }
+        chunk = LIGHTRANGER12_FW_CHUNK_SIZE;
+        if ( ( fw->size - offset ) < chunk )
+        {
+            chunk = ( uint16_t ) ( fw->size - offset );
+        }
+        ctx->temp_buf[ 0 ] = ( uint8_t ) ( ( address >> 8 ) & 0xFF );
+        ctx->temp_buf[ 1 ] = ( uint8_t ) ( address & 0xFF );
+        error_flag |= fw->read_f ( fw->handle, offset, &ctx->temp_buf[ 2 ], chunk );
+        if ( LIGHTRANGER12_OK != error_flag )
+        {
+            return LIGHTRANGER12_ERROR;
+        }
+        crc = lightranger12_crc32 ( crc, &ctx->temp_buf[ 2 ], chunk );
+        error_flag |= lightranger12_write_data ( ctx, ctx->temp_buf, chunk + 2 );
+        offset += chunk;
+    }
+
+    // Do not start the sensor MCU on a corrupted image
+    if ( ( ~crc ) != fw->crc32 )
+    {
+        error_flag |= LIGHTRANGER12_ERROR;
+    }
+    return error_flag;
+}
+
+static err_t lightranger12_set_bus_speed ( lightranger12_t *ctx, uint32_t i2c_speed, uint32_t spi_speed )
+{
+    if ( LIGHTRANGER12_DRV_SEL_I2C == ctx->drv_sel ) 
+    {
+        return i2c_master_set_speed( &ctx->i2c, i2c_speed );
+    }
+    return spi_master_set_speed( &ctx->spi, spi_speed );
+}
+
+static uint32_t lightranger12_crc32 ( uint32_t crc, uint8_t *data_in, uint16_t len )
+{
+    for ( uint16_t cnt = 0; cnt < len; cnt++ )
+    {
+        crc ^= data_in[ cnt ];
+        for ( uint8_t bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
+        {
+            if ( crc & 1 )
+            {
+                crc = ( crc >> 1 ) ^ 0xEDB88320ul;
+            }
+            else
+            {
+                crc >>= 1;
+            }
+        }
+    }
+    return crc;
+}
+
 static void lightranger12_swap_buffer ( uint8_t *buffer, uint16_t size )
 {
     uint8_t data_buf[ 4 ] = { 0 };
@@ -0,0 +1,266 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ * \brief This file contains the LIN 2.x master schedule engine used with LIN Click driver.
+ *
+ * The engine runs a schedule table from a periodic tick. Each slot starts with
+ * a break, generated by sending 0x00 at a lower baud rate, followed by sync and
+ * protected ID on the tick after the break is out. Subscribed responses are
+ * collected on later ticks and delivered into the frame object of the schedule
+ * entry. The tick never waits for the UART.
+ *
+ * \addtogroup lin LIN Click Driver
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef LIN_MASTER_H
+#define LIN_MASTER_H
+
+#include "lin.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup master_macros Master macros
+ * \{
+ */
+
+/**
+ * \defgroup master_settings Master settings
+ * \{
+ */
+#define LIN_MASTER_TICK_MS                      1
+#define LIN_MASTER_MAX_DATA_LEN                 8
+#define LIN_MASTER_MAX_ID                       0x3F
+#define LIN_MASTER_DIAG_ID_MASTER_REQ           0x3C
+#define LIN_MASTER_DIAG_ID_SLAVE_RESP           0x3D
+/** \} */
+
+/**
+ * \defgroup master_direction Frame direction
+ * \{
+ */
+#define LIN_MASTER_PUBLISH                      0
+#define LIN_MASTER_SUBSCRIBE                    1
+/** \} */
+
+/**
+ * \defgroup master_checksum Checksum model
+ * \{
+ */
+#define LIN_MASTER_CHECKSUM_ENHANCED            0
+#define LIN_MASTER_CHECKSUM_CLASSIC             1
+/** \} */
+
+/**
+ * \defgroup master_status Frame status
+ * \{
+ */
+#define LIN_MASTER_STATUS_IDLE                  0
+#define LIN_MASTER_STATUS_OK                    1
+#define LIN_MASTER_STATUS_NO_RESPONSE           2
+#define LIN_MASTER_STATUS_INCOMPLETE            3
+#define LIN_MASTER_STATUS_CHECKSUM_ERROR        4
+#define LIN_MASTER_STATUS_HEADER_ERROR          5
+/** \} */
+
+/** \} */ // End group master_macros
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup master_type Master types
+ * \{
+ */
+
+/**
+ * @brief Frame object definition, one per LIN ID.
+ */
+typedef struct
+{
+    uint8_t data[ LIN_MASTER_MAX_DATA_LEN ];    /**< Data to publish or last data received. */
+    volatile uint8_t status;                    /**< Status of the last transfer. */
+    volatile uint8_t seq;                       /**< Odd while data is written, grows by two per update. */
+
+} lin_master_frame_t;
+
+/**
+ * @brief Schedule table entry definition.
+ */
+typedef struct
+{
+    uint8_t id;                                 /**< Frame ID, 0 to 0x3F. */
+    uint8_t direction;                          /**< LIN_MASTER_PUBLISH or LIN_MASTER_SUBSCRIBE. */
+    uint8_t len;                                /**< Number of data bytes, 1 to 8. */
+    uint8_t slot_ticks;                         /**< Slot length in ticks. */
+    lin_master_frame_t *frame;                  /**< Frame object of this ID. */
+
+} lin_master_entry_t;
+
+/**
+ * @brief Master engine definition.
+ */
+typedef struct
+{
+    lin_t *ctx;                                 /**< LIN Click object. */
+    uint32_t baud_rate;                         /**< LIN baud rate. */
+    uint32_t break_baud;                        /**< Baud rate used to send the break. */
+    uint8_t break_ticks;                        /**< Ticks from the break to the header. */
+    uint8_t checksum_model;                     /**< Checksum model of non-diagnostic frames. */
+
+    lin_master_entry_t *schedule;               /**< Active schedule table. */
+    uint8_t n_entries;                          /**< Number of schedule entries. */
+    uint8_t index;                              /**< Next entry to run. */
+    uint8_t slot_left;                          /**< Ticks left in the current slot. */
+
+    lin_master_entry_t *entry;                  /**< Entry of the current slot. */
+    uint8_t state;                              /**< Break sent, waiting for a response or idle. */
+    uint8_t wait_ticks;                         /**< Ticks left for the break or the response. */
+    uint8_t len;                                /**< Number of data bytes of the current entry. */
+    uint8_t pid;                                /**< Protected ID of the current entry. */
+    uint8_t tx_buf[ LIN_MASTER_MAX_DATA_LEN + 3 ];  /**< Sync, PID, data and checksum to send. */
+    uint8_t rx_len;                             /**< Bytes received in the current slot. */
+    uint8_t rx_buf[ LIN_MASTER_MAX_DATA_LEN + 4 ];  /**< Break, sync, PID, data and checksum read back. */
+
+} lin_master_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+/**
+ * \defgroup master_function Master function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Master initialization function.
+ *
+ * @param master     Master engine.
+ * @param ctx        Initialized LIN Click object.
+ * @param baud_rate  LIN baud rate, the UART must already run at this rate.
+ *
+ * @description This function prepares the engine with no schedule and the enhanced checksum.
+ */
+void lin_master_init ( lin_master_t *master, lin_t *ctx, uint32_t baud_rate );
+
+/**
+ * @brief Schedule select function.
+ *
+ * @param master     Master engine.
+ * @param schedule   Schedule table, NULL to stop.
+ * @param n_entries  Number of schedule entries.
+ *
+ * @description This function switches to a new schedule table, which starts on the next tick.
+ * @note Call it with the tick interrupt disabled or from the tick context.
+ */
+void lin_master_set_schedule ( lin_master_t *master, lin_master_entry_t *schedule, uint8_t n_entries );
+
+/**
+ * @brief Schedule tick function.
+ *
+ * @param master     Master engine.
+ *
+ * @description This function advances the schedule by one tick. It has to be
+ * called every LIN_MASTER_TICK_MS, preferably from a timer interrupt, so the slot
+ * start has the jitter of the timer and not of the application loop. It only
+ * queues bytes and reads what arrived, the break takes one tick at 19200 baud
+ * and two at 9600 baud before the header is sent.
+ * @note Slots have to be longer than the break ticks plus the frame ticks.
+ */
+void lin_master_tick ( lin_master_t *master );
+
+/**
+ * @brief Read frame function.
+ *
+ * @param frame      Frame object.
+ * @param data_buf   Output buffer of LIN_MASTER_MAX_DATA_LEN bytes.
+ *
+ * @returns Sequence count of the data read, it changes with every response.
+ *
+ * @description This function copies the frame data without being torn by a
+ * response stored from the tick interrupt in between.
+ */
+uint8_t lin_master_read_frame ( lin_master_frame_t *frame, uint8_t *data_buf );
+
+/**
+ * @brief Write frame function.
+ *
+ * @param frame      Frame object.
+ * @param data_buf   Data to publish.
+ * @param len        Number of data bytes.
+ *
+ * @description This function updates the data of a published frame. A slot of
+ * this frame that starts while the data is written is skipped, so the bus never
+ * carries half of the new data.
+ */
+void lin_master_write_frame ( lin_master_frame_t *frame, uint8_t *data_buf, uint8_t len );
+
+/**
+ * @brief Protected ID function.
+ *
+ * @param id         Frame ID, 0 to 0x3F.
+ *
+ * @returns Protected ID with the parity bits.
+ *
+ * @description This function returns the protected ID from a lookup table.
+ */
+uint8_t lin_master_get_pid ( uint8_t id );
+
+/**
+ * @brief Checksum function.
+ *
+ * @param pid        Protected ID, included by the enhanced model only.
+ * @param data_buf   Frame data.
+ * @param len        Number of data bytes.
+ * @param model      LIN_MASTER_CHECKSUM_ENHANCED or LIN_MASTER_CHECKSUM_CLASSIC.
+ *
+ * @returns Frame checksum.
+ *
+ * @description This function calculates the inverted sum with carry of the frame.
+ */
+uint8_t lin_master_checksum ( uint8_t pid, uint8_t *data_buf, uint8_t len, uint8_t model );
+
+/**
+ * @brief Response timeout function.
+ *
+ * @param master     Master engine.
+ * @param len        Number of data bytes.
+ *
+ * @returns Response timeout in ticks.
+ *
+ * @description This function returns the maximum frame time of 1.4 times the
+ * nominal header and response time, rounded up to whole ticks.
+ */
+uint8_t lin_master_get_frame_ticks ( lin_master_t *master, uint8_t len );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _LIN_MASTER_H_
+
+/** \} */ // End master_function group
+/*! @} */
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,358 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ */
+
+#include "lin_master.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+#define MASTER_SYNC_BYTE            0x55
+#define MASTER_BREAK_BYTE           0x00
+
+// 0x00 sent at 9/14 of the baud rate is 14 dominant bits, a 13-bit break with margin
+#define MASTER_BREAK_BAUD_NUM       9
+#define MASTER_BREAK_BAUD_DEN       14
+#define MASTER_CHAR_BITS            10
+
+// Header is 34 bits and each response byte 10 bits, the frame may take 1.4 times nominal
+#define MASTER_HEADER_BITS          34
+#define MASTER_FRAME_TOLERANCE      1400
+
+#define MASTER_STATE_IDLE           0
+#define MASTER_STATE_BREAK          1
+#define MASTER_STATE_RESPONSE       2
+
+// ------------------------------------------------------------------ VARIABLES
+
+static const uint8_t master_pid_table[ LIN_MASTER_MAX_ID + 1 ] =
+{
+    0x80, 0xC1, 0x42, 0x03, 0xC4, 0x85, 0x06, 0x47,
+    0x08, 0x49, 0xCA, 0x8B, 0x4C, 0x0D, 0x8E, 0xCF,
+    0x50, 0x11, 0x92, 0xD3, 0x14, 0x55, 0xD6, 0x97,
+    0xD8, 0x99, 0x1A, 0x5B, 0x9C, 0xDD, 0x5E, 0x1F,
+    0x20, 0x61, 0xE2, 0xA3, 0x64, 0x25, 0xA6, 0xE7,
+    0xA8, 0xE9, 0x6A, 0x2B, 0xEC, 0xAD, 0x2E, 0x6F,
+    0xF0, 0xB1, 0x32, 0x73, 0xB4, 0xF5, 0x76, 0x37,
+    0x78, 0x39, 0xBA, 0xFB, 0x3C, 0x7D, 0xFE, 0xBF
+};
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static uint8_t master_get_model ( lin_master_t *master, uint8_t id );
+
+static void master_start_slot ( lin_master_t *master, lin_master_entry_t *entry );
+
+static void master_send_header ( lin_master_t *master );
+
+static void master_collect ( lin_master_t *master );
+
+static void master_finish ( lin_master_t *master );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void lin_master_init ( lin_master_t *master, lin_t *ctx, uint32_t baud_rate )
+{
+    uint32_t break_us;
+
+    master->ctx = ctx;
+    master->baud_rate = baud_rate;
+    master->break_baud = ( baud_rate * MASTER_BREAK_BAUD_NUM ) / MASTER_BREAK_BAUD_DEN;
+    // Whole ticks that cover the break character, the header follows on the next tick
+    break_us = ( MASTER_CHAR_BITS * 1000000ul + master->break_baud - 1 ) / master->break_baud;
+    master->break_ticks = ( uint8_t ) ( break_us / ( LIN_MASTER_TICK_MS * 1000ul ) + 1 );
+    master->checksum_model = LIN_MASTER_CHECKSUM_ENHANCED;
+    master->state = MASTER_STATE_IDLE;
+    master->entry = NULL;
+    master->rx_len = 0;
+
+    lin_master_set_schedule( master, NULL, 0 );
+}
+
+void lin_master_set_schedule ( lin_master_t *master, lin_master_entry_t *schedule, uint8_t n_entries )
+{
+    master->schedule = schedule;
+    master->n_entries = schedule ? n_entries : 0;
+    master->index = 0;
+    master->slot_left = 0;
+}
+
+void lin_master_tick ( lin_master_t *master )
+{
+    lin_master_entry_t *entry;
+
+    if ( MASTER_STATE_BREAK == master->state )
+    {
+        if ( 0 == --master->wait_ticks )
+        {
+            master_send_header( master );
+        }
+    }
+    else if ( MASTER_STATE_RESPONSE == master->state )
+    {
+        master_collect( master );
+        if ( ( master->rx_len >= master->len + 3 ) || ( 0 == --master->wait_ticks ) )
+        {
+            master_finish( master );
+        }
+    }
+
+    if ( 0 == master->n_entries )
+    {
+        return;
+    }
+
+    if ( master->slot_left )
+    {
+        master->slot_left--;
+    }
+    if ( 0 == master->slot_left )
+    {
+        if ( MASTER_STATE_IDLE != master->state )
+        {
+            master_finish( master );
+        }
+
+        entry = &master->schedule[ master->index ];
+        if ( ++master->index >= master->n_entries )
+        {
+            master->index = 0;
+        }
+        master->slot_left = entry->slot_ticks ? entry->slot_ticks : 1;
+        master_start_slot( master, entry );
+    }
+}
+
+uint8_t lin_master_read_frame ( lin_master_frame_t *frame, uint8_t *data_buf )
+{
+    uint8_t seq;
+
+    // Read again if a response was stored in between
+    do
+    {
+        seq = frame->seq;
+        for ( uint8_t cnt = 0; cnt < LIN_MASTER_MAX_DATA_LEN; cnt++ )
+        {
+            data_buf[ cnt ] = frame->data[ cnt ];
+        }
+    }
+    while ( ( seq & 1 ) || ( seq != frame->seq ) );
+
+    return seq;
+}
+
+void lin_master_write_frame ( lin_master_frame_t *frame, uint8_t *data_buf, uint8_t len )
+{
+    if ( len > LIN_MASTER_MAX_DATA_LEN )
+    {
+        len = LIN_MASTER_MAX_DATA_LEN;
+    }
+
+    frame->seq++;
+    for ( uint8_t cnt = 0; cnt < len; cnt++ )
+    {
+        frame->data[ cnt ] = data_buf[ cnt ];
+    }
+    frame->seq++;
+}
+
+uint8_t lin_master_get_pid ( uint8_t id )
+{
+    return master_pid_table[ id & LIN_MASTER_MAX_ID ];
+}
+
+uint8_t lin_master_checksum ( uint8_t pid, uint8_t *data_buf, uint8_t len, uint8_t model )
+{
+    uint16_t sum = 0;
+
+    if ( LIN_MASTER_CHECKSUM_ENHANCED == model )
+    {
+        sum = pid;
+    }
+
+    for ( uint8_t cnt = 0; cnt < len; cnt++ )
+    {
+        sum += data_buf[ cnt ];
+        if ( sum > 0xFF )
+        {
+            sum -= 0xFF;
+        }
+    }
+
+    return ( uint8_t ) ~sum;
+}
+
+uint8_t lin_master_get_frame_ticks ( lin_master_t *master, uint8_t len )
+{
+    uint32_t bits = MASTER_HEADER_BITS + MASTER_CHAR_BITS * ( ( uint32_t ) len + 1 );
+    uint32_t div = master->baud_rate * LIN_MASTER_TICK_MS;
+
+    return ( uint8_t ) ( ( MASTER_FRAME_TOLERANCE * bits + div - 1 ) / div );
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint8_t master_get_model ( lin_master_t *master, uint8_t id )
+{
+    // Diagnostic frames always use the classic checksum
+    if ( ( LIN_MASTER_DIAG_ID_MASTER_REQ == id ) || ( LIN_MASTER_DIAG_ID_SLAVE_RESP == id ) )
+    {
+        return LIN_MASTER_CHECKSUM_CLASSIC;
+    }
+
+    return master->checksum_model;
+}
+
+static void master_start_slot ( lin_master_t *master, lin_master_entry_t *entry )
+{
+    uint8_t id = entry->id & LIN_MASTER_MAX_ID;
+    uint8_t len = ( entry->len > LIN_MASTER_MAX_DATA_LEN ) ? LIN_MASTER_MAX_DATA_LEN : entry->len;
+    uint8_t *tx_data = &master->tx_buf[ 2 ];
+    uint8_t break_byte = MASTER_BREAK_BYTE;
+
+    if ( LIN_MASTER_PUBLISH == entry->direction )
+    {
+        // The tick interrupted lin_master_write_frame(), the slot is skipped
+        if ( entry->frame->seq & 1 )
+        {
+            return;
+        }
+        for ( uint8_t cnt = 0; cnt < len; cnt++ )
+        {
+            tx_data[ cnt ] = entry->frame->data[ cnt ];
+        }
+    }
+
+    master->entry = entry;
+    master->len = len;
+    master->pid = master_pid_table[ id ];
+    master->tx_buf[ 0 ] = MASTER_SYNC_BYTE;
+    master->tx_buf[ 1 ] = master->pid;
+    if ( LIN_MASTER_PUBLISH == entry->direction )
+    {
+        tx_data[ len ] = lin_master_checksum( master->pid, tx_data, len, master_get_model( master, id ) );
+    }
+
+    // Break: one 0x00 at the lower baud rate, it is shifted out while the ticks pass
+    uart_set_baud( &master->ctx->uart, master->break_baud );
+    lin_generic_write( master->ctx, ( char * ) &break_byte, 1 );
+    master->state = MASTER_STATE_BREAK;
+    master->wait_ticks = master->break_ticks;
+}
+
+static void master_send_header ( lin_master_t *master )
+{
+    uart_set_baud( &master->ctx->uart, master->baud_rate );
+    uart_clear( &master->ctx->uart );
+
+    // Sync, PID and a published response leave from the TX ring buffer
+    if ( LIN_MASTER_PUBLISH == master->entry->direction )
+    {
+        lin_generic_write( master->ctx, ( char * ) master->tx_buf, master->len + 3 );
+        master->entry->frame->status = LIN_MASTER_STATUS_OK;
+        master->state = MASTER_STATE_IDLE;
+    }
+    else
+    {
+        lin_generic_write( master->ctx, ( char * ) master->tx_buf, 2 );
+        master->state = MASTER_STATE_RESPONSE;
+        master->rx_len = 0;
+        master->wait_ticks = lin_master_get_frame_ticks( master, master->len );
+    }
+}
+
+static void master_collect ( lin_master_t *master )
+{
+    int32_t rx_len;
+
+    rx_len = lin_generic_read( master->ctx, ( char * ) &master->rx_buf[ master->rx_len ], 
+                               sizeof( master->rx_buf ) - master->rx_len );
+    if ( rx_len <= 0 )
+    {
+        return;
+    }
+
+    master->rx_len += rx_len;
+    // Late echo of the break character
+    if ( MASTER_BREAK_BYTE == master->rx_buf[ 0 ] )
+    {
+        for ( uint8_t cnt = 1; cnt < master->rx_len; cnt++ )
+        {
+            master->rx_buf[ cnt - 1 ] = master->rx_buf[ cnt ];
+        }
+        master->rx_len--;
+    }
+}
+
+static void master_finish ( lin_master_t *master )
+{
+    lin_master_entry_t *entry = master->entry;
+    uint8_t len = master->len;
+    uint8_t *rx_data = &master->rx_buf[ 2 ];
+    uint8_t state = master->state;
+
+    master->state = MASTER_STATE_IDLE;
+
+    // Slot shorter than the break, the header was never sent
+    if ( MASTER_STATE_BREAK == state )
+    {
+        uart_set_baud( &master->ctx->uart, master->baud_rate );
+        entry->frame->status = LIN_MASTER_STATUS_HEADER_ERROR;
+        return;
+    }
+
+    // The transceiver echoes the header, so its absence means a bus fault
+    if ( ( master->rx_len < 2 ) || ( MASTER_SYNC_BYTE != master->rx_buf[ 0 ] ) || 
+         ( master->pid != master->rx_buf[ 1 ] ) )
+    {
+        entry->frame->status = LIN_MASTER_STATUS_HEADER_ERROR;
+    }
+    else if ( 2 == master->rx_len )
+    {
+        entry->frame->status = LIN_MASTER_STATUS_NO_RESPONSE;
+    }
+    else if ( master->rx_len < len + 3 )
+    {
+        entry->frame->status = LIN_MASTER_STATUS_INCOMPLETE;
+    }
+    else if ( rx_data[ len ] != lin_master_checksum( master->pid, rx_data, len, 
+                                                     master_get_model( master, entry->id & LIN_MASTER_MAX_ID ) ) )
+    {
+        entry->frame->status = LIN_MASTER_STATUS_CHECKSUM_ERROR;
+    }
+    else
+    {
+        // Odd sequence count while the data is written
+        entry->frame->seq++;
+        for ( uint8_t cnt = 0; cnt < len; cnt++ )
+        {
+            entry->frame->data[ cnt ] = rx_data[ cnt ];
+        }
+        entry->frame->seq++;
+        entry->frame->status = LIN_MASTER_STATUS_OK;
+    }
+}
+
+// ------------------------------------------------------------------------- END
@@ -28,7 +28,6 @@
     #define MIKROBUS_POSITION_LR MIKROBUS_1
 #endif
 
-#define PROCESS_COUNTER 5
 #define PROCESS_RX_BUFFER_SIZE 300
 
 // ------------------------------------------------------------------ VARIABLES
@@ -100,6 +99,10 @@ void application_init ( void )
     }
     
     lr_default_cfg( &lr, 0, 0 );
+#ifdef DEMO_APP_RECEIVER
+    // Radio rx 0 listens until a packet arrives, so no host timeout
+    lr_tick_conf( &lr, 0 );
+#endif
 
     lr_cmd( &lr, LR_CMD_SYS_GET_VER, resp_buf );
     log_printf( &logger, "System VER: %s \r\n", resp_buf );
@@ -163,33 +166,16 @@ static void lr_process ( void )
     int32_t rsp_size;
     
     char uart_rx_buffer[ PROCESS_RX_BUFFER_SIZE ] = { 0 };
-    uint8_t check_buf_cnt;
-    uint8_t process_cnt = PROCESS_COUNTER;
+    uint16_t check_buf_cnt;
     
-    while ( process_cnt != 0 ) 
-    {
-        rsp_size = lr_generic_read( &lr, &uart_rx_buffer, PROCESS_RX_BUFFER_SIZE );
+    rsp_size = lr_generic_read( &lr, &uart_rx_buffer, PROCESS_RX_BUFFER_SIZE );
 
-        if ( rsp_size > 0 ) 
-        {  
-            // Validation of the received data
-            for ( check_buf_cnt = 0; check_buf_cnt < rsp_size; check_buf_cnt++ ) 
-            {
-                lr_put_char( &lr, uart_rx_buffer[ check_buf_cnt ] );
-                lr_isr_process( &lr );
-            }
-            
-            // Clear RX buffer
-            memset( uart_rx_buffer, 0, PROCESS_RX_BUFFER_SIZE );
-        } 
-        else 
-        {
-            process_cnt--;
-            
-            // Process delay 
-            Delay_ms ( 100 );
-        }
+    // Complete lines are delivered to the callback, partial ones stay in the driver
+    for ( check_buf_cnt = 0; check_buf_cnt < rsp_size; check_buf_cnt++ ) 
+    {
+        lr_put_char( &lr, uart_rx_buffer[ check_buf_cnt ] );
     }
+    lr_isr_process( &lr );
 }
 
 static bool is_digit ( char c ) 
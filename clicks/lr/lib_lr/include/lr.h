@@ -107,6 +107,8 @@ extern "C"{
 #define LR_INVALID_REPAR_DATA_LEN   13
 #define LR_RADIO_ERR                14
 #define LR_DENIED                   18  
+#define LR_TX_PENDING               19
+#define LR_TIMEOUT                  20
 
 /**
  * @brief LR Command String Max Size.
@@ -151,6 +153,13 @@ extern "C"{
  */
 #define DRV_RX_BUFFER_SIZE                       300
 
+/**
+ * @brief LR receive ring size.
+ * @details Size of the ring filled by #lr_rx_isr, must be a power of two.
+ * @note Increase ring size if bytes are dropped while the application is busy.
+ */
+#define LR_RX_RING_SIZE                          512
+
 /*! @} */ // lr_set
 
 /**
@@ -198,6 +207,7 @@ typedef struct
     bool     timer_f;
     bool     timeout_f;
     bool     timer_use_f;
+    volatile bool tick_isr_f;
     uint32_t ticker;
     uint32_t timer_max;
     
@@ -227,6 +237,37 @@ typedef struct
     
 } lr_response_t;
 
+/**
+ * @brief Receive ring object definition.
+ * @details Single-producer/single-consumer ring of LR Click driver. Only one feed path
+ * writes @b head and only #lr_isr_process writes @b tail, so the UART interrupt can
+ * feed the ring while the main loop extracts lines without disabling interrupts.
+ * With @b isr_feed_f cleared the driver reads the UART itself and #lr_put_char may be
+ * used from the main loop, with @b isr_feed_f set only #lr_rx_isr feeds the ring.
+ */
+typedef struct
+{
+    char              buf[ LR_RX_RING_SIZE ];
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    volatile uint16_t dropped;
+    bool              isr_feed_f;
+
+} lr_rx_ring_t;
+
+/**
+ * @brief Second response object definition.
+ * @details Definition of the pending second response of mac tx, mac join, radio tx
+ * and radio rx, which is delivered independently of the command in flight.
+ */
+typedef struct
+{
+    bool    pending_f;
+    uint8_t status;
+    char    *response;
+
+} lr_async_t;
+
 /**
  * @brief Mac object definition.
  * @details Definition of Mac object of LR Click driver.
@@ -264,6 +305,8 @@ typedef struct
     lr_timer_t tm;
     lr_procces_flags_t flags;
     lr_response_t rsp;
+    lr_rx_ring_t ring;
+    lr_async_t async;
     char data_in;
     
 } lr_t;
@@ -289,6 +332,7 @@ typedef struct
     uart_data_bits_t  data_bit;         /**< Data bits. */
     uart_parity_t     parity_bit;       /**< Parity bit. */
     uart_stop_bits_t  stop_bit;         /**< Stop bits. */
+    bool              rx_isr_feed;      /**< Receive ring fed by #lr_rx_isr only. */
 
 } lr_cfg_t;
 
@@ -400,6 +444,32 @@ void lr_cmd ( lr_t *ctx, char *cmd,  char *response );
  */
 uint8_t lr_mac_tx ( lr_t *ctx, lr_mac_t *mac );
 
+/**
+ * @brief Function for starting mac transmission
+ * @details This function sends mac tx and returns as soon as the module accepts it,
+ * without waiting for the transmission and the receive windows. Other commands may be
+ * sent with #lr_cmd meanwhile, the second response is collected in the background.
+ * @param[in] ctx : Click context object. 
+ * See #lr_t object definition for detailed explanation.
+ * @param[in] mac : Mac structure object, @b response receives the second response.
+ * @return LR flag of the first response.
+ * @note Poll the result with #lr_mac_tx_poll.
+ */
+uint8_t lr_mac_tx_start ( lr_t *ctx, lr_mac_t *mac );
+
+/**
+ * @brief Function for polling mac transmission
+ * @details This function processes received data without blocking and returns the
+ * result of the transmission started by #lr_mac_tx_start.
+ * @param[in] ctx : Click context object. 
+ * See #lr_t object definition for detailed explanation.
+ * @return @li @c LR_TX_PENDING - Second response not received yet,
+ *         @li @c LR_TIMEOUT - Host timer expired,
+ *         @li @c other - LR flag of the second response.
+ * @note None.
+ */
+uint8_t lr_mac_tx_poll ( lr_t *ctx );
+
 /**
  * @brief Function for setting join mode
  * @details This function sets join mode.
@@ -437,23 +507,28 @@ uint8_t lr_tx ( lr_t *ctx, char *buffer );
 
 /**
  * @brief Receiver
- * @details Must be placed inside the user made uart interrupt routine.
+ * @details Must be placed inside the user made uart interrupt routine. Stores the
+ * character in the receive ring, characters that do not fit are counted in @b dropped.
  * @param[in] ctx : Click context object. 
  * See #lr_t object definition for detailed explanation.
  * @param[in] rx_input : Data from uart receive register
  * @return Nothing.
- * @note None.
+ * @note Only valid when @b rx_isr_feed is set in #lr_cfg_t, the driver then stops
+ * reading the UART itself and this function is the only producer of the ring.
  */
 void lr_rx_isr ( lr_t *ctx, char rx_input );
 
 /**
  * @brief Timer
  * @details Used for host timing. Should be placed inside the previously made interrupt
- * routine made by user that occurs on every one milisecond.
+ * routine made by user that occurs on every one milisecond. The timer runs while a
+ * response or a second response is awaited and restarts with every command.
  * @param[in] ctx : Click context object. 
  * See #lr_t object definition for detailed explanation.
  * @return Nothing.
- * @note None.
+ * @note Until this function is called the blocking functions count their own 1 ms idle
+ * delays instead, which runs slow while data is being received and does not advance
+ * during #lr_mac_tx_poll.
  */
 void lr_tick_isr ( lr_t *ctx );
 
@@ -462,6 +537,7 @@ void lr_tick_isr ( lr_t *ctx );
  * @details Used to configure host watchdog. When timeout occurs response with no data
  *          will be parsed. If user provide 0 as argument timer will be turned off. By
  *          default after the initialization timer limit is turned on and set to
+ *          #LR_TIMER_EXPIRED milliseconds.
  * @param[in] ctx : Click context object.
  * See #lr_t object definition for detailed explanation.
  * @param[in] timer_limit : ( 0 ~ 4294967296 )  
@@ -480,7 +556,10 @@ void lr_tick_conf ( lr_t *ctx, uint32_t timer_limit );
 
 /**
  * @brief Main Process
- * @details Function must be placed inside the infinite while loop.
+ * @details Function must be placed inside the infinite while loop. Extracts CR/LF
+ * terminated lines from the receive ring and delivers them to the command in flight,
+ * the pending second response or the response callback. Lines longer than the
+ * receive buffer are truncated.
  * @param[in] ctx : Click context object.
  * See #lr_t object definition for detailed explanation.
  * @return Nothing.
@@ -490,12 +569,13 @@ void lr_isr_process ( lr_t *ctx );
 
 /**
  * @brief Function for write char
- * @details Function write char into ctx objects.
+ * @details Function write char into the receive ring from the main loop.
  * @param[in] ctx : Click context object.
  * See #lr_t object definition for detailed explanation.
  * @param[in] data_in : Char to be written 
  * @return Nothing.
- * @note None.
+ * @note Ignored when @b rx_isr_feed is set in #lr_cfg_t, #lr_rx_isr is the only
+ * producer of the ring then.
  */
 void lr_put_char ( lr_t *ctx, char data_in );
 
@@ -26,12 +26,25 @@
  */
 
 #include "lr.h"
+#include "string.h"
+
+/**
+ * @brief LR receive ring mask.
+ * @details Mask of the receive ring indexes of LR Click driver.
+ */
+#define LR_RX_RING_MASK  ( LR_RX_RING_SIZE - 1 )
 
-static void lr_resp ( lr_t *ctx );
 static uint8_t lr_par ( lr_t *ctx );
 static uint8_t lr_repar ( lr_t *ctx );
+static bool lr_is_second_rsp ( lr_t *ctx );
+static uint8_t lr_async_start ( lr_t *ctx, char *response );
+static uint8_t lr_async_wait ( lr_t *ctx );
+static void lr_ring_put ( lr_t *ctx, char rx_input );
+static void lr_tick ( lr_t *ctx );
 static void lr_write ( lr_t *ctx );
 static void lr_read ( lr_t *ctx );
+static void lr_timeout ( lr_t *ctx );
+static int32_t lr_drv_poll ( lr_t *ctx );
 static void lr_drv_process ( lr_t *ctx );
 
 void lr_cfg_setup ( lr_cfg_t *cfg ) 
@@ -50,6 +63,7 @@ void lr_cfg_setup ( lr_cfg_t *cfg )
     cfg->parity_bit    = UART_PARITY_DEFAULT;
     cfg->stop_bit      = UART_STOP_BITS_DEFAULT;
     cfg->uart_blocking = false;
+    cfg->rx_isr_feed   = false;
 }
 
 err_t lr_init ( lr_t *ctx, lr_cfg_t *cfg ) 
@@ -63,6 +77,11 @@ err_t lr_init ( lr_t *ctx, lr_cfg_t *cfg )
     ctx->uart.tx_ring_buffer = ctx->uart_tx_buffer;
     ctx->uart.rx_ring_buffer = ctx->uart_rx_buffer;
 
+    ctx->ring.head    = 0;
+    ctx->ring.tail    = 0;
+    ctx->ring.dropped = 0;
+    ctx->ring.isr_feed_f = cfg->rx_isr_feed;
+
     // UART module config
     uart_cfg.rx_pin = cfg->rx_pin;  // UART RX pin.
     uart_cfg.tx_pin = cfg->tx_pin;  // UART TX pin.
@@ -110,12 +129,17 @@ void lr_default_cfg ( lr_t *ctx, bool cb_default, void ( *response_p )( char *re
     ctx->tm.ticker             = 0;
     ctx->tm.timer_f            = false;
     ctx->tm.timeout_f          = false;
-    ctx->tm.timer_use_f        = false;
+    ctx->tm.timer_use_f        = true;
+    ctx->tm.tick_isr_f         = false;
     ctx->rsp.rsp_f             = false;
     ctx->flags.rsp_rdy_f       = false;
     ctx->flags.lr_rdy_f        = true;
     ctx->rsp.callback_resp     = response_p;
     ctx->rsp.callback_default  = cb_default;
+    ctx->rsp.rsp_buffer        = NULL;
+    ctx->async.pending_f       = false;
+    ctx->async.status          = LR_OK;
+    ctx->async.response        = NULL;
     
     Delay_1sec( );
 }
@@ -130,12 +154,9 @@ int32_t lr_generic_read ( lr_t *ctx, char *data_buf, uint16_t max_len )
     return uart_read( &ctx->uart, data_buf, max_len );
 }
 
-void lr_cmd ( lr_t *ctx, char *cmd,  char *response ) 
+void lr_cmd ( lr_t *ctx, char *cmd,  char *response )
 {
-    char buf[ ] = "";
-    uint8_t *pom = buf;
-
-    while ( !ctx->flags.lr_rdy_f ) 
+    while ( !ctx->flags.lr_rdy_f )
     {
         lr_drv_process( ctx );
     }
@@ -145,17 +166,27 @@ void lr_cmd ( lr_t *ctx, char *cmd,  char *response )
     ctx->rsp.rsp_buffer = response;
     lr_write( ctx );
 
-    while ( !ctx->flags.lr_rdy_f ) 
+    while ( !ctx->flags.lr_rdy_f )
     {
         lr_drv_process( ctx );
     }
 }
 
-uint8_t lr_mac_tx ( lr_t *ctx, lr_mac_t *mac ) 
+uint8_t lr_mac_tx ( lr_t *ctx, lr_mac_t *mac )
 {
     uint8_t res = LR_OK;
 
-    while ( !ctx->flags.lr_rdy_f ) 
+    if ( ( res = lr_mac_tx_start( ctx, mac ) ) )
+    {
+        return res;
+    }
+
+    return lr_async_wait( ctx );
+}
+
+uint8_t lr_mac_tx_start ( lr_t *ctx, lr_mac_t *mac )
+{
+    while ( !ctx->flags.lr_rdy_f || ctx->async.pending_f )
     {
         lr_drv_process( ctx );
     }
@@ -165,143 +196,97 @@ uint8_t lr_mac_tx ( lr_t *ctx, lr_mac_t *mac )
     strcat( ctx->buff.tx_buffer, mac->port_no );
     strcat( ctx->buff.tx_buffer, " " );
     strcat( ctx->buff.tx_buffer, mac->buffer );
-    ctx->rsp.rsp_buffer = mac->response;
-    lr_write( ctx );
 
-    while ( !ctx->flags.lr_rdy_f ) 
-    {
-        lr_drv_process( ctx );
-    }
+    return lr_async_start( ctx, mac->response );
+}
 
-    if ( ( res = lr_par( ctx ) ) ) 
+uint8_t lr_mac_tx_poll ( lr_t *ctx )
+{
+    if ( ctx->async.pending_f )
     {
-        return res;
+        lr_drv_poll( ctx );
     }
-    lr_resp( ctx );
 
-    do 
+    if ( ctx->async.pending_f )
     {
-        while ( !ctx->flags.lr_rdy_f ) 
-        {
-            lr_drv_process( ctx );
-        }
-
-    } 
-    while ( LR_MAC_RX == ( res = lr_repar( ctx ) ) );
+        return LR_TX_PENDING;
+    }
 
-    return res;
+    return ctx->async.status;
 }
 
-uint8_t lr_join ( lr_t *ctx, char *join_mode, char *response ) 
+uint8_t lr_join ( lr_t *ctx, char *join_mode, char *response )
 {
     uint8_t res = LR_OK;
 
-    while ( !ctx->flags.lr_rdy_f ) 
+    while ( !ctx->flags.lr_rdy_f || ctx->async.pending_f )
     {
         lr_drv_process( ctx );
     }
 
     strcpy( ctx->buff.tx_buffer, ( char* ) LR_JOIN );
     strcat( ctx->buff.tx_buffer, join_mode );
-    ctx->rsp.rsp_buffer = response;
-    lr_write( ctx );
 
-    while ( !ctx->flags.lr_rdy_f ) 
-    {
-        lr_drv_process( ctx );
-    }
-
-    if ( ( res = lr_par( ctx ) ) ) 
+    if ( ( res = lr_async_start( ctx, response ) ) )
     {
         return res;
     }
 
-    lr_resp( ctx );
-
-    while ( !ctx->flags.lr_rdy_f ) 
-    {
-        lr_drv_process( ctx );
-    }
-
-    return lr_repar( ctx );
+    return lr_async_wait( ctx );
 }
 
-uint8_t lr_rx ( lr_t *ctx, char *window_size, char *response ) 
+uint8_t lr_rx ( lr_t *ctx, char *window_size, char *response )
 {
     uint8_t res = LR_OK;
 
-    while ( !ctx->flags.lr_rdy_f ) 
+    while ( !ctx->flags.lr_rdy_f || ctx->async.pending_f )
     {
         lr_drv_process( ctx );
     }
 
     strcpy( ctx->buff.tx_buffer, "radio rx " );
     strcat( ctx->buff.tx_buffer, window_size );
-    ctx->rsp.rsp_buffer = response;
-    lr_write( ctx );
 
-    while ( !ctx->flags.lr_rdy_f ) 
-    {
-        lr_drv_process( ctx );
-    }
-
-    if ( res != lr_par( ctx ) ) 
+    if ( ( res = lr_async_start( ctx, response ) ) )
     {
         return res;
     }
 
-    lr_resp( ctx );
+    return lr_async_wait( ctx );
+}
+
+uint8_t lr_tx ( lr_t *ctx, char *buffer )
+{
+    uint8_t res = LR_OK;
 
-    while ( !ctx->flags.lr_rdy_f ) 
+    while ( !ctx->flags.lr_rdy_f || ctx->async.pending_f )
     {
         lr_drv_process( ctx );
     }
 
-    return lr_repar( ctx );
-}
-
-uint8_t lr_tx ( lr_t *ctx, char *buffer ) 
-{
-    lr_return_value_t res = LR_OK;
-    
-    lr_drv_process( ctx );
     strcpy( ctx->buff.tx_buffer, "radio tx ");
     strcat( ctx->buff.tx_buffer, buffer );
 
-    lr_write( ctx );
-
-    lr_drv_process( ctx );
-
-    if ( LR_OK != lr_par( ctx ) ) 
+    if ( ( res = lr_async_start( ctx, ctx->rsp.rsp_buffer ) ) )
     {
-        return lr_par( ctx );
+        return res;
     }
 
-    lr_resp( ctx );
-    lr_drv_process( ctx );
-
-    return lr_repar( ctx );
+    return lr_async_wait( ctx );
 }
 
 void lr_rx_isr ( lr_t *ctx, char rx_input )
 {
-    ctx->buff.rx_buffer[ ctx->buff.rx_buffer_len++ ] = rx_input;
-    if ( rx_input == '\r' ) 
+    if ( ctx->ring.isr_feed_f )
     {
-        ctx->buff.rx_buffer[ ctx->buff.rx_buffer_len++ ] = '\0';
-        ctx->flags.rsp_rdy_f = true;  
-    } 
+        lr_ring_put( ctx, rx_input );
+    }
 }
 
-void lr_tick_isr ( lr_t *ctx ) 
+void lr_tick_isr ( lr_t *ctx )
 {
-    if ( ctx->tm.timer_use_f ) 
-    {
-        if ( ctx->tm.timer_f && ( ctx->tm.ticker++ > ctx->tm.timer_max ) ) 
-        {
-            ctx->tm.timeout_f = true;
-        }
-    }
+    ctx->tm.tick_isr_f = true;
+    lr_tick( ctx );
 }
 
 void lr_tick_conf ( lr_t *ctx, uint32_t timer_limit ) 
@@ -318,35 +303,58 @@ void lr_tick_conf ( lr_t *ctx, uint32_t timer_limit )
     }
 }
 
-void lr_isr_process ( lr_t *ctx ) 
+void lr_isr_process ( lr_t *ctx )
 {
-    lr_rx_isr( ctx, ctx->data_in );
+    uint16_t tail = ctx->ring.tail;
+    char rx_data;
+
+    while ( tail != ctx->ring.head )
+    {
+        rx_data = ctx->ring.buf[ tail ];
+        tail = ( tail + 1 ) & LR_RX_RING_MASK;
+        ctx->ring.tail = tail;
+
+        if ( ( '\r' == rx_data ) || ( '\n' == rx_data ) )
+        {
+            if ( 0 == ctx->buff.rx_buffer_len )
+            {
+                continue;
+            }
+
+            ctx->buff.rx_buffer[ ctx->buff.rx_buffer_len ] = '\0';
+            ctx->buff.rx_buffer_len = 0;
+            lr_read( ctx );
 
-    if ( ctx->flags.rsp_rdy_f ) 
-    {        
-        lr_read( ctx );
+            // Leave the rest in the ring until the command response is parsed
+            if ( ctx->flags.rsp_rdy_f )
+            {
+                ctx->flags.rsp_rdy_f = false;
+                return;
+            }
+        }
+        else if ( ctx->buff.rx_buffer_len < ( LR_MAX_TRANSFER_SIZE - 1 ) )
+        {
+            ctx->buff.rx_buffer[ ctx->buff.rx_buffer_len++ ] = rx_data;
+        }
     }
-    if ( ctx->tm.timeout_f ) 
+
+    if ( ctx->tm.timeout_f )
     {
-        lr_read( ctx );
+        lr_timeout( ctx );
     }
 }
 
-void lr_put_char ( lr_t *ctx, char data_in ) 
+void lr_put_char ( lr_t *ctx, char data_in )
 {
     ctx->data_in = data_in;
+    if ( !ctx->ring.isr_feed_f )
+    {
+        lr_ring_put( ctx, data_in );
+    }
 }
 
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
-static void lr_resp ( lr_t *ctx ) 
-{
-    ctx->buff.rx_buffer_len = 0;
-    ctx->flags.lr_rdy_f     = false;
-    ctx->flags.rsp_rdy_f    = false;
-    ctx->rsp.rsp_f          = true;
-}
-
 static uint8_t lr_par ( lr_t *ctx ) {
     if ( !strcmp( ctx->buff.rx_buffer, "invalid_param" ) ) 
     {
@@ -398,7 +406,7 @@ static uint8_t lr_repar ( lr_t *ctx )
     {
         return LR_OK;
     }
-    if ( !strcmp( ctx->buff.rx_buffer, "mac_rx" ) ) 
+    if ( !strncmp( ctx->buff.rx_buffer, "mac_rx", 6 ) ) 
     {
         return LR_MAC_RX;
     }
@@ -430,82 +438,223 @@ static uint8_t lr_repar ( lr_t *ctx )
     return LR_OK;
 }
 
-static void lr_write ( lr_t *ctx ) 
+static bool lr_is_second_rsp ( lr_t *ctx )
 {
-    char buff; 
+    static const char *second_rsp[ ] =
+    {
+        "mac_tx_ok", "mac_rx", "mac_err", "radio_tx_ok", "radio_rx", "radio_err", "accepted", "denied"
+    };
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < ( sizeof( second_rsp ) / sizeof( second_rsp[ 0 ] ) ); cnt++ )
+    {
+        if ( !strncmp( ctx->buff.rx_buffer, second_rsp[ cnt ], strlen( second_rsp[ cnt ] ) ) )
+        {
+            return true;
+        }
+    }
+
+    // invalid_data_len is a first response too, so it ends the transmission
+    // only when no other command is waiting for its response
+    return ctx->flags.lr_rdy_f && !strcmp( ctx->buff.rx_buffer, "invalid_data_len" );
+}
+
+static uint8_t lr_async_start ( lr_t *ctx, char *response )
+{
+    uint8_t res = LR_OK;
+
+    ctx->rsp.rsp_buffer  = response;
+    ctx->async.response  = response;
+    ctx->async.status    = LR_TX_PENDING;
+    ctx->async.pending_f = true;
+    lr_write( ctx );
+
+    while ( !ctx->flags.lr_rdy_f )
+    {
+        lr_drv_process( ctx );
+    }
+
+    // Host timer expired before the first response
+    if ( !ctx->async.pending_f )
+    {
+        return ctx->async.status;
+    }
+
+    if ( ( res = lr_par( ctx ) ) )
+    {
+        ctx->async.pending_f = false;
+        ctx->async.status    = res;
+        ctx->tm.timer_f      = false;
+    }
+
+    return res;
+}
+
+static uint8_t lr_async_wait ( lr_t *ctx )
+{
+    while ( ctx->async.pending_f )
+    {
+        lr_drv_process( ctx );
+    }
+
+    return ctx->async.status;
+}
+
+static void lr_ring_put ( lr_t *ctx, char rx_input )
+{
+    uint16_t head = ctx->ring.head;
+    uint16_t next = ( head + 1 ) & LR_RX_RING_MASK;
+
+    if ( next == ctx->ring.tail )
+    {
+        ctx->ring.dropped++;
+        return;
+    }
+
+    ctx->ring.buf[ head ] = rx_input;
+    ctx->ring.head = next;
+}
+
+static void lr_tick ( lr_t *ctx )
+{
+    if ( ctx->tm.timer_use_f && ctx->tm.timer_f )
+    {
+        if ( ++ctx->tm.ticker > ctx->tm.timer_max )
+        {
+            ctx->tm.timeout_f = true;
+        }
+    }
+}
+
+static void lr_write ( lr_t *ctx )
+{
+    char buff;
     char *ptr = ctx->buff.tx_buffer;
 
-    while ( *ptr ) 
+    while ( *ptr )
     {
-        if ( !digital_in_read( &ctx->cts ) ) 
+        if ( !digital_in_read( &ctx->cts ) )
         {
             lr_generic_write ( ctx, ptr++, 1 );
         }
     }
-    
+
     buff = 13;
     lr_generic_write ( ctx, &buff, 1 );
     buff = 10;
     lr_generic_write ( ctx, &buff, 1 );
 
-    ctx->buff.rx_buffer_len = 0;
     ctx->flags.lr_rdy_f     = false;
     ctx->flags.rsp_rdy_f    = false;
+    ctx->tm.ticker          = 0;
+    ctx->tm.timeout_f       = false;
     ctx->tm.timer_f         = true;
     ctx->rsp.rsp_f          = true;
 }
 
-static void lr_read ( lr_t *ctx ) 
+static void lr_read ( lr_t *ctx )
 {
-    if ( !ctx->rsp.rsp_f ) 
+    digital_out_high( &ctx->rts );
+
+    if ( ctx->async.pending_f && lr_is_second_rsp( ctx ) )
+    {
+        if ( NULL != ctx->async.response )
+        {
+            strcpy( ctx->async.response, ctx->buff.rx_buffer );
+        }
+        ctx->async.status    = lr_repar( ctx );
+        ctx->async.pending_f = false;
+    }
+    else if ( !ctx->flags.lr_rdy_f )
+    {
+        if ( NULL != ctx->rsp.rsp_buffer )
+        {
+            strcpy( ctx->rsp.rsp_buffer, ctx->buff.rx_buffer );
+        }
+        ctx->flags.lr_rdy_f  = true;
+        ctx->flags.rsp_rdy_f = true;
+        ctx->rsp.rsp_f       = false;
+    }
+    else if ( NULL != ctx->rsp.callback_resp )
     {
-        digital_out_high( &ctx->rts );
         ctx->rsp.callback_resp( ctx->buff.rx_buffer );
-        digital_out_low( &ctx->rts );
+    }
 
-    } 
-    else if ( ctx->rsp.rsp_f ) 
+    digital_out_low( &ctx->rts );
+
+    ctx->tm.timer_f = !ctx->flags.lr_rdy_f || ctx->async.pending_f;
+}
+
+static void lr_timeout ( lr_t *ctx )
+{
+    // Command in flight gets whatever was received so far
+    if ( !ctx->flags.lr_rdy_f )
     {
-        digital_out_high( &ctx->rts );
-        strcpy( ctx->rsp.rsp_buffer, ctx->buff.rx_buffer );
-        digital_out_low( &ctx->rts );
+        ctx->buff.rx_buffer[ ctx->buff.rx_buffer_len ] = '\0';
+        ctx->buff.rx_buffer_len = 0;
+        if ( NULL != ctx->rsp.rsp_buffer )
+        {
+            strcpy( ctx->rsp.rsp_buffer, ctx->buff.rx_buffer );
+        }
+        ctx->flags.lr_rdy_f = true;
+        ctx->rsp.rsp_f      = false;
     }
 
-    ctx->flags.lr_rdy_f  = true;
-    ctx->flags.rsp_rdy_f = false;
-    ctx->tm.timer_f      = false;
-    ctx->rsp.rsp_f       = true;
+    if ( ctx->async.pending_f )
+    {
+        ctx->async.pending_f = false;
+        ctx->async.status    = LR_TIMEOUT;
+    }
+
+    ctx->tm.timeout_f = false;
+    ctx->tm.timer_f   = false;
 }
 
-static void lr_drv_process ( lr_t *ctx  ) 
+static int32_t lr_drv_poll ( lr_t *ctx )
 {
-    int32_t rsp_size;
-    char uart_rx_buffer[ DRV_RX_BUFFER_SIZE ] = { 0 };
-    uint8_t check_buf_cnt;
-    uint8_t process_cnt = 10;
-    
-    while ( process_cnt != 0 ) 
+    char uart_rx_buffer[ DRV_RX_BUFFER_SIZE ];
+    uint16_t free_size = ( ctx->ring.tail - ctx->ring.head - 1 ) & LR_RX_RING_MASK;
+    uint16_t tail = ctx->ring.tail;
+    int32_t rsp_size = 0;
+    int32_t cnt;
+
+    // Ring fed by lr_rx_isr, the UART must not be read from here too
+    if ( ctx->ring.isr_feed_f )
     {
-        rsp_size = lr_generic_read( ctx, &uart_rx_buffer, DRV_RX_BUFFER_SIZE );
+        lr_isr_process( ctx );
+        return ( int32_t ) ( ( ctx->ring.tail - tail ) & LR_RX_RING_MASK );
+    }
 
-        if ( rsp_size > 0 ) 
-        {  
-            // Validation of the received data
-            for ( check_buf_cnt = 0; check_buf_cnt < rsp_size; check_buf_cnt++ ) 
-            {
-                lr_put_char( ctx, uart_rx_buffer[ check_buf_cnt ] );
-                lr_isr_process( ctx );
-            }
-            
-            // Clear RX buffer
-            memset( uart_rx_buffer, 0, DRV_RX_BUFFER_SIZE );
-        } 
-        else 
+    if ( free_size > DRV_RX_BUFFER_SIZE )
+    {
+        free_size = DRV_RX_BUFFER_SIZE;
+    }
+
+    if ( free_size )
+    {
+        rsp_size = lr_generic_read( ctx, uart_rx_buffer, free_size );
+    }
+
+    for ( cnt = 0; cnt < rsp_size; cnt++ )
+    {
+        lr_ring_put( ctx, uart_rx_buffer[ cnt ] );
+    }
+
+    lr_isr_process( ctx );
+
+    return rsp_size;
+}
+
+static void lr_drv_process ( lr_t *ctx  )
+{
+    if ( lr_drv_poll( ctx ) <= 0 )
+    {
+        Delay_1ms( );
+
+        // Host timer counts the idle delays until lr_tick_isr is wired up
+        if ( !ctx->tm.tick_isr_f )
         {
-            process_cnt--;
-            
-            // Process delay 
-            Delay_100ms( );
+            lr_tick( ctx );
         }
     }
 }
@@ -0,0 +1,457 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ * \brief This file contains M-Bus protocol engine used with M Bus Master Click driver.
+ *
+ * The link layer decoder takes one byte at a time and validates the single
+ * character, short and long frames ( EN 13757-2 ). The application layer parses
+ * the RSP_UD header and walks the variable data records ( EN 13757-3 ) in place.
+ * The polling engine reads a list of meters with REQ_UD2, follows multi-telegram
+ * answers by toggling FCB and sends the next request as soon as the bus is free.
+ *
+ * \addtogroup mbusmaster M Bus Master Click Driver
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef MBUSMASTER_PROTO_H
+#define MBUSMASTER_PROTO_H
+
+#include "mbusmaster.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup proto_macros Protocol macros
+ * \{
+ */
+
+/**
+ * \defgroup proto_frame Frame bytes
+ * \{
+ */
+#define MBUSMASTER_FRAME_ACK                    0xE5
+#define MBUSMASTER_FRAME_SHORT_START            0x10
+#define MBUSMASTER_FRAME_LONG_START             0x68
+#define MBUSMASTER_FRAME_STOP                   0x16
+#define MBUSMASTER_FRAME_MAX_SIZE               261
+/** \} */
+
+/**
+ * \defgroup proto_control Control and CI fields
+ * \{
+ */
+#define MBUSMASTER_C_SND_NKE                    0x40
+#define MBUSMASTER_C_SND_UD                     0x53
+#define MBUSMASTER_C_REQ_UD2                    0x5B
+#define MBUSMASTER_C_FCB                        0x20
+#define MBUSMASTER_C_RSP_UD                     0x08
+#define MBUSMASTER_C_RSP_MASK                   0x4F
+#define MBUSMASTER_CI_SELECT                    0x52
+#define MBUSMASTER_CI_RSP_LONG                  0x72
+#define MBUSMASTER_CI_RSP_NONE                  0x78
+#define MBUSMASTER_CI_RSP_SHORT                 0x7A
+/** \} */
+
+/**
+ * \defgroup proto_address Addresses
+ * \{
+ */
+#define MBUSMASTER_ADDR_SECONDARY               0xFD
+#define MBUSMASTER_ADDR_BROADCAST_REPLY         0xFE
+#define MBUSMASTER_ADDR_BROADCAST               0xFF
+/** \} */
+
+/**
+ * \defgroup proto_decode Decoder result
+ * \{
+ */
+#define MBUSMASTER_DECODE_NONE                  0
+#define MBUSMASTER_DECODE_FRAME                 1
+#define MBUSMASTER_DECODE_ERROR                 2
+/** \} */
+
+/**
+ * \defgroup proto_frame_type Frame type
+ * \{
+ */
+#define MBUSMASTER_FRAME_TYPE_ACK               0
+#define MBUSMASTER_FRAME_TYPE_SHORT             1
+#define MBUSMASTER_FRAME_TYPE_LONG              2
+/** \} */
+
+/**
+ * \defgroup proto_dif Special DIF
+ * \{
+ */
+#define MBUSMASTER_DIF_MANUFACTURER             0x0F
+#define MBUSMASTER_DIF_MORE_RECORDS             0x1F
+#define MBUSMASTER_DIF_IDLE_FILLER              0x2F
+#define MBUSMASTER_DIF_VARIABLE                 0x0D
+/** \} */
+
+/**
+ * \defgroup proto_quantity VIF quantity
+ * \{
+ */
+#define MBUSMASTER_QUANTITY_UNKNOWN             0
+#define MBUSMASTER_QUANTITY_ENERGY_WH           1
+#define MBUSMASTER_QUANTITY_ENERGY_J            2
+#define MBUSMASTER_QUANTITY_VOLUME_M3           3
+#define MBUSMASTER_QUANTITY_MASS_KG             4
+#define MBUSMASTER_QUANTITY_POWER_W             5
+#define MBUSMASTER_QUANTITY_POWER_J_H           6
+#define MBUSMASTER_QUANTITY_FLOW_M3_H           7
+#define MBUSMASTER_QUANTITY_FLOW_M3_MIN         8
+#define MBUSMASTER_QUANTITY_FLOW_M3_S           9
+#define MBUSMASTER_QUANTITY_MASS_FLOW_KG_H      10
+#define MBUSMASTER_QUANTITY_FLOW_TEMP_C         11
+#define MBUSMASTER_QUANTITY_RETURN_TEMP_C       12
+#define MBUSMASTER_QUANTITY_TEMP_DIFF_K         13
+#define MBUSMASTER_QUANTITY_EXT_TEMP_C          14
+#define MBUSMASTER_QUANTITY_PRESSURE_BAR        15
+#define MBUSMASTER_QUANTITY_DATE                16
+#define MBUSMASTER_QUANTITY_DATE_TIME           17
+#define MBUSMASTER_QUANTITY_HCA                 18
+#define MBUSMASTER_QUANTITY_FABRICATION_NO      19
+#define MBUSMASTER_QUANTITY_ENHANCED_ID         20
+#define MBUSMASTER_QUANTITY_BUS_ADDRESS         21
+/** \} */
+
+/**
+ * \defgroup proto_meter_status Meter status
+ * \{
+ */
+#define MBUSMASTER_METER_IDLE                   0
+#define MBUSMASTER_METER_OK                     1
+#define MBUSMASTER_METER_TIMEOUT                2
+#define MBUSMASTER_METER_ERROR                  3
+/** \} */
+
+/**
+ * \defgroup proto_event Polling event
+ * \{
+ */
+#define MBUSMASTER_POLL_EVENT_NONE              0
+#define MBUSMASTER_POLL_EVENT_METER             1
+#define MBUSMASTER_POLL_EVENT_CYCLE             2
+/** \} */
+
+/**
+ * \defgroup proto_settings Polling settings
+ * \{
+ */
+#define MBUSMASTER_POLL_DEFAULT_RETRIES         1
+#define MBUSMASTER_POLL_DEFAULT_TELEGRAMS       8
+#define MBUSMASTER_POLL_TX_SIZE                 17
+/** \} */
+
+/** \} */ // End group proto_macros
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup proto_type Protocol types
+ * \{
+ */
+
+/**
+ * @brief Link layer decoder definition.
+ */
+typedef struct
+{
+    uint8_t state;                      /**< Decoder state. */
+    uint16_t cnt;                       /**< Frame bytes received. */
+    uint16_t need;                      /**< Frame length once known. */
+    uint16_t checksum_err;              /**< Frames dropped because of the checksum. */
+    uint16_t frame_err;                 /**< Frames dropped because of the format. */
+    uint8_t buf[ MBUSMASTER_FRAME_MAX_SIZE ];   /**< Frame buffer. */
+
+} mbusmaster_decoder_t;
+
+/**
+ * @brief Link layer frame definition, pointing into the decoder buffer.
+ */
+typedef struct
+{
+    uint8_t type;                       /**< ACK, short or long frame. */
+    uint8_t c;                          /**< Control field. */
+    uint8_t a;                          /**< Address field. */
+    uint8_t ci;                         /**< CI field of a long frame. */
+    const uint8_t *data;                /**< Data after the CI field. */
+    uint8_t len;                        /**< Data length. */
+
+} mbusmaster_frame_t;
+
+/**
+ * @brief RSP_UD telegram definition, pointing into the frame.
+ */
+typedef struct
+{
+    uint32_t id;                        /**< Identification number, 0 without long header. */
+    uint16_t manufacturer;              /**< Manufacturer code. */
+    uint8_t version;                    /**< Version. */
+    uint8_t medium;                     /**< Medium. */
+    uint8_t access_no;                  /**< Access number. */
+    uint8_t status;                     /**< Status byte. */
+    uint16_t signature;                 /**< Signature. */
+    const uint8_t *records;             /**< First data record. */
+    uint8_t records_len;                /**< Length of all data records. */
+    uint8_t more_f;                     /**< More records follow in the next telegram. */
+
+} mbusmaster_telegram_t;
+
+/**
+ * @brief Data record definition, pointing into the telegram.
+ */
+typedef struct
+{
+    uint8_t dif;                        /**< Data information field. */
+    uint8_t vif;                        /**< Value information field, 0 for manufacturer data. */
+    const uint8_t *dib;                 /**< Data information block, DIF and DIFEs. */
+    uint8_t dib_len;                    /**< Data information block length. */
+    const uint8_t *vib;                 /**< Value information block, VIF, plain text and VIFEs. */
+    uint8_t vib_len;                    /**< Value information block length. */
+    const uint8_t *data;                /**< Record data. */
+    uint8_t data_len;                   /**< Record data length. */
+    uint8_t lvar;                       /**< LVAR byte of variable length data. */
+    uint8_t function;                   /**< 0 - instantaneous, 1 - maximum, 2 - minimum, 3 - error. */
+    uint32_t storage;                   /**< Storage number. */
+    uint16_t tariff;                    /**< Tariff. */
+    uint16_t subunit;                   /**< Subunit. */
+
+} mbusmaster_record_t;
+
+/**
+ * @brief Data record iterator definition.
+ */
+typedef struct
+{
+    const uint8_t *pos;                 /**< Next record. */
+    const uint8_t *end;                 /**< End of the records. */
+    uint8_t error_f;                    /**< Malformed record found. */
+
+} mbusmaster_record_iter_t;
+
+/**
+ * @brief Meter definition.
+ */
+typedef struct
+{
+    uint8_t primary;                    /**< Primary address, or MBUSMASTER_ADDR_SECONDARY. */
+    uint8_t secondary[ 8 ];             /**< ID ( BCD, LSB first ), manufacturer, version and medium. */
+    uint16_t timeout;                   /**< Response timeout in ms, 0 for the engine default. */
+    uint8_t fcb;                        /**< FCB of the next REQ_UD2. */
+    uint8_t sync_f;                     /**< FCB synchronized by SND_NKE. */
+    uint8_t status;                     /**< Status of the last poll. */
+    uint8_t telegrams;                  /**< Telegrams received in the last poll. */
+    uint16_t errors;                    /**< Failed polls. */
+
+} mbusmaster_meter_t;
+
+/**
+ * @brief Telegram callback, called for every RSP_UD of a meter.
+ */
+typedef void ( *mbusmaster_telegram_cb_t ) ( mbusmaster_meter_t *meter, mbusmaster_telegram_t *tg );
+
+/**
+ * @brief Polling engine definition.
+ */
+typedef struct
+{
+    mbusmaster_t *ctx;                  /**< Click object. */
+    mbusmaster_meter_t *meters;         /**< Meters polled in turn. */
+    uint16_t n_meters;                  /**< Number of meters. */
+    uint16_t index;                     /**< Meter being polled. */
+    mbusmaster_telegram_cb_t callback;  /**< Telegram callback. */
+
+    uint32_t baud_rate;                 /**< Bus baud rate. */
+    uint16_t timeout;                   /**< Default response timeout in ms. */
+    uint16_t gap;                       /**< Idle time before a request in ms. */
+    uint8_t retries;                    /**< Repetitions of a request without a valid answer. */
+    uint8_t max_telegrams;              /**< Telegrams read from one meter in a cycle. */
+
+    uint8_t state;                      /**< Engine state. */
+    uint8_t step;                       /**< Request of the meter being sent. */
+    uint8_t retry;                      /**< Repetitions of the current request. */
+    uint16_t wait;                      /**< Ticks to wait in the current state. */
+    volatile uint16_t ticker;           /**< ms since the last bus activity. */
+
+    mbusmaster_decoder_t dec;           /**< Link layer decoder. */
+    uint8_t tx_frame[ MBUSMASTER_POLL_TX_SIZE ];    /**< Request frame. */
+
+} mbusmaster_poll_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+/**
+ * \defgroup proto_function Protocol function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Decoder reset function.
+ *
+ * @param dec        Link layer decoder.
+ *
+ * @description This function drops any partial frame and clears the error counters.
+ */
+void mbusmaster_decoder_reset ( mbusmaster_decoder_t *dec );
+
+/**
+ * @brief Decoder byte function.
+ *
+ * @param dec        Link layer decoder.
+ * @param rx_data    Received byte.
+ * @param frame      Frame output, valid until the next byte.
+ *
+ * @returns MBUSMASTER_DECODE_FRAME when a valid frame is complete,
+ * MBUSMASTER_DECODE_ERROR when a frame is dropped or MBUSMASTER_DECODE_NONE.
+ *
+ * @description This function passes one received byte to the link layer decoder.
+ * It checks both length bytes, the second start byte, the checksum and the stop byte.
+ */
+uint8_t mbusmaster_decode_byte ( mbusmaster_decoder_t *dec, uint8_t rx_data, mbusmaster_frame_t *frame );
+
+/**
+ * @brief Telegram parse function.
+ *
+ * @param frame      Valid long frame.
+ * @param tg         Telegram output.
+ *
+ * @returns MBUSMASTER_OK or MBUSMASTER_INIT_ERROR if the frame is not a RSP_UD
+ * with variable data structure or a record is malformed.
+ *
+ * @description This function parses the header of RSP_UD and walks the records once
+ * to check them and to find out if more records follow in the next telegram.
+ */
+MBUSMASTER_RETVAL mbusmaster_telegram_parse ( const mbusmaster_frame_t *frame, mbusmaster_telegram_t *tg );
+
+/**
+ * @brief Record iterator start function.
+ *
+ * @param tg         Parsed telegram.
+ * @param iter       Record iterator.
+ */
+void mbusmaster_record_first ( const mbusmaster_telegram_t *tg, mbusmaster_record_iter_t *iter );
+
+/**
+ * @brief Record iterator next function.
+ *
+ * @param iter       Record iterator.
+ * @param rec        Record output, pointing into the telegram.
+ *
+ * @returns 1 if a record is returned, 0 at the end of the records or on a malformed record.
+ *
+ * @description This function returns the next data record without copying it.
+ * Idle fillers are skipped and manufacturer specific data is returned as the last record.
+ */
+uint8_t mbusmaster_record_next ( mbusmaster_record_iter_t *iter, mbusmaster_record_t *rec );
+
+/**
+ * @brief Record value function.
+ *
+ * @param rec        Data record.
+ * @param value      Value output.
+ *
+ * @returns MBUSMASTER_OK or MBUSMASTER_INIT_ERROR if the data is not an integer or BCD number.
+ *
+ * @description This function decodes integer and BCD record data, variable length
+ * binary and BCD numbers included, to a signed value.
+ */
+MBUSMASTER_RETVAL mbusmaster_record_value ( const mbusmaster_record_t *rec, int64_t *value );
+
+/**
+ * @brief Record quantity function.
+ *
+ * @param rec        Data record.
+ * @param exponent   Decimal exponent of the value unit.
+ *
+ * @returns Quantity of the primary VIF, see proto_quantity.
+ *
+ * @description This function decodes the primary VIF, e.g. VIF 0x13 gives
+ * MBUSMASTER_QUANTITY_VOLUME_M3 with exponent -3, that is liters.
+ */
+uint8_t mbusmaster_record_quantity ( const mbusmaster_record_t *rec, int8_t *exponent );
+
+/**
+ * @brief Polling engine initialization function.
+ *
+ * @param poll       Polling engine.
+ * @param ctx        Initialized Click object.
+ * @param meters     Meters to poll.
+ * @param n_meters   Number of meters.
+ * @param baud_rate  Bus baud rate.
+ * @param callback   Telegram callback.
+ *
+ * @description This function sets the response timeout to 330 bit times plus 50 ms
+ * and the idle time before a request to 11 bit times, as EN 13757-2 allows.
+ * @note M-Bus uses 8 data bits with even parity, set in the Click configuration.
+ */
+void mbusmaster_poll_init ( mbusmaster_poll_t *poll, mbusmaster_t *ctx, mbusmaster_meter_t *meters,
+                            uint16_t n_meters, uint32_t baud_rate, mbusmaster_telegram_cb_t callback );
+
+/**
+ * @brief Polling cycle start function.
+ *
+ * @param poll       Polling engine.
+ *
+ * @description This function starts reading all meters once, from the first one.
+ */
+void mbusmaster_poll_start ( mbusmaster_poll_t *poll );
+
+/**
+ * @brief Polling tick function.
+ *
+ * @param poll       Polling engine.
+ *
+ * @description This function counts the time for the timeouts. Call it every 1 ms
+ * from a timer interrupt.
+ */
+void mbusmaster_poll_tick ( mbusmaster_poll_t *poll );
+
+/**
+ * @brief Polling process function.
+ *
+ * @param poll       Polling engine.
+ *
+ * @returns MBUSMASTER_POLL_EVENT_METER when a meter is done, MBUSMASTER_POLL_EVENT_CYCLE
+ * when the last meter is done or MBUSMASTER_POLL_EVENT_NONE.
+ *
+ * @description This function reads the received bytes, advances the exchange and
+ * sends the next request as soon as the bus is idle. Call it as often as possible
+ * from the main loop, it never blocks.
+ */
+uint8_t mbusmaster_poll_process ( mbusmaster_poll_t *poll );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _MBUSMASTER_PROTO_H_
+
+/** \} */ // End proto_function group
+/*! @} */
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,860 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ */
+
+#include "mbusmaster_proto.h"
+#include "string.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+// Decoder states
+#define PROTO_DEC_IDLE              0
+#define PROTO_DEC_FRAME             1
+
+// Offsets in the long frame
+#define PROTO_LONG_HEADER_LEN       4
+#define PROTO_LONG_OVERHEAD         6
+#define PROTO_LONG_MIN_L            3
+#define PROTO_SHORT_LEN             5
+
+// RSP_UD headers
+#define PROTO_HEADER_LONG_LEN       12
+#define PROTO_HEADER_SHORT_LEN      4
+
+// Record limits
+#define PROTO_MAX_EXT               10
+#define PROTO_EXT_BIT               0x80
+#define PROTO_VIF_PLAIN_TEXT        0x7C
+
+// Engine states
+#define PROTO_STATE_IDLE            0
+#define PROTO_STATE_GAP             1
+#define PROTO_STATE_WAIT_ACK        2
+#define PROTO_STATE_WAIT_RSP        3
+
+// Requests of one meter
+#define PROTO_STEP_NKE              0
+#define PROTO_STEP_SELECT           1
+#define PROTO_STEP_REQ              2
+
+// Bus timing in bit times, EN 13757-2
+#define PROTO_RSP_TIMEOUT_BITS      330
+#define PROTO_RSP_TIMEOUT_MS        50
+#define PROTO_GAP_BITS              11
+#define PROTO_CHAR_BITS             11
+
+#define PROTO_RX_CHUNK_SIZE         64
+
+// Data length by the DIF data field, variable length marked with 0xFF
+static const uint8_t proto_data_len[ 16 ] =
+{
+    0, 1, 2, 3, 4, 4, 6, 8, 0, 1, 2, 3, 4, 0xFF, 6, 0
+};
+
+// Primary VIF ranges, the low bits given by mask select the exponent
+typedef struct
+{
+    uint8_t vif;
+    uint8_t mask;
+    uint8_t quantity;
+    int8_t offset;
+
+} proto_vif_t;
+
+static const proto_vif_t proto_vif_table[ ] =
+{
+    { 0x00, 0x07, MBUSMASTER_QUANTITY_ENERGY_WH,       -3 },
+    { 0x08, 0x07, MBUSMASTER_QUANTITY_ENERGY_J,         0 },
+    { 0x10, 0x07, MBUSMASTER_QUANTITY_VOLUME_M3,       -6 },
+    { 0x18, 0x07, MBUSMASTER_QUANTITY_MASS_KG,         -3 },
+    { 0x28, 0x07, MBUSMASTER_QUANTITY_POWER_W,         -3 },
+    { 0x30, 0x07, MBUSMASTER_QUANTITY_POWER_J_H,        0 },
+    { 0x38, 0x07, MBUSMASTER_QUANTITY_FLOW_M3_H,       -6 },
+    { 0x40, 0x07, MBUSMASTER_QUANTITY_FLOW_M3_MIN,     -7 },
+    { 0x48, 0x07, MBUSMASTER_QUANTITY_FLOW_M3_S,       -9 },
+    { 0x50, 0x07, MBUSMASTER_QUANTITY_MASS_FLOW_KG_H,  -3 },
+    { 0x58, 0x03, MBUSMASTER_QUANTITY_FLOW_TEMP_C,     -3 },
+    { 0x5C, 0x03, MBUSMASTER_QUANTITY_RETURN_TEMP_C,   -3 },
+    { 0x60, 0x03, MBUSMASTER_QUANTITY_TEMP_DIFF_K,     -3 },
+    { 0x64, 0x03, MBUSMASTER_QUANTITY_EXT_TEMP_C,      -3 },
+    { 0x68, 0x03, MBUSMASTER_QUANTITY_PRESSURE_BAR,    -3 },
+    { 0x6C, 0x00, MBUSMASTER_QUANTITY_DATE,             0 },
+    { 0x6D, 0x00, MBUSMASTER_QUANTITY_DATE_TIME,        0 },
+    { 0x6E, 0x00, MBUSMASTER_QUANTITY_HCA,              0 },
+    { 0x78, 0x00, MBUSMASTER_QUANTITY_FABRICATION_NO,   0 },
+    { 0x79, 0x00, MBUSMASTER_QUANTITY_ENHANCED_ID,      0 },
+    { 0x7A, 0x00, MBUSMASTER_QUANTITY_BUS_ADDRESS,      0 }
+};
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static int64_t proto_get_bcd ( const uint8_t *data_buf, uint8_t len );
+
+static int64_t proto_get_int ( const uint8_t *data_buf, uint8_t len );
+
+static uint16_t proto_char_ms ( mbusmaster_poll_t *poll, uint16_t n_chars );
+
+static void proto_meter_begin ( mbusmaster_poll_t *poll );
+
+static void proto_send ( mbusmaster_poll_t *poll );
+
+static void proto_next_request ( mbusmaster_poll_t *poll, uint8_t step );
+
+static uint8_t proto_rx_frame ( mbusmaster_poll_t *poll, mbusmaster_frame_t *frame );
+
+static uint8_t proto_failed ( mbusmaster_poll_t *poll, uint8_t status );
+
+static uint8_t proto_done ( mbusmaster_poll_t *poll, uint8_t status );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void mbusmaster_decoder_reset ( mbusmaster_decoder_t *dec )
+{
+    dec->state = PROTO_DEC_IDLE;
+    dec->cnt = 0;
+    dec->need = 0;
+    dec->checksum_err = 0;
+    dec->frame_err = 0;
+}
+
+uint8_t mbusmaster_decode_byte ( mbusmaster_decoder_t *dec, uint8_t rx_data, mbusmaster_frame_t *frame )
+{
+    uint8_t *buf = dec->buf;
+    uint8_t sum = 0;
+    uint16_t cnt;
+
+    if ( PROTO_DEC_IDLE == dec->state )
+    {
+        if ( MBUSMASTER_FRAME_ACK == rx_data )
+        {
+            frame->type = MBUSMASTER_FRAME_TYPE_ACK;
+            frame->c    = 0;
+            frame->a    = 0;
+            frame->ci   = 0;
+            frame->data = 0;
+            frame->len  = 0;
+            return MBUSMASTER_DECODE_FRAME;
+        }
+
+        if ( MBUSMASTER_FRAME_SHORT_START == rx_data )
+        {
+            dec->need = PROTO_SHORT_LEN;
+        }
+        else if ( MBUSMASTER_FRAME_LONG_START == rx_data )
+        {
+            // Real length is known after the header
+            dec->need = PROTO_LONG_HEADER_LEN;
+        }
+        else
+        {
+            return MBUSMASTER_DECODE_NONE;
+        }
+
+        buf[ 0 ] = rx_data;
+        dec->cnt = 1;
+        dec->state = PROTO_DEC_FRAME;
+        return MBUSMASTER_DECODE_NONE;
+    }
+
+    buf[ dec->cnt++ ] = rx_data;
+
+    if ( ( MBUSMASTER_FRAME_LONG_START == buf[ 0 ] ) && ( PROTO_LONG_HEADER_LEN == dec->cnt ) )
+    {
+        if ( ( buf[ 1 ] != buf[ 2 ] ) || ( MBUSMASTER_FRAME_LONG_START != buf[ 3 ] ) ||
+             ( buf[ 1 ] < PROTO_LONG_MIN_L ) )
+        {
+            dec->frame_err++;
+            dec->state = PROTO_DEC_IDLE;
+            return MBUSMASTER_DECODE_ERROR;
+        }
+        dec->need = buf[ 1 ] + PROTO_LONG_OVERHEAD;
+        return MBUSMASTER_DECODE_NONE;
+    }
+
+    if ( dec->cnt < dec->need )
+    {
+        return MBUSMASTER_DECODE_NONE;
+    }
+
+    dec->state = PROTO_DEC_IDLE;
+
+    if ( MBUSMASTER_FRAME_STOP != buf[ dec->need - 1 ] )
+    {
+        dec->frame_err++;
+        return MBUSMASTER_DECODE_ERROR;
+    }
+
+    // Checksum covers C field to the last data byte
+    cnt = ( MBUSMASTER_FRAME_SHORT_START == buf[ 0 ] ) ? 1 : PROTO_LONG_HEADER_LEN;
+    for ( ; cnt < ( dec->need - 2 ); cnt++ )
+    {
+        sum += buf[ cnt ];
+    }
+    if ( sum != buf[ dec->need - 2 ] )
+    {
+        dec->checksum_err++;
+        return MBUSMASTER_DECODE_ERROR;
+    }
+
+    if ( MBUSMASTER_FRAME_SHORT_START == buf[ 0 ] )
+    {
+        frame->type = MBUSMASTER_FRAME_TYPE_SHORT;
+        frame->c    = buf[ 1 ];
+        frame->a    = buf[ 2 ];
+        frame->ci   = 0;
+        frame->data = 0;
+        frame->len  = 0;
+    }
+    else
+    {
+        frame->type = MBUSMASTER_FRAME_TYPE_LONG;
+        frame->c    = buf[ 4 ];
+        frame->a    = buf[ 5 ];
+        frame->ci   = buf[ 6 ];
+        frame->data = &buf[ 7 ];
+        frame->len  = buf[ 1 ] - PROTO_LONG_MIN_L;
+    }
+
+    return MBUSMASTER_DECODE_FRAME;
+}
+
+MBUSMASTER_RETVAL mbusmaster_telegram_parse ( const mbusmaster_frame_t *frame, mbusmaster_telegram_t *tg )
+{
+    const uint8_t *data_buf = frame->data;
+    mbusmaster_record_iter_t iter;
+    mbusmaster_record_t rec;
+    uint8_t header_len;
+
+    if ( ( MBUSMASTER_FRAME_TYPE_LONG != frame->type ) ||
+         ( MBUSMASTER_C_RSP_UD != ( frame->c & MBUSMASTER_C_RSP_MASK ) ) )
+    {
+        return MBUSMASTER_INIT_ERROR;
+    }
+
+    memset( tg, 0, sizeof( mbusmaster_telegram_t ) );
+
+    switch ( frame->ci )
+    {
+        case MBUSMASTER_CI_RSP_LONG:
+        {
+            header_len = PROTO_HEADER_LONG_LEN;
+            break;
+        }
+        case MBUSMASTER_CI_RSP_SHORT:
+        {
+            header_len = PROTO_HEADER_SHORT_LEN;
+            break;
+        }
+        case MBUSMASTER_CI_RSP_NONE:
+        {
+            header_len = 0;
+            break;
+        }
+        default:
+        {
+            return MBUSMASTER_INIT_ERROR;
+        }
+    }
+
+    if ( frame->len < header_len )
+    {
+        return MBUSMASTER_INIT_ERROR;
+    }
+
+    if ( PROTO_HEADER_LONG_LEN == header_len )
+    {
+        tg->id           = ( uint32_t ) proto_get_bcd( data_buf, 4 );
+        tg->manufacturer = ( ( uint16_t ) data_buf[ 5 ] << 8 ) | data_buf[ 4 ];
+        tg->version      = data_buf[ 6 ];
+        tg->medium       = data_buf[ 7 ];
+        data_buf += 8;
+    }
+    if ( header_len )
+    {
+        tg->access_no = data_buf[ 0 ];
+        tg->status    = data_buf[ 1 ];
+        tg->signature = ( ( uint16_t ) data_buf[ 3 ] << 8 ) | data_buf[ 2 ];
+    }
+
+    tg->records     = frame->data + header_len;
+    tg->records_len = frame->len - header_len;
+
+    mbusmaster_record_first( tg, &iter );
+    while ( mbusmaster_record_next( &iter, &rec ) )
+    {
+        if ( MBUSMASTER_DIF_MORE_RECORDS == rec.dif )
+        {
+            tg->more_f = 1;
+        }
+    }
+
+    return iter.error_f ? MBUSMASTER_INIT_ERROR : MBUSMASTER_OK;
+}
+
+void mbusmaster_record_first ( const mbusmaster_telegram_t *tg, mbusmaster_record_iter_t *iter )
+{
+    iter->pos     = tg->records;
+    iter->end     = tg->records + tg->records_len;
+    iter->error_f = 0;
+}
+
+uint8_t mbusmaster_record_next ( mbusmaster_record_iter_t *iter, mbusmaster_record_t *rec )
+{
+    const uint8_t *pos = iter->pos;
+    const uint8_t *end = iter->end;
+    uint8_t ext = 0;
+    uint8_t len = 0;
+
+    while ( ( pos < end ) && ( MBUSMASTER_DIF_IDLE_FILLER == *pos ) )
+    {
+        pos++;
+    }
+    if ( pos >= end )
+    {
+        iter->pos = end;
+        return 0;
+    }
+
+    memset( rec, 0, sizeof( mbusmaster_record_t ) );
+    rec->dib = pos;
+    rec->dif = *pos++;
+
+    // Manufacturer specific data runs to the end of the telegram
+    if ( MBUSMASTER_DIF_MANUFACTURER == ( rec->dif & 0x0F ) )
+    {
+        rec->dib_len  = 1;
+        rec->data     = pos;
+        rec->data_len = ( uint8_t ) ( end - pos );
+        iter->pos     = end;
+        return 1;
+    }
+
+    rec->function = ( rec->dif >> 4 ) & 0x03;
+    rec->storage  = ( rec->dif >> 6 ) & 0x01;
+
+    for ( ext = 0; rec->dib[ ext ] & PROTO_EXT_BIT; ext++ )
+    {
+        if ( ( pos >= end ) || ( ext >= PROTO_MAX_EXT ) )
+        {
+            iter->error_f = 1;
+            return 0;
+        }
+        if ( ext < 8 )
+        {
+            rec->storage |= ( uint32_t ) ( *pos & 0x0F ) << ( 1 + 4 * ext );
+            rec->tariff  |= ( uint16_t ) ( ( *pos >> 4 ) & 0x03 ) << ( 2 * ext );
+            rec->subunit |= ( uint16_t ) ( ( *pos >> 6 ) & 0x01 ) << ext;
+        }
+        pos++;
+    }
+    rec->dib_len = ( uint8_t ) ( pos - rec->dib );
+
+    if ( pos >= end )
+    {
+        iter->error_f = 1;
+        return 0;
+    }
+    rec->vib = pos;
+    rec->vif = *pos++;
+
+    // Plain text VIF carries its own unit string
+    if ( PROTO_VIF_PLAIN_TEXT == ( rec->vif & ~PROTO_EXT_BIT ) )
+    {
+        if ( ( pos >= end ) || ( *pos >= ( end - pos ) ) )
+        {
+            iter->error_f = 1;
+            return 0;
+        }
+        pos += *pos + 1;
+    }
+
+    for ( ext = 0, len = rec->vif; len & PROTO_EXT_BIT; ext++ )
+    {
+        if ( ( pos >= end ) || ( ext >= PROTO_MAX_EXT ) )
+        {
+            iter->error_f = 1;
+            return 0;
+        }
+        len = *pos++;
+    }
+    rec->vib_len = ( uint8_t ) ( pos - rec->vib );
+
+    len = proto_data_len[ rec->dif & 0x0F ];
+    if ( MBUSMASTER_DIF_VARIABLE == ( rec->dif & 0x0F ) )
+    {
+        if ( pos >= end )
+        {
+            iter->error_f = 1;
+            return 0;
+        }
+        rec->lvar = *pos++;
+        if ( rec->lvar < 0xC0 )
+        {
+            len = rec->lvar;
+        }
+        else if ( rec->lvar < 0xF0 )
+        {
+            // BCD, negative BCD and binary numbers of LVAR-C0h/D0h/E0h bytes
+            len = rec->lvar & 0x0F;
+        }
+        else if ( rec->lvar < 0xF5 )
+        {
+            // Binary numbers of 4*(LVAR-F0h)+4 bytes
+            len = ( ( rec->lvar - 0xF0 ) << 2 ) + 4;
+        }
+        else if ( 0xF5 == rec->lvar )
+        {
+            len = 48;
+        }
+        else if ( 0xF6 == rec->lvar )
+        {
+            len = 64;
+        }
+        else
+        {
+            iter->error_f = 1;
+            return 0;
+        }
+    }
+
+    if ( len > ( end - pos ) )
+    {
+        iter->error_f = 1;
+        return 0;
+    }
+    rec->data     = pos;
+    rec->data_len = len;
+    iter->pos     = pos + len;
+    return 1;
+}
+
+MBUSMASTER_RETVAL mbusmaster_record_value ( const mbusmaster_record_t *rec, int64_t *value )
+{
+    switch ( rec->dif & 0x0F )
+    {
+        case 0x01:
+        case 0x02:
+        case 0x03:
+        case 0x04:
+        case 0x06:
+        case 0x07:
+        {
+            *value = proto_get_int( rec->data, rec->data_len );
+            return MBUSMASTER_OK;
+        }
+        case 0x09:
+        case 0x0A:
+        case 0x0B:
+        case 0x0C:
+        case 0x0E:
+        {
+            *value = proto_get_bcd( rec->data, rec->data_len );
+            return MBUSMASTER_OK;
+        }
+        case MBUSMASTER_DIF_VARIABLE:
+        {
+            if ( ( rec->lvar >= 0xC0 ) && ( rec->lvar < 0xD0 ) )
+            {
+                *value = proto_get_bcd( rec->data, rec->data_len );
+                return MBUSMASTER_OK;
+            }
+            if ( ( rec->lvar >= 0xD0 ) && ( rec->lvar < 0xE0 ) )
+            {
+                *value = -proto_get_bcd( rec->data, rec->data_len );
+                return MBUSMASTER_OK;
+            }
+            if ( ( rec->lvar >= 0xE0 ) && ( rec->lvar < 0xE9 ) )
+            {
+                *value = proto_get_int( rec->data, rec->data_len );
+                return MBUSMASTER_OK;
+            }
+            return MBUSMASTER_INIT_ERROR;
+        }
+        default:
+        {
+            return MBUSMASTER_INIT_ERROR;
+        }
+    }
+}
+
+uint8_t mbusmaster_record_quantity ( const mbusmaster_record_t *rec, int8_t *exponent )
+{
+    uint8_t vif = rec->vif & ~PROTO_EXT_BIT;
+    uint8_t cnt;
+
+    *exponent = 0;
+    if ( NULL == rec->vib )
+    {
+        return MBUSMASTER_QUANTITY_UNKNOWN;
+    }
+
+    for ( cnt = 0; cnt < ( sizeof( proto_vif_table ) / sizeof( proto_vif_table[ 0 ] ) ); cnt++ )
+    {
+        if ( ( vif & ~proto_vif_table[ cnt ].mask ) == proto_vif_table[ cnt ].vif )
+        {
+            *exponent = proto_vif_table[ cnt ].offset + ( vif & proto_vif_table[ cnt ].mask );
+            return proto_vif_table[ cnt ].quantity;
+        }
+    }
+
+    return MBUSMASTER_QUANTITY_UNKNOWN;
+}
+
+void mbusmaster_poll_init ( mbusmaster_poll_t *poll, mbusmaster_t *ctx, mbusmaster_meter_t *meters,
+                            uint16_t n_meters, uint32_t baud_rate, mbusmaster_telegram_cb_t callback )
+{
+    poll->ctx           = ctx;
+    poll->meters        = meters;
+    poll->n_meters      = n_meters;
+    poll->index         = 0;
+    poll->callback      = callback;
+    poll->baud_rate     = baud_rate;
+    poll->timeout       = ( PROTO_RSP_TIMEOUT_BITS * 1000ul + baud_rate - 1 ) / baud_rate + PROTO_RSP_TIMEOUT_MS;
+    poll->gap           = ( PROTO_GAP_BITS * 1000ul + baud_rate - 1 ) / baud_rate + 1;
+    poll->retries       = MBUSMASTER_POLL_DEFAULT_RETRIES;
+    poll->max_telegrams = MBUSMASTER_POLL_DEFAULT_TELEGRAMS;
+    poll->state         = PROTO_STATE_IDLE;
+    poll->ticker        = 0;
+
+    mbusmaster_decoder_reset( &poll->dec );
+}
+
+void mbusmaster_poll_start ( mbusmaster_poll_t *poll )
+{
+    if ( 0 == poll->n_meters )
+    {
+        return;
+    }
+
+    poll->index = 0;
+    proto_meter_begin( poll );
+}
+
+void mbusmaster_poll_tick ( mbusmaster_poll_t *poll )
+{
+    if ( poll->ticker < 0xFFFF )
+    {
+        poll->ticker++;
+    }
+}
+
+uint8_t mbusmaster_poll_process ( mbusmaster_poll_t *poll )
+{
+    uint8_t rx_buf[ PROTO_RX_CHUNK_SIZE ];
+    mbusmaster_frame_t frame;
+    int32_t rx_size;
+    int32_t cnt;
+    uint8_t event = MBUSMASTER_POLL_EVENT_NONE;
+    uint8_t res;
+
+    rx_size = mbusmaster_generic_read( poll->ctx, ( char * ) rx_buf, PROTO_RX_CHUNK_SIZE );
+
+    for ( cnt = 0; cnt < rx_size; cnt++ )
+    {
+        // Any byte on the bus restarts the idle time
+        poll->ticker = 0;
+        res = mbusmaster_decode_byte( &poll->dec, rx_buf[ cnt ], &frame );
+
+        if ( MBUSMASTER_DECODE_FRAME == res )
+        {
+            res = proto_rx_frame( poll, &frame );
+        }
+        else if ( ( MBUSMASTER_DECODE_ERROR == res ) && ( poll->state >= PROTO_STATE_WAIT_ACK ) )
+        {
+            res = proto_failed( poll, MBUSMASTER_METER_ERROR );
+        }
+        else
+        {
+            res = MBUSMASTER_POLL_EVENT_NONE;
+        }
+
+        if ( res > event )
+        {
+            event = res;
+        }
+    }
+
+    switch ( poll->state )
+    {
+        case PROTO_STATE_GAP:
+        {
+            if ( poll->ticker >= poll->wait )
+            {
+                proto_send( poll );
+            }
+            break;
+        }
+        case PROTO_STATE_WAIT_ACK:
+        case PROTO_STATE_WAIT_RSP:
+        {
+            if ( poll->ticker > poll->wait )
+            {
+                res = proto_failed( poll, MBUSMASTER_METER_TIMEOUT );
+                if ( res > event )
+                {
+                    event = res;
+                }
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return event;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static int64_t proto_get_bcd ( const uint8_t *data_buf, uint8_t len )
+{
+    int64_t value = 0;
+    int8_t sign = 1;
+    uint8_t cnt;
+
+    if ( 0 == len )
+    {
+        return 0;
+    }
+
+    // MSB nibble 0xF marks a negative value
+    cnt = len;
+    if ( 0xF0 == ( data_buf[ len - 1 ] & 0xF0 ) )
+    {
+        sign = -1;
+        value = data_buf[ len - 1 ] & 0x0F;
+        cnt--;
+    }
+    while ( cnt-- )
+    {
+        value = value * 100 + ( data_buf[ cnt ] >> 4 ) * 10 + ( data_buf[ cnt ] & 0x0F );
+    }
+
+    return sign * value;
+}
+
+static int64_t proto_get_int ( const uint8_t *data_buf, uint8_t len )
+{
+    uint64_t value = 0;
+    uint8_t cnt = len;
+
+    if ( ( 0 == len ) || ( len > 8 ) )
+    {
+        return 0;
+    }
+
+    while ( cnt-- )
+    {
+        value = ( value << 8 ) | data_buf[ cnt ];
+    }
+
+    // Sign extension of shorter numbers
+    if ( ( len < 8 ) && ( data_buf[ len - 1 ] & 0x80 ) )
+    {
+        value |= ~( ( 1ull << ( 8 * len ) ) - 1 );
+    }
+
+    return ( int64_t ) value;
+}
+
+static uint16_t proto_char_ms ( mbusmaster_poll_t *poll, uint16_t n_chars )
+{
+    return ( uint16_t ) ( ( ( uint32_t ) n_chars * PROTO_CHAR_BITS * 1000ul + poll->baud_rate - 1 ) / poll->baud_rate );
+}
+
+static void proto_meter_begin ( mbusmaster_poll_t *poll )
+{
+    mbusmaster_meter_t *meter = &poll->meters[ poll->index ];
+
+    meter->status    = MBUSMASTER_METER_IDLE;
+    meter->telegrams = 0;
+
+    if ( MBUSMASTER_ADDR_SECONDARY == meter->primary )
+    {
+        proto_next_request( poll, PROTO_STEP_SELECT );
+    }
+    else
+    {
+        proto_next_request( poll, meter->sync_f ? PROTO_STEP_REQ : PROTO_STEP_NKE );
+    }
+}
+
+static void proto_next_request ( mbusmaster_poll_t *poll, uint8_t step )
+{
+    poll->step  = step;
+    poll->retry = 0;
+    poll->state = PROTO_STATE_GAP;
+    poll->wait  = poll->gap;
+}
+
+static void proto_send ( mbusmaster_poll_t *poll )
+{
+    mbusmaster_meter_t *meter = &poll->meters[ poll->index ];
+    uint8_t *frame = poll->tx_frame;
+    uint8_t len;
+    uint8_t cnt;
+    uint8_t sum = 0;
+
+    if ( PROTO_STEP_SELECT == poll->step )
+    {
+        frame[ 0 ] = MBUSMASTER_FRAME_LONG_START;
+        frame[ 1 ] = PROTO_LONG_MIN_L + 8;
+        frame[ 2 ] = PROTO_LONG_MIN_L + 8;
+        frame[ 3 ] = MBUSMASTER_FRAME_LONG_START;
+        frame[ 4 ] = MBUSMASTER_C_SND_UD;
+        frame[ 5 ] = MBUSMASTER_ADDR_SECONDARY;
+        frame[ 6 ] = MBUSMASTER_CI_SELECT;
+        memcpy( &frame[ 7 ], meter->secondary, 8 );
+        for ( cnt = PROTO_LONG_HEADER_LEN; cnt < 15; cnt++ )
+        {
+            sum += frame[ cnt ];
+        }
+        frame[ 15 ] = sum;
+        frame[ 16 ] = MBUSMASTER_FRAME_STOP;
+        len = MBUSMASTER_POLL_TX_SIZE;
+        poll->state = PROTO_STATE_WAIT_ACK;
+    }
+    else
+    {
+        frame[ 0 ] = MBUSMASTER_FRAME_SHORT_START;
+        if ( PROTO_STEP_NKE == poll->step )
+        {
+            frame[ 1 ] = MBUSMASTER_C_SND_NKE;
+            poll->state = PROTO_STATE_WAIT_ACK;
+        }
+        else
+        {
+            frame[ 1 ] = MBUSMASTER_C_REQ_UD2 | ( meter->fcb ? MBUSMASTER_C_FCB : 0 );
+            poll->state = PROTO_STATE_WAIT_RSP;
+        }
+        frame[ 2 ] = meter->primary;
+        frame[ 3 ] = frame[ 1 ] + frame[ 2 ];
+        frame[ 4 ] = MBUSMASTER_FRAME_STOP;
+        len = PROTO_SHORT_LEN;
+    }
+
+    // Drop what is left of a broken frame
+    poll->dec.state = PROTO_DEC_IDLE;
+
+    mbusmaster_generic_write( poll->ctx, ( char * ) frame, len );
+
+    // The write does not wait for the UART, so the timeout starts after the request is out
+    poll->wait = ( meter->timeout ? meter->timeout : poll->timeout ) + proto_char_ms( poll, len );
+    poll->ticker = 0;
+}
+
+static uint8_t proto_rx_frame ( mbusmaster_poll_t *poll, mbusmaster_frame_t *frame )
+{
+    mbusmaster_meter_t *meter = &poll->meters[ poll->index ];
+    mbusmaster_telegram_t tg;
+
+    if ( PROTO_STATE_WAIT_ACK == poll->state )
+    {
+        if ( MBUSMASTER_FRAME_TYPE_ACK != frame->type )
+        {
+            return proto_failed( poll, MBUSMASTER_METER_ERROR );
+        }
+
+        // Both reset and selection start the FCB sequence from 1
+        meter->fcb = 1;
+        if ( PROTO_STEP_NKE == poll->step )
+        {
+            meter->sync_f = 1;
+        }
+        proto_next_request( poll, PROTO_STEP_REQ );
+        return MBUSMASTER_POLL_EVENT_NONE;
+    }
+
+    if ( PROTO_STATE_WAIT_RSP != poll->state )
+    {
+        return MBUSMASTER_POLL_EVENT_NONE;
+    }
+
+    if ( ( MBUSMASTER_FRAME_TYPE_LONG != frame->type ) ||
+         ( MBUSMASTER_C_RSP_UD != ( frame->c & MBUSMASTER_C_RSP_MASK ) ) ||
+         ( ( MBUSMASTER_ADDR_SECONDARY != meter->primary ) && ( frame->a != meter->primary ) ) )
+    {
+        return proto_failed( poll, MBUSMASTER_METER_ERROR );
+    }
+
+    // The exchange is complete on the link layer, the meter moves on to its next telegram
+    meter->fcb ^= 1;
+    meter->telegrams++;
+
+    if ( MBUSMASTER_OK != mbusmaster_telegram_parse( frame, &tg ) )
+    {
+        meter->errors++;
+        return proto_done( poll, MBUSMASTER_METER_ERROR );
+    }
+
+    if ( NULL != poll->callback )
+    {
+        poll->callback( meter, &tg );
+    }
+
+    if ( tg.more_f && ( meter->telegrams < poll->max_telegrams ) )
+    {
+        proto_next_request( poll, PROTO_STEP_REQ );
+        return MBUSMASTER_POLL_EVENT_NONE;
+    }
+
+    return proto_done( poll, MBUSMASTER_METER_OK );
+}
+
+static uint8_t proto_failed ( mbusmaster_poll_t *poll, uint8_t status )
+{
+    mbusmaster_meter_t *meter = &poll->meters[ poll->index ];
+
+    // A repeated REQ_UD2 keeps its FCB, so the meter repeats the lost telegram
+    if ( poll->retry < poll->retries )
+    {
+        poll->retry++;
+        poll->state = PROTO_STATE_GAP;
+        poll->wait  = poll->gap;
+        return MBUSMASTER_POLL_EVENT_NONE;
+    }
+
+    meter->errors++;
+    return proto_done( poll, status );
+}
+
+static uint8_t proto_done ( mbusmaster_poll_t *poll, uint8_t status )
+{
+    poll->meters[ poll->index ].status = status;
+
+    if ( ++poll->index >= poll->n_meters )
+    {
+        poll->state = PROTO_STATE_IDLE;
+        return MBUSMASTER_POLL_EVENT_CYCLE;
+    }
+
+    proto_meter_begin( poll );
+    return MBUSMASTER_POLL_EVENT_METER;
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,109 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file mcp2518fd_queue.h
+ * @brief This file contains the CAN frame queue adapter of MCP2518FD Click Driver.
+ * @details The adapter moves frames between the MCP2518FD FIFOs and the frame
+ * rings of the CAN FD 6 Click driver, so a gateway can bridge both controllers by
+ * passing the RX ring of one controller as the TX ring of the other.
+ */
+
+#ifndef MCP2518FD_QUEUE_H
+#define MCP2518FD_QUEUE_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "mcp2518fd.h"
+#include "canfd6_queue.h"
+
+/*!
+ * @addtogroup mcp2518fd MCP2518FD Click Driver
+ * @brief API for configuring and manipulating MCP2518FD Click driver.
+ * @{
+ */
+
+/**
+ * @defgroup mcp2518fd_queue MCP2518FD frame queue settings.
+ * @brief Settings of the CAN frame queue adapter of MCP2518FD Click driver.
+ */
+
+/**
+ * @addtogroup mcp2518fd_queue
+ * @{
+ */
+
+/**
+ * @brief MCP2518FD queue adapter limits.
+ * @details Maximal number of frames moved per adapter call, bounds the time
+ * spent in the INT pin interrupt.
+ */
+#define MCP2518FD_QUEUE_MAX_FRAMES                              32
+
+/*! @} */ // mcp2518fd_queue
+
+/**
+ * @brief MCP2518FD RX adapter function.
+ * @details This function moves the messages of the RX FIFO specified into the ring,
+ * dropping frames rejected by the software filter. The payload is read straight
+ * into the ring slot. It is meant to be called from the INT pin interrupt or as
+ * soon as the INT pin goes low.
+ * @param[in] ctx : Click context object.
+ * See #mcp2518fd_t object definition for detailed explanation.
+ * @param[in] channel : RX FIFO channel.
+ * @param[in] ring : RX frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @param[in] filter : Software ID filter, NULL to accept all frames.
+ * See #canfd6_id_filter_t object definition for detailed explanation.
+ * @return Number of frames added to the ring.
+ * @note Frames that do not fit in the ring are removed from the FIFO without
+ * reading them and counted in @b dropped. The timestamp is only valid if the
+ * RX FIFO has timestamping enabled.
+ */
+uint8_t mcp2518fd_queue_rx_service ( mcp2518fd_t *ctx, uint8_t channel,
+                                     canfd6_ring_t *ring, canfd6_id_filter_t *filter );
+
+/**
+ * @brief MCP2518FD TX adapter function.
+ * @details This function moves frames from the ring to the TX FIFO specified until
+ * the FIFO is full, and requests their transmission at once.
+ * @param[in] ctx : Click context object.
+ * See #mcp2518fd_t object definition for detailed explanation.
+ * @param[in] channel : TX FIFO channel.
+ * @param[in] ring : TX frame ring.
+ * See #canfd6_ring_t object definition for detailed explanation.
+ * @return Number of frames queued for transmission.
+ * @note The TX FIFO payload size has to hold the longest frame of the ring.
+ * A frame that could not be written to the FIFO stays in the ring and is retried on the next call.
+ */
+uint8_t mcp2518fd_queue_tx_service ( mcp2518fd_t *ctx, uint8_t channel, canfd6_ring_t *ring );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // MCP2518FD_QUEUE_H
+
+/*! @} */ // mcp2518fd
+
+// ------------------------------------------------------------------------ END
@@ -0,0 +1,253 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file mcp2518fd_queue.c
+ * @brief MCP2518FD Click frame queue adapter.
+ */
+
+#include "mcp2518fd_queue.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+/**
+ * @brief Message object ID word fields.
+ * @details SID and EID positions in the first word of the RX and TX message objects.
+ */
+#define QUEUE_OBJ_SID_MASK                                      0x000007FFul
+#define QUEUE_OBJ_EID_MASK                                      0x0003FFFFul
+#define QUEUE_OBJ_EID_SHIFT                                     11
+#define QUEUE_XTD_SID_SHIFT                                     18
+
+/**
+ * @brief Message object control word fields.
+ * @details DLC and flag positions in the second word of the RX and TX message objects.
+ */
+#define QUEUE_OBJ_DLC_MASK                                      0x0000000Ful
+#define QUEUE_OBJ_IDE                                           0x00000010ul
+#define QUEUE_OBJ_RTR                                           0x00000020ul
+#define QUEUE_OBJ_BRS                                           0x00000040ul
+#define QUEUE_OBJ_FDF                                           0x00000080ul
+#define QUEUE_OBJ_ESI                                           0x00000100ul
+
+/**
+ * @brief TX message object header size.
+ * @details Number of bytes before the payload of a TX message object.
+ */
+#define QUEUE_TX_HEADER_SIZE                                    8
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+/**
+ * @brief MCP2518FD TX message object write function.
+ * @details This function writes a frame to the next element of a TX FIFO
+ * and increments the FIFO without requesting the transmission.
+ * @param[in] ctx : Click context object.
+ * See #mcp2518fd_t object definition for detailed explanation.
+ * @param[in] channel : TX FIFO channel.
+ * @param[in] frame : Frame to write.
+ * See #canfd6_frame_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, FIFO is full or not a TX FIFO.
+ * See #err_t definition for detailed explanation.
+ * @note The driver TX message object keeps the control fields in separate words,
+ * so the object is built here in the FIFO RAM layout instead.
+ */
+static err_t queue_tx_write ( mcp2518fd_t *ctx, uint8_t channel, canfd6_frame_t *frame );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+uint8_t mcp2518fd_queue_rx_service ( mcp2518fd_t *ctx, uint8_t channel,
+                                     canfd6_ring_t *ring, canfd6_id_filter_t *filter )
+{
+    mcp2518fd_rx_msg_obj_t rx_obj;
+    canfd6_frame_t *frame;
+    uint32_t ctrl;
+    uint8_t status;
+    uint8_t queued = 0;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < MCP2518FD_QUEUE_MAX_FRAMES; cnt++ )
+    {
+        if ( MCP2518FD_OK != mcp2518fd_receive_channel_status_get( ctx, channel, &status ) )
+        {
+            break;
+        }
+
+        if ( !( status & MCP2518FD_RX_FIFO_NOT_EMPTY ) )
+        {
+            break;
+        }
+
+        frame = canfd6_ring_alloc( ring );
+        if ( NULL == frame )
+        {
+            ring->dropped++;
+            mcp2518fd_receive_channel_update( ctx, channel );
+            continue;
+        }
+
+        ctx->func_data.rxd = frame->data;
+        ctx->func_data.n_bytes = MCP2518FD_MAX_DATA_BYTES;
+        if ( MCP2518FD_OK != mcp2518fd_receive_message_get( ctx, channel, &rx_obj ) )
+        {
+            break;
+        }
+
+        ctrl = rx_obj.word[ 1 ];
+        if ( ctrl & QUEUE_OBJ_IDE )
+        {
+            frame->id = ( ( rx_obj.word[ 0 ] & QUEUE_OBJ_SID_MASK ) << QUEUE_XTD_SID_SHIFT ) |
+                        ( ( rx_obj.word[ 0 ] >> QUEUE_OBJ_EID_SHIFT ) & QUEUE_OBJ_EID_MASK );
+        }
+        else
+        {
+            frame->id = rx_obj.word[ 0 ] & QUEUE_OBJ_SID_MASK;
+        }
+
+        if ( ( NULL != filter ) && !canfd6_filter_match( filter, frame->id, ( ctrl & QUEUE_OBJ_IDE ) ? 1 : 0 ) )
+        {
+            continue;
+        }
+
+        frame->timestamp = rx_obj.word[ 2 ];
+        frame->flags = ( ( ctrl & QUEUE_OBJ_IDE ) ? CANFD6_FRAME_FLAG_XTD : 0 ) |
+                       ( ( ctrl & QUEUE_OBJ_RTR ) ? CANFD6_FRAME_FLAG_RTR : 0 ) |
+                       ( ( ctrl & QUEUE_OBJ_FDF ) ? CANFD6_FRAME_FLAG_FDF : 0 ) |
+                       ( ( ctrl & QUEUE_OBJ_BRS ) ? CANFD6_FRAME_FLAG_BRS : 0 ) |
+                       ( ( ctrl & QUEUE_OBJ_ESI ) ? CANFD6_FRAME_FLAG_ESI : 0 );
+        frame->len = ( uint8_t ) mcp2518fd_dlc_to_data_bytes( ( uint8_t ) ( ctrl & QUEUE_OBJ_DLC_MASK ) );
+
+        canfd6_ring_commit( ring );
+        queued++;
+    }
+
+    return queued;
+}
+
+uint8_t mcp2518fd_queue_tx_service ( mcp2518fd_t *ctx, uint8_t channel, canfd6_ring_t *ring )
+{
+    canfd6_frame_t *frame;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < MCP2518FD_QUEUE_MAX_FRAMES; cnt++ )
+    {
+        frame = canfd6_ring_peek( ring );
+        if ( NULL == frame )
+        {
+            break;
+        }
+
+        if ( MCP2518FD_OK != queue_tx_write( ctx, channel, frame ) )
+        {
+            break;
+        }
+
+        canfd6_ring_release( ring );
+    }
+
+    if ( cnt )
+    {
+        mcp2518fd_transmit_channel_flush( ctx, channel );
+    }
+
+    return cnt;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static err_t queue_tx_write ( mcp2518fd_t *ctx, uint8_t channel, canfd6_frame_t *frame )
+{
+    uint8_t tx_buffer[ MCP2518FD_MAX_MSG_SIZE ];
+    uint32_t fifo_reg[ 3 ];
+    mcp2518fd_fifo_ctl_t ci_fifo_con;
+    mcp2518fd_fifo_stat_t ci_fifo_sta;
+    mcp2518fd_fifo_user_cfg_t ci_fifo_ua;
+    uint32_t obj_id;
+    uint32_t obj_ctrl;
+    uint16_t address;
+    uint8_t num_bytes;
+    uint8_t dlc;
+    uint8_t cnt;
+
+    address = MCP2518FD_REG_CIFIFOCON + ( channel * MCP2518FD_FIFO_OFFSET );
+    if ( MCP2518FD_OK != mcp2518fd_read_word_array( ctx, address, fifo_reg, 3 ) )
+    {
+        return MCP2518FD_ERROR;
+    }
+
+    ci_fifo_con.word = fifo_reg[ 0 ];
+    ci_fifo_sta.word = fifo_reg[ 1 ];
+    ci_fifo_ua.word = fifo_reg[ 2 ];
+    if ( !ci_fifo_con.tx_bf.tx_enable || !ci_fifo_sta.tx_bf.tx_not_full_if )
+    {
+        return MCP2518FD_ERROR;
+    }
+
+#ifdef USERADDRESS_TIMES_FOUR
+    address = 4 * ci_fifo_ua.bf.user_address;
+#else
+    address = ci_fifo_ua.bf.user_address;
+#endif
+    address += MCP2518FD_RAMADDR_START;
+
+    if ( frame->flags & CANFD6_FRAME_FLAG_XTD )
+    {
+        obj_id = ( ( frame->id >> QUEUE_XTD_SID_SHIFT ) & QUEUE_OBJ_SID_MASK ) |
+                 ( ( frame->id & QUEUE_OBJ_EID_MASK ) << QUEUE_OBJ_EID_SHIFT );
+    }
+    else
+    {
+        obj_id = frame->id & QUEUE_OBJ_SID_MASK;
+    }
+
+    dlc = canfd6_frame_len_to_dlc( frame->len );
+    obj_ctrl = dlc |
+               ( ( frame->flags & CANFD6_FRAME_FLAG_XTD ) ? QUEUE_OBJ_IDE : 0 ) |
+               ( ( frame->flags & CANFD6_FRAME_FLAG_RTR ) ? QUEUE_OBJ_RTR : 0 ) |
+               ( ( frame->flags & CANFD6_FRAME_FLAG_BRS ) ? QUEUE_OBJ_BRS : 0 ) |
+               ( ( frame->flags & CANFD6_FRAME_FLAG_FDF ) ? QUEUE_OBJ_FDF : 0 ) |
+               ( ( frame->flags & CANFD6_FRAME_FLAG_ESI ) ? QUEUE_OBJ_ESI : 0 );
+
+    for ( cnt = 0; cnt < 4; cnt++ )
+    {
+        tx_buffer[ cnt ] = ( uint8_t ) ( obj_id >> ( cnt * 8 ) );
+        tx_buffer[ cnt + 4 ] = ( uint8_t ) ( obj_ctrl >> ( cnt * 8 ) );
+    }
+
+    // Payload is padded with zeros to the DLC length and to a whole word
+    num_bytes = ( uint8_t ) mcp2518fd_dlc_to_data_bytes( dlc );
+    num_bytes = ( num_bytes + 3 ) & ~0x03;
+    for ( cnt = 0; cnt < num_bytes; cnt++ )
+    {
+        tx_buffer[ QUEUE_TX_HEADER_SIZE + cnt ] = ( cnt < frame->len ) ? frame->data[ cnt ] : 0;
+    }
+
+    if ( MCP2518FD_OK != mcp2518fd_write_byte_array( ctx, address, tx_buffer, QUEUE_TX_HEADER_SIZE + num_bytes ) )
+    {
+        return MCP2518FD_ERROR;
+    }
+
+    return mcp2518fd_transmit_channel_update( ctx, channel, false );
+}
+
+// ------------------------------------------------------------------------ END
@@ -0,0 +1,235 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ * \brief This file contains the Mahony orientation filter used with MPU 9DOF Click driver.
+ *
+ * The filter works on raw int16 samples, so it can be fed from any IMU driver
+ * as long as the accel, gyro and mag axes share the same frame.
+ * Two kernels are provided: a float kernel and a Q30 fixed-point kernel for
+ * cores without an FPU. Both estimate the gyro bias through the integral term.
+ *
+ * \addtogroup mpu9dof MPU 9DOF Click Driver
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef MPU9DOF_FUSION_H
+#define MPU9DOF_FUSION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup fusion_macros Fusion macros
+ * \{
+ */
+
+/**
+ * \defgroup fusion_gyro_scale Gyro scale in rad/s per LSB
+ * \{
+ */
+#define MPU9DOF_FUSION_GYRO_SCALE_250DPS        ( 3.14159265f / 180.0f / 131.0f )
+#define MPU9DOF_FUSION_GYRO_SCALE_500DPS        ( 3.14159265f / 180.0f / 65.5f )
+#define MPU9DOF_FUSION_GYRO_SCALE_1000DPS       ( 3.14159265f / 180.0f / 32.8f )
+#define MPU9DOF_FUSION_GYRO_SCALE_2000DPS       ( 3.14159265f / 180.0f / 16.4f )
+/** \} */
+
+/**
+ * \defgroup fusion_gain Default filter gains
+ * \{
+ */
+#define MPU9DOF_FUSION_DEFAULT_KP               1.0f
+#define MPU9DOF_FUSION_DEFAULT_KI               0.02f
+/** \} */
+
+/**
+ * \defgroup fusion_q Fixed-point format
+ * \{
+ */
+#define MPU9DOF_FUSION_Q                        30
+#define MPU9DOF_FUSION_Q_ONE                    ( ( int32_t ) 1 << MPU9DOF_FUSION_Q )
+/** \} */
+
+/** \} */ // End group fusion_macros
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup fusion_type Fusion types
+ * \{
+ */
+
+/**
+ * @brief Raw axis sample structure definition.
+ */
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+
+} mpu9dof_axis_t;
+
+/**
+ * @brief Orientation quaternion structure definition.
+ */
+typedef struct
+{
+    float w;
+    float x;
+    float y;
+    float z;
+
+} mpu9dof_quat_t;
+
+/**
+ * @brief Float filter state definition.
+ */
+typedef struct
+{
+    mpu9dof_quat_t q;           /**< Orientation, body to earth frame. */
+    float integral[ 3 ];        /**< Gyro bias correction in rad/s. */
+
+    float gyro_coef;            /**< Gyro scale multiplied by half sample period. */
+    float kp_coef;              /**< Proportional gain multiplied by sample period. */
+    float ki_coef;              /**< Integral gain multiplied by double sample period. */
+    float half_dt;              /**< Half sample period in seconds. */
+
+} mpu9dof_fusion_t;
+
+/**
+ * @brief Fixed-point filter state definition.
+ * @details Quaternion, unit vectors and integral are Q30, the gyro
+ * coefficient is Q30 scaled up by gyro_shift so slow rates keep their resolution.
+ */
+typedef struct
+{
+    int32_t q[ 4 ];             /**< Orientation w, x, y, z. */
+    int32_t integral[ 3 ];      /**< Gyro bias correction in rad/s. */
+
+    int32_t gyro_coef;          /**< Gyro scale multiplied by half sample period. */
+    uint8_t gyro_shift;         /**< Extra fraction bits of gyro_coef. */
+    int32_t kp_coef;            /**< Proportional gain multiplied by sample period. */
+    int32_t ki_coef;            /**< Integral gain multiplied by double sample period. */
+    int32_t half_dt;            /**< Half sample period in seconds. */
+
+} mpu9dof_fusion_q_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+/**
+ * \defgroup fusion_function Fusion function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Float filter initialization function.
+ *
+ * @param fusion         Filter state.
+ * @param gyro_scale     Gyro scale in rad/s per LSB.
+ * @param sample_period  Update period in seconds.
+ * @param kp             Proportional gain.
+ * @param ki             Integral gain, 0 disables gyro bias estimation.
+ *
+ * @description This function resets the orientation and precomputes
+ * the per-sample coefficients.
+ */
+void mpu9dof_fusion_init ( mpu9dof_fusion_t *fusion, float gyro_scale, float sample_period, float kp, float ki );
+
+/**
+ * @brief Float filter update function.
+ *
+ * @param fusion   Filter state.
+ * @param gyro     Raw gyro sample.
+ * @param accel    Raw accel sample.
+ * @param mag      Raw mag sample aligned to the accel frame, NULL for 6DOF.
+ *
+ * @description This function runs one filter step.
+ * @note On MPU-9150 the magnetometer X and Y are swapped and Z is inverted
+ * with respect to the accel/gyro frame.
+ */
+void mpu9dof_fusion_update ( mpu9dof_fusion_t *fusion, mpu9dof_axis_t *gyro,
+                             mpu9dof_axis_t *accel, mpu9dof_axis_t *mag );
+
+/**
+ * @brief Fixed-point filter initialization function.
+ *
+ * @param fusion         Filter state.
+ * @param gyro_scale     Gyro scale in rad/s per LSB.
+ * @param sample_period  Update period in seconds.
+ * @param kp             Proportional gain.
+ * @param ki             Integral gain, 0 disables gyro bias estimation.
+ *
+ * @description This function resets the orientation and converts the
+ * coefficients to fixed-point, floats are used only here.
+ */
+void mpu9dof_fusion_q_init ( mpu9dof_fusion_q_t *fusion, float gyro_scale, float sample_period, float kp, float ki );
+
+/**
+ * @brief Fixed-point filter update function.
+ *
+ * @param fusion   Filter state.
+ * @param gyro     Raw gyro sample.
+ * @param accel    Raw accel sample.
+ * @param mag      Raw mag sample aligned to the accel frame, NULL for 6DOF.
+ *
+ * @description This function runs one filter step with 32-bit integer arithmetic only.
+ */
+void mpu9dof_fusion_q_update ( mpu9dof_fusion_q_t *fusion, mpu9dof_axis_t *gyro,
+                               mpu9dof_axis_t *accel, mpu9dof_axis_t *mag );
+
+/**
+ * @brief Fixed-point quaternion get function.
+ *
+ * @param fusion   Filter state.
+ * @param quat     Orientation quaternion.
+ *
+ * @description This function converts the Q30 orientation to float.
+ */
+void mpu9dof_fusion_q_get_quat ( mpu9dof_fusion_q_t *fusion, mpu9dof_quat_t *quat );
+
+/**
+ * @brief Euler angles get function.
+ *
+ * @param quat     Orientation quaternion.
+ * @param roll     Roll in degrees.
+ * @param pitch    Pitch in degrees.
+ * @param yaw      Yaw in degrees.
+ *
+ * @description This function converts the quaternion to Z-Y-X Euler angles.
+ */
+void mpu9dof_fusion_get_euler ( mpu9dof_quat_t *quat, float *roll, float *pitch, float *yaw );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // MPU9DOF_FUSION_H
+
+/** \} */ // End fusion_function group
+/*! @} */
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,367 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ */
+
+#include "mpu9dof_fusion.h"
+#include "math.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+#define FUSION_RAD_TO_DEG       57.2957795f
+#define FUSION_Q_HALF           ( MPU9DOF_FUSION_Q / 2 )
+#define FUSION_Q_HALF_MASK      ( ( ( int32_t ) 1 << FUSION_Q_HALF ) - 1 )
+#define FUSION_GYRO_COEF_MIN    ( 1.0f * ( 1ul << 14 ) )
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static int32_t fusion_q_mul ( int32_t a, int32_t b );
+
+static uint32_t fusion_q_isqrt ( uint32_t val );
+
+static uint8_t fusion_q_normalize_raw ( mpu9dof_axis_t *raw, int32_t *out );
+
+static void fusion_q_normalize_quat ( int32_t *q );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void mpu9dof_fusion_init ( mpu9dof_fusion_t *fusion, float gyro_scale, float sample_period, float kp, float ki )
+{
+    fusion->q.w = 1.0f;
+    fusion->q.x = 0.0f;
+    fusion->q.y = 0.0f;
+    fusion->q.z = 0.0f;
+    fusion->integral[ 0 ] = 0.0f;
+    fusion->integral[ 1 ] = 0.0f;
+    fusion->integral[ 2 ] = 0.0f;
+
+    fusion->half_dt = 0.5f * sample_period;
+    fusion->gyro_coef = gyro_scale * fusion->half_dt;
+    fusion->kp_coef = kp * sample_period;
+    fusion->ki_coef = 2.0f * ki * sample_period;
+}
+
+void mpu9dof_fusion_update ( mpu9dof_fusion_t *fusion, mpu9dof_axis_t *gyro,
+                             mpu9dof_axis_t *accel, mpu9dof_axis_t *mag )
+{
+    float q0 = fusion->q.w;
+    float q1 = fusion->q.x;
+    float q2 = fusion->q.y;
+    float q3 = fusion->q.z;
+    float tx = gyro->x * fusion->gyro_coef;
+    float ty = gyro->y * fusion->gyro_coef;
+    float tz = gyro->z * fusion->gyro_coef;
+    float ax = accel->x;
+    float ay = accel->y;
+    float az = accel->z;
+    float norm = ax * ax + ay * ay + az * az;
+
+    if ( norm > 0.0f )
+    {
+        float ex, ey, ez;
+        float vx, vy, vz;
+
+        norm = 1.0f / sqrt( norm );
+        ax *= norm;
+        ay *= norm;
+        az *= norm;
+
+        // Half of the estimated gravity direction
+        vx = q1 * q3 - q0 * q2;
+        vy = q0 * q1 + q2 * q3;
+        vz = q0 * q0 - 0.5f + q3 * q3;
+
+        ex = ay * vz - az * vy;
+        ey = az * vx - ax * vz;
+        ez = ax * vy - ay * vx;
+
+        if ( NULL != mag )
+        {
+            float mx = mag->x;
+            float my = mag->y;
+            float mz = mag->z;
+
+            norm = mx * mx + my * my + mz * mz;
+            if ( norm > 0.0f )
+            {
+                float hx, hy, bx, bz;
+                float wx, wy, wz;
+
+                norm = 1.0f / sqrt( norm );
+                mx *= norm;
+                my *= norm;
+                mz *= norm;
+
+                // Earth frame flux, rotated onto the x-z plane
+                hx = 2.0f * ( mx * ( 0.5f - q2 * q2 - q3 * q3 ) + my * ( q1 * q2 - q0 * q3 ) + mz * ( q1 * q3 + q0 * q2 ) );
+                hy = 2.0f * ( mx * ( q1 * q2 + q0 * q3 ) + my * ( 0.5f - q1 * q1 - q3 * q3 ) + mz * ( q2 * q3 - q0 * q1 ) );
+                bx = sqrt( hx * hx + hy * hy );
+                bz = 2.0f * ( mx * ( q1 * q3 - q0 * q2 ) + my * ( q2 * q3 + q0 * q1 ) + mz * ( 0.5f - q1 * q1 - q2 * q2 ) );
+
+                // Half of the estimated flux direction
+                wx = bx * ( 0.5f - q2 * q2 - q3 * q3 ) + bz * ( q1 * q3 - q0 * q2 );
+                wy = bx * ( q1 * q2 - q0 * q3 ) + bz * ( q0 * q1 + q2 * q3 );
+                wz = bx * ( q0 * q2 + q1 * q3 ) + bz * ( 0.5f - q1 * q1 - q2 * q2 );
+
+                ex += my * wz - mz * wy;
+                ey += mz * wx - mx * wz;
+                ez += mx * wy - my * wx;
+            }
+        }
+
+        fusion->integral[ 0 ] += fusion->ki_coef * ex;
+        fusion->integral[ 1 ] += fusion->ki_coef * ey;
+        fusion->integral[ 2 ] += fusion->ki_coef * ez;
+
+        tx += fusion->kp_coef * ex + fusion->integral[ 0 ] * fusion->half_dt;
+        ty += fusion->kp_coef * ey + fusion->integral[ 1 ] * fusion->half_dt;
+        tz += fusion->kp_coef * ez + fusion->integral[ 2 ] * fusion->half_dt;
+    }
+
+    fusion->q.w = q0 - q1 * tx - q2 * ty - q3 * tz;
+    fusion->q.x = q1 + q0 * tx + q2 * tz - q3 * ty;
+    fusion->q.y = q2 + q0 * ty - q1 * tz + q3 * tx;
+    fusion->q.z = q3 + q0 * tz + q1 * ty - q2 * tx;
+
+    norm = 1.0f / sqrt( fusion->q.w * fusion->q.w + fusion->q.x * fusion->q.x +
+                        fusion->q.y * fusion->q.y + fusion->q.z * fusion->q.z );
+    fusion->q.w *= norm;
+    fusion->q.x *= norm;
+    fusion->q.y *= norm;
+    fusion->q.z *= norm;
+}
+
+void mpu9dof_fusion_q_init ( mpu9dof_fusion_q_t *fusion, float gyro_scale, float sample_period, float kp, float ki )
+{
+    fusion->q[ 0 ] = MPU9DOF_FUSION_Q_ONE;
+    fusion->q[ 1 ] = 0;
+    fusion->q[ 2 ] = 0;
+    fusion->q[ 3 ] = 0;
+    fusion->integral[ 0 ] = 0;
+    fusion->integral[ 1 ] = 0;
+    fusion->integral[ 2 ] = 0;
+
+    float gyro_coef = gyro_scale * 0.5f * sample_period * ( float ) MPU9DOF_FUSION_Q_ONE;
+
+    // Scale the gyro coefficient to at least 15 significant bits, int16 times it fits int32
+    fusion->gyro_shift = 0;
+    while ( ( gyro_coef > 0.0f ) && ( gyro_coef < FUSION_GYRO_COEF_MIN ) && ( fusion->gyro_shift < 31 ) )
+    {
+        gyro_coef *= 2.0f;
+        fusion->gyro_shift++;
+    }
+    fusion->gyro_coef = ( int32_t ) ( gyro_coef + 0.5f );
+    fusion->half_dt = ( int32_t ) ( 0.5f * sample_period * MPU9DOF_FUSION_Q_ONE + 0.5f );
+    fusion->kp_coef = ( int32_t ) ( kp * sample_period * MPU9DOF_FUSION_Q_ONE + 0.5f );
+    fusion->ki_coef = ( int32_t ) ( 2.0f * ki * sample_period * MPU9DOF_FUSION_Q_ONE + 0.5f );
+}
+
+void mpu9dof_fusion_q_update ( mpu9dof_fusion_q_t *fusion, mpu9dof_axis_t *gyro,
+                               mpu9dof_axis_t *accel, mpu9dof_axis_t *mag )
+{
+    int32_t q0 = fusion->q[ 0 ];
+    int32_t q1 = fusion->q[ 1 ];
+    int32_t q2 = fusion->q[ 2 ];
+    int32_t q3 = fusion->q[ 3 ];
+    int32_t tx = ( ( int32_t ) gyro->x * fusion->gyro_coef ) >> fusion->gyro_shift;
+    int32_t ty = ( ( int32_t ) gyro->y * fusion->gyro_coef ) >> fusion->gyro_shift;
+    int32_t tz = ( ( int32_t ) gyro->z * fusion->gyro_coef ) >> fusion->gyro_shift;
+    int32_t a[ 3 ];
+    int32_t m[ 3 ];
+
+    if ( fusion_q_normalize_raw( accel, a ) )
+    {
+        int32_t ex, ey, ez;
+        int32_t vx, vy, vz;
+
+        vx = fusion_q_mul( q1, q3 ) - fusion_q_mul( q0, q2 );
+        vy = fusion_q_mul( q0, q1 ) + fusion_q_mul( q2, q3 );
+        vz = fusion_q_mul( q0, q0 ) - ( MPU9DOF_FUSION_Q_ONE >> 1 ) + fusion_q_mul( q3, q3 );
+
+        ex = fusion_q_mul( a[ 1 ], vz ) - fusion_q_mul( a[ 2 ], vy );
+        ey = fusion_q_mul( a[ 2 ], vx ) - fusion_q_mul( a[ 0 ], vz );
+        ez = fusion_q_mul( a[ 0 ], vy ) - fusion_q_mul( a[ 1 ], vx );
+
+        if ( ( NULL != mag ) && fusion_q_normalize_raw( mag, m ) )
+        {
+            int32_t half = MPU9DOF_FUSION_Q_ONE >> 1;
+            int32_t q0q1 = fusion_q_mul( q0, q1 );
+            int32_t q0q2 = fusion_q_mul( q0, q2 );
+            int32_t q0q3 = fusion_q_mul( q0, q3 );
+            int32_t q1q1 = fusion_q_mul( q1, q1 );
+            int32_t q1q2 = fusion_q_mul( q1, q2 );
+            int32_t q1q3 = fusion_q_mul( q1, q3 );
+            int32_t q2q2 = fusion_q_mul( q2, q2 );
+            int32_t q2q3 = fusion_q_mul( q2, q3 );
+            int32_t q3q3 = fusion_q_mul( q3, q3 );
+            int32_t hx, hy, bx, bz;
+            int32_t wx, wy, wz;
+
+            hx = 2 * ( fusion_q_mul( m[ 0 ], half - q2q2 - q3q3 ) + fusion_q_mul( m[ 1 ], q1q2 - q0q3 ) +
+                       fusion_q_mul( m[ 2 ], q1q3 + q0q2 ) );
+            hy = 2 * ( fusion_q_mul( m[ 0 ], q1q2 + q0q3 ) + fusion_q_mul( m[ 1 ], half - q1q1 - q3q3 ) +
+                       fusion_q_mul( m[ 2 ], q2q3 - q0q1 ) );
+            // Horizontal flux is at most one, Q15 root is plenty for the error term
+            bx = ( int32_t ) fusion_q_isqrt( ( uint32_t ) ( fusion_q_mul( hx, hx ) + fusion_q_mul( hy, hy ) ) ) << FUSION_Q_HALF;
+            bz = 2 * ( fusion_q_mul( m[ 0 ], q1q3 - q0q2 ) + fusion_q_mul( m[ 1 ], q2q3 + q0q1 ) +
+                       fusion_q_mul( m[ 2 ], half - q1q1 - q2q2 ) );
+
+            wx = fusion_q_mul( bx, half - q2q2 - q3q3 ) + fusion_q_mul( bz, q1q3 - q0q2 );
+            wy = fusion_q_mul( bx, q1q2 - q0q3 ) + fusion_q_mul( bz, q0q1 + q2q3 );
+            wz = fusion_q_mul( bx, q0q2 + q1q3 ) + fusion_q_mul( bz, half - q1q1 - q2q2 );
+
+            ex += fusion_q_mul( m[ 1 ], wz ) - fusion_q_mul( m[ 2 ], wy );
+            ey += fusion_q_mul( m[ 2 ], wx ) - fusion_q_mul( m[ 0 ], wz );
+            ez += fusion_q_mul( m[ 0 ], wy ) - fusion_q_mul( m[ 1 ], wx );
+        }
+
+        fusion->integral[ 0 ] += fusion_q_mul( fusion->ki_coef, ex );
+        fusion->integral[ 1 ] += fusion_q_mul( fusion->ki_coef, ey );
+        fusion->integral[ 2 ] += fusion_q_mul( fusion->ki_coef, ez );
+
+        tx += fusion_q_mul( fusion->kp_coef, ex ) + fusion_q_mul( fusion->integral[ 0 ], fusion->half_dt );
+        ty += fusion_q_mul( fusion->kp_coef, ey ) + fusion_q_mul( fusion->integral[ 1 ], fusion->half_dt );
+        tz += fusion_q_mul( fusion->kp_coef, ez ) + fusion_q_mul( fusion->integral[ 2 ], fusion->half_dt );
+    }
+
+    fusion->q[ 0 ] = q0 - fusion_q_mul( q1, tx ) - fusion_q_mul( q2, ty ) - fusion_q_mul( q3, tz );
+    fusion->q[ 1 ] = q1 + fusion_q_mul( q0, tx ) + fusion_q_mul( q2, tz ) - fusion_q_mul( q3, ty );
+    fusion->q[ 2 ] = q2 + fusion_q_mul( q0, ty ) - fusion_q_mul( q1, tz ) + fusion_q_mul( q3, tx );
+    fusion->q[ 3 ] = q3 + fusion_q_mul( q0, tz ) + fusion_q_mul( q1, ty ) - fusion_q_mul( q2, tx );
+
+    fusion_q_normalize_quat( fusion->q );
+}
+
+void mpu9dof_fusion_q_get_quat ( mpu9dof_fusion_q_t *fusion, mpu9dof_quat_t *quat )
+{
+    quat->w = ( float ) fusion->q[ 0 ] / MPU9DOF_FUSION_Q_ONE;
+    quat->x = ( float ) fusion->q[ 1 ] / MPU9DOF_FUSION_Q_ONE;
+    quat->y = ( float ) fusion->q[ 2 ] / MPU9DOF_FUSION_Q_ONE;
+    quat->z = ( float ) fusion->q[ 3 ] / MPU9DOF_FUSION_Q_ONE;
+}
+
+void mpu9dof_fusion_get_euler ( mpu9dof_quat_t *quat, float *roll, float *pitch, float *yaw )
+{
+    float sin_pitch = 2.0f * ( quat->w * quat->y - quat->z * quat->x );
+
+    if ( sin_pitch > 1.0f )
+    {
+        sin_pitch = 1.0f;
+    }
+    else if ( sin_pitch < -1.0f )
+    {
+        sin_pitch = -1.0f;
+    }
+
+    *roll = atan2( 2.0f * ( quat->w * quat->x + quat->y * quat->z ),
+                   1.0f - 2.0f * ( quat->x * quat->x + quat->y * quat->y ) ) * FUSION_RAD_TO_DEG;
+    *pitch = asin( sin_pitch ) * FUSION_RAD_TO_DEG;
+    *yaw = atan2( 2.0f * ( quat->w * quat->z + quat->x * quat->y ),
+                  1.0f - 2.0f * ( quat->y * quat->y + quat->z * quat->z ) ) * FUSION_RAD_TO_DEG;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static int32_t fusion_q_mul ( int32_t a, int32_t b )
+{
+    // Q15 halves keep every partial product within int32, the dropped low product is below 1 LSB
+    int32_t ah = a >> FUSION_Q_HALF;
+    int32_t bh = b >> FUSION_Q_HALF;
+    int32_t al = a & FUSION_Q_HALF_MASK;
+    int32_t bl = b & FUSION_Q_HALF_MASK;
+
+    return ah * bh + ( ( ah * bl ) >> FUSION_Q_HALF ) + ( ( al * bh ) >> FUSION_Q_HALF );
+}
+
+static uint32_t fusion_q_isqrt ( uint32_t val )
+{
+    uint32_t res = 0;
+    uint32_t bit = ( uint32_t ) 1 << 30;
+
+    while ( bit > val )
+    {
+        bit >>= 2;
+    }
+
+    while ( bit )
+    {
+        if ( val >= res + bit )
+        {
+            val -= res + bit;
+            res = ( res >> 1 ) + bit;
+        }
+        else
+        {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return ( uint32_t ) res;
+}
+
+static uint8_t fusion_q_normalize_raw ( mpu9dof_axis_t *raw, int32_t *out )
+{
+    int32_t inv;
+    int32_t rem;
+    int32_t norm;
+
+    // Three squared int16 values fit uint32
+    norm = ( int32_t ) fusion_q_isqrt( ( uint32_t ) ( ( int32_t ) raw->x * raw->x ) +
+                                       ( uint32_t ) ( ( int32_t ) raw->y * raw->y ) +
+                                       ( uint32_t ) ( ( int32_t ) raw->z * raw->z ) );
+    if ( 0 == norm )
+    {
+        return 0;
+    }
+
+    // One division per vector, the remainder term restores the bits the quotient drops
+    inv = MPU9DOF_FUSION_Q_ONE / norm;
+    rem = MPU9DOF_FUSION_Q_ONE % norm;
+    out[ 0 ] = raw->x * inv + ( raw->x * rem ) / norm;
+    out[ 1 ] = raw->y * inv + ( raw->y * rem ) / norm;
+    out[ 2 ] = raw->z * inv + ( raw->z * rem ) / norm;
+
+    return 1;
+}
+
+static void fusion_q_normalize_quat ( int32_t *q )
+{
+    int32_t norm;
+    int32_t inv;
+
+    norm = fusion_q_mul( q[ 0 ], q[ 0 ] ) + fusion_q_mul( q[ 1 ], q[ 1 ] ) +
+           fusion_q_mul( q[ 2 ], q[ 2 ] ) + fusion_q_mul( q[ 3 ], q[ 3 ] );
+
+    // One step moves the norm only by the squared gyro increment, so a Newton step
+    // of 1/sqrt around one, ( 3 - n ) / 2, renormalizes without a division or root
+    inv = MPU9DOF_FUSION_Q_ONE + ( ( MPU9DOF_FUSION_Q_ONE - norm ) >> 1 );
+    q[ 0 ] = fusion_q_mul( q[ 0 ], inv );
+    q[ 1 ] = fusion_q_mul( q[ 1 ], inv );
+    q[ 2 ] = fusion_q_mul( q[ 2 ], inv );
+    q[ 3 ] = fusion_q_mul( q[ 3 ], inv );
+}
+
+// ------------------------------------------------------------------------- END
@@ -191,6 +191,22 @@ extern "C"{
 #define OXIMETER5_INTERRUPT_INACTIVE             0x00
 #define OXIMETER5_INTERRUPT_ACTIVE               0x01
 
+/**
+ * @brief Oximeter 5 streaming estimator setting.
+ * @details Specified setting for the sample-by-sample HR and SpO2 estimator
+ * of Oximeter 5 Click driver.
+ */
+#define OXIMETER5_STREAM_NO_BEAT                 0x00
+#define OXIMETER5_STREAM_BEAT                    0x01
+#define OXIMETER5_STREAM_DEFAULT_SAMPLE_RATE     25
+#define OXIMETER5_STREAM_MIN_BPM                 30
+#define OXIMETER5_STREAM_MAX_BPM                 220
+#define OXIMETER5_STREAM_MIN_HEIGHT              30
+#define OXIMETER5_STREAM_DC_SHIFT                5
+#define OXIMETER5_STREAM_MA_SIZE                 4
+#define OXIMETER5_STREAM_HR_HISTORY              4
+#define OXIMETER5_STREAM_RATIO_HISTORY           5
+
 /**
  * @brief Oximeter 5 device address setting.
  * @details Specified setting for device slave address selection of
@@ -255,6 +271,47 @@ typedef struct
 
 } oximeter5_cfg_t;
 
+/**
+ * @brief Oximeter 5 Click streaming estimator object.
+ * @details Streaming HR and SpO2 estimator state of Oximeter 5 Click driver.
+ * Every field is updated in constant time per sample.
+ */
+typedef struct
+{
+    uint16_t sample_rate;       /**< Sample rate in samples per second. */
+    uint16_t min_interval;      /**< Shortest accepted beat interval in samples. */
+    uint16_t max_interval;      /**< Longest accepted beat interval in samples. */
+
+    int32_t ir_dc;              /**< IR DC estimate, Q8. */
+    int32_t red_dc;             /**< Red DC estimate, Q8. */
+
+    int32_t ma_buf[ OXIMETER5_STREAM_MA_SIZE ];   /**< Moving average window. */
+    int32_t ma_sum;             /**< Moving average window sum. */
+    uint8_t ma_idx;             /**< Moving average window index. */
+
+    int32_t trough;             /**< Lowest filtered sample since the last valley. */
+    int32_t candidate;          /**< Highest filtered sample since the trough. */
+    int32_t amplitude;          /**< Decaying valley depth, sets the detection threshold. */
+    uint16_t candidate_at;      /**< Position of the candidate, in samples since the last valley. */
+    uint16_t since_valley;      /**< Samples since the last detected valley. */
+    uint8_t valley_seen;        /**< Set once the first valley was detected. */
+
+    uint32_t ir_max;            /**< IR maximum within the current beat. */
+    uint32_t ir_min;            /**< IR minimum within the current beat. */
+    uint32_t red_max;           /**< Red maximum within the current beat. */
+    uint32_t red_min;           /**< Red minimum within the current beat. */
+
+    uint16_t interval[ OXIMETER5_STREAM_HR_HISTORY ];  /**< Last beat intervals. */
+    uint16_t interval_sum;      /**< Sum of the last beat intervals. */
+    uint8_t interval_cnt;       /**< Number of valid intervals. */
+    uint8_t interval_idx;       /**< Next interval slot. */
+
+    int32_t ratio[ OXIMETER5_STREAM_RATIO_HISTORY ];   /**< Last SpO2 ratios. */
+    uint8_t ratio_cnt;          /**< Number of valid ratios. */
+    uint8_t ratio_idx;          /**< Next ratio slot. */
+
+} oximeter5_stream_t;
+
 /**
  * @brief Oximeter 5 Click return value data.
  * @details Predefined enum values for driver return values.
@@ -548,6 +605,65 @@ err_t oximeter5_get_oxygen_saturation ( uint32_t *pun_ir_buffer, int32_t n_ir_bu
  */
 err_t oximeter5_get_heart_rate ( uint32_t *pun_ir_buffer, int32_t n_ir_buffer_length, uint32_t *pun_red_buffer, int32_t *pn_heart_rate );
 
+/**
+ * @brief Oximeter 5 streaming estimator init function.
+ * @details This function resets the sample-by-sample heart rate and
+ * oxygen saturation estimator.
+ * @param[out] stream : Streaming estimator object.
+ * See #oximeter5_stream_t object definition for detailed explanation.
+ * @param[in] sample_rate : Effective sample rate after FIFO averaging,
+ * 25 for the default configuration.
+ * @return Nothing.
+ * @note None.
+ */
+void oximeter5_stream_init ( oximeter5_stream_t *stream, uint16_t sample_rate );
+
+/**
+ * @brief Oximeter 5 streaming estimator update function.
+ * @details This function feeds one IR/Red sample pair to the estimator.
+ * It tracks the DC level with a first order filter, smooths the inverted
+ * IR AC with a running moving average and detects valleys online, so the
+ * cost per sample is constant and no sample buffer is needed.
+ * @param[in,out] stream : Streaming estimator object.
+ * See #oximeter5_stream_t object definition for detailed explanation.
+ * @param[in] ir : IR ADC data.
+ * @param[in] red : Red ADC data.
+ * @return @li @c 0 - No new beat,
+ *         @li @c 1 - Beat detected, estimates were updated.
+ * @note None.
+ */
+uint8_t oximeter5_stream_update ( oximeter5_stream_t *stream, uint32_t ir, uint32_t red );
+
+/**
+ * @brief Oximeter 5 streaming heart rate function.
+ * @details This function returns the heart rate averaged over the last
+ * beat intervals seen by the streaming estimator.
+ * @param[in] stream : Streaming estimator object.
+ * See #oximeter5_stream_t object definition for detailed explanation.
+ * @param[out] heart_rate : Heart rate in beats per minute.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no valid beat yet.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t oximeter5_stream_get_heart_rate ( oximeter5_stream_t *stream, int32_t *heart_rate );
+
+/**
+ * @brief Oximeter 5 streaming oxygen saturation function.
+ * @details This function returns the oxygen saturation from the median
+ * of the last per-beat ratios seen by the streaming estimator.
+ * @param[in] stream : Streaming estimator object.
+ * See #oximeter5_stream_t object definition for detailed explanation.
+ * @param[out] spo2 : SpO2 Oxygen saturation data, from 0 percent to 100 percent.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no valid ratio yet.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t oximeter5_stream_get_oxygen_saturation ( oximeter5_stream_t *stream, uint8_t *spo2 );
+
 #ifdef __cplusplus
 }
 #endif
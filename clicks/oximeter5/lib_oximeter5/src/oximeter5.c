@@ -26,6 +26,7 @@
  */
 
 #include "oximeter5.h"
+#include "string.h"
 
 #define SAMPLING_FREQUENCY          25   
 #define BUFFER_SIZE                 ( SAMPLING_FREQUENCY * 4 ) 
@@ -81,6 +82,13 @@ static void dev_remove_close_peaks ( int32_t *pn_locs, int32_t *pn_npks, int32_t
  */
 static void dev_find_peaks ( int32_t *pn_locs, int32_t *n_npks,  int32_t  *pn_x, uint8_t n_size, int32_t n_min_height, int32_t n_min_distance, int32_t n_max_num );
 
+/**
+ * @brief Oximeter 5 streaming beat function.
+ * @details This function closes one beat of the streaming estimator,
+ * it updates the interval history and the SpO2 ratio history.
+ */
+static void dev_stream_beat ( oximeter5_stream_t *stream, uint16_t interval );
+
 void oximeter5_cfg_setup ( oximeter5_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -556,6 +564,162 @@ err_t oximeter5_get_heart_rate ( uint32_t *pun_ir_buffer, int32_t n_ir_buffer_le
 
 }
 
+void oximeter5_stream_init ( oximeter5_stream_t *stream, uint16_t sample_rate )
+{
+    memset( stream, 0, sizeof( oximeter5_stream_t ) );
+    
+    stream->sample_rate = sample_rate;
+    stream->min_interval = ( ( uint32_t ) sample_rate * 60 ) / OXIMETER5_STREAM_MAX_BPM;
+    stream->max_interval = ( ( uint32_t ) sample_rate * 60 ) / OXIMETER5_STREAM_MIN_BPM;
+}
+
+uint8_t oximeter5_stream_update ( oximeter5_stream_t *stream, uint32_t ir, uint32_t red )
+{
+    int32_t n_ac, n_threshold;
+    uint8_t beat = OXIMETER5_STREAM_NO_BEAT;
+    
+    if ( 0 == stream->ir_dc )
+    {
+        stream->ir_dc = ( int32_t ) ir << 8;
+        stream->red_dc = ( int32_t ) red << 8;
+        stream->ir_max = stream->ir_min = ir;
+        stream->red_max = stream->red_min = red;
+    }
+    
+    // first order DC tracking, Q8 keeps the fraction lost by the shift
+    stream->ir_dc += ( ( ( int32_t ) ir << 8 ) - stream->ir_dc ) >> OXIMETER5_STREAM_DC_SHIFT;
+    stream->red_dc += ( ( ( int32_t ) red << 8 ) - stream->red_dc ) >> OXIMETER5_STREAM_DC_SHIFT;
+    
+    // remove DC and invert signal so that we can use peak detector as valley detector
+    n_ac = ( stream->ir_dc >> 8 ) - ( int32_t ) ir;
+    
+    // 4 pt running Moving Average
+    stream->ma_sum -= stream->ma_buf[ stream->ma_idx ];
+    stream->ma_buf[ stream->ma_idx ] = n_ac;
+    stream->ma_sum += n_ac;
+    if ( ++stream->ma_idx >= OXIMETER5_STREAM_MA_SIZE )
+    {
+        stream->ma_idx = 0;
+    }
+    n_ac = stream->ma_sum / OXIMETER5_STREAM_MA_SIZE;
+    
+    if ( stream->since_valley < 0xFFFF )
+    {
+        stream->since_valley++;
+    }
+    
+    if ( ir > stream->ir_max )
+    {
+        stream->ir_max = ir;
+    }
+    if ( ir < stream->ir_min )
+    {
+        stream->ir_min = ir;
+    }
+    if ( red > stream->red_max )
+    {
+        stream->red_max = red;
+    }
+    if ( red < stream->red_min )
+    {
+        stream->red_min = red;
+    }
+    
+    // the valley of IR is a peak of the flipped signal: rise from the trough by
+    // the threshold and fall back by half of it, slow baseline wander never falls back
+    if ( n_ac < stream->trough )
+    {
+        stream->trough = n_ac;
+        stream->candidate = n_ac;
+        stream->candidate_at = stream->since_valley;
+    }
+    else if ( n_ac > stream->candidate )
+    {
+        stream->candidate = n_ac;
+        stream->candidate_at = stream->since_valley;
+    }
+    
+    // threshold follows the recent valley depth and slowly decays when beats stop
+    stream->amplitude -= stream->amplitude >> 7;
+    n_threshold = stream->amplitude >> 1;
+    if ( n_threshold < OXIMETER5_STREAM_MIN_HEIGHT )
+    {
+        n_threshold = OXIMETER5_STREAM_MIN_HEIGHT;
+    }
+    
+    if ( ( ( stream->candidate - stream->trough ) > n_threshold ) && 
+         ( ( stream->candidate - n_ac ) > ( n_threshold >> 1 ) ) && 
+         ( stream->candidate_at > stream->min_interval ) )
+    {
+        stream->amplitude += ( ( stream->candidate - stream->trough ) - stream->amplitude ) >> 2;
+        
+        if ( stream->valley_seen && ( stream->candidate_at <= stream->max_interval ) )
+        {
+            dev_stream_beat( stream, stream->candidate_at );
+            beat = OXIMETER5_STREAM_BEAT;
+        }
+        
+        stream->valley_seen = 1;
+        stream->since_valley -= stream->candidate_at;
+        stream->candidate_at = 0;
+        stream->trough = n_ac;
+        stream->candidate = n_ac;
+        stream->ir_max = stream->ir_min = ir;
+        stream->red_max = stream->red_min = red;
+    }
+    
+    return beat;
+}
+
+err_t oximeter5_stream_get_heart_rate ( oximeter5_stream_t *stream, int32_t *heart_rate )
+{
+    if ( 0 == stream->interval_cnt )
+    {
+        *heart_rate = OXIMETER5_HEART_RATE_ERROR_DATA;
+        return OXIMETER5_ERROR;
+    }
+    
+    *heart_rate = ( ( int32_t ) stream->sample_rate * 60 * stream->interval_cnt ) / stream->interval_sum;
+    
+    return OXIMETER5_OK;
+}
+
+err_t oximeter5_stream_get_oxygen_saturation ( oximeter5_stream_t *stream, uint8_t *spo2 )
+{
+    int32_t an_ratio[ OXIMETER5_STREAM_RATIO_HISTORY ];
+    int32_t n_ratio_average;
+    uint8_t n_middle_idx;
+    
+    if ( 0 == stream->ratio_cnt )
+    {
+        *spo2 = OXIMETER5_PN_SPO2_ERROR_DATA;
+        return OXIMETER5_ERROR;
+    }
+    
+    // choose median value since PPG signal may varies from beat to beat
+    memcpy( an_ratio, stream->ratio, sizeof( an_ratio ) );
+    dev_sort_ascend( an_ratio, stream->ratio_cnt );
+    n_middle_idx = stream->ratio_cnt / 2;
+    
+    if ( stream->ratio_cnt % 2 )
+    {
+        n_ratio_average = an_ratio[ n_middle_idx ];
+    }
+    else
+    {
+        n_ratio_average = ( an_ratio[ n_middle_idx - 1 ] + an_ratio[ n_middle_idx ] ) / 2;
+    }
+    
+    if ( ( n_ratio_average > 2 ) && ( n_ratio_average < 184 ) )
+    {
+        *spo2 = uch_spo2_table[ n_ratio_average ];
+        return OXIMETER5_OK;
+    }
+    
+    *spo2 = OXIMETER5_PN_SPO2_ERROR_DATA;
+    return OXIMETER5_ERROR;
+}
+
 static void dev_peaks_above_min_height ( int32_t *pn_locs, int32_t *n_npks,  int32_t  *pn_x, uint8_t n_size, int32_t n_min_height )
 {
     uint8_t n_width;
@@ -663,4 +827,54 @@ static void dev_find_peaks ( int32_t *pn_locs, int32_t *n_npks,  int32_t  *pn_x,
     }
 }
 
+static void dev_stream_beat ( oximeter5_stream_t *stream, uint16_t interval )
+{
+    uint32_t n_ir_ac, n_red_ac, n_ir_dc, n_red_dc;
+    uint32_t n_ac_ratio, n_dc_ratio;
+    
+    if ( stream->interval_cnt < OXIMETER5_STREAM_HR_HISTORY )
+    {
+        stream->interval_cnt++;
+    }
+    else
+    {
+        stream->interval_sum -= stream->interval[ stream->interval_idx ];
+    }
+    stream->interval[ stream->interval_idx ] = interval;
+    stream->interval_sum += interval;
+    if ( ++stream->interval_idx >= OXIMETER5_STREAM_HR_HISTORY )
+    {
+        stream->interval_idx = 0;
+    }
+    
+    n_ir_ac = stream->ir_max - stream->ir_min;
+    n_red_ac = stream->red_max - stream->red_min;
+    n_ir_dc = ( uint32_t ) ( stream->ir_dc >> 8 );
+    n_red_dc = ( uint32_t ) ( stream->red_dc >> 8 );
+    
+    if ( ( 0 == n_ir_ac ) || ( 0 == n_red_dc ) )
+    {
+        return;
+    }
+    
+    // ( red AC / IR AC ) * ( IR DC / red DC ) in Q12, 18-bit data keeps both terms in 32 bits
+    n_ac_ratio = ( n_red_ac << 12 ) / n_ir_ac;
+    n_dc_ratio = ( n_ir_dc << 12 ) / n_red_dc;
+    
+    if ( ( n_ac_ratio > 0x3FFF ) || ( n_dc_ratio > 0x3FFF ) )
+    {
+        return;
+    }
+    
+    stream->ratio[ stream->ratio_idx ] = ( int32_t ) ( ( ( ( n_ac_ratio * n_dc_ratio ) >> 12 ) * 100 ) >> 12 );
+    if ( ++stream->ratio_idx >= OXIMETER5_STREAM_RATIO_HISTORY )
+    {
+        stream->ratio_idx = 0;
+    }
+    if ( stream->ratio_cnt < OXIMETER5_STREAM_RATIO_HISTORY )
+    {
+        stream->ratio_cnt++;
+    }
+}
+
 // ------------------------------------------------------------------------- END
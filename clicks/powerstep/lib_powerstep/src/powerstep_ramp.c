@@ -0,0 +1,248 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file powerstep_ramp.c
+ * @brief Power Step Click Step Generator.
+ */
+
+#include "powerstep_ramp.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+/**
+ * @brief Power Step shortest interval.
+ * @details A step needs one tick high and one tick low, in ticks Q24.8.
+ */
+#define POWERSTEP_RAMP_MIN_INTERVAL              0x200ul
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+err_t powerstep_ramp_init ( powerstep_ramp_t *ramp, powerstep_t *ctx, uint32_t tick_hz )
+{
+    ramp->ctx = ctx;
+    ramp->tick_hz = tick_hz;
+    ramp->busy = 0;
+    ramp->stop_f = 0;
+    ramp->pin_high = 0;
+    ramp->position = 0;
+    digital_out_low ( &ctx->step );
+    return powerstep_ramp_set_profile ( ramp, POWERSTEP_RAMP_TRAPEZOID, POWERSTEP_RAMP_DEFAULT_V_START, 
+                                        POWERSTEP_RAMP_DEFAULT_V_MAX, POWERSTEP_RAMP_DEFAULT_ACCEL );
+}
+
+err_t powerstep_ramp_set_profile ( powerstep_ramp_t *ramp, uint8_t profile, uint32_t v_start, 
+                                   uint32_t v_max, uint32_t accel )
+{
+    float dv = 0;
+    float t_ramp = 0;
+    float time = 0;
+    float pos = 0;
+    float speed = 0;
+    uint32_t n_ramp = 0;
+    uint32_t entries = 0;
+    uint32_t interval = 0;
+    uint8_t cnt = 0;
+
+    if ( ramp->busy || ( profile > POWERSTEP_RAMP_S_CURVE ) || ( 0 == v_start ) || ( 0 == accel ) || 
+         ( v_start > v_max ) || ( ( v_max * 2 ) > ramp->tick_hz ) )
+    {
+        return POWERSTEP_ERROR;
+    }
+
+    // S-curve takes 1.5 times longer to reach the same speed with the same peak acceleration
+    dv = ( float ) ( v_max - v_start );
+    t_ramp = dv / accel;
+    if ( POWERSTEP_RAMP_S_CURVE == profile )
+    {
+        t_ramp *= 1.5f;
+    }
+    n_ramp = ( uint32_t ) ( ( v_start + v_max ) * 0.5f * t_ramp + 0.5f );
+
+    ramp->shift = 0;
+    while ( ( ( n_ramp + ( 1ul << ramp->shift ) - 1 ) >> ramp->shift ) > POWERSTEP_RAMP_TABLE_SIZE )
+    {
+        ramp->shift++;
+    }
+    entries = ( n_ramp + ( 1ul << ramp->shift ) - 1 ) >> ramp->shift;
+
+    // Walk the profile in time, one table entry at a time
+    for ( cnt = 0; cnt < entries; cnt++ )
+    {
+        pos = time / t_ramp;
+        if ( pos > 1.0f )
+        {
+            pos = 1.0f;
+        }
+        if ( POWERSTEP_RAMP_S_CURVE == profile )
+        {
+            pos = pos * pos * ( 3.0f - 2.0f * pos );
+        }
+        speed = v_start + dv * pos;
+        interval = ( uint32_t ) ( ramp->tick_hz * 256.0f / speed );
+        ramp->table[ cnt ] = ( interval < POWERSTEP_RAMP_MIN_INTERVAL ) ? POWERSTEP_RAMP_MIN_INTERVAL : interval;
+        time += ( float ) ( 1ul << ramp->shift ) / speed;
+    }
+
+    interval = ( uint32_t ) ( ramp->tick_hz * 256.0f / v_max );
+    ramp->cruise = ( interval < POWERSTEP_RAMP_MIN_INTERVAL ) ? POWERSTEP_RAMP_MIN_INTERVAL : interval;
+    ramp->ramp_steps = entries << ramp->shift;
+    return POWERSTEP_OK;
+}
+
+err_t powerstep_ramp_move ( powerstep_ramp_t *ramp, int32_t steps )
+{
+    if ( ramp->busy )
+    {
+        return POWERSTEP_ERROR;
+    }
+    if ( 0 == steps )
+    {
+        return POWERSTEP_OK;
+    }
+
+    if ( steps > 0 )
+    {
+        powerstep_set_direction ( ramp->ctx, POWERSTEP_DIR_CW );
+        ramp->dir_step = 1;
+        ramp->steps = ( uint32_t ) steps;
+    }
+    else
+    {
+        powerstep_set_direction ( ramp->ctx, POWERSTEP_DIR_CCW );
+        ramp->dir_step = -1;
+        ramp->steps = 0u - ( uint32_t ) steps;
+    }
+    ramp->done = 0;
+    ramp->frac = 0;
+    ramp->ticks = 1;
+    ramp->stop_f = 0;
+    ramp->pin_high = 0;
+
+    // Set last, the tick starts the move from here
+    ramp->busy = 1;
+    return POWERSTEP_OK;
+}
+
+err_t powerstep_ramp_move_to ( powerstep_ramp_t *ramp, int32_t position )
+{
+    return powerstep_ramp_move ( ramp, position - ramp->position );
+}
+
+void powerstep_ramp_stop ( powerstep_ramp_t *ramp )
+{
+    if ( ramp->busy )
+    {
+        ramp->stop_f = 1;
+    }
+}
+
+uint8_t powerstep_ramp_is_busy ( powerstep_ramp_t *ramp )
+{
+    return ramp->busy;
+}
+
+int32_t powerstep_ramp_get_position ( powerstep_ramp_t *ramp )
+{
+    return ramp->position;
+}
+
+err_t powerstep_ramp_set_position ( powerstep_ramp_t *ramp, int32_t position )
+{
+    if ( ramp->busy )
+    {
+        return POWERSTEP_ERROR;
+    }
+    ramp->position = position;
+    return POWERSTEP_OK;
+}
+
+uint8_t powerstep_ramp_tick ( powerstep_ramp_t *ramp )
+{
+    uint32_t level = 0;
+    uint32_t rest = 0;
+    uint32_t interval = 0;
+
+    if ( !ramp->busy )
+    {
+        return 0;
+    }
+
+    if ( ramp->pin_high )
+    {
+        digital_out_low ( &ramp->ctx->step );
+        ramp->pin_high = 0;
+    }
+
+    if ( --ramp->ticks )
+    {
+        return 1;
+    }
+
+    if ( ramp->done >= ramp->steps )
+    {
+        ramp->busy = 0;
+        return 0;
+    }
+
+    digital_out_high ( &ramp->ctx->step );
+    ramp->pin_high = 1;
+    ramp->position += ramp->dir_step;
+
+    level = ramp->done++;
+    rest = ramp->steps - ramp->done;
+
+    // Stopping shortens the move to the steps needed to ramp down from the current speed
+    if ( ramp->stop_f )
+    {
+        if ( level > ramp->ramp_steps )
+        {
+            level = ramp->ramp_steps;
+        }
+        if ( rest > ( level + 1 ) )
+        {
+            rest = level + 1;
+            ramp->steps = ramp->done + rest;
+        }
+        ramp->stop_f = 0;
+    }
+
+    if ( 0 == rest )
+    {
+        ramp->ticks = 1;
+        return 1;
+    }
+
+    // Interval after step k mirrors the one before step n - 1 - k, so the
+    // speed level is the distance to the nearer end of the move
+    if ( level > ( rest - 1 ) )
+    {
+        level = rest - 1;
+    }
+    interval = ( level < ramp->ramp_steps ) ? ramp->table[ level >> ramp->shift ] : ramp->cruise;
+    interval += ramp->frac;
+    ramp->ticks = interval >> 8;
+    ramp->frac = ( uint8_t ) ( interval & 0xFF );
+    return 1;
+}
+
+// ------------------------------------------------------------------------- END
@@ -351,6 +351,7 @@ typedef struct
     // ctx variable 
 
     uint8_t slave_address;
+    uint16_t phase_step;
 
 } pwm_t;
 
@@ -548,6 +549,33 @@ void pwm_set_pre_scale ( pwm_t *ctx, uint8_t pre_scale );
  */
 void pwm_set_all_raw ( pwm_t *ctx, uint16_t raw_dc );
 
+/**
+ * @brief Set channels raw function.
+ *
+ * @param ctx          Click object.
+ * @param chann_id     First channel to be set.
+ * @param raw_dc       12-bit raw DC for each channel, 0 is full off and 4096 full on.
+ * @param n_channels   Number of consecutive channels.
+ *
+ * @description This function sets consecutive channels in one auto-increment burst.
+ * With outputs changing on STOP command, see pwm_output_config(), all channels
+ * change together at the end of the burst.
+ * @note Auto-increment has to be enabled, see pwm_dev_config().
+ */
+void pwm_set_channels_raw ( pwm_t *ctx, uint8_t chann_id, uint16_t *raw_dc, uint8_t n_channels );
+
+/**
+ * @brief Set phase step function.
+ *
+ * @param ctx          Click object.
+ * @param phase_step   12-bit delay between the rising edges of adjacent channels.
+ *
+ * @description This function staggers the start of the channels set by
+ * pwm_set_channels_raw(), channel N turns on at N * phase_step, which spreads
+ * the switching current over the period. Zero turns all channels on together.
+ */
+void pwm_set_phase_step ( pwm_t *ctx, uint16_t phase_step );
+
 #ifdef __cplusplus
 }
 #endif
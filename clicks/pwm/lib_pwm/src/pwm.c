@@ -54,6 +54,7 @@ PWM_RETVAL pwm_init ( pwm_t *ctx, pwm_cfg_t *cfg )
     i2c_cfg.sda    = cfg->sda;
 
     ctx->slave_address = cfg->i2c_address;
+    ctx->phase_step = 0;
 
     if ( i2c_master_open( &ctx->i2c, &i2c_cfg ) == I2C_MASTER_ERROR )
     {
@@ -198,6 +199,53 @@ void pwm_set_channel_raw ( pwm_t *ctx, uint8_t chann_id, uint16_t raw_off_set, u
     i2c_master_write( &ctx->i2c, w_buffer, 5 ); 
 }
 
+void pwm_set_channels_raw ( pwm_t *ctx, uint8_t chann_id, uint16_t *raw_dc, uint8_t n_channels )
+{
+    uint8_t w_buffer[ 65 ];
+    uint16_t on;
+    uint16_t off;
+    uint8_t cnt;
+
+    if ( chann_id > 15 )
+    {
+        return;
+    }
+    if ( n_channels > ( 16 - chann_id ) )
+    {
+        n_channels = 16 - chann_id;
+    }
+
+    w_buffer[ 0 ] = chann_id * 4 + PWM_CH0_ON_L;
+
+    for ( cnt = 0; cnt < n_channels; cnt++ )
+    {
+        on = ( ( uint32_t ) ( chann_id + cnt ) * ctx->phase_step ) % PWM_MAX_RESOLUTION;
+        off = ( on + raw_dc[ cnt ] ) % PWM_MAX_RESOLUTION;
+
+        w_buffer[ cnt * 4 + 1 ] = on & 0x00FF;
+        w_buffer[ cnt * 4 + 2 ] = ( on & 0x0F00 ) >> 8;
+        w_buffer[ cnt * 4 + 3 ] = off & 0x00FF;
+        w_buffer[ cnt * 4 + 4 ] = ( off & 0x0F00 ) >> 8;
+
+        // Full on and full off bits, ON and OFF counts would be equal
+        if ( raw_dc[ cnt ] >= PWM_MAX_RESOLUTION )
+        {
+            w_buffer[ cnt * 4 + 2 ] |= 0x10;
+        }
+        else if ( 0 == raw_dc[ cnt ] )
+        {
+            w_buffer[ cnt * 4 + 4 ] |= 0x10;
+        }
+    }
+
+    i2c_master_write( &ctx->i2c, w_buffer, n_channels * 4 + 1 );
+}
+
+void pwm_set_phase_step ( pwm_t *ctx, uint16_t phase_step )
+{
+    ctx->phase_step = phase_step % PWM_MAX_RESOLUTION;
+}
+
 void pwm_all_chann_state ( pwm_t *ctx, uint8_t state )
 {
     uint8_t w_buffer[ 5 ];
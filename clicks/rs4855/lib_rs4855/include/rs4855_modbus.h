@@ -0,0 +1,278 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ * \brief This file contains the Modbus RTU engine used with RS485 5 Click driver.
+ *
+ * The engine drives DE and RE around every frame, so the application only
+ * deals with registers. Frame gaps t1.5 and t3.5 are derived from the baud rate,
+ * and a response is accepted as soon as its expected length has arrived.
+ *
+ * \addtogroup rs4855 RS485 5 Click Driver
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef RS4855_MODBUS_H
+#define RS4855_MODBUS_H
+
+#include "rs4855.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup modbus_macros Modbus macros
+ * \{
+ */
+
+/**
+ * \defgroup modbus_status Modbus status
+ * \{
+ */
+#define RS4855_MODBUS_OK                        0
+#define RS4855_MODBUS_ERROR_TIMEOUT             -1
+#define RS4855_MODBUS_ERROR_CRC                 -2
+#define RS4855_MODBUS_ERROR_FRAME               -3
+#define RS4855_MODBUS_ERROR_NO_REQUEST          -4
+#define RS4855_MODBUS_ERROR_SKIPPED             -5
+/** \} */
+
+/**
+ * \defgroup modbus_function Modbus function codes
+ * \{
+ */
+#define RS4855_MODBUS_FC_READ_HOLDING           0x03
+#define RS4855_MODBUS_FC_READ_INPUT             0x04
+#define RS4855_MODBUS_FC_WRITE_SINGLE           0x06
+#define RS4855_MODBUS_FC_WRITE_MULTIPLE         0x10
+/** \} */
+
+/**
+ * \defgroup modbus_exception Modbus exception codes
+ * \{
+ */
+#define RS4855_MODBUS_EX_ILLEGAL_FUNCTION       0x01
+#define RS4855_MODBUS_EX_ILLEGAL_ADDRESS        0x02
+#define RS4855_MODBUS_EX_ILLEGAL_VALUE          0x03
+/** \} */
+
+/**
+ * \defgroup modbus_settings Modbus settings
+ * \{
+ */
+#define RS4855_MODBUS_ADU_SIZE                  256
+#define RS4855_MODBUS_MAX_READ_REGS             125
+#define RS4855_MODBUS_MAX_WRITE_REGS            123
+#define RS4855_MODBUS_BROADCAST                 0x00
+#define RS4855_MODBUS_DEFAULT_TIMEOUT_MS        100
+#define RS4855_MODBUS_FAIL_LIMIT                3
+#define RS4855_MODBUS_SKIP_CYCLES               8
+/** \} */
+
+/** \} */ // End group modbus_macros
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup modbus_type Modbus types
+ * \{
+ */
+
+/**
+ * @brief Modbus RTU engine definition.
+ */
+typedef struct
+{
+    rs4855_t *ctx;                  /**< RS485 5 Click object. */
+
+    uint16_t char_us;               /**< Duration of one 11-bit character. */
+    uint16_t t15_us;                /**< Inter-character timeout. */
+    uint16_t t35_us;                /**< Inter-frame delay. */
+    uint16_t de_release_us;         /**< Delay from the end of a write to DE release. */
+    uint16_t timeout_ms;            /**< Response timeout. */
+    uint8_t gap_pending;            /**< Set when t3.5 has not elapsed since the last frame. */
+
+    uint8_t slave_address;          /**< Own address in slave mode. */
+    uint16_t *holding_regs;         /**< Holding registers in slave mode. */
+    uint16_t num_holding;           /**< Number of holding registers. */
+    uint16_t *input_regs;           /**< Input registers in slave mode. */
+    uint16_t num_input;             /**< Number of input registers. */
+
+    uint16_t adu_len;               /**< Length of the frame in adu. */
+    uint8_t adu[ RS4855_MODBUS_ADU_SIZE ];  /**< Frame buffer. */
+
+} rs4855_modbus_t;
+
+/**
+ * @brief Modbus poll table entry definition.
+ */
+typedef struct
+{
+    uint8_t slave;                  /**< Slave address. */
+    uint8_t function;               /**< Function code, see modbus_function. */
+    uint16_t address;               /**< First register address. */
+    uint16_t quantity;              /**< Number of registers. */
+    uint16_t *regs;                 /**< Register values read or written. */
+
+    int8_t status;                  /**< Status of the last transaction, see modbus_status. */
+    uint8_t fail_cnt;               /**< Consecutive timeouts. */
+    uint8_t skip_cnt;               /**< Cycles left to skip an unresponsive slave. */
+
+} rs4855_modbus_poll_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+/**
+ * \defgroup modbus_function_api Modbus function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Modbus engine initialization function.
+ *
+ * @param mb         Modbus engine.
+ * @param ctx        Initialized RS485 5 Click object.
+ * @param baud_rate  UART baud rate.
+ *
+ * @description This function derives the frame timing from the baud rate and
+ * leaves the transceiver in receive mode. Above 19200 baud the fixed 750 us and
+ * 1750 us gaps of the Modbus specification are used.
+ * @note de_release_us defaults to two and a half characters, as the blocking write
+ * may return with one byte in the shift register and one in the holding register.
+ * Increase it on UARTs with a deeper transmit FIFO.
+ */
+void rs4855_modbus_init ( rs4855_modbus_t *mb, rs4855_t *ctx, uint32_t baud_rate );
+
+/**
+ * @brief CRC-16 function.
+ *
+ * @param data_buf  Data.
+ * @param len       Number of bytes.
+ *
+ * @returns Modbus CRC-16, low byte is sent first.
+ *
+ * @description This function calculates the Modbus CRC-16 with a lookup table.
+ */
+uint16_t rs4855_modbus_crc16 ( uint8_t *data_buf, uint16_t len );
+
+/**
+ * @brief Read registers function.
+ *
+ * @param mb        Modbus engine.
+ * @param slave     Slave address.
+ * @param function  RS4855_MODBUS_FC_READ_HOLDING or RS4855_MODBUS_FC_READ_INPUT.
+ * @param address   First register address.
+ * @param quantity  Number of registers, up to RS4855_MODBUS_MAX_READ_REGS.
+ * @param regs      Register values.
+ *
+ * @returns 0 on success, exception code from the slave or a negative modbus_status error.
+ *
+ * @description This function reads holding or input registers of a slave.
+ */
+int8_t rs4855_modbus_read_registers ( rs4855_modbus_t *mb, uint8_t slave, uint8_t function,
+                                      uint16_t address, uint16_t quantity, uint16_t *regs );
+
+/**
+ * @brief Write single register function.
+ *
+ * @param mb        Modbus engine.
+ * @param slave     Slave address, RS4855_MODBUS_BROADCAST for all slaves.
+ * @param address   Register address.
+ * @param value     Register value.
+ *
+ * @returns 0 on success, exception code from the slave or a negative modbus_status error.
+ *
+ * @description This function writes one holding register of a slave.
+ */
+int8_t rs4855_modbus_write_register ( rs4855_modbus_t *mb, uint8_t slave, uint16_t address, uint16_t value );
+
+/**
+ * @brief Write multiple registers function.
+ *
+ * @param mb        Modbus engine.
+ * @param slave     Slave address, RS4855_MODBUS_BROADCAST for all slaves.
+ * @param address   First register address.
+ * @param quantity  Number of registers, up to RS4855_MODBUS_MAX_WRITE_REGS.
+ * @param regs      Register values.
+ *
+ * @returns 0 on success, exception code from the slave or a negative modbus_status error.
+ *
+ * @description This function writes holding registers of a slave.
+ */
+int8_t rs4855_modbus_write_registers ( rs4855_modbus_t *mb, uint8_t slave, uint16_t address,
+                                       uint16_t quantity, uint16_t *regs );
+
+/**
+ * @brief Poll cycle function.
+ *
+ * @param mb        Modbus engine.
+ * @param polls     Poll table.
+ * @param n_polls   Number of poll table entries.
+ *
+ * @returns Number of entries that completed successfully.
+ *
+ * @description This function runs every entry of the poll table back to back,
+ * each request leaves as soon as t3.5 has passed after the previous response.
+ * A slave that times out RS4855_MODBUS_FAIL_LIMIT times in a row is skipped for
+ * RS4855_MODBUS_SKIP_CYCLES cycles, so an offline meter does not cost a timeout every cycle.
+ */
+uint8_t rs4855_modbus_poll_cycle ( rs4855_modbus_t *mb, rs4855_modbus_poll_t *polls, uint8_t n_polls );
+
+/**
+ * @brief Slave setup function.
+ *
+ * @param mb            Modbus engine.
+ * @param address       Own slave address.
+ * @param holding_regs  Holding registers, NULL if not used.
+ * @param num_holding   Number of holding registers.
+ * @param input_regs    Input registers, NULL if not used.
+ * @param num_input     Number of input registers.
+ *
+ * @description This function maps the register tables served in slave mode.
+ */
+void rs4855_modbus_slave_setup ( rs4855_modbus_t *mb, uint8_t address, uint16_t *holding_regs,
+                                 uint16_t num_holding, uint16_t *input_regs, uint16_t num_input );
+
+/**
+ * @brief Slave process function.
+ *
+ * @param mb        Modbus engine.
+ *
+ * @returns 0 if a request was served, exception code sent or a negative modbus_status error.
+ *
+ * @description This function receives one request, if any is pending, and answers
+ * it from the register tables. Function codes 3, 4, 6 and 16 are supported.
+ * @note Call it often, it returns RS4855_MODBUS_ERROR_NO_REQUEST at once when the bus is idle.
+ */
+int8_t rs4855_modbus_slave_process ( rs4855_modbus_t *mb );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _RS4855_MODBUS_H_
+
+/** \} */ // End modbus_function_api group
+/*! @} */
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,527 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ */
+
+#include "rs4855_modbus.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+#define MODBUS_CHAR_BITS            11
+#define MODBUS_FAST_BAUD            19200
+#define MODBUS_FAST_T15_US          750
+#define MODBUS_FAST_T35_US          1750
+#define MODBUS_EXCEPTION_FLAG       0x80
+#define MODBUS_EXCEPTION_LEN        5
+#define MODBUS_MIN_FRAME_LEN        4
+
+// The last byte may still wait in the holding register behind the one in the shift register
+#define MODBUS_DE_RELEASE_CHARS_X2  5
+
+// ------------------------------------------------------------------ VARIABLES
+
+static const uint16_t modbus_crc_table[ 256 ] =
+{
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void modbus_send ( rs4855_modbus_t *mb, uint16_t len );
+
+static int8_t modbus_receive ( rs4855_modbus_t *mb, uint16_t expected_len, uint32_t timeout_us );
+
+static int8_t modbus_transaction ( rs4855_modbus_t *mb, uint16_t len, uint16_t expected_len );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void rs4855_modbus_init ( rs4855_modbus_t *mb, rs4855_t *ctx, uint32_t baud_rate )
+{
+    mb->ctx = ctx;
+    mb->char_us = ( uint16_t ) ( ( MODBUS_CHAR_BITS * 1000000ul + baud_rate - 1 ) / baud_rate );
+    if ( baud_rate > MODBUS_FAST_BAUD )
+    {
+        mb->t15_us = MODBUS_FAST_T15_US;
+        mb->t35_us = MODBUS_FAST_T35_US;
+    }
+    else
+    {
+        mb->t15_us = ( mb->char_us * 3 ) / 2;
+        mb->t35_us = ( mb->char_us * 7 ) / 2;
+    }
+    mb->de_release_us = ( uint16_t ) ( ( ( uint32_t ) mb->char_us * MODBUS_DE_RELEASE_CHARS_X2 ) / 2 );
+    mb->timeout_ms = RS4855_MODBUS_DEFAULT_TIMEOUT_MS;
+    mb->gap_pending = 1;
+    mb->adu_len = 0;
+
+    rs4855_modbus_slave_setup( mb, 0, NULL, 0, NULL, 0 );
+
+    rs4855_set_de_state( ctx, RS4855_PIN_STATE_LOW );
+    rs4855_set_re_state( ctx, RS4855_PIN_STATE_LOW );
+}
+
+uint16_t rs4855_modbus_crc16 ( uint8_t *data_buf, uint16_t len )
+{
+    uint16_t crc = 0xFFFF;
+
+    while ( len-- )
+    {
+        crc = ( crc >> 8 ) ^ modbus_crc_table[ ( crc ^ *data_buf++ ) & 0xFF ];
+    }
+
+    return crc;
+}
+
+int8_t rs4855_modbus_read_registers ( rs4855_modbus_t *mb, uint8_t slave, uint8_t function,
+                                      uint16_t address, uint16_t quantity, uint16_t *regs )
+{
+    int8_t status;
+
+    if ( ( 0 == quantity ) || ( quantity > RS4855_MODBUS_MAX_READ_REGS ) || ( RS4855_MODBUS_BROADCAST == slave ) )
+    {
+        return RS4855_MODBUS_ERROR_FRAME;
+    }
+
+    mb->adu[ 0 ] = slave;
+    mb->adu[ 1 ] = function;
+    mb->adu[ 2 ] = ( uint8_t ) ( address >> 8 );
+    mb->adu[ 3 ] = ( uint8_t ) address;
+    mb->adu[ 4 ] = ( uint8_t ) ( quantity >> 8 );
+    mb->adu[ 5 ] = ( uint8_t ) quantity;
+
+    status = modbus_transaction( mb, 6, 5 + 2 * quantity );
+    if ( RS4855_MODBUS_OK != status )
+    {
+        return status;
+    }
+    if ( mb->adu[ 2 ] != 2 * quantity )
+    {
+        return RS4855_MODBUS_ERROR_FRAME;
+    }
+
+    for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+    {
+        regs[ cnt ] = ( ( uint16_t ) mb->adu[ 3 + 2 * cnt ] << 8 ) | mb->adu[ 4 + 2 * cnt ];
+    }
+
+    return RS4855_MODBUS_OK;
+}
+
+int8_t rs4855_modbus_write_register ( rs4855_modbus_t *mb, uint8_t slave, uint16_t address, uint16_t value )
+{
+    mb->adu[ 0 ] = slave;
+    mb->adu[ 1 ] = RS4855_MODBUS_FC_WRITE_SINGLE;
+    mb->adu[ 2 ] = ( uint8_t ) ( address >> 8 );
+    mb->adu[ 3 ] = ( uint8_t ) address;
+    mb->adu[ 4 ] = ( uint8_t ) ( value >> 8 );
+    mb->adu[ 5 ] = ( uint8_t ) value;
+
+    return modbus_transaction( mb, 6, 8 );
+}
+
+int8_t rs4855_modbus_write_registers ( rs4855_modbus_t *mb, uint8_t slave, uint16_t address,
+                                       uint16_t quantity, uint16_t *regs )
+{
+    if ( ( 0 == quantity ) || ( quantity > RS4855_MODBUS_MAX_WRITE_REGS ) )
+    {
+        return RS4855_MODBUS_ERROR_FRAME;
+    }
+
+    mb->adu[ 0 ] = slave;
+    mb->adu[ 1 ] = RS4855_MODBUS_FC_WRITE_MULTIPLE;
+    mb->adu[ 2 ] = ( uint8_t ) ( address >> 8 );
+    mb->adu[ 3 ] = ( uint8_t ) address;
+    mb->adu[ 4 ] = ( uint8_t ) ( quantity >> 8 );
+    mb->adu[ 5 ] = ( uint8_t ) quantity;
+    mb->adu[ 6 ] = ( uint8_t ) ( 2 * quantity );
+    for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+    {
+        mb->adu[ 7 + 2 * cnt ] = ( uint8_t ) ( regs[ cnt ] >> 8 );
+        mb->adu[ 8 + 2 * cnt ] = ( uint8_t ) regs[ cnt ];
+    }
+
+    return modbus_transaction( mb, 7 + 2 * quantity, 8 );
+}
+
+uint8_t rs4855_modbus_poll_cycle ( rs4855_modbus_t *mb, rs4855_modbus_poll_t *polls, uint8_t n_polls )
+{
+    uint8_t n_ok = 0;
+
+    for ( uint8_t cnt = 0; cnt < n_polls; cnt++ )
+    {
+        rs4855_modbus_poll_t *poll = &polls[ cnt ];
+
+        if ( poll->skip_cnt )
+        {
+            poll->skip_cnt--;
+            poll->status = RS4855_MODBUS_ERROR_SKIPPED;
+            continue;
+        }
+
+        switch ( poll->function )
+        {
+            case RS4855_MODBUS_FC_READ_HOLDING:
+            case RS4855_MODBUS_FC_READ_INPUT:
+            {
+                poll->status = rs4855_modbus_read_registers( mb, poll->slave, poll->function,
+                                                             poll->address, poll->quantity, poll->regs );
+                break;
+            }
+            case RS4855_MODBUS_FC_WRITE_SINGLE:
+            {
+                poll->status = rs4855_modbus_write_register( mb, poll->slave, poll->address, poll->regs[ 0 ] );
+                break;
+            }
+            case RS4855_MODBUS_FC_WRITE_MULTIPLE:
+            {
+                poll->status = rs4855_modbus_write_registers( mb, poll->slave, poll->address,
+                                                              poll->quantity, poll->regs );
+                break;
+            }
+            default:
+            {
+                poll->status = RS4855_MODBUS_EX_ILLEGAL_FUNCTION;
+                break;
+            }
+        }
+
+        if ( RS4855_MODBUS_ERROR_TIMEOUT == poll->status )
+        {
+            // One more timeout after a skip period sends the slave back to skipping
+            if ( ++poll->fail_cnt >= RS4855_MODBUS_FAIL_LIMIT )
+            {
+                poll->fail_cnt = RS4855_MODBUS_FAIL_LIMIT - 1;
+                poll->skip_cnt = RS4855_MODBUS_SKIP_CYCLES;
+            }
+        }
+        else
+        {
+            poll->fail_cnt = 0;
+        }
+
+        if ( RS4855_MODBUS_OK == poll->status )
+        {
+            n_ok++;
+        }
+    }
+
+    return n_ok;
+}
+
+void rs4855_modbus_slave_setup ( rs4855_modbus_t *mb, uint8_t address, uint16_t *holding_regs,
+                                 uint16_t num_holding, uint16_t *input_regs, uint16_t num_input )
+{
+    mb->slave_address = address;
+    mb->holding_regs = holding_regs;
+    mb->num_holding = holding_regs ? num_holding : 0;
+    mb->input_regs = input_regs;
+    mb->num_input = input_regs ? num_input : 0;
+}
+
+int8_t rs4855_modbus_slave_process ( rs4855_modbus_t *mb )
+{
+    uint16_t *regs = mb->holding_regs;
+    uint16_t num_regs = mb->num_holding;
+    uint16_t address;
+    uint16_t quantity;
+    uint8_t exception = 0;
+    uint16_t len = 6;
+    int8_t status;
+
+    status = modbus_receive( mb, 0, 0 );
+    if ( RS4855_MODBUS_ERROR_TIMEOUT == status )
+    {
+        return RS4855_MODBUS_ERROR_NO_REQUEST;
+    }
+    if ( RS4855_MODBUS_OK != status )
+    {
+        // Corrupted requests are dropped silently, the master will time out
+        return status;
+    }
+    if ( ( mb->adu[ 0 ] != mb->slave_address ) && ( mb->adu[ 0 ] != RS4855_MODBUS_BROADCAST ) )
+    {
+        return RS4855_MODBUS_ERROR_NO_REQUEST;
+    }
+
+    address = ( ( uint16_t ) mb->adu[ 2 ] << 8 ) | mb->adu[ 3 ];
+    quantity = ( ( uint16_t ) mb->adu[ 4 ] << 8 ) | mb->adu[ 5 ];
+
+    switch ( mb->adu[ 1 ] )
+    {
+        case RS4855_MODBUS_FC_READ_INPUT:
+        {
+            regs = mb->input_regs;
+            num_regs = mb->num_input;
+        }
+        // fall through
+        case RS4855_MODBUS_FC_READ_HOLDING:
+        {
+            if ( ( 8 != mb->adu_len ) || ( 0 == quantity ) || ( quantity > RS4855_MODBUS_MAX_READ_REGS ) )
+            {
+                exception = RS4855_MODBUS_EX_ILLEGAL_VALUE;
+            }
+            else if ( ( ( uint32_t ) address + quantity ) > num_regs )
+            {
+                exception = RS4855_MODBUS_EX_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                mb->adu[ 2 ] = ( uint8_t ) ( 2 * quantity );
+                for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+                {
+                    mb->adu[ 3 + 2 * cnt ] = ( uint8_t ) ( regs[ address + cnt ] >> 8 );
+                    mb->adu[ 4 + 2 * cnt ] = ( uint8_t ) regs[ address + cnt ];
+                }
+                len = 3 + 2 * quantity;
+            }
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_SINGLE:
+        {
+            if ( 8 != mb->adu_len )
+            {
+                exception = RS4855_MODBUS_EX_ILLEGAL_VALUE;
+            }
+            else if ( address >= mb->num_holding )
+            {
+                exception = RS4855_MODBUS_EX_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                mb->holding_regs[ address ] = quantity;
+            }
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_MULTIPLE:
+        {
+            if ( ( 0 == quantity ) || ( quantity > RS4855_MODBUS_MAX_WRITE_REGS ) ||
+                 ( mb->adu[ 6 ] != 2 * quantity ) || ( mb->adu_len != 9 + 2 * quantity ) )
+            {
+                exception = RS4855_MODBUS_EX_ILLEGAL_VALUE;
+            }
+            else if ( ( ( uint32_t ) address + quantity ) > mb->num_holding )
+            {
+                exception = RS4855_MODBUS_EX_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+                {
+                    mb->holding_regs[ address + cnt ] = ( ( uint16_t ) mb->adu[ 7 + 2 * cnt ] << 8 ) | 
+                                                        mb->adu[ 8 + 2 * cnt ];
+                }
+            }
+            break;
+        }
+        default:
+        {
+            exception = RS4855_MODBUS_EX_ILLEGAL_FUNCTION;
+            break;
+        }
+    }
+
+    if ( RS4855_MODBUS_BROADCAST == mb->adu[ 0 ] )
+    {
+        return exception;
+    }
+
+    if ( exception )
+    {
+        mb->adu[ 1 ] |= MODBUS_EXCEPTION_FLAG;
+        mb->adu[ 2 ] = exception;
+        len = 3;
+    }
+    modbus_send( mb, len );
+
+    return exception;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void modbus_send ( rs4855_modbus_t *mb, uint16_t len )
+{
+    uint16_t crc = rs4855_modbus_crc16( mb->adu, len );
+
+    mb->adu[ len++ ] = ( uint8_t ) crc;
+    mb->adu[ len++ ] = ( uint8_t ) ( crc >> 8 );
+
+    if ( mb->gap_pending )
+    {
+        Delay_us( mb->t35_us );
+    }
+
+    // Receiver off while driving the bus, so no echo is left in the RX ring
+    rs4855_set_re_state( mb->ctx, RS4855_PIN_STATE_HIGH );
+    rs4855_set_de_state( mb->ctx, RS4855_PIN_STATE_HIGH );
+    uart_clear( &mb->ctx->uart );
+
+    uart_set_blocking( &mb->ctx->uart, true );
+    rs4855_generic_write( mb->ctx, ( char * ) mb->adu, len );
+    uart_set_blocking( &mb->ctx->uart, false );
+
+    // Blocking write returns once the last byte is handed to the UART, the one before
+    // it may still be shifting out, so DE is held for two and a half characters
+    Delay_us( mb->de_release_us );
+    rs4855_set_de_state( mb->ctx, RS4855_PIN_STATE_LOW );
+    rs4855_set_re_state( mb->ctx, RS4855_PIN_STATE_LOW );
+
+    mb->gap_pending = 1;
+}
+
+static int8_t modbus_receive ( rs4855_modbus_t *mb, uint16_t expected_len, uint32_t timeout_us )
+{
+    uint16_t step_us = ( mb->char_us >> 1 ) ? ( mb->char_us >> 1 ) : 1;
+    uint32_t waited_us = 0;
+    uint16_t silent_us = 0;
+    uint8_t gap_error = 0;
+    int32_t rx_len;
+    uint16_t crc;
+
+    mb->adu_len = 0;
+    for ( ; ; )
+    {
+        rx_len = rs4855_generic_read( mb->ctx, ( char * ) &mb->adu[ mb->adu_len ],
+                                      RS4855_MODBUS_ADU_SIZE - mb->adu_len );
+        if ( rx_len > 0 )
+        {
+            // A pause longer than t1.5 inside a frame makes the frame invalid
+            if ( mb->adu_len && ( silent_us > mb->t15_us ) )
+            {
+                gap_error = 1;
+            }
+            mb->adu_len += rx_len;
+            silent_us = 0;
+
+            if ( expected_len && ( ( mb->adu_len >= expected_len ) || 
+                 ( ( mb->adu_len >= MODBUS_EXCEPTION_LEN ) && ( mb->adu[ 1 ] & MODBUS_EXCEPTION_FLAG ) ) ) )
+            {
+                break;
+            }
+            if ( mb->adu_len >= RS4855_MODBUS_ADU_SIZE )
+            {
+                break;
+            }
+            continue;
+        }
+
+        if ( 0 == mb->adu_len )
+        {
+            if ( waited_us >= timeout_us )
+            {
+                return RS4855_MODBUS_ERROR_TIMEOUT;
+            }
+        }
+        else if ( silent_us >= mb->t35_us )
+        {
+            break;
+        }
+
+        Delay_us( step_us );
+        waited_us += step_us;
+        silent_us += step_us;
+    }
+
+    // A frame accepted by length has not been followed by t3.5 yet
+    mb->gap_pending = ( silent_us < mb->t35_us );
+
+    if ( gap_error || ( mb->adu_len < MODBUS_MIN_FRAME_LEN ) )
+    {
+        return RS4855_MODBUS_ERROR_FRAME;
+    }
+
+    crc = rs4855_modbus_crc16( mb->adu, mb->adu_len - 2 );
+    if ( ( mb->adu[ mb->adu_len - 2 ] != ( uint8_t ) crc ) || ( mb->adu[ mb->adu_len - 1 ] != ( uint8_t ) ( crc >> 8 ) ) )
+    {
+        return RS4855_MODBUS_ERROR_CRC;
+    }
+
+    return RS4855_MODBUS_OK;
+}
+
+static int8_t modbus_transaction ( rs4855_modbus_t *mb, uint16_t len, uint16_t expected_len )
+{
+    uint8_t slave = mb->adu[ 0 ];
+    uint8_t function = mb->adu[ 1 ];
+    int8_t status;
+
+    modbus_send( mb, len );
+    if ( RS4855_MODBUS_BROADCAST == slave )
+    {
+        return RS4855_MODBUS_OK;
+    }
+
+    status = modbus_receive( mb, expected_len, ( uint32_t ) mb->timeout_ms * 1000 );
+    if ( RS4855_MODBUS_OK != status )
+    {
+        return status;
+    }
+    if ( mb->adu[ 0 ] != slave )
+    {
+        return RS4855_MODBUS_ERROR_FRAME;
+    }
+    if ( mb->adu[ 1 ] == ( function | MODBUS_EXCEPTION_FLAG ) )
+    {
+        return mb->adu[ 2 ];
+    }
+    if ( mb->adu[ 1 ] != function )
+    {
+        return RS4855_MODBUS_ERROR_FRAME;
+    }
+
+    return RS4855_MODBUS_OK;
+}
+
+// ------------------------------------------------------------------------- END
@@ -314,6 +314,7 @@ typedef struct
     uint16_t vref;
     uint16_t low_res;
     uint16_t high_res;
+    uint16_t phase_step;
 
     servo_pos_and_res_t pos_and_res;
 
@@ -525,6 +526,58 @@ void servo_set_mode ( servo_t *ctx, uint8_t mode, uint8_t w_data );
  */
 void servo_set_position ( servo_t *ctx, uint8_t motor, uint8_t position );
 
+/**
+ * @brief Set positions function.
+ *
+ * @param ctx       Click object.
+ * @param motor     First motor to be set.
+ * @param position  Position for each motor.
+ * @param n_motors  Number of consecutive motors.
+ *
+ * @description This function sets consecutive motors in one auto-increment burst.
+ * With outputs changing on STOP command, the default of MODE2 register, all
+ * motors change together at the end of the burst.
+ */
+void servo_set_positions ( servo_t *ctx, uint8_t motor, uint8_t *position, uint8_t n_motors );
+
+/**
+ * @brief Set pulses function.
+ *
+ * @param ctx       Click object.
+ * @param motor     First motor to be set.
+ * @param pulse     12-bit pulse width for each motor, see servo_position_to_pulse().
+ * @param n_motors  Number of consecutive motors.
+ *
+ * @description This function sets the raw pulse width of consecutive motors in one
+ * auto-increment burst.
+ */
+void servo_set_pulses ( servo_t *ctx, uint8_t motor, uint16_t *pulse, uint8_t n_motors );
+
+/**
+ * @brief Position to pulse function.
+ *
+ * @param ctx       Click object.
+ * @param position  Position of the motor.
+ *
+ * @returns 12-bit pulse width.
+ *
+ * @description This function maps the position to the pulse width with the
+ * position and resolution set by servo_setting().
+ */
+uint16_t servo_position_to_pulse ( servo_t *ctx, uint8_t position );
+
+/**
+ * @brief Set phase step function.
+ *
+ * @param ctx         Click object.
+ * @param phase_step  12-bit delay between the pulses of adjacent motors.
+ *
+ * @description This function staggers the pulses, motor N starts its pulse at
+ * N * phase_step, which spreads the current drawn by the motors over the period.
+ * Zero starts all pulses together.
+ */
+void servo_set_phase_step ( servo_t *ctx, uint16_t phase_step );
+
 /**
  * @brief Set frequency function.
  *
@@ -0,0 +1,174 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ * \brief This file contains the trajectory engine used with Servo Click driver.
+ *
+ * Each motor moves from its current pulse width to a target over a number of
+ * ticks, linearly or with ease in and out. The tick only computes the pulse
+ * widths and can run from a timer interrupt at the PWM frequency, the changed
+ * motors are written by servo_traj_process() in one auto-increment burst.
+ *
+ * \addtogroup servo Servo Click Driver
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SERVO_TRAJ_H
+#define SERVO_TRAJ_H
+
+#include "servo.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup traj_macros Trajectory macros
+ * \{
+ */
+
+/**
+ * \defgroup traj_profile Trajectory profile
+ * \{
+ */
+#define SERVO_TRAJ_PROFILE_LINEAR             0
+#define SERVO_TRAJ_PROFILE_EASE               1
+/** \} */
+
+/**
+ * \defgroup traj_settings Trajectory settings
+ * \{
+ */
+#define SERVO_TRAJ_MAX_MOTORS                 16
+/** \} */
+
+/** \} */ // End group traj_macros
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup traj_type Trajectory types
+ * \{
+ */
+
+/**
+ * @brief Trajectory of one motor.
+ */
+typedef struct
+{
+    volatile uint16_t pulse;            /**< Current pulse width. */
+    uint16_t written;                   /**< Pulse width last written to the chip. */
+    uint16_t start;                     /**< Pulse width at the start of the move. */
+    int16_t delta;                      /**< Pulse width change over the move. */
+    uint16_t elapsed;                   /**< Ticks since the start of the move. */
+    volatile uint16_t duration;         /**< Ticks of the move, zero when idle. */
+    uint8_t profile;                    /**< SERVO_TRAJ_PROFILE_LINEAR or SERVO_TRAJ_PROFILE_EASE. */
+
+} servo_traj_motor_t;
+
+/**
+ * @brief Trajectory engine definition.
+ */
+typedef struct
+{
+    servo_t *ctx;                       /**< Servo Click object. */
+    uint8_t motor;                      /**< First motor. */
+    uint8_t n_motors;                   /**< Number of consecutive motors. */
+
+    servo_traj_motor_t motors[ SERVO_TRAJ_MAX_MOTORS ];    /**< Motor trajectories. */
+
+} servo_traj_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+/**
+ * \defgroup traj_function Trajectory function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Trajectory engine initialization function.
+ *
+ * @param traj       Trajectory engine.
+ * @param ctx        Initialized Servo Click object.
+ * @param motor      First motor, e.g. SERVO_MOTOR_1.
+ * @param n_motors   Number of consecutive motors.
+ * @param position   Start position for each motor.
+ *
+ * @details This function sets the motors to the start positions, they are written
+ * by the next servo_traj_process().
+ */
+void servo_traj_init ( servo_traj_t *traj, servo_t *ctx, uint8_t motor, uint8_t n_motors, uint8_t *position );
+
+/**
+ * @brief Trajectory move function.
+ *
+ * @param traj       Trajectory engine.
+ * @param index      Motor index, zero for the first motor of the engine.
+ * @param position   Target position.
+ * @param ticks      Duration of the move in ticks, zero to jump.
+ * @param profile    SERVO_TRAJ_PROFILE_LINEAR or SERVO_TRAJ_PROFILE_EASE.
+ *
+ * @details This function starts a move from the current pulse width, a move in
+ * progress is replaced without a jump.
+ */
+void servo_traj_move ( servo_traj_t *traj, uint8_t index, uint8_t position, uint16_t ticks, uint8_t profile );
+
+/**
+ * @brief Trajectory busy function.
+ *
+ * @param traj       Trajectory engine.
+ *
+ * @returns 1 while any motor moves, 0 otherwise.
+ */
+uint8_t servo_traj_is_busy ( servo_traj_t *traj );
+
+/**
+ * @brief Trajectory tick function.
+ *
+ * @param traj       Trajectory engine.
+ *
+ * @details This function advances the moves by one tick. It does not access the bus,
+ * call it from a timer interrupt or from the main loop, once per PWM period at most.
+ */
+void servo_traj_tick ( servo_traj_t *traj );
+
+/**
+ * @brief Trajectory process function.
+ *
+ * @param traj       Trajectory engine.
+ *
+ * @details This function writes the motors changed since the last call in one burst,
+ * from the first to the last changed motor. Call it from the main loop.
+ */
+void servo_traj_process ( servo_traj_t *traj );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SERVO_TRAJ_H_
+
+/** \} */ // End traj_function group
+/*! @} */
+// ------------------------------------------------------------------------- END
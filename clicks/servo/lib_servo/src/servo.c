@@ -31,6 +31,8 @@
 
 static uint16_t map_priv ( servo_map_t map );
 
+static void fill_channel_priv ( servo_t *ctx, uint8_t motor, uint16_t pulse, uint8_t *data_buf );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void servo_cfg_setup ( servo_cfg_t *cfg )
@@ -60,6 +62,7 @@ SERVO_RETVAL servo_init ( servo_t *ctx, servo_cfg_t *cfg )
 
     ctx->slave_address_of_pca9685 = cfg->i2c_address_of_pca9685;
     ctx->slave_address_of_ltc2497 = cfg->i2c_address_of_ltc2497;
+    ctx->phase_step = 0;
 
     if ( i2c_master_open( &ctx->i2c, &i2c_cfg ) == I2C_MASTER_ERROR )
     {
@@ -189,8 +192,54 @@ void servo_set_mode ( servo_t *ctx, uint8_t mode, uint8_t w_data )
 void servo_set_position ( servo_t *ctx, uint8_t motor, uint8_t position )
 {
     uint8_t write_reg[ 4 ];
+
+    fill_channel_priv( ctx, motor, servo_position_to_pulse( ctx, position ), write_reg );
+    servo_generic_write_of_pca9685( ctx, motor, write_reg, 4 );
+}
+
+void servo_set_positions ( servo_t *ctx, uint8_t motor, uint8_t *position, uint8_t n_motors )
+{
+    uint16_t pulse[ 16 ];
+    uint8_t cnt;
+
+    if ( n_motors > 16 )
+    {
+        n_motors = 16;
+    }
+
+    for ( cnt = 0; cnt < n_motors; cnt++ )
+    {
+        pulse[ cnt ] = servo_position_to_pulse( ctx, position[ cnt ] );
+    }
+
+    servo_set_pulses( ctx, motor, pulse, n_motors );
+}
+
+void servo_set_pulses ( servo_t *ctx, uint8_t motor, uint16_t *pulse, uint8_t n_motors )
+{
+    uint8_t write_reg[ 64 ];
+    uint8_t cnt;
+
+    if ( ( motor < SERVO_MOTOR_1 ) || ( motor > SERVO_MOTOR_16 ) )
+    {
+        return;
+    }
+    if ( n_motors > ( ( SERVO_MOTOR_16 - motor ) / 4 + 1 ) )
+    {
+        n_motors = ( SERVO_MOTOR_16 - motor ) / 4 + 1;
+    }
+
+    for ( cnt = 0; cnt < n_motors; cnt++ )
+    {
+        fill_channel_priv( ctx, motor + cnt * 4, pulse[ cnt ], &write_reg[ cnt * 4 ] );
+    }
+
+    servo_generic_write_of_pca9685( ctx, motor, write_reg, n_motors * 4 );
+}
+
+uint16_t servo_position_to_pulse ( servo_t *ctx, uint8_t position )
+{
     uint16_t set_map;
-    uint16_t on = 0x0000;
     servo_map_t map; 
     
     map.x = position;
@@ -204,14 +253,13 @@ void servo_set_position ( servo_t *ctx, uint8_t motor, uint8_t position )
     {
         set_map = 70;
     }
-        
-    write_reg[ 0 ] = on;
-    write_reg[ 1 ] = on >> 8;
-    write_reg[ 2 ] = set_map;
-    write_reg[ 3 ] = set_map >> 8;
 
-    servo_start( ctx );
-    servo_generic_write_of_pca9685( ctx, motor, write_reg, 4 );
+    return set_map;
+}
+
+void servo_set_phase_step ( servo_t *ctx, uint16_t phase_step )
+{
+    ctx->phase_step = phase_step & 0x0FFF;
 }
 
 void servo_set_freq ( servo_t *ctx, uint16_t freq )
@@ -276,5 +324,24 @@ static uint16_t map_priv ( servo_map_t map )
     return val;
 }
 
+static void fill_channel_priv ( servo_t *ctx, uint8_t motor, uint16_t pulse, uint8_t *data_buf )
+{
+    uint16_t on;
+    uint16_t off;
+
+    // Pulse may wrap past the end of the period, the chip handles OFF below ON
+    on = 0;
+    if ( ( motor >= SERVO_MOTOR_1 ) && ( motor <= SERVO_MOTOR_16 ) )
+    {
+        on = ( ( uint32_t ) ( ( motor - SERVO_MOTOR_1 ) / 4 ) * ctx->phase_step ) & 0x0FFF;
+    }
+    off = ( on + pulse ) & 0x0FFF;
+
+    data_buf[ 0 ] = on;
+    data_buf[ 1 ] = on >> 8;
+    data_buf[ 2 ] = off;
+    data_buf[ 3 ] = off >> 8;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -0,0 +1,161 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ */
+
+#include "servo_traj.h"
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void servo_traj_init ( servo_traj_t *traj, servo_t *ctx, uint8_t motor, uint8_t n_motors, uint8_t *position )
+{
+    servo_traj_motor_t *m;
+    uint8_t cnt;
+
+    if ( n_motors > SERVO_TRAJ_MAX_MOTORS )
+    {
+        n_motors = SERVO_TRAJ_MAX_MOTORS;
+    }
+
+    traj->ctx = ctx;
+    traj->motor = motor;
+    traj->n_motors = n_motors;
+
+    for ( cnt = 0; cnt < n_motors; cnt++ )
+    {
+        m = &traj->motors[ cnt ];
+        m->duration = 0;
+        m->elapsed = 0;
+        m->pulse = servo_position_to_pulse( ctx, position[ cnt ] );
+        m->written = ~m->pulse;
+    }
+}
+
+void servo_traj_move ( servo_traj_t *traj, uint8_t index, uint8_t position, uint16_t ticks, uint8_t profile )
+{
+    servo_traj_motor_t *m;
+    uint16_t target;
+
+    if ( index >= traj->n_motors )
+    {
+        return;
+    }
+
+    m = &traj->motors[ index ];
+    target = servo_position_to_pulse( traj->ctx, position );
+
+    // Stop the tick from using the move while it is replaced
+    m->duration = 0;
+    if ( 0 == ticks )
+    {
+        m->pulse = target;
+        return;
+    }
+    m->start = m->pulse;
+    m->delta = ( int16_t ) target - ( int16_t ) m->start;
+    m->elapsed = 0;
+    m->profile = profile;
+    m->duration = ticks;
+}
+
+uint8_t servo_traj_is_busy ( servo_traj_t *traj )
+{
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < traj->n_motors; cnt++ )
+    {
+        if ( traj->motors[ cnt ].duration )
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void servo_traj_tick ( servo_traj_t *traj )
+{
+    servo_traj_motor_t *m;
+    uint32_t x;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < traj->n_motors; cnt++ )
+    {
+        m = &traj->motors[ cnt ];
+        if ( 0 == m->duration )
+        {
+            continue;
+        }
+
+        // Fraction of the move in Q15, eased with 3x^2 - 2x^3
+        m->elapsed++;
+        x = ( ( uint32_t ) m->elapsed << 15 ) / m->duration;
+        if ( SERVO_TRAJ_PROFILE_EASE == m->profile )
+        {
+            x = ( ( x * x ) >> 15 ) * ( 98304 - 2 * x ) >> 15;
+        }
+        m->pulse = m->start + ( ( int32_t ) m->delta * ( int32_t ) x ) / 32768;
+
+        if ( m->elapsed >= m->duration )
+        {
+            m->duration = 0;
+        }
+    }
+}
+
+void servo_traj_process ( servo_traj_t *traj )
+{
+    uint16_t pulse[ SERVO_TRAJ_MAX_MOTORS ];
+    int8_t first = -1;
+    int8_t last = -1;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < traj->n_motors; cnt++ )
+    {
+        pulse[ cnt ] = traj->motors[ cnt ].pulse;
+        if ( pulse[ cnt ] != traj->motors[ cnt ].written )
+        {
+            if ( first < 0 )
+            {
+                first = cnt;
+            }
+            last = cnt;
+        }
+    }
+
+    if ( first < 0 )
+    {
+        return;
+    }
+
+    servo_set_pulses( traj->ctx, traj->motor + first * 4, &pulse[ first ], last - first + 1 );
+
+    for ( cnt = first; cnt <= last; cnt++ )
+    {
+        traj->motors[ cnt ].written = pulse[ cnt ];
+    }
+}
+
+// ------------------------------------------------------------------------- END
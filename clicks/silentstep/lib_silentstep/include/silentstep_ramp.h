@@ -0,0 +1,233 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file silentstep_ramp.h
+ * @brief This file contains step generator with ramps for Silent Step Click Driver.
+ * @details Steps are issued from a periodic tick instead of busy waits, so moves
+ * run in the background. Speed follows a trapezoidal or S-curve profile planned
+ * once into an interval table, the tick only adds and shifts.
+ */
+
+#ifndef SILENTSTEP_RAMP_H
+#define SILENTSTEP_RAMP_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "silentstep.h"
+
+/*!
+ * @addtogroup silentstep Silent Step Click Driver
+ * @brief API for configuring and manipulating Silent Step Click driver.
+ * @{
+ */
+
+/**
+ * @defgroup silentstep_ramp Silent Step Ramp Settings
+ * @brief Settings for step generator of Silent Step Click driver.
+ */
+
+/**
+ * @addtogroup silentstep_ramp
+ * @{
+ */
+
+/**
+ * @brief Silent Step ramp profile setting.
+ * @details Shape of the speed profile.
+ */
+#define SILENTSTEP_RAMP_TRAPEZOID                 0
+#define SILENTSTEP_RAMP_S_CURVE                   1
+
+/**
+ * @brief Silent Step ramp default setting.
+ * @details Default start speed and maximal speed in steps per second and
+ * acceleration in steps per second squared.
+ */
+#define SILENTSTEP_RAMP_DEFAULT_V_START           100
+#define SILENTSTEP_RAMP_DEFAULT_V_MAX             1000
+#define SILENTSTEP_RAMP_DEFAULT_ACCEL             2000
+
+/**
+ * @brief Silent Step ramp table size.
+ * @details Number of intervals in the ramp table. Longer ramps use one interval
+ * for 2, 4, 8... steps.
+ * @note Increase table size if needed.
+ */
+#define SILENTSTEP_RAMP_TABLE_SIZE                64
+
+/*! @} */ // silentstep_ramp
+
+/**
+ * @brief Silent Step step generator object.
+ * @details Step generator definition of Silent Step Click driver.
+ */
+typedef struct
+{
+    silentstep_t *ctx;                    /**< Click context object. */
+    uint32_t tick_hz;                   /**< Tick frequency. */
+
+    // Profile
+    uint32_t table[ SILENTSTEP_RAMP_TABLE_SIZE ];     /**< Ramp intervals in ticks, Q24.8. */
+    uint32_t cruise;                    /**< Interval at maximal speed in ticks, Q24.8. */
+    uint32_t ramp_steps;                /**< Steps from start to maximal speed. */
+    uint8_t shift;                      /**< Log2 of steps per table entry. */
+
+    // Move
+    volatile uint8_t busy;              /**< Move in progress. */
+    volatile uint8_t stop_f;            /**< Stop requested. */
+    int8_t dir_step;                    /**< Position change per step. */
+    uint8_t pin_high;                   /**< STEP pin is high. */
+    uint32_t steps;                     /**< Steps of the move. */
+    uint32_t done;                      /**< Steps made. */
+    uint32_t ticks;                     /**< Ticks to the next step. */
+    uint8_t frac;                       /**< Fraction of a tick carried to the next step. */
+    volatile int32_t position;          /**< Position in steps. */
+
+} silentstep_ramp_t;
+
+/**
+ * @brief Silent Step step generator initialization function.
+ * @details This function initializes the step generator with the default profile.
+ * @param[out] ramp : Step generator object.
+ * See #silentstep_ramp_t object definition for detailed explanation.
+ * @param[in] ctx : Initialized Click context object.
+ * See #silentstep_t object definition for detailed explanation.
+ * @param[in] tick_hz : Frequency silentstep_ramp_tick( ) is called at.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The driver stage has to be enabled by the application, see silentstep_set_toff( ).
+ */
+err_t silentstep_ramp_init ( silentstep_ramp_t *ramp, silentstep_t *ctx, uint32_t tick_hz );
+
+/**
+ * @brief Silent Step set profile function.
+ * @details This function plans the ramp into the interval table. The floating point
+ * math is done here once, not per step.
+ * @param[in] ramp : Step generator object.
+ * See #silentstep_ramp_t object definition for detailed explanation.
+ * @param[in] profile : @li @c 0 - Trapezoidal, constant acceleration,
+ *                      @li @c 1 - S-curve, acceleration rising and falling smoothly.
+ * @param[in] v_start : Start and stop speed in steps per second.
+ * @param[in] v_max : Maximal speed in steps per second, up to half of the tick frequency.
+ * @param[in] accel : Acceleration in steps per second squared, peak value for S-curve.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, wrong parameters or move in progress.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t silentstep_ramp_set_profile ( silentstep_ramp_t *ramp, uint8_t profile, uint32_t v_start, 
+                                    uint32_t v_max, uint32_t accel );
+
+/**
+ * @brief Silent Step move function.
+ * @details This function starts a relative move and returns at once.
+ * @param[in] ramp : Step generator object.
+ * See #silentstep_ramp_t object definition for detailed explanation.
+ * @param[in] steps : Number of steps, negative for counter clockwise.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, move in progress.
+ * See #err_t definition for detailed explanation.
+ * @note Moves shorter than two ramps reach a lower peak speed.
+ */
+err_t silentstep_ramp_move ( silentstep_ramp_t *ramp, int32_t steps );
+
+/**
+ * @brief Silent Step move to function.
+ * @details This function starts a move to an absolute position and returns at once.
+ * @param[in] ramp : Step generator object.
+ * See #silentstep_ramp_t object definition for detailed explanation.
+ * @param[in] position : Target position in steps.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, move in progress.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t silentstep_ramp_move_to ( silentstep_ramp_t *ramp, int32_t position );
+
+/**
+ * @brief Silent Step stop function.
+ * @details This function decelerates the move in progress to a stop along the ramp.
+ * @param[in] ramp : Step generator object.
+ * See #silentstep_ramp_t object definition for detailed explanation.
+ * @return None.
+ * @note None.
+ */
+void silentstep_ramp_stop ( silentstep_ramp_t *ramp );
+
+/**
+ * @brief Silent Step busy check function.
+ * @details This function checks if a move is in progress.
+ * @param[in] ramp : Step generator object.
+ * See #silentstep_ramp_t object definition for detailed explanation.
+ * @return @li @c 0 - Idle,
+ *         @li @c 1 - Move in progress.
+ * @note None.
+ */
+uint8_t silentstep_ramp_is_busy ( silentstep_ramp_t *ramp );
+
+/**
+ * @brief Silent Step get position function.
+ * @details This function returns the current position.
+ * @param[in] ramp : Step generator object.
+ * See #silentstep_ramp_t object definition for detailed explanation.
+ * @return Position in steps.
+ * @note None.
+ */
+int32_t silentstep_ramp_get_position ( silentstep_ramp_t *ramp );
+
+/**
+ * @brief Silent Step set position function.
+ * @details This function sets the current position, e.g. zero after homing.
+ * @param[in] ramp : Step generator object.
+ * See #silentstep_ramp_t object definition for detailed explanation.
+ * @param[in] position : New position in steps.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, move in progress.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t silentstep_ramp_set_position ( silentstep_ramp_t *ramp, int32_t position );
+
+/**
+ * @brief Silent Step tick function.
+ * @details This function issues the steps. Call it from a periodic timer interrupt
+ * at the frequency given to silentstep_ramp_init( ). A STEP pulse lasts one tick.
+ * @param[in] ramp : Step generator object.
+ * See #silentstep_ramp_t object definition for detailed explanation.
+ * @return @li @c 0 - Idle,
+ *         @li @c 1 - Move in progress.
+ * @note The cost per tick is constant, without divisions.
+ */
+uint8_t silentstep_ramp_tick ( silentstep_ramp_t *ramp );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // SILENTSTEP_RAMP_H
+
+/*! @} */ // silentstep
+
+// ------------------------------------------------------------------------ END
@@ -443,6 +443,23 @@ void sqiflash_write_suspend ( sqiflash_t *ctx );
  */
 void sqiflash_write_resume ( sqiflash_t *ctx );
 
+/**
+ * @brief SQI FLASH Read With Write-Suspend.
+ * @details This function reads data without waiting for an ongoing sector/block
+ * erase or page program to complete. If the device is busy, the write operation
+ * is suspended, data is read and the operation is resumed afterwards.
+ * @param[in] ctx : Click context object.
+ * See #sqiflash_t object definition for detailed explanation.
+ * @param[in] address : Address to start reading from.
+ * @param[out] buffer : Buffer to read to.
+ * @param[in] data_count : Amount of bytes to read.
+ * @return Nothing.
+ * @note Data in the sector or block being erased or page being programmed is not valid.
+ * Chip-Erase can not be suspended, so the function waits for it to complete.
+ * The device requires a minimum of 500 us between each Write-Suspend command.
+ */
+void sqiflash_read_suspend ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count );
+
 /**
  * @brief SQI FLASH Get Security ID SPI.
  * @details Reads the Unique ID Pre-Programmed at factory.
@@ -283,6 +283,29 @@ void sqiflash_write_resume ( sqiflash_t *ctx )
     spi_master_deselect_device( ctx->chip_select );  
 }
 
+void sqiflash_read_suspend ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count ) 
+{
+    uint8_t suspended = 0;
+
+    if ( sqiflash_busy( ctx ) ) 
+    {
+        sqiflash_write_suspend( ctx );
+        while ( sqiflash_busy( ctx ) );
+        suspended = sqiflash_get_status_reg( ctx ) & ( SQIFLASH_STATUS_WSE | SQIFLASH_STATUS_WSP );
+    }
+
+    spi_master_select_device( ctx->chip_select );
+    sqiflash_command( ctx, SQIFLASH_INSTR_READ );
+    sqiflash_write_address( ctx, address );
+    sqiflash_read( ctx, &buffer[ 0 ], data_count );
+    spi_master_deselect_device( ctx->chip_select );  
+
+    if ( suspended ) 
+    {
+        sqiflash_write_resume( ctx );
+    }
+}
+
 void sqiflash_spi_get_security_id ( sqiflash_t *ctx, uint8_t *buffer, uint32_t data_count ) 
 {
     while ( sqiflash_busy( ctx ) );
@@ -77,6 +77,7 @@
 #define SRAM_RETVAL  uint8_t
 
 #define SRAM_OK                       0x00
+#define SRAM_ERROR                    0x01
 #define SRAM_INIT_ERROR               0xFF
 /** \} */
 
@@ -102,6 +103,21 @@
 #define SRAM_MODE_REG_SM              0x40
 /** \} */
 
+/**
+ * \defgroup mem_range Memory range
+ * \{
+ */
+#define SRAM_MIN_ADDRESS              0x000000
+#define SRAM_MAX_ADDRESS              0x01FFFF
+/** \} */
+
+/**
+ * \defgroup mem_pool Memory pool
+ * \{
+ */
+#define SRAM_POOL_DEFAULT_ALIGN       4
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -150,6 +166,33 @@ typedef struct
 
 } sram_cfg_t;
 
+/**
+ * @brief Memory pool object definition.
+ *
+ * Arena allocator used for placing large buffers into the SRAM.
+ */
+typedef struct
+{
+    uint32_t base;
+    uint32_t size;
+    uint32_t offset;
+
+} sram_pool_t;
+
+/**
+ * @brief Write-combining buffer object definition.
+ *
+ * Adjacent small writes are merged in the RAM buffer and flushed as a single burst.
+ */
+typedef struct
+{
+    uint8_t *buf;
+    uint16_t buf_size;
+    uint32_t address;
+    uint16_t len;
+
+} sram_wc_t;
+
 /** \} */ // End types group
 
 // ------------------------------------------------------------------ CONSTANTS
@@ -294,6 +337,147 @@ void sram_soft_reset ( sram_t *ctx );
  */
 void sram_hold_transmission ( sram_t *ctx );
 
+/**
+ * @brief Sequential write data funcion.
+ *
+ * @param ctx            Click object.
+ * @param reg_address    24-bit starting register address.
+ * @param data_in        Data to be written.
+ * @param len            Number of data bytes.
+ *
+ * @returns SRAM_OK or SRAM_ERROR if the data does not fit in the memory range.
+ *
+ * @description Function writes the desired number of data bytes starting from the target 24-bit 
+ * register address of 23LC1024 chip in a single burst.
+ * @note The chip must be in sequential mode (default after power-up). In page mode the address wraps 
+ * inside the 32-byte page.
+ */
+SRAM_RETVAL sram_write_data ( sram_t *ctx, uint32_t reg_address, uint8_t *data_in, uint32_t len );
+
+/**
+ * @brief Sequential read data funcion.
+ *
+ * @param ctx            Click object.
+ * @param reg_address    24-bit starting register address.
+ * @param data_out       Read data output.
+ * @param len            Number of data bytes.
+ *
+ * @returns SRAM_OK or SRAM_ERROR if the data does not fit in the memory range.
+ *
+ * @description Function reads the desired number of data bytes starting from the target 24-bit 
+ * register address of 23LC1024 chip in a single burst.
+ * @note The chip must be in sequential mode (default after power-up). In page mode the address wraps 
+ * inside the 32-byte page.
+ */
+SRAM_RETVAL sram_read_data ( sram_t *ctx, uint32_t reg_address, uint8_t *data_out, uint32_t len );
+
+/**
+ * @brief Memory pool init funcion.
+ *
+ * @param pool           Memory pool object.
+ * @param base           Starting memory address of the pool.
+ * @param size           Pool size in bytes.
+ *
+ * @returns SRAM_OK or SRAM_ERROR if the pool does not fit in the memory range.
+ *
+ * @description Function initializes the memory pool object which covers the selected SRAM region.
+ */
+SRAM_RETVAL sram_pool_init ( sram_pool_t *pool, uint32_t base, uint32_t size );
+
+/**
+ * @brief Memory pool allocate funcion.
+ *
+ * @param pool           Memory pool object.
+ * @param len            Number of bytes to allocate.
+ * @param align          Address alignment, power of two (0 selects SRAM_POOL_DEFAULT_ALIGN).
+ * @param address        Allocated starting memory address output.
+ *
+ * @returns SRAM_OK or SRAM_ERROR if the pool has no room left.
+ *
+ * @description Function allocates a block of SRAM from the memory pool.
+ * @note Blocks are released in LIFO order by using sram_pool_release.
+ */
+SRAM_RETVAL sram_pool_alloc ( sram_pool_t *pool, uint32_t len, uint32_t align, uint32_t *address );
+
+/**
+ * @brief Memory pool get mark funcion.
+ *
+ * @param pool           Memory pool object.
+ *
+ * @returns Current pool mark.
+ *
+ * @description Function returns the current pool mark, used for releasing the blocks allocated after it.
+ */
+uint32_t sram_pool_get_mark ( sram_pool_t *pool );
+
+/**
+ * @brief Memory pool release funcion.
+ *
+ * @param pool           Memory pool object.
+ * @param mark           Pool mark returned by sram_pool_get_mark (0 releases the whole pool).
+ *
+ * @description Function releases all blocks allocated after the selected pool mark.
+ */
+void sram_pool_release ( sram_pool_t *pool, uint32_t mark );
+
+/**
+ * @brief Write-combining buffer init funcion.
+ *
+ * @param wc             Write-combining buffer object.
+ * @param buf            User provided RAM buffer.
+ * @param buf_size       Size of the user provided RAM buffer.
+ *
+ * @returns SRAM_OK or SRAM_ERROR if the buffer is not valid.
+ *
+ * @description Function initializes the write-combining buffer object.
+ */
+SRAM_RETVAL sram_wc_init ( sram_wc_t *wc, uint8_t *buf, uint16_t buf_size );
+
+/**
+ * @brief Write-combining write funcion.
+ *
+ * @param ctx            Click object.
+ * @param wc             Write-combining buffer object.
+ * @param reg_address    24-bit starting register address.
+ * @param data_in        Data to be written.
+ * @param len            Number of data bytes.
+ *
+ * @returns SRAM_OK or SRAM_ERROR if the data does not fit in the memory range.
+ *
+ * @description Function appends data to the write-combining buffer. The buffer is flushed by using 
+ * sram_write_data when the new data is not adjacent to the buffered data or does not fit in the buffer.
+ * @note The chip must be in sequential mode (default after power-up).
+ */
+SRAM_RETVAL sram_wc_write ( sram_t *ctx, sram_wc_t *wc, uint32_t reg_address, uint8_t *data_in, uint32_t len );
+
+/**
+ * @brief Write-combining flush funcion.
+ *
+ * @param ctx            Click object.
+ * @param wc             Write-combining buffer object.
+ *
+ * @returns SRAM_OK or SRAM_ERROR.
+ *
+ * @description Function writes all buffered data to the SRAM in a single burst.
+ */
+SRAM_RETVAL sram_wc_flush ( sram_t *ctx, sram_wc_t *wc );
+
+/**
+ * @brief Write-combining read funcion.
+ *
+ * @param ctx            Click object.
+ * @param wc             Write-combining buffer object.
+ * @param reg_address    24-bit starting register address.
+ * @param data_out       Read data output.
+ * @param len            Number of data bytes.
+ *
+ * @returns SRAM_OK or SRAM_ERROR if the data does not fit in the memory range.
+ *
+ * @description Function flushes the write-combining buffer if it overlaps the requested range and 
+ * then reads the desired number of data bytes by using sram_read_data.
+ */
+SRAM_RETVAL sram_wc_read ( sram_t *ctx, sram_wc_t *wc, uint32_t reg_address, uint8_t *data_out, uint32_t len );
+
 #ifdef __cplusplus
 }
 #endif
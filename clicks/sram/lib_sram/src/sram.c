@@ -26,6 +26,7 @@
  */
 
 #include "sram.h"
+#include "string.h"
 
 // ------------------------------------------------------------- PRIVATE MACROS 
 
@@ -209,6 +210,189 @@ void sram_hold_transmission ( sram_t *ctx )
     dev_comm_delay( );
 }
 
+SRAM_RETVAL sram_write_data ( sram_t *ctx, uint32_t reg_address, uint8_t *data_in, uint32_t len )
+{
+    uint8_t tx_buf[ 4 ];
+    
+    if ( ( NULL == data_in ) || ( len > ( SRAM_MAX_ADDRESS + 1 ) ) || 
+         ( ( reg_address + len ) > ( SRAM_MAX_ADDRESS + 1 ) ) )
+    {
+        return SRAM_ERROR;
+    }
+    
+    tx_buf[ 0 ] = SRAM_CMD_WRITE;
+    tx_buf[ 1 ] = ( uint8_t ) ( reg_address >> 16 );
+    tx_buf[ 2 ] = ( uint8_t ) ( reg_address >> 8 );
+    tx_buf[ 3 ] = ( uint8_t )   reg_address;
+
+    spi_master_select_device( ctx->chip_select );
+    spi_master_write( &ctx->spi, tx_buf, 4 );
+    spi_master_write( &ctx->spi, data_in, len );
+    spi_master_deselect_device( ctx->chip_select );
+
+    return SRAM_OK;
+}
+
+SRAM_RETVAL sram_read_data ( sram_t *ctx, uint32_t reg_address, uint8_t *data_out, uint32_t len )
+{
+    uint8_t tx_buf[ 4 ];
+    
+    if ( ( NULL == data_out ) || ( len > ( SRAM_MAX_ADDRESS + 1 ) ) || 
+         ( ( reg_address + len ) > ( SRAM_MAX_ADDRESS + 1 ) ) )
+    {
+        return SRAM_ERROR;
+    }
+    
+    tx_buf[ 0 ] = SRAM_CMD_READ;
+    tx_buf[ 1 ] = ( uint8_t ) ( reg_address >> 16 );
+    tx_buf[ 2 ] = ( uint8_t ) ( reg_address >> 8 );
+    tx_buf[ 3 ] = ( uint8_t )   reg_address;
+
+    spi_master_select_device( ctx->chip_select );
+    spi_master_write( &ctx->spi, tx_buf, 4 );
+    spi_master_read( &ctx->spi, data_out, len );
+    spi_master_deselect_device( ctx->chip_select );
+
+    return SRAM_OK;
+}
+
+SRAM_RETVAL sram_pool_init ( sram_pool_t *pool, uint32_t base, uint32_t size )
+{
+    if ( ( NULL == pool ) || ( 0 == size ) || ( size > ( SRAM_MAX_ADDRESS + 1 ) ) || 
+         ( ( base + size ) > ( SRAM_MAX_ADDRESS + 1 ) ) )
+    {
+        return SRAM_ERROR;
+    }
+
+    pool->base = base;
+    pool->size = size;
+    pool->offset = 0;
+
+    return SRAM_OK;
+}
+
+SRAM_RETVAL sram_pool_alloc ( sram_pool_t *pool, uint32_t len, uint32_t align, uint32_t *address )
+{
+    uint32_t start;
+    uint32_t offset;
+
+    if ( ( NULL == pool ) || ( NULL == address ) || ( 0 == len ) )
+    {
+        return SRAM_ERROR;
+    }
+    if ( 0 == align )
+    {
+        align = SRAM_POOL_DEFAULT_ALIGN;
+    }
+    if ( align & ( align - 1 ) )
+    {
+        return SRAM_ERROR;
+    }
+
+    start = ( pool->base + pool->offset + align - 1 ) & ~( align - 1 );
+    offset = start - pool->base;
+    if ( ( offset > pool->size ) || ( len > ( pool->size - offset ) ) )
+    {
+        return SRAM_ERROR;
+    }
+
+    pool->offset = offset + len;
+    *address = start;
+
+    return SRAM_OK;
+}
+
+uint32_t sram_pool_get_mark ( sram_pool_t *pool )
+{
+    return pool->offset;
+}
+
+void sram_pool_release ( sram_pool_t *pool, uint32_t mark )
+{
+    if ( mark < pool->offset )
+    {
+        pool->offset = mark;
+    }
+}
+
+SRAM_RETVAL sram_wc_init ( sram_wc_t *wc, uint8_t *buf, uint16_t buf_size )
+{
+    if ( ( NULL == wc ) || ( NULL == buf ) || ( 0 == buf_size ) )
+    {
+        return SRAM_ERROR;
+    }
+
+    wc->buf = buf;
+    wc->buf_size = buf_size;
+    wc->address = SRAM_MIN_ADDRESS;
+    wc->len = 0;
+
+    return SRAM_OK;
+}
+
+SRAM_RETVAL sram_wc_write ( sram_t *ctx, sram_wc_t *wc, uint32_t reg_address, uint8_t *data_in, uint32_t len )
+{
+    SRAM_RETVAL error_flag = SRAM_OK;
+
+    if ( ( NULL == data_in ) || ( len > ( SRAM_MAX_ADDRESS + 1 ) ) || 
+         ( ( reg_address + len ) > ( SRAM_MAX_ADDRESS + 1 ) ) )
+    {
+        return SRAM_ERROR;
+    }
+
+    if ( ( wc->len > 0 ) && 
+         ( ( reg_address != ( wc->address + wc->len ) ) || ( ( wc->len + len ) > wc->buf_size ) ) )
+    {
+        error_flag |= sram_wc_flush( ctx, wc );
+    }
+
+    if ( len >= wc->buf_size )
+    {
+        // Data which fills the whole buffer is written directly.
+        error_flag |= sram_write_data( ctx, reg_address, data_in, len );
+    }
+    else
+    {
+        if ( 0 == wc->len )
+        {
+            wc->address = reg_address;
+        }
+        memcpy( &wc->buf[ wc->len ], data_in, len );
+        wc->len += len;
+    }
+
+    return error_flag;
+}
+
+SRAM_RETVAL sram_wc_flush ( sram_t *ctx, sram_wc_t *wc )
+{
+    SRAM_RETVAL error_flag;
+
+    if ( 0 == wc->len )
+    {
+        return SRAM_OK;
+    }
+
+    error_flag = sram_write_data( ctx, wc->address, wc->buf, wc->len );
+    wc->len = 0;
+
+    return error_flag;
+}
+
+SRAM_RETVAL sram_wc_read ( sram_t *ctx, sram_wc_t *wc, uint32_t reg_address, uint8_t *data_out, uint32_t len )
+{
+    if ( ( wc->len > 0 ) && ( reg_address < ( wc->address + wc->len ) ) && 
+         ( wc->address < ( reg_address + len ) ) )
+    {
+        if ( SRAM_OK != sram_wc_flush( ctx, wc ) )
+        {
+            return SRAM_ERROR;
+        }
+    }
+
+    return sram_read_data( ctx, reg_address, data_out, len );
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static void dev_comm_delay ( void )
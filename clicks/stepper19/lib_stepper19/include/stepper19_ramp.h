@@ -0,0 +1,235 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file stepper19_ramp.h
+ * @brief This file contains step generator with ramps for Stepper 19 Click Driver.
+ * @details Steps are issued from a periodic tick instead of busy waits, so moves
+ * run in the background. Speed follows a trapezoidal or S-curve profile planned
+ * once into an interval table, the tick only adds and shifts.
+ */
+
+#ifndef STEPPER19_RAMP_H
+#define STEPPER19_RAMP_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "stepper19.h"
+
+/*!
+ * @addtogroup stepper19 Stepper 19 Click Driver
+ * @brief API for configuring and manipulating Stepper 19 Click driver.
+ * @{
+ */
+
+/**
+ * @defgroup stepper19_ramp Stepper 19 Ramp Settings
+ * @brief Settings for step generator of Stepper 19 Click driver.
+ */
+
+/**
+ * @addtogroup stepper19_ramp
+ * @{
+ */
+
+/**
+ * @brief Stepper 19 ramp profile setting.
+ * @details Shape of the speed profile.
+ */
+#define STEPPER19_RAMP_TRAPEZOID                 0
+#define STEPPER19_RAMP_S_CURVE                   1
+
+/**
+ * @brief Stepper 19 ramp default setting.
+ * @details Default start speed and maximal speed in steps per second and
+ * acceleration in steps per second squared.
+ */
+#define STEPPER19_RAMP_DEFAULT_V_START           100
+#define STEPPER19_RAMP_DEFAULT_V_MAX             1000
+#define STEPPER19_RAMP_DEFAULT_ACCEL             2000
+
+/**
+ * @brief Stepper 19 ramp table size.
+ * @details Number of intervals in the ramp table. Longer ramps use one interval
+ * for 2, 4, 8... steps.
+ * @note Increase table size if needed.
+ */
+#define STEPPER19_RAMP_TABLE_SIZE                64
+
+/*! @} */ // stepper19_ramp
+
+/**
+ * @brief Stepper 19 step generator object.
+ * @details Step generator definition of Stepper 19 Click driver.
+ */
+typedef struct
+{
+    stepper19_t *ctx;                    /**< Click context object. */
+    uint32_t tick_hz;                   /**< Tick frequency. */
+
+    // Profile
+    uint32_t table[ STEPPER19_RAMP_TABLE_SIZE ];     /**< Ramp intervals in ticks, Q24.8. */
+    uint32_t cruise;                    /**< Interval at maximal speed in ticks, Q24.8. */
+    uint32_t ramp_steps;                /**< Steps from start to maximal speed. */
+    uint8_t shift;                      /**< Log2 of steps per table entry. */
+
+    // Move
+    volatile uint8_t busy;              /**< Move in progress. */
+    volatile uint8_t stop_f;            /**< Stop requested. */
+    int8_t dir_step;                    /**< Position change per step. */
+    uint8_t pin_high;                   /**< STEP pin is high. */
+    uint32_t steps;                     /**< Steps of the move. */
+    uint32_t done;                      /**< Steps made. */
+    uint32_t ticks;                     /**< Ticks to the next step. */
+    uint8_t frac;                       /**< Fraction of a tick carried to the next step. */
+    volatile int32_t position;          /**< Position in steps. */
+
+} stepper19_ramp_t;
+
+/**
+ * @brief Stepper 19 step generator initialization function.
+ * @details This function initializes the step generator with the default profile.
+ * The STEP and DIR pins have to be driven from GPIO, not from the port expander.
+ * @param[out] ramp : Step generator object.
+ * See #stepper19_ramp_t object definition for detailed explanation.
+ * @param[in] ctx : Initialized Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @param[in] tick_hz : Frequency stepper19_ramp_tick( ) is called at.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, STEP and DIR pins on the port expander.
+ * See #err_t definition for detailed explanation.
+ * @note The driver stage has to be enabled by the application, see stepper19_enable_device( )
+ * and stepper19_set_toff( ).
+ */
+err_t stepper19_ramp_init ( stepper19_ramp_t *ramp, stepper19_t *ctx, uint32_t tick_hz );
+
+/**
+ * @brief Stepper 19 set profile function.
+ * @details This function plans the ramp into the interval table. The floating point
+ * math is done here once, not per step.
+ * @param[in] ramp : Step generator object.
+ * See #stepper19_ramp_t object definition for detailed explanation.
+ * @param[in] profile : @li @c 0 - Trapezoidal, constant acceleration,
+ *                      @li @c 1 - S-curve, acceleration rising and falling smoothly.
+ * @param[in] v_start : Start and stop speed in steps per second.
+ * @param[in] v_max : Maximal speed in steps per second, up to half of the tick frequency.
+ * @param[in] accel : Acceleration in steps per second squared, peak value for S-curve.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, wrong parameters or move in progress.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t stepper19_ramp_set_profile ( stepper19_ramp_t *ramp, uint8_t profile, uint32_t v_start, 
+                                   uint32_t v_max, uint32_t accel );
+
+/**
+ * @brief Stepper 19 move function.
+ * @details This function starts a relative move and returns at once.
+ * @param[in] ramp : Step generator object.
+ * See #stepper19_ramp_t object definition for detailed explanation.
+ * @param[in] steps : Number of steps, negative for counter clockwise.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, move in progress.
+ * See #err_t definition for detailed explanation.
+ * @note Moves shorter than two ramps reach a lower peak speed.
+ */
+err_t stepper19_ramp_move ( stepper19_ramp_t *ramp, int32_t steps );
+
+/**
+ * @brief Stepper 19 move to function.
+ * @details This function starts a move to an absolute position and returns at once.
+ * @param[in] ramp : Step generator object.
+ * See #stepper19_ramp_t object definition for detailed explanation.
+ * @param[in] position : Target position in steps.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, move in progress.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t stepper19_ramp_move_to ( stepper19_ramp_t *ramp, int32_t position );
+
+/**
+ * @brief Stepper 19 stop function.
+ * @details This function decelerates the move in progress to a stop along the ramp.
+ * @param[in] ramp : Step generator object.
+ * See #stepper19_ramp_t object definition for detailed explanation.
+ * @return None.
+ * @note None.
+ */
+void stepper19_ramp_stop ( stepper19_ramp_t *ramp );
+
+/**
+ * @brief Stepper 19 busy check function.
+ * @details This function checks if a move is in progress.
+ * @param[in] ramp : Step generator object.
+ * See #stepper19_ramp_t object definition for detailed explanation.
+ * @return @li @c 0 - Idle,
+ *         @li @c 1 - Move in progress.
+ * @note None.
+ */
+uint8_t stepper19_ramp_is_busy ( stepper19_ramp_t *ramp );
+
+/**
+ * @brief Stepper 19 get position function.
+ * @details This function returns the current position.
+ * @param[in] ramp : Step generator object.
+ * See #stepper19_ramp_t object definition for detailed explanation.
+ * @return Position in steps.
+ * @note None.
+ */
+int32_t stepper19_ramp_get_position ( stepper19_ramp_t *ramp );
+
+/**
+ * @brief Stepper 19 set position function.
+ * @details This function sets the current position, e.g. zero after homing.
+ * @param[in] ramp : Step generator object.
+ * See #stepper19_ramp_t object definition for detailed explanation.
+ * @param[in] position : New position in steps.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, move in progress.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t stepper19_ramp_set_position ( stepper19_ramp_t *ramp, int32_t position );
+
+/**
+ * @brief Stepper 19 tick function.
+ * @details This function issues the steps. Call it from a periodic timer interrupt
+ * at the frequency given to stepper19_ramp_init( ). A STEP pulse lasts one tick.
+ * @param[in] ramp : Step generator object.
+ * See #stepper19_ramp_t object definition for detailed explanation.
+ * @return @li @c 0 - Idle,
+ *         @li @c 1 - Move in progress.
+ * @note The cost per tick is constant, without divisions.
+ */
+uint8_t stepper19_ramp_tick ( stepper19_ramp_t *ramp );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // STEPPER19_RAMP_H
+
+/*! @} */ // stepper19
+
+// ------------------------------------------------------------------------ END
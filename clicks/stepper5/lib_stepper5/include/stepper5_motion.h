@@ -0,0 +1,286 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file stepper5_motion.h
+ * @brief This file contains multi-axis motion planner for Stepper 5 Click Driver.
+ * @details Linear moves of up to four axes are queued and executed as one path.
+ * Axes step together by integer DDA, the queue is replanned on every move so
+ * the speed is blended through the junctions instead of stopping at each one.
+ * STEP and DIR pins of all axes are driven from one periodic tick, an axis may
+ * be any Click with STEP and DIR pins, e.g. Silent Step or Multi Stepper TB67S109.
+ */
+
+#ifndef STEPPER5_MOTION_H
+#define STEPPER5_MOTION_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "stepper5.h"
+
+/*!
+ * @addtogroup stepper5 Stepper 5 Click Driver
+ * @brief API for configuring and manipulating Stepper 5 Click driver.
+ * @{
+ */
+
+/**
+ * @defgroup stepper5_motion Stepper 5 Motion Settings
+ * @brief Settings for motion planner of Stepper 5 Click driver.
+ */
+
+/**
+ * @addtogroup stepper5_motion
+ * @{
+ */
+
+/**
+ * @brief Stepper 5 motion size setting.
+ * @details Maximal number of axes and number of moves in the queue.
+ * @note Queue size has to be a power of two.
+ */
+#define STEPPER5_MOTION_MAX_AXES                4
+#define STEPPER5_MOTION_QUEUE_SIZE              16
+
+/**
+ * @brief Stepper 5 motion default setting.
+ * @details Default start and stop speed in steps per second, acceleration in
+ * steps per second squared and junction deviation in steps.
+ */
+#define STEPPER5_MOTION_DEFAULT_V_MIN           100
+#define STEPPER5_MOTION_DEFAULT_ACCEL           2000
+#define STEPPER5_MOTION_DEFAULT_JUNCTION_DEV    4
+
+/*! @} */ // stepper5_motion
+
+/**
+ * @brief Stepper 5 motion axis object.
+ * @details Axis definition of Stepper 5 motion planner.
+ */
+typedef struct
+{
+    digital_out_t *step;                /**< Step signal pin. */
+    digital_out_t *dir;                 /**< Direction control pin. */
+    uint8_t dir_pos;                    /**< Direction pin state for positive moves. */
+
+} stepper5_motion_axis_t;
+
+/**
+ * @brief Stepper 5 motion block object.
+ * @details One linear move in the queue of Stepper 5 motion planner.
+ */
+typedef struct
+{
+    // Geometry, fixed once queued
+    uint32_t steps[ STEPPER5_MOTION_MAX_AXES ];     /**< Steps per axis. */
+    uint32_t events;                    /**< Steps of the longest axis. */
+    uint8_t dir_bits;                   /**< Axes moving in negative direction. */
+    float length;                       /**< Path length in steps. */
+    float ratio;                        /**< Steps of the longest axis per path step. */
+
+    // Plan, path speed squared
+    float nominal_sq;                   /**< Requested speed. */
+    float max_entry_sq;                 /**< Junction speed limit. */
+    float entry_sq;                     /**< Planned entry speed. */
+
+    // Profile for the tick, longest axis steps per tick, Q0.32
+    volatile uint8_t seq;               /**< Profile sequence, odd while it is written. */
+    uint32_t start_rate;                /**< Start speed after a stop. */
+    uint32_t nominal_rate;              /**< Cruise speed. */
+    uint32_t exit_rate;                 /**< Exit speed. */
+    uint32_t accel_rate;                /**< Speed change per tick, Q0.40. */
+    uint32_t decel_after;               /**< Step to start deceleration at. */
+    uint32_t scale;                     /**< Speed scale from previous block, Q16.16. */
+
+} stepper5_motion_block_t;
+
+/**
+ * @brief Stepper 5 motion planner object.
+ * @details Motion planner definition of Stepper 5 Click driver.
+ */
+typedef struct
+{
+    stepper5_motion_axis_t axis[ STEPPER5_MOTION_MAX_AXES ];    /**< Axes. */
+    uint8_t n_axes;                     /**< Number of axes. */
+    uint32_t tick_hz;                   /**< Tick frequency. */
+
+    // Limits
+    float v_min_sq;                     /**< Start and stop speed squared. */
+    float accel;                        /**< Acceleration along the path. */
+    float junction_dev;                 /**< Junction deviation. */
+
+    // Queue
+    stepper5_motion_block_t queue[ STEPPER5_MOTION_QUEUE_SIZE ];    /**< Moves. */
+    volatile uint8_t head;              /**< Next free block, written by planner. */
+    volatile uint8_t tail;              /**< Block in execution, written by tick. */
+    float prev_unit[ STEPPER5_MOTION_MAX_AXES ];    /**< Direction of the last move. */
+    int32_t target[ STEPPER5_MOTION_MAX_AXES ];     /**< Position at the end of the queue. */
+
+    // Execution
+    stepper5_motion_block_t *current;   /**< Block in execution, NULL between blocks. */
+    uint32_t counter[ STEPPER5_MOTION_MAX_AXES ];   /**< DDA counters. */
+    uint32_t events;                    /**< Steps of the longest axis made. */
+    uint32_t decel_after;               /**< Step to start deceleration at. */
+    uint8_t seq;                        /**< Profile sequence of the block in execution. */
+    uint32_t rate;                      /**< Speed, Q0.32. */
+    uint32_t nominal_rate;              /**< Cruise speed, Q0.32. */
+    uint32_t exit_rate;                 /**< Exit speed, Q0.32. */
+    uint32_t accel_rate;                /**< Speed change per tick, Q0.40. */
+    uint32_t accel_frac;                /**< Speed change carried to the next tick, Q0.40. */
+    uint32_t phase;                     /**< Step phase, Q0.32. */
+    uint8_t pins_high;                  /**< Axes with STEP pin high. */
+    volatile int32_t position[ STEPPER5_MOTION_MAX_AXES ];  /**< Position in steps. */
+
+} stepper5_motion_t;
+
+/**
+ * @brief Stepper 5 motion planner initialization function.
+ * @details This function initializes the motion planner with no axes and the default limits.
+ * @param[out] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] tick_hz : Frequency stepper5_motion_tick( ) is called at.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t stepper5_motion_init ( stepper5_motion_t *motion, uint32_t tick_hz );
+
+/**
+ * @brief Stepper 5 add axis function.
+ * @details This function adds an axis, axes are numbered in the order they are added.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] step : Initialized STEP pin of the axis.
+ * @param[in] dir : Initialized DIR pin of the axis.
+ * @param[in] dir_pos : DIR pin state for positive moves.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no free axis or queue not empty.
+ * See #err_t definition for detailed explanation.
+ * @note The driver stages have to be configured and enabled by the application.
+ */
+err_t stepper5_motion_add_axis ( stepper5_motion_t *motion, digital_out_t *step, 
+                                 digital_out_t *dir, uint8_t dir_pos );
+
+/**
+ * @brief Stepper 5 set limits function.
+ * @details This function sets the limits used to plan the moves queued after the call.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] v_min : Start and stop speed in steps per second.
+ * @param[in] accel : Acceleration along the path in steps per second squared.
+ * @param[in] junction_dev : Junction deviation in steps, higher values pass corners faster.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, wrong parameters or queue not empty.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t stepper5_motion_set_limits ( stepper5_motion_t *motion, uint32_t v_min, 
+                                   uint32_t accel, uint32_t junction_dev );
+
+/**
+ * @brief Stepper 5 move function.
+ * @details This function queues a linear move relative to the end of the queue and
+ * replans the queue. It returns at once.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] steps : Steps per axis, one value for each axis.
+ * @param[in] speed : Speed along the path in steps per second, up to half of the tick frequency.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, wrong speed or queue full.
+ * See #err_t definition for detailed explanation.
+ * @note Retry later if the queue is full.
+ */
+err_t stepper5_motion_move ( stepper5_motion_t *motion, int32_t *steps, uint32_t speed );
+
+/**
+ * @brief Stepper 5 move to function.
+ * @details This function queues a linear move to an absolute position.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] position : Target position per axis, one value for each axis.
+ * @param[in] speed : Speed along the path in steps per second, up to half of the tick frequency.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, wrong speed or queue full.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t stepper5_motion_move_to ( stepper5_motion_t *motion, int32_t *position, uint32_t speed );
+
+/**
+ * @brief Stepper 5 motion busy check function.
+ * @details This function checks if moves are queued or in progress.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @return @li @c 0 - Idle,
+ *         @li @c 1 - Moves in progress.
+ * @note None.
+ */
+uint8_t stepper5_motion_is_busy ( stepper5_motion_t *motion );
+
+/**
+ * @brief Stepper 5 motion get position function.
+ * @details This function returns the current position of an axis.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] axis : Axis number.
+ * @return Position in steps.
+ * @note None.
+ */
+int32_t stepper5_motion_get_position ( stepper5_motion_t *motion, uint8_t axis );
+
+/**
+ * @brief Stepper 5 motion set position function.
+ * @details This function sets the current position of all axes, e.g. zero after homing.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] position : New position per axis, one value for each axis.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, moves in progress.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t stepper5_motion_set_position ( stepper5_motion_t *motion, int32_t *position );
+
+/**
+ * @brief Stepper 5 motion tick function.
+ * @details This function issues the steps of all axes. Call it from a periodic timer
+ * interrupt at the frequency given to stepper5_motion_init( ). A STEP pulse lasts one tick.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @return @li @c 0 - Idle,
+ *         @li @c 1 - Move in progress.
+ * @note The cost per tick is bounded by the number of axes, with 32-bit arithmetic and
+ * without divisions.
+ */
+uint8_t stepper5_motion_tick ( stepper5_motion_t *motion );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // STEPPER5_MOTION_H
+
+/*! @} */ // stepper5
+
+// ------------------------------------------------------------------------ END
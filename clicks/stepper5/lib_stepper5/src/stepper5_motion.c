@@ -0,0 +1,546 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file stepper5_motion.c
+ * @brief Stepper 5 Click Motion Planner.
+ */
+
+#include "stepper5_motion.h"
+#include "math.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+/**
+ * @brief Stepper 5 motion queue index mask.
+ */
+#define STEPPER5_MOTION_QUEUE_MASK              ( STEPPER5_MOTION_QUEUE_SIZE - 1 )
+
+/**
+ * @brief Stepper 5 motion rate of one step per tick, Q0.32.
+ */
+#define STEPPER5_MOTION_RATE_ONE                4294967296.0f
+
+/**
+ * @brief Stepper 5 motion acceleration of one step per tick squared, Q0.40.
+ * @details The low bits below the rate resolution are carried over from tick to tick.
+ */
+#define STEPPER5_MOTION_ACCEL_ONE               1099511627776.0f
+#define STEPPER5_MOTION_ACCEL_MAX               4294967040.0f
+#define STEPPER5_MOTION_ACCEL_FRAC_BITS         8
+#define STEPPER5_MOTION_ACCEL_FRAC_MASK         ( ( 1ul << STEPPER5_MOTION_ACCEL_FRAC_BITS ) - 1 )
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+/**
+ * @brief Stepper 5 rate function.
+ * @details This function converts a speed of the longest axis to steps per tick.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] speed : Speed in steps per second.
+ * @return Steps per tick, Q0.32.
+ * @note None.
+ */
+static uint32_t stepper5_motion_rate ( stepper5_motion_t *motion, float speed );
+
+/**
+ * @brief Stepper 5 prepare function.
+ * @details This function turns the planned entry and exit speed of a block into
+ * the profile used by the tick.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] blk : Block to prepare.
+ * @param[in] exit_sq : Exit speed squared along the path.
+ * @return None.
+ * @note None.
+ */
+static void stepper5_motion_prepare ( stepper5_motion_t *motion, stepper5_motion_block_t *blk, float exit_sq );
+
+/**
+ * @brief Stepper 5 plan function.
+ * @details This function replans the entry speeds of the queue after a block is added,
+ * the backward pass limits each entry to what decelerates into the next one, the forward
+ * pass to what accelerates from the previous one.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] newest : Index of the block added.
+ * @return None.
+ * @note None.
+ */
+static void stepper5_motion_plan ( stepper5_motion_t *motion, uint8_t newest );
+
+/**
+ * @brief Stepper 5 refresh function.
+ * @details This function takes the exit speed and the deceleration point of the block
+ * in execution again once the planner has raised them for a block queued behind it.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] blk : Block in execution.
+ * @return None.
+ * @note Called from the tick, the profile is skipped while the planner writes it.
+ */
+static void stepper5_motion_refresh ( stepper5_motion_t *motion, stepper5_motion_block_t *blk );
+
+/**
+ * @brief Stepper 5 load function.
+ * @details This function starts the execution of a block, sets the DIR pins and
+ * carries the speed over from the previous block.
+ * @param[in] motion : Motion planner object.
+ * See #stepper5_motion_t object definition for detailed explanation.
+ * @param[in] blk : Block to start.
+ * @return None.
+ * @note None.
+ */
+static void stepper5_motion_load ( stepper5_motion_t *motion, stepper5_motion_block_t *blk );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+err_t stepper5_motion_init ( stepper5_motion_t *motion, uint32_t tick_hz )
+{
+    uint8_t cnt = 0;
+
+    if ( 0 == tick_hz )
+    {
+        return STEPPER5_ERROR;
+    }
+
+    motion->tick_hz = tick_hz;
+    motion->n_axes = 0;
+    motion->head = 0;
+    motion->tail = 0;
+    motion->current = NULL;
+    motion->rate = 0;
+    motion->accel_frac = 0;
+    motion->phase = 0;
+    motion->pins_high = 0;
+    for ( cnt = 0; cnt < STEPPER5_MOTION_MAX_AXES; cnt++ )
+    {
+        motion->position[ cnt ] = 0;
+        motion->target[ cnt ] = 0;
+    }
+    for ( cnt = 0; cnt < STEPPER5_MOTION_QUEUE_SIZE; cnt++ )
+    {
+        motion->queue[ cnt ].ratio = 1.0f;
+        motion->queue[ cnt ].seq = 0;
+    }
+    return stepper5_motion_set_limits ( motion, STEPPER5_MOTION_DEFAULT_V_MIN, STEPPER5_MOTION_DEFAULT_ACCEL, 
+                                        STEPPER5_MOTION_DEFAULT_JUNCTION_DEV );
+}
+
+err_t stepper5_motion_add_axis ( stepper5_motion_t *motion, digital_out_t *step, 
+                                 digital_out_t *dir, uint8_t dir_pos )
+{
+    if ( ( motion->n_axes >= STEPPER5_MOTION_MAX_AXES ) || ( motion->head != motion->tail ) )
+    {
+        return STEPPER5_ERROR;
+    }
+    motion->axis[ motion->n_axes ].step = step;
+    motion->axis[ motion->n_axes ].dir = dir;
+    motion->axis[ motion->n_axes ].dir_pos = dir_pos;
+    digital_out_low ( step );
+    motion->n_axes++;
+    return STEPPER5_OK;
+}
+
+err_t stepper5_motion_set_limits ( stepper5_motion_t *motion, uint32_t v_min, 
+                                   uint32_t accel, uint32_t junction_dev )
+{
+    if ( ( 0 == v_min ) || ( 0 == accel ) || ( ( v_min * 2 ) > motion->tick_hz ) || 
+         ( motion->head != motion->tail ) )
+    {
+        return STEPPER5_ERROR;
+    }
+    motion->v_min_sq = ( float ) v_min * v_min;
+    motion->accel = ( float ) accel;
+    motion->junction_dev = ( float ) junction_dev;
+    return STEPPER5_OK;
+}
+
+err_t stepper5_motion_move ( stepper5_motion_t *motion, int32_t *steps, uint32_t speed )
+{
+    stepper5_motion_block_t *blk = NULL;
+    stepper5_motion_block_t *prev = NULL;
+    float unit[ STEPPER5_MOTION_MAX_AXES ] = { 0 };
+    float length = 0;
+    float cos_theta = 0;
+    float sin_half = 0;
+    float junction_sq = 0;
+    uint8_t head = motion->head;
+    uint8_t next = ( head + 1 ) & STEPPER5_MOTION_QUEUE_MASK;
+    uint8_t cnt = 0;
+
+    if ( ( 0 == speed ) || ( ( speed * 2 ) > motion->tick_hz ) || ( next == motion->tail ) )
+    {
+        return STEPPER5_ERROR;
+    }
+
+    blk = &motion->queue[ head ];
+    prev = &motion->queue[ ( head - 1 ) & STEPPER5_MOTION_QUEUE_MASK ];
+    blk->events = 0;
+    blk->dir_bits = 0;
+    for ( cnt = 0; cnt < motion->n_axes; cnt++ )
+    {
+        if ( steps[ cnt ] < 0 )
+        {
+            blk->steps[ cnt ] = 0u - ( uint32_t ) steps[ cnt ];
+            blk->dir_bits |= ( 1 << cnt );
+        }
+        else
+        {
+            blk->steps[ cnt ] = ( uint32_t ) steps[ cnt ];
+        }
+        if ( blk->steps[ cnt ] > blk->events )
+        {
+            blk->events = blk->steps[ cnt ];
+        }
+        length += ( float ) steps[ cnt ] * steps[ cnt ];
+    }
+    if ( 0 == blk->events )
+    {
+        return STEPPER5_OK;
+    }
+
+    blk->length = sqrt ( length );
+    blk->ratio = blk->events / blk->length;
+    blk->scale = ( uint32_t ) ( blk->ratio / prev->ratio * 65536.0f + 0.5f );
+    blk->nominal_sq = ( float ) speed * speed;
+    if ( blk->nominal_sq < motion->v_min_sq )
+    {
+        blk->nominal_sq = motion->v_min_sq;
+    }
+    for ( cnt = 0; cnt < motion->n_axes; cnt++ )
+    {
+        unit[ cnt ] = steps[ cnt ] / blk->length;
+        cos_theta -= motion->prev_unit[ cnt ] * unit[ cnt ];
+    }
+
+    // Junction speed from the deviation of a circle tangent to both moves,
+    // straight joins keep the speed and reversals stop
+    blk->max_entry_sq = motion->v_min_sq;
+    if ( ( head != motion->tail ) && ( cos_theta < 0.999999f ) )
+    {
+        blk->max_entry_sq = ( blk->nominal_sq < prev->nominal_sq ) ? blk->nominal_sq : prev->nominal_sq;
+        if ( cos_theta > -0.999999f )
+        {
+            sin_half = sqrt ( 0.5f * ( 1.0f - cos_theta ) );
+            junction_sq = motion->accel * motion->junction_dev * sin_half / ( 1.0f - sin_half );
+            if ( junction_sq < blk->max_entry_sq )
+            {
+                blk->max_entry_sq = junction_sq;
+            }
+        }
+        if ( blk->max_entry_sq < motion->v_min_sq )
+        {
+            blk->max_entry_sq = motion->v_min_sq;
+        }
+    }
+    blk->entry_sq = blk->max_entry_sq;
+
+    for ( cnt = 0; cnt < motion->n_axes; cnt++ )
+    {
+        motion->prev_unit[ cnt ] = unit[ cnt ];
+        motion->target[ cnt ] += steps[ cnt ];
+    }
+    stepper5_motion_plan ( motion, head );
+
+    // Publish last, the tick takes the block from here
+    motion->head = next;
+    return STEPPER5_OK;
+}
+
+err_t stepper5_motion_move_to ( stepper5_motion_t *motion, int32_t *position, uint32_t speed )
+{
+    int32_t steps[ STEPPER5_MOTION_MAX_AXES ] = { 0 };
+    uint8_t cnt = 0;
+
+    for ( cnt = 0; cnt < motion->n_axes; cnt++ )
+    {
+        steps[ cnt ] = position[ cnt ] - motion->target[ cnt ];
+    }
+    return stepper5_motion_move ( motion, steps, speed );
+}
+
+uint8_t stepper5_motion_is_busy ( stepper5_motion_t *motion )
+{
+    return ( motion->head != motion->tail );
+}
+
+int32_t stepper5_motion_get_position ( stepper5_motion_t *motion, uint8_t axis )
+{
+    if ( axis >= STEPPER5_MOTION_MAX_AXES )
+    {
+        return 0;
+    }
+    return motion->position[ axis ];
+}
+
+err_t stepper5_motion_set_position ( stepper5_motion_t *motion, int32_t *position )
+{
+    uint8_t cnt = 0;
+
+    if ( motion->head != motion->tail )
+    {
+        return STEPPER5_ERROR;
+    }
+    for ( cnt = 0; cnt < motion->n_axes; cnt++ )
+    {
+        motion->position[ cnt ] = position[ cnt ];
+        motion->target[ cnt ] = position[ cnt ];
+    }
+    return STEPPER5_OK;
+}
+
+uint8_t stepper5_motion_tick ( stepper5_motion_t *motion )
+{
+    stepper5_motion_block_t *blk = motion->current;
+    uint32_t phase = 0;
+    uint32_t delta = 0;
+    uint8_t cnt = 0;
+
+    if ( motion->pins_high )
+    {
+        for ( cnt = 0; cnt < motion->n_axes; cnt++ )
+        {
+            if ( motion->pins_high & ( 1 << cnt ) )
+            {
+                digital_out_low ( motion->axis[ cnt ].step );
+            }
+        }
+        motion->pins_high = 0;
+    }
+
+    if ( NULL == blk )
+    {
+        if ( motion->tail == motion->head )
+        {
+            motion->rate = 0;
+            return 0;
+        }
+        // Block is being replanned, take it on the next tick
+        blk = &motion->queue[ motion->tail ];
+        if ( !( blk->seq & 1 ) )
+        {
+            stepper5_motion_load ( motion, blk );
+        }
+        return 1;
+    }
+
+    if ( blk->seq != motion->seq )
+    {
+        stepper5_motion_refresh ( motion, blk );
+    }
+
+    // Speed change of this tick, the bits below the rate resolution carry over
+    delta = motion->accel_frac + motion->accel_rate;
+    motion->accel_frac = delta & STEPPER5_MOTION_ACCEL_FRAC_MASK;
+    delta >>= STEPPER5_MOTION_ACCEL_FRAC_BITS;
+
+    if ( motion->events < motion->decel_after )
+    {
+        if ( motion->rate < motion->nominal_rate )
+        {
+            motion->rate += delta;
+            if ( motion->rate > motion->nominal_rate )
+            {
+                motion->rate = motion->nominal_rate;
+            }
+        }
+    }
+    else if ( motion->rate > ( motion->exit_rate + delta ) )
+    {
+        motion->rate -= delta;
+    }
+    else if ( motion->rate > motion->exit_rate )
+    {
+        motion->rate = motion->exit_rate;
+    }
+
+    // Step of the longest axis on phase overflow, the others follow by DDA
+    phase = motion->phase + motion->rate;
+    if ( phase >= motion->phase )
+    {
+        motion->phase = phase;
+        return 1;
+    }
+    motion->phase = phase;
+
+    for ( cnt = 0; cnt < motion->n_axes; cnt++ )
+    {
+        motion->counter[ cnt ] += blk->steps[ cnt ];
+        if ( motion->counter[ cnt ] >= blk->events )
+        {
+            motion->counter[ cnt ] -= blk->events;
+            digital_out_high ( motion->axis[ cnt ].step );
+            motion->pins_high |= ( 1 << cnt );
+            motion->position[ cnt ] += ( blk->dir_bits & ( 1 << cnt ) ) ? -1 : 1;
+        }
+    }
+
+    if ( ++motion->events >= blk->events )
+    {
+        motion->current = NULL;
+        motion->tail = ( motion->tail + 1 ) & STEPPER5_MOTION_QUEUE_MASK;
+    }
+    return 1;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint32_t stepper5_motion_rate ( stepper5_motion_t *motion, float speed )
+{
+    return ( uint32_t ) ( speed / motion->tick_hz * STEPPER5_MOTION_RATE_ONE );
+}
+
+static void stepper5_motion_prepare ( stepper5_motion_t *motion, stepper5_motion_block_t *blk, float exit_sq )
+{
+    float two_accel = 2.0f * motion->accel;
+    float accel_dist = ( blk->nominal_sq - blk->entry_sq ) / two_accel;
+    float decel_dist = ( blk->nominal_sq - exit_sq ) / two_accel;
+    float accel_rate = 0;
+    uint32_t decel_steps = 0;
+
+    // Nominal speed not reached, decelerate from where both ramps cross
+    if ( ( accel_dist + decel_dist ) > blk->length )
+    {
+        decel_dist = ( blk->length + ( blk->entry_sq - exit_sq ) / two_accel ) * 0.5f;
+        if ( decel_dist < 0 )
+        {
+            decel_dist = 0;
+        }
+        else if ( decel_dist > blk->length )
+        {
+            decel_dist = blk->length;
+        }
+    }
+    decel_steps = ( uint32_t ) ( decel_dist * blk->ratio + 0.5f );
+    if ( decel_steps > blk->events )
+    {
+        decel_steps = blk->events;
+    }
+
+    accel_rate = motion->accel * blk->ratio / motion->tick_hz / motion->tick_hz * STEPPER5_MOTION_ACCEL_ONE;
+    if ( accel_rate > STEPPER5_MOTION_ACCEL_MAX )
+    {
+        accel_rate = STEPPER5_MOTION_ACCEL_MAX;
+    }
+
+    // Odd sequence while writing, the tick may be executing this block
+    blk->seq++;
+    blk->start_rate = stepper5_motion_rate ( motion, sqrt ( motion->v_min_sq ) * blk->ratio );
+    blk->nominal_rate = stepper5_motion_rate ( motion, sqrt ( blk->nominal_sq ) * blk->ratio );
+    blk->exit_rate = stepper5_motion_rate ( motion, sqrt ( exit_sq ) * blk->ratio );
+    blk->accel_rate = ( uint32_t ) accel_rate;
+    blk->decel_after = blk->events - decel_steps;
+    blk->seq++;
+}
+
+static void stepper5_motion_plan ( stepper5_motion_t *motion, uint8_t newest )
+{
+    stepper5_motion_block_t *blk = NULL;
+    stepper5_motion_block_t *next = NULL;
+    float two_accel = 2.0f * motion->accel;
+    float entry_sq = 0;
+    float next_entry_sq = motion->v_min_sq;
+    uint8_t tail = motion->tail;
+    uint8_t idx = newest;
+
+    // Backward pass, the entry of the oldest block is already fixed
+    while ( idx != tail )
+    {
+        blk = &motion->queue[ idx ];
+        entry_sq = next_entry_sq + two_accel * blk->length;
+        blk->entry_sq = ( entry_sq < blk->max_entry_sq ) ? entry_sq : blk->max_entry_sq;
+        next_entry_sq = blk->entry_sq;
+        idx = ( idx - 1 ) & STEPPER5_MOTION_QUEUE_MASK;
+    }
+
+    // Forward pass, profiles are prepared once the exit is known
+    for ( idx = tail; idx != newest; idx = ( idx + 1 ) & STEPPER5_MOTION_QUEUE_MASK )
+    {
+        blk = &motion->queue[ idx ];
+        next = &motion->queue[ ( idx + 1 ) & STEPPER5_MOTION_QUEUE_MASK ];
+        entry_sq = blk->entry_sq + two_accel * blk->length;
+        if ( next->entry_sq > entry_sq )
+        {
+            next->entry_sq = entry_sq;
+        }
+        stepper5_motion_prepare ( motion, blk, next->entry_sq );
+    }
+    stepper5_motion_prepare ( motion, &motion->queue[ newest ], motion->v_min_sq );
+}
+
+static void stepper5_motion_refresh ( stepper5_motion_t *motion, stepper5_motion_block_t *blk )
+{
+    uint8_t seq = blk->seq;
+
+    // The planner runs below the tick, a profile seen unchanged here is complete
+    if ( seq & 1 )
+    {
+        return;
+    }
+    motion->decel_after = blk->decel_after;
+    motion->exit_rate = blk->exit_rate;
+    motion->seq = seq;
+}
+
+static void stepper5_motion_load ( stepper5_motion_t *motion, stepper5_motion_block_t *blk )
+{
+    uint8_t cnt = 0;
+
+    for ( cnt = 0; cnt < motion->n_axes; cnt++ )
+    {
+        motion->counter[ cnt ] = blk->events >> 1;
+        if ( blk->dir_bits & ( 1 << cnt ) )
+        {
+            digital_out_write ( motion->axis[ cnt ].dir, !motion->axis[ cnt ].dir_pos );
+        }
+        else
+        {
+            digital_out_write ( motion->axis[ cnt ].dir, motion->axis[ cnt ].dir_pos );
+        }
+    }
+    motion->events = 0;
+    motion->seq = blk->seq;
+    motion->decel_after = blk->decel_after;
+    motion->nominal_rate = blk->nominal_rate;
+    motion->exit_rate = blk->exit_rate;
+    motion->accel_rate = blk->accel_rate;
+
+    // Keep the path speed through the junction, start from the minimal speed after a stop,
+    // Q16.16 scale applied in halves so the product stays within 32 bits
+    if ( motion->rate )
+    {
+        motion->rate = ( motion->rate >> 16 ) * blk->scale + 
+                       ( ( ( motion->rate & 0xFFFFul ) * ( blk->scale >> 2 ) ) >> 14 );
+    }
+    else
+    {
+        motion->rate = blk->start_rate;
+    }
+    if ( motion->rate > motion->nominal_rate )
+    {
+        motion->rate = motion->nominal_rate;
+    }
+    motion->current = blk;
+}
+
+// ------------------------------------------------------------------------- END
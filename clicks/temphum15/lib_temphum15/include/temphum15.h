@@ -119,6 +119,16 @@ extern "C"{
 #define TEMPHUM15_MODE_MEDIUM_PRECISION                          0x01
 #define TEMPHUM15_MODE_LOW_PRECISION                             0x02
 
+/**
+ * @brief Temp&Hum 15 measurement time settings.
+ * @details Measurement duration in milliseconds for each precision mode of
+ * Temp&Hum 15 Click driver.
+ */
+
+#define TEMPHUM15_MEAS_TIME_HIGH_PRECISION_MS                    10
+#define TEMPHUM15_MEAS_TIME_MEDIUM_PRECISION_MS                  6
+#define TEMPHUM15_MEAS_TIME_LOW_PRECISION_MS                     3
+
 /*! @} */ // precision_mode
 
 /**
@@ -299,6 +309,53 @@ err_t temphum15_generic_read ( temphum15_t *ctx, uint8_t reg, uint8_t *rx_buf, u
  */
 err_t temphum15_get_temp_and_hum ( temphum15_t *ctx, uint8_t precision_mode, float *temp_val, float *hum_val );
 
+/**
+ * @brief Temp&Hum 15 start measurement function.
+ * @details This function sends the measurement command for the selected
+ * precision mode and returns without waiting for the conversion.
+ * @param[in] ctx : Click context object.
+ * See #temphum15_t object definition for detailed explanation.
+ * @param[in] precision_mode : Precision mode setting.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note The result is read by temphum15_read_measurement once
+ * temphum15_get_measurement_time has elapsed.
+ *
+ * @endcode
+ */
+err_t temphum15_start_measurement ( temphum15_t *ctx, uint8_t precision_mode );
+
+/**
+ * @brief Temp&Hum 15 get measurement time function.
+ * @details This function returns the measurement duration for the selected precision mode.
+ * @param[in] precision_mode : Precision mode setting.
+ * @return Measurement time in milliseconds.
+ * @note None.
+ *
+ * @endcode
+ */
+uint8_t temphum15_get_measurement_time ( uint8_t precision_mode );
+
+/**
+ * @brief Temp&Hum 15 read measurement function.
+ * @details This function reads temperature and humidity of the measurement
+ * started by temphum15_start_measurement.
+ * @param[in] ctx : Click context object.
+ * See #temphum15_t object definition for detailed explanation.
+ * @param[out] temp_val : Output temperature value.
+ * @param[out] hum_val : Output humidity value.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error or conversion still running.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ *
+ * @endcode
+ */
+err_t temphum15_read_measurement ( temphum15_t *ctx, float *temp_val, float *hum_val );
+
 /**
  * @brief Temp&Hum 15 soft reset function.
  * @details This function sends soft reset command to the sensor.
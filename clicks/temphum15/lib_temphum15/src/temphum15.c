@@ -114,23 +114,32 @@ err_t temphum15_generic_read ( temphum15_t *ctx, uint8_t reg, uint8_t *rx_buf, u
 
 err_t temphum15_get_temp_and_hum ( temphum15_t *ctx, uint8_t precision_mode, float *temp_val, float *hum_val ) {
     err_t status;
-    uint16_t rx_word;
-    uint8_t rx_buf[ 6 ];
-    uint8_t cmd;
-    uint8_t delay_sel;
     
-    status = TEMPHUM15_SUCCESS;
-    delay_sel = 0;
+    status = temphum15_start_measurement( ctx, precision_mode );
+    
+    if ( status != TEMPHUM15_SUCCESS ) {
+        return status;
+    }
+    
+    if ( precision_mode > TEMPHUM15_MODE_LOW_PRECISION ) {
+        precision_mode = TEMPHUM15_MODE_HIGH_PRECISION;
+    }
+    
+    ( *delay_ptr_arr[ precision_mode ] )( );
+    
+    return temphum15_read_measurement( ctx, temp_val, hum_val );
+}
+
+err_t temphum15_start_measurement ( temphum15_t *ctx, uint8_t precision_mode ) {
+    uint8_t cmd;
     
     switch ( precision_mode ) {
         case TEMPHUM15_MODE_MEDIUM_PRECISION: {
             cmd = TEMPHUM15_CMD_MEASURE_MEDIUM_PRECISION;
-            delay_sel++;
             break;
         }
         case TEMPHUM15_MODE_LOW_PRECISION: {
             cmd = TEMPHUM15_CMD_MEASURE_LOW_PRECISION;
-            delay_sel += 2;
             break;
         }
         default: {
@@ -138,15 +147,34 @@ err_t temphum15_get_temp_and_hum ( temphum15_t *ctx, uint8_t precision_mode, flo
         }
     }
     
-    status |= i2c_master_write( &ctx->i2c, &cmd, 1 );
-    
-    if ( status != TEMPHUM15_SUCCESS ) {
-        return status;
+    return i2c_master_write( &ctx->i2c, &cmd, 1 );
+}
+
+uint8_t temphum15_get_measurement_time ( uint8_t precision_mode ) {
+    switch ( precision_mode ) {
+        case TEMPHUM15_MODE_MEDIUM_PRECISION: {
+            return TEMPHUM15_MEAS_TIME_MEDIUM_PRECISION_MS;
+        }
+        case TEMPHUM15_MODE_LOW_PRECISION: {
+            return TEMPHUM15_MEAS_TIME_LOW_PRECISION_MS;
+        }
+        default: {
+            return TEMPHUM15_MEAS_TIME_HIGH_PRECISION_MS;
+        }
     }
+}
+
+err_t temphum15_read_measurement ( temphum15_t *ctx, float *temp_val, float *hum_val ) {
+    err_t status;
+    uint16_t rx_word;
+    uint8_t rx_buf[ 6 ];
     
-    ( *delay_ptr_arr[ delay_sel ] )( );
+    // The sensor does not acknowledge the read while the conversion is running
+    status = i2c_master_read( &ctx->i2c, rx_buf, 6 );
     
-    status |= i2c_master_read( &ctx->i2c, rx_buf, 6 );
+    if ( status != TEMPHUM15_SUCCESS ) {
+        return TEMPHUM15_ERROR;
+    }
     
     rx_word = rx_buf[ 0 ];
     rx_word <<= 8;
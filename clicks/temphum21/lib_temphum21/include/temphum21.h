@@ -120,6 +120,12 @@ extern "C"{
 #define TEMPHUM21_TEMP_OFFSET               40.0
 #define TEMPHUM21_HUM_RES                   100.0
 
+/**
+ * @brief TempHum 21 measurement time.
+ * @details Maximum measurement cycle duration in milliseconds of TempHum 21 Click driver.
+ */
+#define TEMPHUM21_MEAS_TIME_MS              40
+
 /**
  * @brief TempHum 21 alarm configuration values.
  * @details Specified alarm configuration values of TempHum 21 Click driver.
@@ -288,6 +294,22 @@ err_t temphum21_request_measurement ( temphum21_t *ctx );
  */
 err_t temphum21_read_measurement ( temphum21_t *ctx, float *temperature, float *humidity );
 
+/**
+ * @brief TempHum 21 fetch measurement function.
+ * @details This function reads temperature in Celsius and relative humidity in percents
+ * of the measurement requested by #temphum21_request_measurement without waiting.
+ * @param[in] ctx : Click context object.
+ * See #temphum21_t object definition for detailed explanation.
+ * @param[out] temperature : Temperature in Celsius.
+ * @param[out] humidity : Relative humidity in Percents.
+ * @return @li @c  0 - Success, valid data that has not been fetched since the last measurement cycle,
+ *         @li @c -1 - Error, stale data (the measurement cycle is not finished yet) or command mode.
+ * See #err_t definition for detailed explanation.
+ * @note Call it #TEMPHUM21_MEAS_TIME_MS after the request, so conversions of several sensors
+ * on the same bus can overlap.
+ */
+err_t temphum21_fetch_measurement ( temphum21_t *ctx, float *temperature, float *humidity );
+
 /**
  * @brief TempHum 21 get all pin function.
  * @details This function returns the alarm low (ALL) pin logic state.
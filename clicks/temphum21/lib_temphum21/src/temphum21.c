@@ -27,6 +27,19 @@
 
 #include "temphum21.h"
 
+/**
+ * @brief TempHum 21 read data function.
+ * @details This function reads temperature in Celsius and relative humidity in percents
+ * together with the status bits of the last measurement cycle.
+ * @param[in] ctx : Click context object.
+ * See #temphum21_t object definition for detailed explanation.
+ * @param[out] temperature : Temperature in Celsius.
+ * @param[out] humidity : Relative humidity in Percents.
+ * @return Status bits (TEMPHUM21_STATUS_x) or -1 on error.
+ * @note None.
+ */
+static err_t temphum21_read_data ( temphum21_t *ctx, float *temperature, float *humidity );
+
 void temphum21_cfg_setup ( temphum21_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -138,24 +151,26 @@ err_t temphum21_request_measurement ( temphum21_t *ctx )
 
 err_t temphum21_read_measurement ( temphum21_t *ctx, float *temperature, float *humidity )
 {
-    uint8_t data_buf[ 4 ] = { 0 };
-    uint16_t raw_data = 0;
     err_t error_flag = temphum21_request_measurement ( ctx );
     // The measurement cycle duration is typically 36.65ms for temperature and humidity readings.
     Delay_10ms ( );
     Delay_10ms ( );
     Delay_10ms ( );
     Delay_10ms ( );
-    error_flag |= i2c_master_read ( &ctx->i2c, data_buf, 4 );
-    raw_data = ( ( ( uint16_t ) data_buf[ 0 ] << 8 ) | data_buf[ 1 ] ) & TEMPHUM21_DATA_RES;
-    *humidity = ( float ) raw_data / TEMPHUM21_DATA_RES * TEMPHUM21_HUM_RES;
-    raw_data = ( ( ( uint16_t ) data_buf[ 2 ] << 6 ) | ( data_buf[ 3 ] >> 2 ) ) & TEMPHUM21_DATA_RES;
-    *temperature = ( float ) raw_data / TEMPHUM21_DATA_RES * TEMPHUM21_TEMP_RES - TEMPHUM21_TEMP_OFFSET;
-    if ( TEMPHUM21_OK == error_flag )
+    if ( TEMPHUM21_OK != error_flag )
     {
-        error_flag = data_buf[ 0 ] & TEMPHUM21_STATUS_BIT_MASK; // status bits
+        return error_flag;
     }
-    return error_flag; 
+    return temphum21_read_data ( ctx, temperature, humidity );
+}
+
+err_t temphum21_fetch_measurement ( temphum21_t *ctx, float *temperature, float *humidity )
+{
+    if ( TEMPHUM21_STATUS_NORMAL_OP != temphum21_read_data ( ctx, temperature, humidity ) )
+    {
+        return TEMPHUM21_ERROR;
+    }
+    return TEMPHUM21_OK;
 }
 
 uint8_t temphum21_get_all_pin ( temphum21_t *ctx )
@@ -236,4 +251,20 @@ err_t temphum21_exit_command_mode ( temphum21_t *ctx )
     return error_flag;
 }
 
+static err_t temphum21_read_data ( temphum21_t *ctx, float *temperature, float *humidity )
+{
+    uint8_t data_buf[ 4 ] = { 0 };
+    uint16_t raw_data = 0;
+    err_t error_flag = i2c_master_read ( &ctx->i2c, data_buf, 4 );
+    raw_data = ( ( ( uint16_t ) data_buf[ 0 ] << 8 ) | data_buf[ 1 ] ) & TEMPHUM21_DATA_RES;
+    *humidity = ( float ) raw_data / TEMPHUM21_DATA_RES * TEMPHUM21_HUM_RES;
+    raw_data = ( ( ( uint16_t ) data_buf[ 2 ] << 6 ) | ( data_buf[ 3 ] >> 2 ) ) & TEMPHUM21_DATA_RES;
+    *temperature = ( float ) raw_data / TEMPHUM21_DATA_RES * TEMPHUM21_TEMP_RES - TEMPHUM21_TEMP_OFFSET;
+    if ( TEMPHUM21_OK == error_flag )
+    {
+        error_flag = data_buf[ 0 ] & TEMPHUM21_STATUS_BIT_MASK; // status bits
+    }
+    return error_flag; 
+}
+
 // ------------------------------------------------------------------------- END
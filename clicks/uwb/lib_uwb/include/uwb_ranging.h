@@ -0,0 +1,252 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ * \brief This file contains the double-sided two-way ranging engine used with UWB Click driver.
+ *
+ * A tag sends POLL, the anchor answers with RESPONSE and the tag closes with
+ * FINAL, which carries the tag timestamps. The anchor computes the time of
+ * flight with the asymmetric formula, which cancels the clock drift of both
+ * devices, and sends it back in REPORT. Replies are scheduled with delayed TX
+ * relative to the RX timestamp, so the reply time does not depend on the host.
+ *
+ * \addtogroup uwb UWB Click Driver
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef UWB_RANGING_H
+#define UWB_RANGING_H
+
+#include "uwb.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup ranging_macros Ranging macros
+ * \{
+ */
+
+/**
+ * \defgroup ranging_role Ranging role
+ * \{
+ */
+#define UWB_RANGING_ROLE_TAG                    0
+#define UWB_RANGING_ROLE_ANCHOR                 1
+/** \} */
+
+/**
+ * \defgroup ranging_event Ranging event
+ * \{
+ */
+#define UWB_RANGING_EVENT_NONE                  0
+#define UWB_RANGING_EVENT_RANGE                 1
+#define UWB_RANGING_EVENT_ERROR                 2
+/** \} */
+
+/**
+ * \defgroup ranging_status Ranging status
+ * \{
+ */
+#define UWB_RANGING_STATUS_IDLE                 0
+#define UWB_RANGING_STATUS_OK                   1
+#define UWB_RANGING_STATUS_TIMEOUT              2
+#define UWB_RANGING_STATUS_RX_ERROR             3
+#define UWB_RANGING_STATUS_TX_LATE              4
+/** \} */
+
+/**
+ * \defgroup ranging_settings Ranging settings
+ * \{
+ */
+#define UWB_RANGING_DEFAULT_REPLY_US            3000
+#define UWB_RANGING_DEFAULT_RX_TIMEOUT_US       6000
+#define UWB_RANGING_DEFAULT_ANTENNA_DELAY       16436
+#define UWB_RANGING_BROADCAST                   0xFFFF
+#define UWB_RANGING_FRAME_SIZE                  24
+/** \} */
+
+/** \} */ // End group ranging_macros
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup ranging_type Ranging types
+ * \{
+ */
+
+/**
+ * @brief Ranging result definition, one per peer.
+ */
+typedef struct
+{
+    uint16_t address;                   /**< Short address of the peer. */
+    int32_t tof;                        /**< Time of flight in device time units of 15.65 ps. */
+    int32_t distance_mm;                /**< Distance in millimeters. */
+    volatile uint8_t status;            /**< Status of the last exchange, see ranging_status. */
+    volatile uint8_t updated;           /**< Incremented on every range computed. */
+
+} uwb_ranging_peer_t;
+
+/**
+ * @brief Ranging engine definition.
+ */
+typedef struct
+{
+    uwb_t *ctx;                         /**< UWB Click object. */
+    uint8_t role;                       /**< UWB_RANGING_ROLE_TAG or UWB_RANGING_ROLE_ANCHOR. */
+    uint16_t pan_id;                    /**< PAN ID of the network. */
+    uint16_t address;                   /**< Own short address. */
+
+    uint32_t reply_dly;                 /**< Reply delay in device time units. */
+    uint16_t rx_timeout;                /**< Receive timeout in 1.026 us units. */
+    uint16_t antenna_delay;             /**< TX and RX antenna delay in device time units. */
+    uint32_t sys_cfg;                   /**< System configuration without the receive timeout. */
+    uint8_t rx_wto;                     /**< Receive timeout enabled. */
+
+    uwb_ranging_peer_t *anchors;        /**< Anchors ranged by a tag in turn. */
+    uint8_t n_anchors;                  /**< Number of anchors. */
+    uint8_t index;                      /**< Next anchor to range. */
+    uwb_ranging_peer_t *active;         /**< Anchor of the exchange in progress. */
+    uwb_ranging_peer_t last;            /**< Last tag ranged by an anchor. */
+
+    uint8_t state;                      /**< Exchange state. */
+    uint8_t seq;                        /**< Frame sequence number. */
+    uint16_t peer;                      /**< Address of the peer in the exchange. */
+    uint64_t poll_rx;                   /**< POLL receive timestamp of an anchor. */
+    uint16_t late_cnt;                  /**< Replies not sent because the delayed TX time had passed. */
+
+    uint8_t frame[ UWB_RANGING_FRAME_SIZE ];    /**< Frame buffer. */
+
+} uwb_ranging_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+/**
+ * \defgroup ranging_function Ranging function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Ranging engine initialization function.
+ *
+ * @param rng        Ranging engine.
+ * @param ctx        Initialized UWB Click object.
+ * @param role       UWB_RANGING_ROLE_TAG or UWB_RANGING_ROLE_ANCHOR.
+ * @param pan_id     PAN ID of the network.
+ * @param address    Own short address.
+ *
+ * @details This function writes the antenna delays and the receive timeout,
+ * unmasks the receive and transmit done events on the QINT pin and, for an
+ * anchor, starts listening. The receive timeout only runs while a reply is
+ * expected, an idle anchor listens without it.
+ * @note Channel, data rate and preamble have to be set and tuned before,
+ * see uwb_set_transmit_type() and uwb_tune_config().
+ */
+void uwb_ranging_init ( uwb_ranging_t *rng, uwb_t *ctx, uint8_t role, uint16_t pan_id, uint16_t address );
+
+/**
+ * @brief Ranging timing function.
+ *
+ * @param rng            Ranging engine.
+ * @param reply_us       Delay from a received frame to the reply.
+ * @param rx_timeout_us  Time to wait for the reply after a frame is sent.
+ *
+ * @details This function sets the reply delay used by RESPONSE and FINAL. It has
+ * to cover the preamble of the reply and the time the host needs to read the
+ * frame and to write the reply over SPI. Shorter replies give more ranges per
+ * second and less error from the clock drift.
+ * @note rx_timeout_us has to be longer than reply_us plus the frame duration.
+ */
+void uwb_ranging_set_timing ( uwb_ranging_t *rng, uint16_t reply_us, uint16_t rx_timeout_us );
+
+/**
+ * @brief Antenna delay function.
+ *
+ * @param rng            Ranging engine.
+ * @param antenna_delay  Antenna delay in device time units.
+ *
+ * @details This function writes the TX and RX antenna delay, calibrated per device
+ * against a known distance.
+ */
+void uwb_ranging_set_antenna_delay ( uwb_ranging_t *rng, uint16_t antenna_delay );
+
+/**
+ * @brief Anchor table function.
+ *
+ * @param rng        Ranging engine.
+ * @param anchors    Anchors with the address set, results are stored in place.
+ * @param n_anchors  Number of anchors.
+ *
+ * @details This function sets the anchors a tag ranges in turn.
+ */
+void uwb_ranging_set_anchors ( uwb_ranging_t *rng, uwb_ranging_peer_t *anchors, uint8_t n_anchors );
+
+/**
+ * @brief Ranging start function.
+ *
+ * @param rng        Ranging engine.
+ *
+ * @returns UWB_OK or UWB_ERROR if the engine is not an idle tag with anchors.
+ *
+ * @details This function sends POLL to the next anchor of the table. The result
+ * is reported by uwb_ranging_process() once REPORT arrives.
+ */
+err_t uwb_ranging_start ( uwb_ranging_t *rng );
+
+/**
+ * @brief Ranging process function.
+ *
+ * @param rng        Ranging engine.
+ *
+ * @returns UWB_RANGING_EVENT_RANGE when a range is computed, UWB_RANGING_EVENT_ERROR
+ * when an exchange failed or UWB_RANGING_EVENT_NONE.
+ *
+ * @details This function services the QINT pin. It returns at once when the pin is
+ * low, otherwise it reads the event status, timestamps and frame in one SPI burst
+ * each and advances the exchange. Call it from the QINT rising edge interrupt for
+ * the shortest reply time, or as often as possible from the main loop.
+ */
+uint8_t uwb_ranging_process ( uwb_ranging_t *rng );
+
+/**
+ * @brief Distance function.
+ *
+ * @param tof        Time of flight in device time units.
+ *
+ * @returns Distance in millimeters.
+ *
+ * @details This function converts the time of flight to the distance.
+ */
+int32_t uwb_ranging_tof_to_mm ( int32_t tof );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _UWB_RANGING_H_
+
+/** \} */ // End ranging_function group
+/*! @} */
+// ------------------------------------------------------------------------- END
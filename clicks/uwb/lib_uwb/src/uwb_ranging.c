@@ -0,0 +1,594 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ */
+
+#include "uwb_ranging.h"
+
+// ------------------------------------------------------------- PRIVATE MACROS
+
+// System control bits
+#define RANGING_CTRL_TXSTRT         0x0002
+#define RANGING_CTRL_TXDLYS         0x0004
+#define RANGING_CTRL_TRXOFF         0x0040
+#define RANGING_CTRL_WAIT4RESP      0x0080
+#define RANGING_CTRL_RXENAB         0x0100
+
+// Event status bits
+#define RANGING_STATUS_RXFCG        0x00004000ul
+#define RANGING_STATUS_RX_GOOD      0x00006F00ul
+#define RANGING_STATUS_RX_ERR       0x24059000ul
+#define RANGING_STATUS_RX_TO        0x00220000ul
+#define RANGING_STATUS_TX_ALL       0x000000F8ul
+#define RANGING_STATUS_TXFRS        0x00000080ul
+#define RANGING_STATUS_HPDWARN      0x08000000ul
+
+// Receive wait timeout enable bit of the system configuration
+#define RANGING_SYS_CFG_RXWTOE      0x10000000ul
+
+// IEEE 802.15.4 data frame, PAN ID compression, short addresses
+#define RANGING_FC_LOW              0x41
+#define RANGING_FC_HIGH             0x88
+#define RANGING_HEADER_LEN          10
+#define RANGING_FCS_LEN             2
+#define RANGING_IDX_SEQ             2
+#define RANGING_IDX_PAN             3
+#define RANGING_IDX_DST             5
+#define RANGING_IDX_SRC             7
+#define RANGING_IDX_FUNC            9
+
+#define RANGING_FUNC_POLL           0x21
+#define RANGING_FUNC_RESP           0x10
+#define RANGING_FUNC_FINAL          0x23
+#define RANGING_FUNC_REPORT         0x2A
+
+#define RANGING_POLL_LEN            RANGING_HEADER_LEN
+#define RANGING_RESP_LEN            RANGING_HEADER_LEN
+#define RANGING_FINAL_LEN           ( RANGING_HEADER_LEN + 12 )
+#define RANGING_REPORT_LEN          ( RANGING_HEADER_LEN + 4 )
+
+// Exchange states
+#define RANGING_STATE_IDLE          0
+#define RANGING_STATE_WAIT_RESP     1
+#define RANGING_STATE_WAIT_FINAL    2
+#define RANGING_STATE_WAIT_REPORT   3
+
+// Device time unit is 1 / ( 128 * 499.2 MHz ), receive timeout unit is 512 / 499.2 MHz
+#define RANGING_DWT_PER_US_X10      638976ul
+#define RANGING_UUS_PER_US_NUM      975ul
+#define RANGING_UUS_PER_US_DEN      1000ul
+#define RANGING_SPEED_OF_LIGHT      299702547ul
+#define RANGING_DWT_PER_S_DIV_1000  63897600ul
+
+#define RANGING_LDE_RXANTD_SUB      0x1804
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void ranging_write ( uwb_t *ctx, uint8_t reg_adr, uint16_t sub, uint8_t *tx_buf, uint16_t len );
+
+static void ranging_read ( uwb_t *ctx, uint8_t reg_adr, uint16_t sub, uint8_t *rx_buf, uint16_t len );
+
+static void ranging_write_u32 ( uwb_t *ctx, uint8_t reg_adr, uint16_t sub, uint32_t value, uint8_t len );
+
+static uint32_t ranging_get_u32 ( uint8_t *data_buf );
+
+static void ranging_put_u32 ( uint8_t *data_buf, uint32_t value );
+
+static uint64_t ranging_read_timestamp ( uwb_t *ctx, uint8_t reg_adr );
+
+static void ranging_control ( uwb_ranging_t *rng, uint16_t ctrl );
+
+static void ranging_build_header ( uwb_ranging_t *rng, uint16_t dst, uint8_t func );
+
+static void ranging_set_rx_timeout ( uwb_ranging_t *rng, uint8_t enable );
+
+static uint8_t ranging_send ( uwb_ranging_t *rng, uint8_t len, uint64_t rx_ts, uint8_t wait_resp );
+
+static void ranging_listen ( uwb_ranging_t *rng );
+
+static uint8_t ranging_rx_frame ( uwb_ranging_t *rng );
+
+static uint8_t ranging_rx_failed ( uwb_ranging_t *rng, uint8_t status );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void uwb_ranging_init ( uwb_ranging_t *rng, uwb_t *ctx, uint8_t role, uint16_t pan_id, uint16_t address )
+{
+    uint8_t sys_cfg[ 4 ] = { 0 };
+
+    rng->ctx = ctx;
+    rng->role = role;
+    rng->pan_id = pan_id;
+    rng->address = address;
+    rng->anchors = NULL;
+    rng->n_anchors = 0;
+    rng->index = 0;
+    rng->active = NULL;
+    rng->last.address = UWB_RANGING_BROADCAST;
+    rng->last.status = UWB_RANGING_STATUS_IDLE;
+    rng->last.updated = 0;
+    rng->state = RANGING_STATE_IDLE;
+    rng->seq = 0;
+    rng->late_cnt = 0;
+
+    ranging_control( rng, RANGING_CTRL_TRXOFF );
+
+    // Receive timeout is only on while a reply is expected
+    ranging_read( ctx, UWB_REG_SYS_CFG, 0, sys_cfg, 4 );
+    rng->sys_cfg = ranging_get_u32( sys_cfg ) & ~RANGING_SYS_CFG_RXWTOE;
+    rng->rx_wto = 1;
+    ranging_set_rx_timeout( rng, 0 );
+    ranging_write_u32( ctx, UWB_REG_SYS_EVENT_MASK, 0, RANGING_STATUS_RXFCG | RANGING_STATUS_RX_ERR | 
+                       RANGING_STATUS_RX_TO | RANGING_STATUS_TXFRS, 4 );
+    ranging_write_u32( ctx, UWB_REG_EVENT_STATUS, 0,
+                       RANGING_STATUS_RX_GOOD | RANGING_STATUS_RX_ERR | RANGING_STATUS_RX_TO |
+                       RANGING_STATUS_TX_ALL | RANGING_STATUS_HPDWARN, 4 );
+
+    uwb_ranging_set_antenna_delay( rng, UWB_RANGING_DEFAULT_ANTENNA_DELAY );
+    uwb_ranging_set_timing( rng, UWB_RANGING_DEFAULT_REPLY_US, UWB_RANGING_DEFAULT_RX_TIMEOUT_US );
+
+    if ( UWB_RANGING_ROLE_ANCHOR == role )
+    {
+        ranging_listen( rng );
+    }
+}
+
+void uwb_ranging_set_timing ( uwb_ranging_t *rng, uint16_t reply_us, uint16_t rx_timeout_us )
+{
+    rng->reply_dly = ( uint32_t ) ( ( ( uint64_t ) reply_us * RANGING_DWT_PER_US_X10 ) / 10 );
+    rng->rx_timeout = ( uint16_t ) ( ( ( uint32_t ) rx_timeout_us * RANGING_UUS_PER_US_NUM ) /
+                                     RANGING_UUS_PER_US_DEN );
+
+    ranging_write_u32( rng->ctx, UWB_REG_RX_TIMEOUT, 0, rng->rx_timeout, 2 );
+}
+
+void uwb_ranging_set_antenna_delay ( uwb_ranging_t *rng, uint16_t antenna_delay )
+{
+    rng->antenna_delay = antenna_delay;
+
+    ranging_write_u32( rng->ctx, UWB_REG_TX_ANTD, 0, antenna_delay, 2 );
+    ranging_write_u32( rng->ctx, UWB_REG_LEAD_EDGE_DET_CTRL, RANGING_LDE_RXANTD_SUB, antenna_delay, 2 );
+}
+
+void uwb_ranging_set_anchors ( uwb_ranging_t *rng, uwb_ranging_peer_t *anchors, uint8_t n_anchors )
+{
+    uint8_t cnt;
+
+    rng->anchors = anchors;
+    rng->n_anchors = anchors ? n_anchors : 0;
+    rng->index = 0;
+
+    for ( cnt = 0; cnt < rng->n_anchors; cnt++ )
+    {
+        anchors[ cnt ].status = UWB_RANGING_STATUS_IDLE;
+        anchors[ cnt ].updated = 0;
+    }
+}
+
+err_t uwb_ranging_start ( uwb_ranging_t *rng )
+{
+    if ( ( UWB_RANGING_ROLE_TAG != rng->role ) || ( 0 == rng->n_anchors ) ||
+         ( RANGING_STATE_IDLE != rng->state ) )
+    {
+        return UWB_ERROR;
+    }
+
+    rng->active = &rng->anchors[ rng->index ];
+    if ( ++rng->index >= rng->n_anchors )
+    {
+        rng->index = 0;
+    }
+
+    rng->peer = rng->active->address;
+    rng->seq++;
+    ranging_build_header( rng, rng->peer, RANGING_FUNC_POLL );
+    rng->state = RANGING_STATE_WAIT_RESP;
+    ranging_send( rng, RANGING_POLL_LEN, 0, 1 );
+
+    return UWB_OK;
+}
+
+uint8_t uwb_ranging_process ( uwb_ranging_t *rng )
+{
+    uint8_t status_buf[ 4 ];
+    uint32_t status;
+
+    if ( !uwb_get_qint_pin_status( rng->ctx ) )
+    {
+        return UWB_RANGING_EVENT_NONE;
+    }
+
+    ranging_read( rng->ctx, UWB_REG_EVENT_STATUS, 0, status_buf, 4 );
+    status = ranging_get_u32( status_buf );
+
+    if ( status & RANGING_STATUS_RXFCG )
+    {
+        ranging_write_u32( rng->ctx, UWB_REG_EVENT_STATUS, 0, RANGING_STATUS_RX_GOOD | RANGING_STATUS_TX_ALL, 4 );
+        return ranging_rx_frame( rng );
+    }
+
+    if ( status & ( RANGING_STATUS_RX_ERR | RANGING_STATUS_RX_TO ) )
+    {
+        ranging_write_u32( rng->ctx, UWB_REG_EVENT_STATUS, 0, RANGING_STATUS_RX_ERR | RANGING_STATUS_RX_TO, 4 );
+        return ranging_rx_failed( rng, ( status & RANGING_STATUS_RX_TO ) ? UWB_RANGING_STATUS_TIMEOUT :
+                                                                           UWB_RANGING_STATUS_RX_ERROR );
+    }
+
+    if ( status & RANGING_STATUS_TXFRS )
+    {
+        ranging_write_u32( rng->ctx, UWB_REG_EVENT_STATUS, 0, RANGING_STATUS_TX_ALL, 4 );
+        // REPORT is out, nothing answers it, so the anchor listens for the next POLL
+        if ( ( UWB_RANGING_ROLE_ANCHOR == rng->role ) && ( RANGING_STATE_IDLE == rng->state ) )
+        {
+            ranging_listen( rng );
+        }
+    }
+
+    return UWB_RANGING_EVENT_NONE;
+}
+
+int32_t uwb_ranging_tof_to_mm ( int32_t tof )
+{
+    return ( int32_t ) ( ( ( int64_t ) tof * RANGING_SPEED_OF_LIGHT ) / ( int64_t ) RANGING_DWT_PER_S_DIV_1000 );
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void ranging_write ( uwb_t *ctx, uint8_t reg_adr, uint16_t sub, uint8_t *tx_buf, uint16_t len )
+{
+    uint8_t header[ 3 ];
+    uint8_t header_len = 1;
+
+    header[ 0 ] = WRITE_MASK | reg_adr;
+    if ( sub )
+    {
+        header[ 0 ] |= SUB_MASK;
+        if ( sub < 128 )
+        {
+            header[ 1 ] = ( uint8_t ) sub;
+            header_len = 2;
+        }
+        else
+        {
+            header[ 1 ] = SUB_EXT_MASK | ( uint8_t ) ( sub & 0x7F );
+            header[ 2 ] = ( uint8_t ) ( sub >> 7 );
+            header_len = 3;
+        }
+    }
+
+    spi_master_select_device( ctx->chip_select );
+    spi_master_write( &ctx->spi, header, header_len );
+    spi_master_write( &ctx->spi, tx_buf, len );
+    spi_master_deselect_device( ctx->chip_select );
+}
+
+static void ranging_read ( uwb_t *ctx, uint8_t reg_adr, uint16_t sub, uint8_t *rx_buf, uint16_t len )
+{
+    uint8_t header[ 3 ];
+    uint8_t header_len = 1;
+
+    header[ 0 ] = READ_MASK | reg_adr;
+    if ( sub )
+    {
+        header[ 0 ] |= SUB_MASK;
+        if ( sub < 128 )
+        {
+            header[ 1 ] = ( uint8_t ) sub;
+            header_len = 2;
+        }
+        else
+        {
+            header[ 1 ] = SUB_EXT_MASK | ( uint8_t ) ( sub & 0x7F );
+            header[ 2 ] = ( uint8_t ) ( sub >> 7 );
+            header_len = 3;
+        }
+    }
+
+    spi_master_select_device( ctx->chip_select );
+    spi_master_write_then_read( &ctx->spi, header, header_len, rx_buf, len );
+    spi_master_deselect_device( ctx->chip_select );
+}
+
+static void ranging_write_u32 ( uwb_t *ctx, uint8_t reg_adr, uint16_t sub, uint32_t value, uint8_t len )
+{
+    uint8_t data_buf[ 4 ];
+
+    ranging_put_u32( data_buf, value );
+    ranging_write( ctx, reg_adr, sub, data_buf, len );
+}
+
+static uint32_t ranging_get_u32 ( uint8_t *data_buf )
+{
+    return ( ( uint32_t ) data_buf[ 3 ] << 24 ) | ( ( uint32_t ) data_buf[ 2 ] << 16 ) |
+           ( ( uint32_t ) data_buf[ 1 ] << 8 ) | data_buf[ 0 ];
+}
+
+static void ranging_put_u32 ( uint8_t *data_buf, uint32_t value )
+{
+    data_buf[ 0 ] = ( uint8_t ) value;
+    data_buf[ 1 ] = ( uint8_t ) ( value >> 8 );
+    data_buf[ 2 ] = ( uint8_t ) ( value >> 16 );
+    data_buf[ 3 ] = ( uint8_t ) ( value >> 24 );
+}
+
+static uint64_t ranging_read_timestamp ( uwb_t *ctx, uint8_t reg_adr )
+{
+    uint8_t ts[ 5 ];
+
+    ranging_read( ctx, reg_adr, 0, ts, 5 );
+
+    return ( ( uint64_t ) ts[ 4 ] << 32 ) | ranging_get_u32( ts );
+}
+
+static void ranging_control ( uwb_ranging_t *rng, uint16_t ctrl )
+{
+    uint8_t ctrl_buf[ 2 ];
+
+    ctrl_buf[ 0 ] = ( uint8_t ) ctrl;
+    ctrl_buf[ 1 ] = ( uint8_t ) ( ctrl >> 8 );
+    ranging_write( rng->ctx, UWB_REG_SYS_CTRL, 0, ctrl_buf, 2 );
+}
+
+static void ranging_build_header ( uwb_ranging_t *rng, uint16_t dst, uint8_t func )
+{
+    rng->frame[ 0 ] = RANGING_FC_LOW;
+    rng->frame[ 1 ] = RANGING_FC_HIGH;
+    rng->frame[ RANGING_IDX_SEQ ] = rng->seq;
+    rng->frame[ RANGING_IDX_PAN ] = ( uint8_t ) rng->pan_id;
+    rng->frame[ RANGING_IDX_PAN + 1 ] = ( uint8_t ) ( rng->pan_id >> 8 );
+    rng->frame[ RANGING_IDX_DST ] = ( uint8_t ) dst;
+    rng->frame[ RANGING_IDX_DST + 1 ] = ( uint8_t ) ( dst >> 8 );
+    rng->frame[ RANGING_IDX_SRC ] = ( uint8_t ) rng->address;
+    rng->frame[ RANGING_IDX_SRC + 1 ] = ( uint8_t ) ( rng->address >> 8 );
+    rng->frame[ RANGING_IDX_FUNC ] = func;
+}
+
+static void ranging_set_rx_timeout ( uwb_ranging_t *rng, uint8_t enable )
+{
+    if ( enable == rng->rx_wto )
+    {
+        return;
+    }
+
+    rng->rx_wto = enable;
+    ranging_write_u32( rng->ctx, UWB_REG_SYS_CFG, 0, 
+                       enable ? ( rng->sys_cfg | RANGING_SYS_CFG_RXWTOE ) : rng->sys_cfg, 4 );
+}
+
+static uint8_t ranging_send ( uwb_ranging_t *rng, uint8_t len, uint64_t rx_ts, uint8_t wait_resp )
+{
+    uint16_t ctrl = RANGING_CTRL_TXSTRT;
+    uint8_t flen = len + RANGING_FCS_LEN;
+    uint8_t status_buf[ 4 ];
+
+    // The receiver turns on after the frame only when a reply is expected, with the timeout on
+    ranging_set_rx_timeout( rng, wait_resp );
+    if ( wait_resp )
+    {
+        ctrl |= RANGING_CTRL_WAIT4RESP;
+    }
+
+    ranging_write( rng->ctx, UWB_REG_TX_DATA_BUF, 0, rng->frame, len );
+    ranging_write( rng->ctx, UWB_REG_SYS_TX_CTRL, 0, &flen, 1 );
+
+    if ( rx_ts )
+    {
+        // Reply time is counted from the RX timestamp, bits 0 to 8 of DX_TIME are ignored
+        ranging_write_u32( rng->ctx, UWB_REG_DX_TIME, 1, ( uint32_t ) ( ( rx_ts + rng->reply_dly ) >> 8 ), 4 );
+        ctrl |= RANGING_CTRL_TXDLYS;
+    }
+
+    ranging_control( rng, ctrl );
+
+    if ( rx_ts )
+    {
+        ranging_read( rng->ctx, UWB_REG_EVENT_STATUS, 0, status_buf, 4 );
+        if ( ranging_get_u32( status_buf ) & RANGING_STATUS_HPDWARN )
+        {
+            ranging_control( rng, RANGING_CTRL_TRXOFF );
+            ranging_write_u32( rng->ctx, UWB_REG_EVENT_STATUS, 0, RANGING_STATUS_HPDWARN, 4 );
+            rng->late_cnt++;
+            return UWB_RANGING_STATUS_TX_LATE;
+        }
+    }
+
+    return UWB_RANGING_STATUS_OK;
+}
+
+static void ranging_listen ( uwb_ranging_t *rng )
+{
+    rng->state = RANGING_STATE_IDLE;
+    ranging_control( rng, RANGING_CTRL_TRXOFF );
+    ranging_set_rx_timeout( rng, 0 );
+    ranging_control( rng, RANGING_CTRL_RXENAB );
+}
+
+static uint8_t ranging_rx_frame ( uwb_ranging_t *rng )
+{
+    uint8_t info[ 4 ];
+    uint8_t len;
+    uint16_t dst;
+    uint16_t src;
+    uint8_t func;
+    uint64_t rx_ts;
+    uint64_t tx_ts;
+    uint32_t final_tx;
+    uint32_t round_a;
+    uint32_t reply_a;
+    uint32_t round_b;
+    uint32_t reply_b;
+    uint64_t round_prod;
+    uint64_t reply_prod;
+    uint64_t rounds_sum;
+    int32_t tof;
+
+    ranging_read( rng->ctx, UWB_REG_RX_INFO, 0, info, 4 );
+    len = ( info[ 0 ] & 0x7F ) - RANGING_FCS_LEN;
+    if ( ( len < RANGING_HEADER_LEN ) || ( len > UWB_RANGING_FRAME_SIZE ) )
+    {
+        return ranging_rx_failed( rng, UWB_RANGING_STATUS_RX_ERROR );
+    }
+
+    ranging_read( rng->ctx, UWB_REG_RX_BUF, 0, rng->frame, len );
+    dst = ( ( uint16_t ) rng->frame[ RANGING_IDX_DST + 1 ] << 8 ) | rng->frame[ RANGING_IDX_DST ];
+    src = ( ( uint16_t ) rng->frame[ RANGING_IDX_SRC + 1 ] << 8 ) | rng->frame[ RANGING_IDX_SRC ];
+    func = rng->frame[ RANGING_IDX_FUNC ];
+
+    if ( ( RANGING_FC_LOW != rng->frame[ 0 ] ) || ( RANGING_FC_HIGH != rng->frame[ 1 ] ) ||
+         ( rng->frame[ RANGING_IDX_PAN ] != ( uint8_t ) rng->pan_id ) ||
+         ( rng->frame[ RANGING_IDX_PAN + 1 ] != ( uint8_t ) ( rng->pan_id >> 8 ) ) ||
+         ( ( dst != rng->address ) && ( dst != UWB_RANGING_BROADCAST ) ) )
+    {
+        // Not for us, keep waiting for the current exchange
+        ranging_control( rng, RANGING_CTRL_RXENAB );
+        return UWB_RANGING_EVENT_NONE;
+    }
+
+    rx_ts = ranging_read_timestamp( rng->ctx, UWB_REG_RX_MESSAGE_TOA );
+
+    if ( ( RANGING_FUNC_POLL == func ) && ( UWB_RANGING_ROLE_ANCHOR == rng->role ) )
+    {
+        // A new POLL restarts the exchange, also with a tag that gave up on the previous one
+        rng->peer = src;
+        rng->poll_rx = rx_ts;
+        rng->seq = rng->frame[ RANGING_IDX_SEQ ];
+        ranging_build_header( rng, src, RANGING_FUNC_RESP );
+        rng->state = RANGING_STATE_WAIT_FINAL;
+        if ( UWB_RANGING_STATUS_OK != ranging_send( rng, RANGING_RESP_LEN, rx_ts, 1 ) )
+        {
+            ranging_listen( rng );
+        }
+        return UWB_RANGING_EVENT_NONE;
+    }
+
+    if ( src != rng->peer )
+    {
+        ranging_control( rng, RANGING_CTRL_RXENAB );
+        return UWB_RANGING_EVENT_NONE;
+    }
+
+    if ( ( RANGING_FUNC_RESP == func ) && ( RANGING_STATE_WAIT_RESP == rng->state ) )
+    {
+        tx_ts = ranging_read_timestamp( rng->ctx, UWB_REG_TX_MESSAGE_TOS );
+
+        // FINAL carries its own TX timestamp, known in advance from the delayed TX time
+        final_tx = ( uint32_t ) ( ( ( rx_ts + rng->reply_dly ) >> 8 ) & 0xFFFFFFFEul );
+        final_tx = ( final_tx << 8 ) + rng->antenna_delay;
+
+        ranging_build_header( rng, src, RANGING_FUNC_FINAL );
+        ranging_put_u32( &rng->frame[ RANGING_HEADER_LEN ], ( uint32_t ) tx_ts );
+        ranging_put_u32( &rng->frame[ RANGING_HEADER_LEN + 4 ], ( uint32_t ) rx_ts );
+        ranging_put_u32( &rng->frame[ RANGING_HEADER_LEN + 8 ], final_tx );
+        rng->state = RANGING_STATE_WAIT_REPORT;
+        if ( UWB_RANGING_STATUS_OK != ranging_send( rng, RANGING_FINAL_LEN, rx_ts, 1 ) )
+        {
+            return ranging_rx_failed( rng, UWB_RANGING_STATUS_TX_LATE );
+        }
+        return UWB_RANGING_EVENT_NONE;
+    }
+
+    if ( ( RANGING_FUNC_FINAL == func ) && ( RANGING_STATE_WAIT_FINAL == rng->state ) &&
+         ( RANGING_FINAL_LEN == len ) )
+    {
+        tx_ts = ranging_read_timestamp( rng->ctx, UWB_REG_TX_MESSAGE_TOS );
+
+        // 32-bit differences stay valid for exchanges shorter than 67 ms
+        round_a = ranging_get_u32( &rng->frame[ RANGING_HEADER_LEN + 4 ] ) -
+                  ranging_get_u32( &rng->frame[ RANGING_HEADER_LEN ] );
+        reply_a = ranging_get_u32( &rng->frame[ RANGING_HEADER_LEN + 8 ] ) -
+                  ranging_get_u32( &rng->frame[ RANGING_HEADER_LEN + 4 ] );
+        round_b = ( uint32_t ) rx_ts - ( uint32_t ) tx_ts;
+        reply_b = ( uint32_t ) tx_ts - ( uint32_t ) rng->poll_rx;
+
+        // Asymmetric double-sided formula, the clock offset of both devices cancels out.
+        // Unsigned 32x32 products always fit in 64 bits, the sign is handled separately.
+        round_prod = ( uint64_t ) round_a * round_b;
+        reply_prod = ( uint64_t ) reply_a * reply_b;
+        rounds_sum = ( uint64_t ) round_a + round_b + reply_a + reply_b;
+        if ( round_prod >= reply_prod )
+        {
+            tof = ( int32_t ) ( ( round_prod - reply_prod ) / rounds_sum );
+        }
+        else
+        {
+            tof = -( int32_t ) ( ( reply_prod - round_prod ) / rounds_sum );
+        }
+
+        rng->last.address = src;
+        rng->last.tof = tof;
+        rng->last.distance_mm = uwb_ranging_tof_to_mm( tof );
+        rng->last.status = UWB_RANGING_STATUS_OK;
+        rng->last.updated++;
+
+        // REPORT is sent at once, the receiver turns on for the next POLL once it is out
+        ranging_build_header( rng, src, RANGING_FUNC_REPORT );
+        ranging_put_u32( &rng->frame[ RANGING_HEADER_LEN ], ( uint32_t ) tof );
+        rng->state = RANGING_STATE_IDLE;
+        ranging_send( rng, RANGING_REPORT_LEN, 0, 0 );
+        return UWB_RANGING_EVENT_RANGE;
+    }
+
+    if ( ( RANGING_FUNC_REPORT == func ) && ( RANGING_STATE_WAIT_REPORT == rng->state ) &&
+         ( RANGING_REPORT_LEN == len ) )
+    {
+        tof = ( int32_t ) ranging_get_u32( &rng->frame[ RANGING_HEADER_LEN ] );
+        rng->active->tof = tof;
+        rng->active->distance_mm = uwb_ranging_tof_to_mm( tof );
+        rng->active->status = UWB_RANGING_STATUS_OK;
+        rng->active->updated++;
+        rng->state = RANGING_STATE_IDLE;
+        return UWB_RANGING_EVENT_RANGE;
+    }
+
+    ranging_control( rng, RANGING_CTRL_RXENAB );
+    return UWB_RANGING_EVENT_NONE;
+}
+
+static uint8_t ranging_rx_failed ( uwb_ranging_t *rng, uint8_t status )
+{
+    uint8_t state = rng->state;
+
+    if ( UWB_RANGING_ROLE_ANCHOR == rng->role )
+    {
+        ranging_listen( rng );
+        if ( RANGING_STATE_IDLE == state )
+        {
+            return UWB_RANGING_EVENT_NONE;
+        }
+        rng->last.status = status;
+        return UWB_RANGING_EVENT_ERROR;
+    }
+
+    rng->state = RANGING_STATE_IDLE;
+    ranging_control( rng, RANGING_CTRL_TRXOFF );
+    if ( ( RANGING_STATE_IDLE == state ) || ( NULL == rng->active ) )
+    {
+        return UWB_RANGING_EVENT_NONE;
+    }
+    rng->active->status = status;
+    return UWB_RANGING_EVENT_ERROR;
+}
+
+// ------------------------------------------------------------------------- END
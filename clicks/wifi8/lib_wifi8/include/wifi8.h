@@ -226,7 +226,7 @@ err_t wifi8_default_cfg(wifi8_t *ctx);
  * See #err_t definition for detailed explanation.
  * @note None.
  */
-err_t wifi8_generic_write(wifi8_t *ctx, uint8_t *data_in, uint8_t len);
+err_t wifi8_generic_write(wifi8_t *ctx, uint8_t *data_in, uint16_t len);
 
 /**
  * @brief Generic reading function.
@@ -242,7 +242,7 @@ err_t wifi8_generic_write(wifi8_t *ctx, uint8_t *data_in, uint8_t len);
  * See #err_t definition for detailed explanation.
  * @note None.
  */
-err_t wifi8_generic_read(wifi8_t *ctx, uint8_t *data_out, uint8_t len);
+err_t wifi8_generic_read(wifi8_t *ctx, uint8_t *data_out, uint16_t len);
 
 /**
  * @brief Write data to register address.
@@ -609,6 +609,9 @@ err_t wifi8_socket_send_to(wifi8_t *ctx, int8_t sock, void *pv_send_buffer, uint
  * must have been received through any of the two socket events
  * @b SOCKET_MSG_CONNECT or @b SOCKET_MSG_ACCEPT , from the socket callback.
  * Hence, indicating that the socket is already connected to a remote host.
+ * The payload is read from the module straight into @b pv_recv_buf. If more data
+ * arrives than fits, the buffer is refilled and @b SOCKET_MSG_RECV is raised once per
+ * chunk, with @b u16_remaining_size telling how much is still to come.
  */
 err_t wifi8_socket_receive(wifi8_t *ctx, int8_t sock, void *pv_recv_buf, uint16_t u16_buf_len, uint32_t u32_timeoutmsec);
 
@@ -399,7 +399,11 @@ Usage restrictions (eg STA mode only) should always be made clear at the API lay
 #define M2M_SCAN_DEFAULT_NUM_PROBE (2)
 #define M2M_FASTCONNECT_DEFAULT_RSSI_THRESH (-45)
 
-#define NM_BUS_MAX_TRX_SZ 256
+/* One bus transaction carries a full SPI data packet, define it lower for hosts
+that cannot afford the buffers. */
+#ifndef NM_BUS_MAX_TRX_SZ
+#define NM_BUS_MAX_TRX_SZ (DATA_PKT_SZ + MAX_TRX_CFG_SZ)
+#endif
 
 #define M2M_MAX_SSID_LEN 33
 
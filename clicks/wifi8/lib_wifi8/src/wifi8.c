@@ -867,7 +867,7 @@ err_t wifi8_default_cfg(wifi8_t *ctx)
     return wifi8_init_drv(ctx);
 }
 
-err_t wifi8_generic_write(wifi8_t *ctx, uint8_t *data_in, uint8_t len)
+err_t wifi8_generic_write(wifi8_t *ctx, uint8_t *data_in, uint16_t len)
 {
     spi_master_select_device(ctx->chip_select);
     Delay_10us ( );
@@ -877,7 +877,7 @@ err_t wifi8_generic_write(wifi8_t *ctx, uint8_t *data_in, uint8_t len)
     return error_flag;
 }
 
-err_t wifi8_generic_read(wifi8_t *ctx, uint8_t *data_out, uint8_t len)
+err_t wifi8_generic_read(wifi8_t *ctx, uint8_t *data_out, uint16_t len)
 {
     spi_master_select_device(ctx->chip_select);
     Delay_10us ( );
@@ -2684,7 +2684,7 @@ static err_t hif_send(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_opcode, uint8_t *
                 u32_curr_addr += M2M_HIF_HDR_OFFSET;
                 if (pu8_ctrl_buf != NULL)
                 {
-                    if (WIFI8_OK != wifi8_block_write(ctx, u32_curr_addr, pu8_ctrl_buf, u16_ctrl_buf_size))
+                    if (WIFI8_OK != nm_write_block(ctx, u32_curr_addr, pu8_ctrl_buf, u16_ctrl_buf_size))
                     {
                         return WIFI8_ERROR;
                     }
@@ -2693,7 +2693,7 @@ static err_t hif_send(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_opcode, uint8_t *
                 if (pu8_data_buf != NULL)
                 {
                     u32_curr_addr += u32_ctrl_data_gap;
-                    if (WIFI8_OK != wifi8_block_write(ctx, u32_curr_addr, pu8_data_buf, u16_data_size))
+                    if (WIFI8_OK != nm_write_block(ctx, u32_curr_addr, pu8_data_buf, u16_data_size))
                     {
                         return WIFI8_ERROR;
                     }
@@ -2757,7 +2757,7 @@ static err_t hif_receive(wifi8_t *ctx, uint32_t u32_addr, uint8_t *pu8_buf, uint
     }
 
     /* Receive the payload */
-    if (WIFI8_OK != wifi8_block_read(ctx, u32_addr, pu8_buf, u16_sz))
+    if (WIFI8_OK != nm_read_block(ctx, u32_addr, pu8_buf, u16_sz))
     {
         return WIFI8_ERROR;
     }
@@ -3448,36 +3448,49 @@ static void socket_read_socket_data(wifi8_t *ctx, int8_t sock, wifi8_socket_recv
 {
     uint32_t u32_address = u32_start_address;
     uint16_t u16_read;
-    int16_t s16_diff;
+    uint8_t u8_set_rx_done;
 
     pstr_recv->u16_remaining_size = u16_read_count;
     if ((u16_read_count > 0) && (ctx->sockets[sock].pu8_user_buffer !=  ((void *)0) ) && 
         (ctx->sockets[sock].u16_user_buffer_size > 0) && (ctx->sockets[sock].b_is_used == 1))
     {
-        u16_read = u16_read_count;
-        s16_diff = u16_read - ctx->sockets[sock].u16_user_buffer_size;
-        if (s16_diff > 0)
+        /* The payload lands in the application buffer, chunk by chunk if it does not fit,
+        and every chunk is handed to the callback in place before the next one is read. */
+        do
         {
-            u16_read = ctx->sockets[sock].u16_user_buffer_size;
-        }
+            u8_set_rx_done = 1;
+            u16_read = u16_read_count;
+            if (u16_read > ctx->sockets[sock].u16_user_buffer_size)
+            {
+                u8_set_rx_done = 0;
+                u16_read = ctx->sockets[sock].u16_user_buffer_size;
+            }
+
+            if (hif_receive(ctx, u32_address, ctx->sockets[sock].pu8_user_buffer, u16_read, u8_set_rx_done) != WIFI8_OK)
+            {
+                break;
+            }
 
-        if (hif_receive(ctx, u32_address, ctx->sockets[sock].pu8_user_buffer, u16_read, 1) == WIFI8_OK)
-        {
             pstr_recv->pu8_buffer = ctx->sockets[sock].pu8_user_buffer;
             pstr_recv->s16_buffer_size = u16_read;
             pstr_recv->u16_remaining_size -= u16_read;
 
-            ctx->sockets[sock].u16_user_buffer_size -= u16_read;
-            if (ctx->sockets[sock].u16_user_buffer_size == 0)
+            if (ctx->app_socket_cb)
             {
-                ctx->sockets[sock].pu8_user_buffer = NULL;
+                ctx->app_socket_cb(sock, u8_socket_msg, pstr_recv);
             }
 
-            if (ctx->app_socket_cb)
+            u16_read_count -= u16_read;
+            u32_address += u16_read;
+
+            /* the application closed the socket while the rest of the data is pending.
+            */
+            if ((u16_read_count > 0) && (!ctx->sockets[sock].b_is_used))
             {
-                ctx->app_socket_cb(sock, u8_socket_msg, pstr_recv);
+                hif_receive(ctx, 0, NULL, 0, 1);
+                break;
             }
-        }
+        } while (u16_read_count > 0);
     }
 }
 
@@ -4238,6 +4251,7 @@ static err_t nm_read_block(wifi8_t *ctx, uint32_t u32_addr, uint8_t *pu_buf, uin
         if (u32_sz <= u16_max_trx_sz)
         {
             s8_ret += wifi8_block_read(ctx, u32_addr, &pu_buf[off], (uint16_t)u32_sz);
+            break;
         }
         else
         {
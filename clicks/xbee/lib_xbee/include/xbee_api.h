@@ -0,0 +1,365 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file xbee_api.h
+ * @brief This file contains API frame engine for XBEE Click Driver.
+ * @details In API mode ( AP = 1 or 2 ) every message is a frame with a start
+ * delimiter, length, frame type and checksum, so one node can address many
+ * destinations and change settings of local and remote modules without the
+ * command mode guard times. Responses carry the frame ID of the request.
+ */
+
+#ifndef XBEE_API_H
+#define XBEE_API_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "xbee.h"
+
+/*!
+ * @addtogroup xbee XBEE Click Driver
+ * @brief API for configuring and manipulating XBEE Click driver.
+ * @{
+ */
+
+/**
+ * @defgroup xbee_api XBEE API Frame Settings
+ * @brief Settings for API frames of XBEE Click driver.
+ */
+
+/**
+ * @addtogroup xbee_api
+ * @{
+ */
+
+/**
+ * @brief XBEE API frame special bytes.
+ * @details Start delimiter and the bytes escaped in API mode with escaping ( AP = 2 ).
+ */
+#define XBEE_API_START_DELIMITER           0x7E
+#define XBEE_API_ESCAPE                    0x7D
+#define XBEE_API_XON                       0x11
+#define XBEE_API_XOFF                      0x13
+#define XBEE_API_ESCAPE_XOR                0x20
+
+/**
+ * @brief XBEE API frame types.
+ * @details Frame types handled by the API frame engine.
+ */
+#define XBEE_API_FRAME_AT_CMD              0x08
+#define XBEE_API_FRAME_AT_CMD_QUEUE        0x09
+#define XBEE_API_FRAME_TX_REQUEST          0x10
+#define XBEE_API_FRAME_REMOTE_AT_CMD       0x17
+#define XBEE_API_FRAME_AT_RSP              0x88
+#define XBEE_API_FRAME_TX_STATUS_LEGACY    0x89
+#define XBEE_API_FRAME_MODEM_STATUS        0x8A
+#define XBEE_API_FRAME_TX_STATUS           0x8B
+#define XBEE_API_FRAME_RX_PACKET           0x90
+#define XBEE_API_FRAME_REMOTE_AT_RSP       0x97
+
+/**
+ * @brief XBEE API frame status.
+ * @details Status returned for a tracked frame ID. Any other value is the
+ * delivery status of TX status or the command status of AT response frame.
+ */
+#define XBEE_API_STATUS_SUCCESS            0x00
+#define XBEE_API_STATUS_UNKNOWN            0xFE
+#define XBEE_API_STATUS_PENDING            0xFF
+
+/**
+ * @brief XBEE API broadcast address.
+ * @details 16-bit address used when the 16-bit address of the destination is unknown.
+ */
+#define XBEE_API_ADDR16_UNKNOWN            0xFFFE
+
+/**
+ * @brief XBEE API frame engine sizes.
+ * @details Maximal frame data length ( frame type to the last data byte ) and
+ * number of frame IDs waiting for the response at the same time.
+ * @note Increase sizes if needed.
+ */
+#define XBEE_API_MAX_FRAME_SIZE            128
+#define XBEE_API_MAX_PENDING               8
+
+/**
+ * @brief XBEE API frame header sizes.
+ * @details Number of frame data bytes in front of the payload.
+ */
+#define XBEE_API_TX_REQUEST_HDR_SIZE       14
+#define XBEE_API_TX_MAX_PAYLOAD            ( XBEE_API_MAX_FRAME_SIZE - XBEE_API_TX_REQUEST_HDR_SIZE )
+
+/*! @} */ // xbee_api
+
+/**
+ * @brief XBEE API received packet object.
+ * @details Received packet ( 0x90 ) passed to the RX handler.
+ */
+typedef struct
+{
+    uint8_t *addr64;                /**< 64-bit source address, MSB first. */
+    uint16_t addr16;                /**< 16-bit source address. */
+    uint8_t options;                /**< Receive options. */
+    uint8_t *data;                  /**< Received data, valid until the handler returns. */
+    uint16_t len;                   /**< Received data length. */
+
+} xbee_api_rx_t;
+
+/**
+ * @brief XBEE API AT command response object.
+ * @details Local ( 0x88 ) or remote ( 0x97 ) AT command response passed to the AT handler.
+ */
+typedef struct
+{
+    uint8_t frame_id;               /**< Frame ID of the command. */
+    uint8_t remote;                 /**< 1 for remote AT command response. */
+    uint8_t *addr64;                /**< 64-bit address of the remote node, NULL for local. */
+    uint16_t addr16;                /**< 16-bit address of the remote node. */
+    char cmd[ 2 ];                  /**< AT command. */
+    uint8_t status;                 /**< Command status, 0 - OK. */
+    uint8_t *data;                  /**< Command data, valid until the handler returns. */
+    uint16_t len;                   /**< Command data length. */
+
+} xbee_api_at_rsp_t;
+
+/**
+ * @brief XBEE API frame handlers.
+ * @details Handlers called from xbee_api_process for the received frames.
+ */
+typedef void ( *xbee_api_rx_handler_t ) ( xbee_api_rx_t *rx );
+typedef void ( *xbee_api_at_handler_t ) ( xbee_api_at_rsp_t *rsp );
+typedef void ( *xbee_api_modem_handler_t ) ( uint8_t status );
+typedef void ( *xbee_api_tx_handler_t ) ( uint8_t frame_id, uint8_t status );
+typedef void ( *xbee_api_frame_handler_t ) ( uint8_t *frame, uint16_t len );
+
+/**
+ * @brief XBEE API frame ID tracking object.
+ * @details Frame ID waiting for the response and its status.
+ */
+typedef struct
+{
+    uint8_t frame_id;               /**< Frame ID, 0 for a free entry. */
+    uint8_t status;                 /**< Response status or XBEE_API_STATUS_PENDING. */
+
+} xbee_api_pending_t;
+
+/**
+ * @brief XBEE API frame engine object.
+ * @details API frame engine definition of XBEE Click driver.
+ */
+typedef struct
+{
+    xbee_t *ctx;                    /**< Click context object. */
+    uint8_t mode;                   /**< XBEE_MODE_API_WITHOUT_ESC or XBEE_MODE_API_WITH_ESC. */
+
+    // Handlers
+    xbee_api_rx_handler_t rx_handler;           /**< Received packet handler. */
+    xbee_api_at_handler_t at_handler;           /**< Local and remote AT command response handler. */
+    xbee_api_modem_handler_t modem_handler;     /**< Modem status handler. */
+    xbee_api_tx_handler_t tx_handler;           /**< TX status handler. */
+    xbee_api_frame_handler_t frame_handler;     /**< Handler of the other frame types. */
+
+    // Decoder
+    uint8_t state;                  /**< Decoder state. */
+    uint8_t esc_f;                  /**< Next byte is escaped. */
+    uint8_t sum;                    /**< Checksum of the frame data received so far. */
+    uint16_t len;                   /**< Frame data length. */
+    uint16_t cnt;                   /**< Frame data bytes received. */
+    uint16_t checksum_err;          /**< Frames dropped because of the checksum. */
+    uint16_t frame_err;             /**< Frames dropped because of the length or a new start delimiter. */
+
+    // Frame ID tracking
+    uint8_t frame_id;               /**< Last frame ID used. */
+    xbee_api_pending_t pending[ XBEE_API_MAX_PENDING ];    /**< Frame IDs waiting for the response. */
+
+    // Buffers
+    uint8_t rx_frame[ XBEE_API_MAX_FRAME_SIZE ];           /**< Received frame data. */
+    uint8_t tx_frame[ XBEE_API_MAX_FRAME_SIZE + 4 ];       /**< Frame built in place, delimiter to checksum. */
+
+} xbee_api_t;
+
+/**
+ * @brief XBEE API frame engine initialization function.
+ * @details This function initializes the API frame engine.
+ * @param[out] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @param[in] ctx : Initialized Click context object.
+ * See #xbee_t object definition for detailed explanation.
+ * @param[in] mode : @li @c 1 - API mode without ESC,
+ *                   @li @c 2 - API mode with ESC.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The module has to be switched to the same API mode once before, by
+ * xbee_set_api_mode( ) followed by xbee_save_changes( ) in command mode.
+ * All handlers are cleared, set the ones needed in the engine object.
+ */
+err_t xbee_api_init ( xbee_api_t *api, xbee_t *ctx, uint8_t mode );
+
+/**
+ * @brief XBEE API process function.
+ * @details This function reads all the bytes waiting in the UART ring buffer,
+ * decodes them and calls the handlers for every complete frame.
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @return Number of valid frames received.
+ * @note Call it from the main loop often enough for the UART ring buffer not to overflow.
+ */
+uint8_t xbee_api_process ( xbee_api_t *api );
+
+/**
+ * @brief XBEE API byte decode function.
+ * @details This function passes one received byte to the frame decoder.
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @param[in] rx_data : Received byte.
+ * @return @li @c 1 - Valid frame received and handled,
+ *         @li @c 0 - Frame not complete yet or dropped.
+ * @note None.
+ */
+uint8_t xbee_api_rx_byte ( xbee_api_t *api, uint8_t rx_data );
+
+/**
+ * @brief XBEE API get payload function.
+ * @details This function returns the payload area of the TX request frame
+ * for the data to be written in place before xbee_api_send_tx_request( ).
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @return Payload buffer of XBEE_API_TX_MAX_PAYLOAD bytes.
+ * @note The other send functions build their frames in the same buffer.
+ */
+uint8_t *xbee_api_get_tx_payload ( xbee_api_t *api );
+
+/**
+ * @brief XBEE API send TX request function.
+ * @details This function completes the TX request ( 0x10 ) around the payload
+ * already written in place and sends it.
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @param[in] addr64 : 64-bit destination address, MSB first.
+ * @param[in] addr16 : 16-bit destination address or XBEE_API_ADDR16_UNKNOWN.
+ * @param[in] len : Payload length.
+ * @param[out] frame_id : Frame ID to query the TX status with, NULL for no TX status.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, payload too long or too many frame IDs pending.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t xbee_api_send_tx_request ( xbee_api_t *api, uint8_t *addr64, uint16_t addr16, uint16_t len, uint8_t *frame_id );
+
+/**
+ * @brief XBEE API send AT command function.
+ * @details This function sends a local AT command ( 0x08 ) in API frame.
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @param[in] cmd : Two character AT command, e.g. "DL".
+ * @param[in] param : Command parameter, NULL for a query.
+ * @param[in] param_len : Command parameter length, 0 for a query.
+ * @param[out] frame_id : Frame ID to query the response status with, NULL for no response.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The change takes effect at once, no command mode guard times are needed.
+ */
+err_t xbee_api_send_at_cmd ( xbee_api_t *api, char *cmd, uint8_t *param, uint8_t param_len, uint8_t *frame_id );
+
+/**
+ * @brief XBEE API send remote AT command function.
+ * @details This function sends an AT command ( 0x17 ) to a remote node.
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @param[in] addr64 : 64-bit address of the remote node, MSB first.
+ * @param[in] addr16 : 16-bit address of the remote node or XBEE_API_ADDR16_UNKNOWN.
+ * @param[in] cmd : Two character AT command.
+ * @param[in] param : Command parameter, NULL for a query.
+ * @param[in] param_len : Command parameter length, 0 for a query.
+ * @param[in] options : Remote command options, 0x02 - apply changes.
+ * @param[out] frame_id : Frame ID to query the response status with, NULL for no response.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t xbee_api_send_remote_at_cmd ( xbee_api_t *api, uint8_t *addr64, uint16_t addr16, char *cmd,
+                                    uint8_t *param, uint8_t param_len, uint8_t options, uint8_t *frame_id );
+
+/**
+ * @brief XBEE API send frame function.
+ * @details This function sends a frame of any type with the frame data already
+ * written in place, starting with the frame type at xbee_api_get_frame_data( ).
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @param[in] len : Frame data length, frame type included.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Frame ID of the frame is not tracked.
+ */
+err_t xbee_api_send_frame ( xbee_api_t *api, uint16_t len );
+
+/**
+ * @brief XBEE API get frame data function.
+ * @details This function returns the frame data area of the TX frame.
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @return Frame data buffer of XBEE_API_MAX_FRAME_SIZE bytes.
+ * @note None.
+ */
+uint8_t *xbee_api_get_frame_data ( xbee_api_t *api );
+
+/**
+ * @brief XBEE API get status function.
+ * @details This function returns the status of a tracked frame ID. Once the
+ * response is in, the frame ID is released and the status is returned once.
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @param[in] frame_id : Frame ID returned by one of the send functions.
+ * @return @li @c 0x00 - Success,
+ *         @li @c 0xFE - Frame ID not tracked,
+ *         @li @c 0xFF - Response pending,
+ *         @li @c other - Delivery or command status.
+ * @note None.
+ */
+uint8_t xbee_api_get_status ( xbee_api_t *api, uint8_t frame_id );
+
+/**
+ * @brief XBEE API cancel function.
+ * @details This function releases a tracked frame ID without waiting for the response,
+ * e.g. after a host timeout.
+ * @param[in] api : API frame engine object.
+ * See #xbee_api_t object definition for detailed explanation.
+ * @param[in] frame_id : Frame ID to release.
+ * @return None.
+ * @note None.
+ */
+void xbee_api_cancel ( xbee_api_t *api, uint8_t frame_id );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // XBEE_API_H
+
+/*! @} */ // xbee
+
+// ------------------------------------------------------------------------ END
@@ -0,0 +1,630 @@
+/****************************************************************************
+** Copyright (C) 2026 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file xbee4_api.c
+ * @brief XBEE 4 Click API Frame Engine.
+ */
+
+#include "xbee4_api.h"
+#include "string.h"
+
+/**
+ * @brief XBEE 4 API decoder states.
+ * @details Position of the decoder in the frame.
+ */
+#define XBEE4_API_STATE_DELIMITER           0
+#define XBEE4_API_STATE_LEN_MSB             1
+#define XBEE4_API_STATE_LEN_LSB             2
+#define XBEE4_API_STATE_DATA                3
+#define XBEE4_API_STATE_CHECKSUM            4
+
+/**
+ * @brief XBEE 4 API read chunk size.
+ * @details Number of bytes taken from the UART ring buffer at once.
+ */
+#define XBEE4_API_RX_CHUNK_SIZE             32
+
+/**
+ * @brief XBEE 4 API frame data offsets.
+ * @details Minimal frame data lengths of the received frame types.
+ */
+#define XBEE4_API_RX_PACKET_HDR_SIZE        12
+#define XBEE4_API_TX_STATUS_SIZE            7
+#define XBEE4_API_TX_STATUS_LEGACY_SIZE     3
+#define XBEE4_API_AT_RSP_HDR_SIZE           5
+#define XBEE4_API_REMOTE_AT_RSP_HDR_SIZE    15
+#define XBEE4_API_MODEM_STATUS_SIZE         2
+#define XBEE4_API_AT_CMD_HDR_SIZE           4
+#define XBEE4_API_REMOTE_AT_CMD_HDR_SIZE    15
+
+/**
+ * @brief XBEE 4 API dispatch function.
+ * @details This function calls the handler of the received frame and releases
+ * the tracked frame ID the frame responds to.
+ * @param[in] api : API frame engine object.
+ * See #xbee4_api_t object definition for detailed explanation.
+ * @return @li @c 1 - Valid frame,
+ *         @li @c 0 - Frame too short for its type.
+ * @note None.
+ */
+static uint8_t xbee4_api_dispatch ( xbee4_api_t *api );
+
+/**
+ * @brief XBEE 4 API complete function.
+ * @details This function stores the response status of a tracked frame ID.
+ * @param[in] api : API frame engine object.
+ * See #xbee4_api_t object definition for detailed explanation.
+ * @param[in] frame_id : Frame ID of the response.
+ * @param[in] status : Response status.
+ * @return None.
+ * @note None.
+ */
+static void xbee4_api_complete ( xbee4_api_t *api, uint8_t frame_id, uint8_t status );
+
+/**
+ * @brief XBEE 4 API find function.
+ * @details This function returns the tracking entry of a frame ID.
+ * @param[in] api : API frame engine object.
+ * See #xbee4_api_t object definition for detailed explanation.
+ * @param[in] frame_id : Frame ID to look for.
+ * @return Entry index or XBEE4_API_MAX_PENDING if the frame ID is not tracked.
+ * @note None.
+ */
+static uint8_t xbee4_api_find ( xbee4_api_t *api, uint8_t frame_id );
+
+/**
+ * @brief XBEE 4 API new frame ID function.
+ * @details This function takes the next free frame ID and starts tracking it.
+ * @param[in] api : API frame engine object.
+ * See #xbee4_api_t object definition for detailed explanation.
+ * @param[out] frame_id : New frame ID.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, all tracking entries are in use.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t xbee4_api_new_frame_id ( xbee4_api_t *api, uint8_t *frame_id );
+
+/**
+ * @brief XBEE 4 API write frame function.
+ * @details This function adds the delimiter, length and checksum around the frame
+ * data in the TX frame buffer and writes it, escaping the special bytes in API
+ * mode with escaping. Runs of bytes that need no escaping are written straight
+ * from the frame buffer.
+ * @param[in] api : API frame engine object.
+ * See #xbee4_api_t object definition for detailed explanation.
+ * @param[in] len : Frame data length.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t xbee4_api_write_frame ( xbee4_api_t *api, uint16_t len );
+
+/**
+ * @brief XBEE 4 API send tracked function.
+ * @details This function writes the frame and returns its frame ID, or releases
+ * the frame ID if the frame could not be written.
+ * @param[in] api : API frame engine object.
+ * See #xbee4_api_t object definition for detailed explanation.
+ * @param[in] len : Frame data length.
+ * @param[in] id : Frame ID of the frame, 0 if not tracked.
+ * @param[out] frame_id : Frame ID output, may be NULL.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t xbee4_api_send_tracked ( xbee4_api_t *api, uint16_t len, uint8_t id, uint8_t *frame_id );
+
+/**
+ * @brief XBEE 4 API escape check function.
+ * @details This function checks if a byte has to be escaped in API mode with escaping.
+ * @param[in] data_in : Byte to check.
+ * @return @li @c 1 - Byte has to be escaped,
+ *         @li @c 0 - Byte is sent as is.
+ * @note None.
+ */
+static uint8_t xbee4_api_is_special ( uint8_t data_in );
+
+err_t xbee4_api_init ( xbee4_api_t *api, xbee4_t *ctx, uint8_t mode )
+{
+    if ( ( XBEE4_MODE_API_WITHOUT_ESC != mode ) && ( XBEE4_MODE_API_WITH_ESC != mode ) )
+    {
+        return XBEE4_ERROR;
+    }
+    memset ( api, 0, sizeof ( xbee4_api_t ) );
+    api->ctx = ctx;
+    api->mode = mode;
+    api->state = XBEE4_API_STATE_DELIMITER;
+    return XBEE4_OK;
+}
+
+uint8_t xbee4_api_process ( xbee4_api_t *api )
+{
+    uint8_t rx_buf[ XBEE4_API_RX_CHUNK_SIZE ] = { 0 };
+    int32_t rx_size = 0;
+    int32_t cnt = 0;
+    uint8_t frames = 0;
+
+    while ( ( rx_size = xbee4_generic_read( api->ctx, ( uint8_t * ) rx_buf, XBEE4_API_RX_CHUNK_SIZE ) ) > 0 )
+    {
+        for ( cnt = 0; cnt < rx_size; cnt++ )
+        {
+            frames += xbee4_api_rx_byte( api, rx_buf[ cnt ] );
+        }
+    }
+    return frames;
+}
+
+uint8_t xbee4_api_rx_byte ( xbee4_api_t *api, uint8_t rx_data )
+{
+    // Without escaping the delimiter may appear in the frame data, so it starts
+    // a frame only while waiting for one.
+    if ( ( XBEE4_API_START_DELIMITER == rx_data ) && 
+         ( ( XBEE4_MODE_API_WITH_ESC == api->mode ) || ( XBEE4_API_STATE_DELIMITER == api->state ) ) )
+    {
+        if ( XBEE4_API_STATE_DELIMITER != api->state )
+        {
+            api->frame_err++;
+        }
+        api->state = XBEE4_API_STATE_LEN_MSB;
+        api->esc_f = 0;
+        return 0;
+    }
+
+    if ( XBEE4_API_STATE_DELIMITER == api->state )
+    {
+        return 0;
+    }
+
+    if ( XBEE4_MODE_API_WITH_ESC == api->mode )
+    {
+        if ( XBEE4_API_ESCAPE == rx_data )
+        {
+            api->esc_f = 1;
+            return 0;
+        }
+        if ( api->esc_f )
+        {
+            rx_data ^= XBEE4_API_ESCAPE_XOR;
+            api->esc_f = 0;
+        }
+    }
+
+    switch ( api->state )
+    {
+        case XBEE4_API_STATE_LEN_MSB:
+        {
+            api->len = ( uint16_t ) rx_data << 8;
+            api->state = XBEE4_API_STATE_LEN_LSB;
+            break;
+        }
+        case XBEE4_API_STATE_LEN_LSB:
+        {
+            api->len |= rx_data;
+            if ( ( 0 == api->len ) || ( api->len > XBEE4_API_MAX_FRAME_SIZE ) )
+            {
+                api->frame_err++;
+                api->state = XBEE4_API_STATE_DELIMITER;
+                break;
+            }
+            api->cnt = 0;
+            api->sum = 0;
+            api->state = XBEE4_API_STATE_DATA;
+            break;
+        }
+        case XBEE4_API_STATE_DATA:
+        {
+            api->rx_frame[ api->cnt++ ] = rx_data;
+            api->sum += rx_data;
+            if ( api->cnt == api->len )
+            {
+                api->state = XBEE4_API_STATE_CHECKSUM;
+            }
+            break;
+        }
+        case XBEE4_API_STATE_CHECKSUM:
+        {
+            api->state = XBEE4_API_STATE_DELIMITER;
+            if ( 0xFF != ( uint8_t ) ( api->sum + rx_data ) )
+            {
+                api->checksum_err++;
+                return 0;
+            }
+            return xbee4_api_dispatch( api );
+        }
+        default:
+        {
+            api->state = XBEE4_API_STATE_DELIMITER;
+            break;
+        }
+    }
+    return 0;
+}
+
+uint8_t *xbee4_api_get_tx_payload ( xbee4_api_t *api )
+{
+    return &api->tx_frame[ 3 + XBEE4_API_TX_REQUEST_HDR_SIZE ];
+}
+
+uint8_t *xbee4_api_get_frame_data ( xbee4_api_t *api )
+{
+    return &api->tx_frame[ 3 ];
+}
+
+err_t xbee4_api_send_tx_request ( xbee4_api_t *api, uint8_t *addr64, uint16_t addr16, uint16_t len, uint8_t *frame_id )
+{
+    uint8_t *frame = &api->tx_frame[ 3 ];
+    uint8_t id = 0;
+
+    if ( len > XBEE4_API_TX_MAX_PAYLOAD )
+    {
+        return XBEE4_ERROR;
+    }
+    if ( ( NULL != frame_id ) && ( XBEE4_OK != xbee4_api_new_frame_id( api, &id ) ) )
+    {
+        return XBEE4_ERROR;
+    }
+
+    // The payload is already in place behind the header
+    frame[ 0 ] = XBEE4_API_FRAME_TX_REQUEST;
+    frame[ 1 ] = id;
+    memcpy ( &frame[ 2 ], addr64, 8 );
+    frame[ 10 ] = ( uint8_t ) ( ( addr16 >> 8 ) & 0xFF );
+    frame[ 11 ] = ( uint8_t ) ( addr16 & 0xFF );
+    frame[ 12 ] = 0;
+    frame[ 13 ] = 0;
+    return xbee4_api_send_tracked( api, XBEE4_API_TX_REQUEST_HDR_SIZE + len, id, frame_id );
+}
+
+err_t xbee4_api_send_at_cmd ( xbee4_api_t *api, char *cmd, uint8_t *param, uint8_t param_len, uint8_t *frame_id )
+{
+    uint8_t *frame = &api->tx_frame[ 3 ];
+    uint8_t id = 0;
+
+    if ( ( ( NULL == param ) && param_len ) || ( param_len > ( XBEE4_API_MAX_FRAME_SIZE - XBEE4_API_AT_CMD_HDR_SIZE ) ) )
+    {
+        return XBEE4_ERROR;
+    }
+    if ( ( NULL != frame_id ) && ( XBEE4_OK != xbee4_api_new_frame_id( api, &id ) ) )
+    {
+        return XBEE4_ERROR;
+    }
+
+    frame[ 0 ] = XBEE4_API_FRAME_AT_CMD;
+    frame[ 1 ] = id;
+    frame[ 2 ] = cmd[ 0 ];
+    frame[ 3 ] = cmd[ 1 ];
+    if ( param_len )
+    {
+        memcpy ( &frame[ XBEE4_API_AT_CMD_HDR_SIZE ], param, param_len );
+    }
+    return xbee4_api_send_tracked( api, XBEE4_API_AT_CMD_HDR_SIZE + param_len, id, frame_id );
+}
+
+err_t xbee4_api_send_remote_at_cmd ( xbee4_api_t *api, uint8_t *addr64, uint16_t addr16, char *cmd,
+                                     uint8_t *param, uint8_t param_len, uint8_t options, uint8_t *frame_id )
+{
+    uint8_t *frame = &api->tx_frame[ 3 ];
+    uint8_t id = 0;
+
+    if ( ( ( NULL == param ) && param_len ) || ( param_len > ( XBEE4_API_MAX_FRAME_SIZE - XBEE4_API_REMOTE_AT_CMD_HDR_SIZE ) ) )
+    {
+        return XBEE4_ERROR;
+    }
+    if ( ( NULL != frame_id ) && ( XBEE4_OK != xbee4_api_new_frame_id( api, &id ) ) )
+    {
+        return XBEE4_ERROR;
+    }
+
+    frame[ 0 ] = XBEE4_API_FRAME_REMOTE_AT_CMD;
+    frame[ 1 ] = id;
+    memcpy ( &frame[ 2 ], addr64, 8 );
+    frame[ 10 ] = ( uint8_t ) ( ( addr16 >> 8 ) & 0xFF );
+    frame[ 11 ] = ( uint8_t ) ( addr16 & 0xFF );
+    frame[ 12 ] = options;
+    frame[ 13 ] = cmd[ 0 ];
+    frame[ 14 ] = cmd[ 1 ];
+    if ( param_len )
+    {
+        memcpy ( &frame[ XBEE4_API_REMOTE_AT_CMD_HDR_SIZE ], param, param_len );
+    }
+    return xbee4_api_send_tracked( api, XBEE4_API_REMOTE_AT_CMD_HDR_SIZE + param_len, id, frame_id );
+}
+
+err_t xbee4_api_send_frame ( xbee4_api_t *api, uint16_t len )
+{
+    if ( ( 0 == len ) || ( len > XBEE4_API_MAX_FRAME_SIZE ) )
+    {
+        return XBEE4_ERROR;
+    }
+    return xbee4_api_write_frame( api, len );
+}
+
+uint8_t xbee4_api_get_status ( xbee4_api_t *api, uint8_t frame_id )
+{
+    uint8_t entry = xbee4_api_find( api, frame_id );
+    uint8_t status = XBEE4_API_STATUS_UNKNOWN;
+
+    if ( ( 0 == frame_id ) || ( entry >= XBEE4_API_MAX_PENDING ) )
+    {
+        return XBEE4_API_STATUS_UNKNOWN;
+    }
+    status = api->pending[ entry ].status;
+    if ( XBEE4_API_STATUS_PENDING != status )
+    {
+        api->pending[ entry ].frame_id = 0;
+    }
+    return status;
+}
+
+void xbee4_api_cancel ( xbee4_api_t *api, uint8_t frame_id )
+{
+    uint8_t entry = xbee4_api_find( api, frame_id );
+
+    if ( ( 0 != frame_id ) && ( entry < XBEE4_API_MAX_PENDING ) )
+    {
+        api->pending[ entry ].frame_id = 0;
+    }
+}
+
+static uint8_t xbee4_api_dispatch ( xbee4_api_t *api )
+{
+    uint8_t *frame = api->rx_frame;
+    xbee4_api_rx_t rx;
+    xbee4_api_at_rsp_t at_rsp;
+
+    switch ( frame[ 0 ] )
+    {
+        case XBEE4_API_FRAME_RX_PACKET:
+        {
+            if ( api->len < XBEE4_API_RX_PACKET_HDR_SIZE )
+            {
+                break;
+            }
+            rx.addr64 = &frame[ 1 ];
+            rx.addr16 = ( ( uint16_t ) frame[ 9 ] << 8 ) | frame[ 10 ];
+            rx.options = frame[ 11 ];
+            rx.data = &frame[ XBEE4_API_RX_PACKET_HDR_SIZE ];
+            rx.len = api->len - XBEE4_API_RX_PACKET_HDR_SIZE;
+            if ( NULL != api->rx_handler )
+            {
+                api->rx_handler( &rx );
+            }
+            return 1;
+        }
+        case XBEE4_API_FRAME_TX_STATUS:
+        {
+            if ( api->len < XBEE4_API_TX_STATUS_SIZE )
+            {
+                break;
+            }
+            xbee4_api_complete( api, frame[ 1 ], frame[ 5 ] );
+            if ( NULL != api->tx_handler )
+            {
+                api->tx_handler( frame[ 1 ], frame[ 5 ] );
+            }
+            return 1;
+        }
+        case XBEE4_API_FRAME_TX_STATUS_LEGACY:
+        {
+            if ( api->len < XBEE4_API_TX_STATUS_LEGACY_SIZE )
+            {
+                break;
+            }
+            xbee4_api_complete( api, frame[ 1 ], frame[ 2 ] );
+            if ( NULL != api->tx_handler )
+            {
+                api->tx_handler( frame[ 1 ], frame[ 2 ] );
+            }
+            return 1;
+        }
+        case XBEE4_API_FRAME_AT_RSP:
+        {
+            if ( api->len < XBEE4_API_AT_RSP_HDR_SIZE )
+            {
+                break;
+            }
+            at_rsp.frame_id = frame[ 1 ];
+            at_rsp.remote = 0;
+            at_rsp.addr64 = NULL;
+            at_rsp.addr16 = 0;
+            at_rsp.cmd[ 0 ] = frame[ 2 ];
+            at_rsp.cmd[ 1 ] = frame[ 3 ];
+            at_rsp.status = frame[ 4 ];
+            at_rsp.data = &frame[ XBEE4_API_AT_RSP_HDR_SIZE ];
+            at_rsp.len = api->len - XBEE4_API_AT_RSP_HDR_SIZE;
+            xbee4_api_complete( api, at_rsp.frame_id, at_rsp.status );
+            if ( NULL != api->at_handler )
+            {
+                api->at_handler( &at_rsp );
+            }
+            return 1;
+        }
+        case XBEE4_API_FRAME_REMOTE_AT_RSP:
+        {
+            if ( api->len < XBEE4_API_REMOTE_AT_RSP_HDR_SIZE )
+            {
+                break;
+            }
+            at_rsp.frame_id = frame[ 1 ];
+            at_rsp.remote = 1;
+            at_rsp.addr64 = &frame[ 2 ];
+            at_rsp.addr16 = ( ( uint16_t ) frame[ 10 ] << 8 ) | frame[ 11 ];
+            at_rsp.cmd[ 0 ] = frame[ 12 ];
+            at_rsp.cmd[ 1 ] = frame[ 13 ];
+            at_rsp.status = frame[ 14 ];
+            at_rsp.data = &frame[ XBEE4_API_REMOTE_AT_RSP_HDR_SIZE ];
+            at_rsp.len = api->len - XBEE4_API_REMOTE_AT_RSP_HDR_SIZE;
+            xbee4_api_complete( api, at_rsp.frame_id, at_rsp.status );
+            if ( NULL != api->at_handler )
+            {
+                api->at_handler( &at_rsp );
+            }
+            return 1;
+        }
+        case XBEE4_API_FRAME_MODEM_STATUS:
+        {
+            if ( api->len < XBEE4_API_MODEM_STATUS_SIZE )
+            {
+                break;
+            }
+            if ( NULL != api->modem_handler )
+            {
+                api->modem_handler( frame[ 1 ] );
+            }
+            return 1;
+        }
+        default:
+        {
+            if ( NULL != api->frame_handler )
+            {
+                api->frame_handler( frame, api->len );
+            }
+            return 1;
+        }
+    }
+    api->frame_err++;
+    return 0;
+}
+
+static void xbee4_api_complete ( xbee4_api_t *api, uint8_t frame_id, uint8_t status )
+{
+    uint8_t entry = xbee4_api_find( api, frame_id );
+
+    if ( ( 0 != frame_id ) && ( entry < XBEE4_API_MAX_PENDING ) && 
+         ( XBEE4_API_STATUS_PENDING == api->pending[ entry ].status ) )
+    {
+        api->pending[ entry ].status = status;
+    }
+}
+
+static uint8_t xbee4_api_find ( xbee4_api_t *api, uint8_t frame_id )
+{
+    uint8_t entry = 0;
+
+    for ( entry = 0; entry < XBEE4_API_MAX_PENDING; entry++ )
+    {
+        if ( frame_id == api->pending[ entry ].frame_id )
+        {
+            break;
+        }
+    }
+    return entry;
+}
+
+static err_t xbee4_api_new_frame_id ( xbee4_api_t *api, uint8_t *frame_id )
+{
+    uint8_t entry = xbee4_api_find( api, 0 );
+
+    if ( entry >= XBEE4_API_MAX_PENDING )
+    {
+        return XBEE4_ERROR;
+    }
+
+    // Frame ID 0 disables the response, IDs still tracked are skipped
+    do
+    {
+        if ( 0 == ++api->frame_id )
+        {
+            api->frame_id = 1;
+        }
+    }
+    while ( xbee4_api_find( api, api->frame_id ) < XBEE4_API_MAX_PENDING );
+
+    api->pending[ entry ].frame_id = api->frame_id;
+    api->pending[ entry ].status = XBEE4_API_STATUS_PENDING;
+    *frame_id = api->frame_id;
+    return XBEE4_OK;
+}
+
+static err_t xbee4_api_write_frame ( xbee4_api_t *api, uint16_t len )
+{
+    uint8_t *frame = api->tx_frame;
+    uint16_t frame_len = len + 4;
+    uint16_t run = 0;
+    uint16_t cnt = 0;
+    uint8_t sum = 0;
+    uint8_t esc_buf[ 2 ] = { XBEE4_API_ESCAPE, 0 };
+
+    frame[ 0 ] = XBEE4_API_START_DELIMITER;
+    frame[ 1 ] = ( uint8_t ) ( ( len >> 8 ) & 0xFF );
+    frame[ 2 ] = ( uint8_t ) ( len & 0xFF );
+    for ( cnt = 3; cnt < ( len + 3 ); cnt++ )
+    {
+        sum += frame[ cnt ];
+    }
+    frame[ len + 3 ] = 0xFF - sum;
+
+    if ( XBEE4_MODE_API_WITH_ESC != api->mode )
+    {
+        return ( xbee4_generic_write( api->ctx, ( uint8_t * ) frame, frame_len ) < 0 ) ? XBEE4_ERROR : XBEE4_OK;
+    }
+
+    // The start delimiter is never escaped
+    for ( cnt = 1; cnt < frame_len; cnt++ )
+    {
+        if ( !xbee4_api_is_special( frame[ cnt ] ) )
+        {
+            continue;
+        }
+        if ( xbee4_generic_write( api->ctx, ( uint8_t * ) &frame[ run ], cnt - run ) < 0 )
+        {
+            return XBEE4_ERROR;
+        }
+        esc_buf[ 1 ] = frame[ cnt ] ^ XBEE4_API_ESCAPE_XOR;
+        if ( xbee4_generic_write( api->ctx, ( uint8_t * ) esc_buf, 2 ) < 0 )
+        {
+            return XBEE4_ERROR;
+        }
+        run = cnt + 1;
+    }
+    if ( ( run < frame_len ) && ( xbee4_generic_write( api->ctx, ( uint8_t * ) &frame[ run ], frame_len - run ) < 0 ) )
+    {
+        return XBEE4_ERROR;
+    }
+    return XBEE4_OK;
+}
+
+static err_t xbee4_api_send_tracked ( xbee4_api_t *api, uint16_t len, uint8_t id, uint8_t *frame_id )
+{
+    if ( XBEE4_OK != xbee4_api_write_frame( api, len ) )
+    {
+        xbee4_api_cancel( api, id );
+        return XBEE4_ERROR;
+    }
+    if ( NULL != frame_id )
+    {
+        *frame_id = id;
+    }
+    return XBEE4_OK;
+}
+
+static uint8_t xbee4_api_is_special ( uint8_t data_in )
+{
+    return ( ( XBEE4_API_START_DELIMITER == data_in ) || ( XBEE4_API_ESCAPE == data_in ) || 
+             ( XBEE4_API_XON == data_in ) || ( XBEE4_API_XOFF == data_in ) );
+}
+
+// ------------------------------------------------------------------------- END